@@ -889,7 +889,7 @@ idAFEntity_Base::DropAFs
   where * is an aribtrary string.
 ================
 */
-void idAFEntity_Base::DropAFs( idEntity *ent, const char *type, idList<idEntity *> *list ) {
+void idAFEntity_Base::DropAFs( idEntity *ent, const char *type, idList<idEntity *, idListFrameAllocator> *list ) {
 	const idKeyValue *kv;
 	const char *skinName;
 	idEntity *newEnt;
@@ -1163,7 +1163,7 @@ void idAFEntity_Gibbable::SpawnGibs( const idVec3 &dir, const char *damageDefNam
 	int i;
 	bool gibNonSolid;
 	idVec3 entityCenter, velocity;
-	idList<idEntity *> list;
+	idList<idEntity *, idListFrameAllocator> list;
 
 	assert( !gameLocal.isClient );
 
@@ -603,6 +603,7 @@ private:
 	void					SortActiveEntityList( void );
 	void					ShowTargets( void );
 	void					RunDebugInfo( void );
+	void					ToggleFrameAllocator( void );
 
 	void					InitScriptForMap( void );
 
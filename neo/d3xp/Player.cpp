@@ -3190,7 +3190,11 @@ void idPlayer::DrawHUD( idUserInterface *_hud ) {
 	// FIXME: this is temp to allow the sound meter to show up in the hud
 	// it should be commented out before shipping but the code can remain
 	// for mod developers to enable for the same functionality
-	_hud->SetStateInt( "s_debug", cvarSystem->GetCVarInteger( "s_showLevelMeter" ) );
+	static cvarHandle_t showLevelMeter = -1;
+	if ( showLevelMeter == -1 ) {
+		showLevelMeter = cvarSystem->GetHandle( "s_showLevelMeter" );
+	}
+	_hud->SetStateInt( "s_debug", cvarSystem->GetCVarInteger( showLevelMeter ) );
 
 	weapon.GetEntity()->UpdateGUI();
 
@@ -10019,8 +10023,12 @@ idPlayer::UpdatePlayerIcons
 ===============
 */
 void idPlayer::UpdatePlayerIcons( void ) {
+	static cvarHandle_t clientMaxPrediction = -1;
+	if ( clientMaxPrediction == -1 ) {
+		clientMaxPrediction = cvarSystem->GetHandle( "net_clientMaxPrediction" );
+	}
 	int time = networkSystem->ServerGetClientTimeSinceLastPacket( entityNumber );
-	if ( time > cvarSystem->GetCVarInteger( "net_clientMaxPrediction" ) ) {
+	if ( time > cvarSystem->GetCVarInteger( clientMaxPrediction ) ) {
 		isLagged = true;
 	} else {
 		isLagged = false;
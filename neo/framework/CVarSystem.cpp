@@ -31,6 +31,9 @@ If you have questions concerning this license or the applicable additional terms
 
 idCVar * idCVar::staticVars = NULL;
 
+// guards the values that can be read through handles from other threads
+static idSysSpinLock		cvarValueLock;
+
 /*
 ===============================================================================
 
@@ -53,8 +56,10 @@ public:
 	void					UpdateCheat( void );
 	void					Set( const char *newValue, bool force, bool fromServer );
 	void					Reset( void );
+	void					RecordChange( void );
 
 private:
+	cvarHandle_t			handle;					// index in the handle table
 	idStr					nameString;				// name
 	idStr					resetString;			// resetting will change to this value
 	idStr					valueString;			// value
@@ -73,6 +78,7 @@ idInternalCVar::idInternalCVar
 ============
 */
 idInternalCVar::idInternalCVar( void ) {
+	handle = -1;
 }
 
 /*
@@ -96,6 +102,7 @@ idInternalCVar::idInternalCVar( const char *newName, const char *newValue, int n
 	UpdateValue();
 	UpdateCheat();
 	internalVar = this;
+	handle = -1;
 }
 
 /*
@@ -119,6 +126,7 @@ idInternalCVar::idInternalCVar( const idCVar *cvar ) {
 	UpdateValue();
 	UpdateCheat();
 	internalVar = this;
+	handle = -1;
 }
 
 /*
@@ -198,8 +206,17 @@ void idInternalCVar::Update( const idCVar *cvar ) {
 		Mem_Free( valueStrings );
 		valueStrings = CopyValueStrings( cvar->GetValueStrings() );
 		valueCompletion = cvar->GetValueCompletion();
+		idStr oldValue = valueString;
+		int oldInteger = integerValue;
+		float oldFloat = floatValue;
+		cvarValueLock.Lock();
 		UpdateValue();
+		cvarValueLock.Unlock();
 		cvarSystem->SetModifiedFlags( cvar->GetFlags() );
+		// the new type or range may have changed the value
+		if ( valueString.Cmp( oldValue ) != 0 || integerValue != oldInteger || floatValue != oldFloat ) {
+			RecordChange();
+		}
 	}
 
 	flags |= cvar->GetFlags();
@@ -314,7 +331,11 @@ void idInternalCVar::Set( const char *newValue, bool force, bool fromServer ) {
 #endif
 		}
 #endif
-		if ( ( flags & CVAR_CHEAT ) && !cvarSystem->GetCVarBool( "net_allowCheats" ) ) {
+		static cvarHandle_t allowCheats = -1;
+		if ( allowCheats == -1 ) {
+			allowCheats = cvarSystem->GetHandle( "net_allowCheats" );
+		}
+		if ( ( flags & CVAR_CHEAT ) && !cvarSystem->GetCVarBool( allowCheats ) ) {
 			common->Printf( "%s cannot be changed in multiplayer.\n", nameString.c_str() );
 #if ID_ALLOW_CHEATS
 			common->Printf( "ID_ALLOW_CHEATS override!\n" );
@@ -344,12 +365,15 @@ void idInternalCVar::Set( const char *newValue, bool force, bool fromServer ) {
 		return;
 	}
 
+	cvarValueLock.Lock();
 	valueString = newValue;
 	value = valueString.c_str();
 	UpdateValue();
+	cvarValueLock.Unlock();
 
 	SetModified();
 	cvarSystem->SetModifiedFlags( flags );
+	RecordChange();
 }
 
 /*
@@ -358,9 +382,17 @@ idInternalCVar::Reset
 ============
 */
 void idInternalCVar::Reset( void ) {
+	bool changed = ( valueString.Icmp( resetString ) != 0 );
+
+	cvarValueLock.Lock();
 	valueString = resetString;
 	value = valueString.c_str();
 	UpdateValue();
+	cvarValueLock.Unlock();
+
+	if ( changed ) {
+		RecordChange();
+	}
 }
 
 /*
@@ -441,6 +473,18 @@ public:
 	virtual int				GetCVarInteger( const char *name ) const;
 	virtual float			GetCVarFloat( const char *name ) const;
 
+	virtual cvarHandle_t	GetHandle( const char *name ) const;
+	virtual idCVar *		FindByHandle( cvarHandle_t handle );
+
+	virtual const char *	GetCVarString( cvarHandle_t handle ) const;
+	virtual bool			GetCVarBool( cvarHandle_t handle ) const;
+	virtual int				GetCVarInteger( cvarHandle_t handle ) const;
+	virtual float			GetCVarFloat( cvarHandle_t handle ) const;
+	virtual void			CopyCVarString( cvarHandle_t handle, char *buffer, int bufferSize ) const;
+
+	virtual int				GetChangedCVars( int &sequence, cvarHandle_t *handles, int maxHandles ) const;
+	virtual void			AdvanceChangeJournal( void );
+
 	virtual bool			Command( const idCmdArgs &args );
 
 	virtual void			CommandCompletion( void(*callback)( const char *s ) );
@@ -460,12 +504,18 @@ public:
 	void					RegisterInternal( idCVar *cvar );
 	idInternalCVar *		FindInternal( const char *name ) const;
 	void					SetInternal( const char *name, const char *value, int flags );
+	void					AddInternal( idInternalCVar *internal );
+	void					RecordChange( idInternalCVar *internal );
 
 private:
 	bool					initialized;
 	idList<idInternalCVar*>	cvars;
 	idHashIndex				cvarHash;
 	int						modifiedFlags;
+	idList<idInternalCVar*>	handleTable;			// never shrinks so handles stay valid, removed cvars are NULL
+	idList<cvarHandle_t>	changeJournal;			// handles of the changed cvars in the current and previous frame
+	int						journalBase;			// sequence number of the first journal entry
+	int						journalFrameStart;		// sequence number of the first change in the current frame
 							// use a static dictionary to MoveCVarsToDict can be used from game
 	static idDict			moveCVarsToDict;
 
@@ -536,7 +586,6 @@ idCVarSystemLocal::SetInternal
 ============
 */
 void idCVarSystemLocal::SetInternal( const char *name, const char *value, int flags ) {
-	int hash;
 	idInternalCVar *internal;
 
 	internal = FindInternal( name );
@@ -547,9 +596,45 @@ void idCVarSystemLocal::SetInternal( const char *name, const char *value, int fl
 		internal->UpdateCheat();
 	} else {
 		internal = new idInternalCVar( name, value, flags );
-		hash = cvarHash.GenerateKey( internal->nameString.c_str(), false );
-		cvarHash.Add( hash, cvars.Append( internal ) );
+		AddInternal( internal );
+	}
+}
+
+/*
+============
+idCVarSystemLocal::AddInternal
+============
+*/
+void idCVarSystemLocal::AddInternal( idInternalCVar *internal ) {
+	int hash;
+
+	hash = cvarHash.GenerateKey( internal->nameString.c_str(), false );
+	cvarHash.Add( hash, cvars.Append( internal ) );
+
+	idScopedSpinLock lock( cvarValueLock );
+	internal->handle = handleTable.Append( internal );
+}
+
+/*
+============
+idCVarSystemLocal::RecordChange
+============
+*/
+void idCVarSystemLocal::RecordChange( idInternalCVar *internal ) {
+	if ( internal->handle == -1 ) {
+		return;
 	}
+	idScopedSpinLock lock( cvarValueLock );
+	changeJournal.Append( internal->handle );
+}
+
+/*
+============
+idInternalCVar::RecordChange
+============
+*/
+void idInternalCVar::RecordChange( void ) {
+	localCVarSystem.RecordChange( this );
 }
 
 /*
@@ -560,6 +645,8 @@ idCVarSystemLocal::idCVarSystemLocal
 idCVarSystemLocal::idCVarSystemLocal( void ) {
 	initialized = false;
 	modifiedFlags = 0;
+	journalBase = 0;
+	journalFrameStart = 0;
 }
 
 /*
@@ -590,6 +677,13 @@ idCVarSystemLocal::Shutdown
 ============
 */
 void idCVarSystemLocal::Shutdown( void ) {
+	cvarValueLock.Lock();
+	handleTable.Clear();
+	changeJournal.Clear();
+	journalBase = 0;
+	journalFrameStart = 0;
+	cvarValueLock.Unlock();
+
 	cvars.DeleteContents( true );
 	cvarHash.Free();
 	moveCVarsToDict.Clear();
@@ -611,7 +705,6 @@ idCVarSystemLocal::Register
 ============
 */
 void idCVarSystemLocal::Register( idCVar *cvar ) {
-	int hash;
 	idInternalCVar *internal;
 
 	cvar->SetInternalVar( cvar );
@@ -622,8 +715,7 @@ void idCVarSystemLocal::Register( idCVar *cvar ) {
 		internal->Update( cvar );
 	} else {
 		internal = new idInternalCVar( cvar );
-		hash = cvarHash.GenerateKey( internal->nameString.c_str(), false );
-		cvarHash.Add( hash, cvars.Append( internal ) );
+		AddInternal( internal );
 	}
 
 	cvar->SetInternalVar( internal );
@@ -726,6 +818,143 @@ float idCVarSystemLocal::GetCVarFloat( const char *name ) const {
 	return 0.0f;
 }
 
+/*
+============
+idCVarSystemLocal::GetHandle
+============
+*/
+cvarHandle_t idCVarSystemLocal::GetHandle( const char *name ) const {
+	idInternalCVar *internal = FindInternal( name );
+	if ( internal ) {
+		return internal->handle;
+	}
+	return -1;
+}
+
+/*
+============
+idCVarSystemLocal::FindByHandle
+============
+*/
+idCVar *idCVarSystemLocal::FindByHandle( cvarHandle_t handle ) {
+	if ( handle < 0 || handle >= handleTable.Num() ) {
+		return NULL;
+	}
+	return handleTable[handle];
+}
+
+/*
+============
+idCVarSystemLocal::GetCVarString
+============
+*/
+const char *idCVarSystemLocal::GetCVarString( cvarHandle_t handle ) const {
+	if ( handle < 0 || handle >= handleTable.Num() || handleTable[handle] == NULL ) {
+		return "";
+	}
+	return handleTable[handle]->GetString();
+}
+
+/*
+============
+idCVarSystemLocal::GetCVarBool
+============
+*/
+bool idCVarSystemLocal::GetCVarBool( cvarHandle_t handle ) const {
+	return ( GetCVarInteger( handle ) != 0 );
+}
+
+/*
+============
+idCVarSystemLocal::GetCVarInteger
+
+The handle table can grow and user created cvars can be deleted while another
+thread reads from it, so the value is read while holding the lock.
+============
+*/
+int idCVarSystemLocal::GetCVarInteger( cvarHandle_t handle ) const {
+	idScopedSpinLock lock( cvarValueLock );
+
+	if ( handle < 0 || handle >= handleTable.Num() || handleTable[handle] == NULL ) {
+		return 0;
+	}
+	return handleTable[handle]->GetInteger();
+}
+
+/*
+============
+idCVarSystemLocal::GetCVarFloat
+============
+*/
+float idCVarSystemLocal::GetCVarFloat( cvarHandle_t handle ) const {
+	idScopedSpinLock lock( cvarValueLock );
+
+	if ( handle < 0 || handle >= handleTable.Num() || handleTable[handle] == NULL ) {
+		return 0.0f;
+	}
+	return handleTable[handle]->GetFloat();
+}
+
+/*
+============
+idCVarSystemLocal::CopyCVarString
+============
+*/
+void idCVarSystemLocal::CopyCVarString( cvarHandle_t handle, char *buffer, int bufferSize ) const {
+	idScopedSpinLock lock( cvarValueLock );
+
+	if ( handle < 0 || handle >= handleTable.Num() || handleTable[handle] == NULL ) {
+		idStr::Copynz( buffer, "", bufferSize );
+		return;
+	}
+	idStr::Copynz( buffer, handleTable[handle]->GetString(), bufferSize );
+}
+
+/*
+============
+idCVarSystemLocal::GetChangedCVars
+============
+*/
+int idCVarSystemLocal::GetChangedCVars( int &sequence, cvarHandle_t *handles, int maxHandles ) const {
+	int i, num, first;
+
+	idScopedSpinLock lock( cvarValueLock );
+
+	if ( sequence < journalBase || sequence > journalBase + changeJournal.Num() ) {
+		sequence = journalBase + changeJournal.Num();
+		return -1;
+	}
+
+	first = sequence - journalBase;
+	num = Min( changeJournal.Num() - first, maxHandles );
+	for ( i = 0; i < num; i++ ) {
+		handles[i] = changeJournal[first + i];
+	}
+	sequence += num;
+
+	return num;
+}
+
+/*
+============
+idCVarSystemLocal::AdvanceChangeJournal
+============
+*/
+void idCVarSystemLocal::AdvanceChangeJournal( void ) {
+	int i, numDropped;
+
+	idScopedSpinLock lock( cvarValueLock );
+
+	numDropped = journalFrameStart - journalBase;
+	for ( i = numDropped; i < changeJournal.Num(); i++ ) {
+		changeJournal[i - numDropped] = changeJournal[i];
+	}
+	changeJournal.SetNum( changeJournal.Num() - numDropped, false );
+
+	journalBase += numDropped;
+	journalFrameStart = journalBase + changeJournal.Num();
+}
+
 /*
 ============
 idCVarSystemLocal::Command
@@ -1245,6 +1474,9 @@ void idCVarSystemLocal::Restart_f( const idCmdArgs &args ) {
 		// throw out any variables the user created
 		if ( !( cvar->flags & CVAR_STATIC ) ) {
 			hash = localCVarSystem.cvarHash.GenerateKey( cvar->nameString, false );
+			cvarValueLock.Lock();
+			localCVarSystem.handleTable[cvar->handle] = NULL;
+			cvarValueLock.Unlock();
 			delete cvar;
 			localCVarSystem.cvars.RemoveIndex( i );
 			localCVarSystem.cvarHash.RemoveIndex( hash, i );
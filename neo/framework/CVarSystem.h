@@ -76,6 +76,10 @@ If you have questions concerning this license or the applicable additional terms
 	CVAR_ROM, CVAR_ARCHIVE, CVAR_USERINFO, CVAR_SERVERINFO, CVAR_NETWORKSYNC
 	is set.
 
+	CVars can be looked up once by name to get a handle which is then used
+	to read the value without hashing and comparing the name again. Numeric
+	values and string copies can be read through a handle from any thread.
+
 ===============================================================================
 */
 
@@ -102,6 +106,8 @@ typedef enum {
 	CVAR_MODIFIED			= BIT(18)	// set when the variable is modified
 } cvarFlags_t;
 
+typedef int cvarHandle_t;				// -1 is never a valid handle
+
 
 /*
 ===============================================================================
@@ -232,6 +238,28 @@ public:
 	virtual int				GetCVarInteger( const char *name ) const = 0;
 	virtual float			GetCVarFloat( const char *name ) const = 0;
 
+							// Returns a handle for the CVar with the given name, or -1 if there is no such CVar.
+							// Handles stay valid until shutdown, except that cvar_restart invalidates the
+							// handles of CVars created by the user.
+	virtual cvarHandle_t	GetHandle( const char *name ) const = 0;
+	virtual idCVar *		FindByHandle( cvarHandle_t handle ) = 0;
+
+							// Gets the value of a CVar by handle. The numeric values can be read from any thread.
+	virtual const char *	GetCVarString( cvarHandle_t handle ) const = 0;
+	virtual bool			GetCVarBool( cvarHandle_t handle ) const = 0;
+	virtual int				GetCVarInteger( cvarHandle_t handle ) const = 0;
+	virtual float			GetCVarFloat( cvarHandle_t handle ) const = 0;
+							// Copies the string value of a CVar, can be used from any thread.
+	virtual void			CopyCVarString( cvarHandle_t handle, char *buffer, int bufferSize ) const = 0;
+
+							// Every change to a CVar value is added to a change journal which holds the changes
+							// of the current and the previous frame. Returns the handles of the CVars changed
+							// since the given journal sequence number and advances it past them. Returns -1 if
+							// changes were already dropped from the journal, in which case anything may have changed.
+	virtual int				GetChangedCVars( int &sequence, cvarHandle_t *handles, int maxHandles ) const = 0;
+							// Starts a new frame in the change journal, dropping the changes older than the last frame.
+	virtual void			AdvanceChangeJournal( void ) = 0;
+
 							// Called by the command system when argv(0) doesn't match a known command.
 							// Returns true if argv(0) is a variable reference and prints or changes the CVar.
 	virtual bool			Command( const idCmdArgs &args ) = 0;
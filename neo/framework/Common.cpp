@@ -1731,7 +1731,8 @@ idCommonLocal::LocalizeGui
 ===============
 */
 void idCommonLocal::LocalizeGui( const char *fileName, idLangDict &langDict ) {
-	idStr out, ws, work;
+	idStr out;
+	idStrView ws;
 	const char *buffer = NULL;
 	out.Empty();
 	int k;
@@ -1749,7 +1750,7 @@ void idCommonLocal::LocalizeGui( const char *fileName, idLangDict &langDict ) {
 			idToken token;
 			while( src.ReadToken( &token ) ) {
 				src.GetLastWhiteSpace( ws );
-				out += ws;
+				out.Append( ws );
 				if ( token.type == TT_STRING ) {
 					out += va( "\"%s\"", token.c_str() );
 				} else {
@@ -1759,13 +1760,12 @@ void idCommonLocal::LocalizeGui( const char *fileName, idLangDict &langDict ) {
 					outFile->Write( out.c_str(), out.Length() );
 					out = "";
 				}
-				work = token.Right( 6 );
-				if ( token.Icmp( "text" ) == 0 || work.Icmp( "::text" ) == 0 || token.Icmp( "choices" ) == 0 ) {
+				if ( token.Icmp( "text" ) == 0 || idStrView( token ).Right( 6 ).Icmp( "::text" ) == 0 || token.Icmp( "choices" ) == 0 ) {
 					if ( src.ReadToken( &token ) ) {
 						// see if already exists, if so save that id to this position in this file
 						// otherwise add this to the list and save the id to this position in this file
 						src.GetLastWhiteSpace( ws );
-						out += ws;
+						out.Append( ws );
 						token = langDict.AddString( token );
 						out += "\"";
 						for ( k = 0; k < token.Length(); k++ ) {
@@ -1788,7 +1788,7 @@ void idCommonLocal::LocalizeGui( const char *fileName, idLangDict &langDict ) {
 						// see if already exists, if so save that id to this position in this file
 						// otherwise add this to the list and save the id to this position in this file
 						src.GetLastWhiteSpace( ws );
-						out += ws;
+						out.Append( ws );
 						out += "\"";
 						for ( k = 0; k < token.Length(); k++ ) {
 							ch = token[k];
@@ -2291,6 +2291,214 @@ void Com_FinishBuild_f( const idCmdArgs &args ) {
 	globalImages->FinishBuild( ( args.Argc() > 1 ) );
 }
 
+/*
+===============================================================================
+
+	Lock-free queue stress test and benchmark.
+
+	Producers push ( producer << 24 ) | sequence numbers, consumers check that
+	the sequence numbers of every producer arrive in order and that the number
+	and sum of the popped items match what was pushed.
+
+===============================================================================
+*/
+
+const int LFQ_QUEUE_SIZE		= 1024;
+const int LFQ_MAX_THREADS		= 4;
+const int LFQ_ITEMS_PER_THREAD	= 1 << 20;
+
+// ring buffer with the same interface as the lock-free queues guarded by a critical section
+class idLockedTestQueue {
+public:
+							idLockedTestQueue( void ) { head = tail = 0; }
+
+	bool					Push( const int &element ) {
+								Sys_EnterCriticalSection( CRITICAL_SECTION_THREE );
+								if ( tail - head >= LFQ_QUEUE_SIZE ) {
+									Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+									return false;
+								}
+								elements[tail & ( LFQ_QUEUE_SIZE - 1 )] = element;
+								tail++;
+								Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+								return true;
+							}
+	bool					Pop( int &element ) {
+								Sys_EnterCriticalSection( CRITICAL_SECTION_THREE );
+								if ( head == tail ) {
+									Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+									return false;
+								}
+								element = elements[head & ( LFQ_QUEUE_SIZE - 1 )];
+								head++;
+								Sys_LeaveCriticalSection( CRITICAL_SECTION_THREE );
+								return true;
+							}
+
+private:
+	int						head;
+	int						tail;
+	int						elements[LFQ_QUEUE_SIZE];
+};
+
+template<class queueType>
+class idQueueStressTest {
+public:
+	queueType				queue;
+	int						numProducers;
+	idSysInterlockedInteger	producersDone;
+	idSysInterlockedInteger	threadsRunning;
+	idSysInterlockedInteger	numPopped;
+	idSysInterlockedInteger	sumPopped;
+	idSysInterlockedInteger	numErrors;
+
+	static unsigned int		ProducerThread( void *parm );
+	static unsigned int		ConsumerThread( void *parm );
+};
+
+typedef struct {
+	void *					test;
+	int						num;
+} lfqThreadParm_t;
+
+/*
+================
+idQueueStressTest::ProducerThread
+================
+*/
+template<class queueType>
+unsigned int idQueueStressTest<queueType>::ProducerThread( void *parm ) {
+	lfqThreadParm_t *p = (lfqThreadParm_t *)parm;
+	idQueueStressTest<queueType> *test = (idQueueStressTest<queueType> *)p->test;
+
+	for ( int i = 0; i < LFQ_ITEMS_PER_THREAD; i++ ) {
+		const int item = ( p->num << 24 ) | i;
+		while( !test->queue.Push( item ) ) {
+			idSysAtomic::YieldThread();
+		}
+	}
+	test->producersDone.Increment();
+	test->threadsRunning.Decrement();
+	return 0;
+}
+
+/*
+================
+idQueueStressTest::ConsumerThread
+================
+*/
+template<class queueType>
+unsigned int idQueueStressTest<queueType>::ConsumerThread( void *parm ) {
+	lfqThreadParm_t *p = (lfqThreadParm_t *)parm;
+	idQueueStressTest<queueType> *test = (idQueueStressTest<queueType> *)p->test;
+	int last[LFQ_MAX_THREADS];
+	int count = 0, errors = 0;
+	unsigned int sum = 0;
+
+	for ( int i = 0; i < LFQ_MAX_THREADS; i++ ) {
+		last[i] = -1;
+	}
+
+	while( 1 ) {
+		int item;
+		if ( !test->queue.Pop( item ) ) {
+			if ( test->producersDone.GetValue() == test->numProducers ) {
+				// the producers are done, drain whatever is left
+				if ( !test->queue.Pop( item ) ) {
+					break;
+				}
+			} else {
+				idSysAtomic::YieldThread();
+				continue;
+			}
+		}
+		const int producer = item >> 24;
+		const int sequence = item & ( ( 1 << 24 ) - 1 );
+		if ( producer < 0 || producer >= test->numProducers || sequence <= last[producer] ) {
+			errors++;
+		} else {
+			last[producer] = sequence;
+		}
+		count++;
+		sum += (unsigned int)sequence;
+	}
+
+	test->numPopped.Add( count );
+	test->sumPopped.Add( (int)sum );
+	test->numErrors.Add( errors );
+	test->threadsRunning.Decrement();
+	return 0;
+}
+
+/*
+================
+Com_RunQueueStressTest
+================
+*/
+template<class queueType>
+static void Com_RunQueueStressTest( const char *name, int numProducers, int numConsumers ) {
+	idQueueStressTest<queueType> *test = new idQueueStressTest<queueType>;
+	lfqThreadParm_t parms[LFQ_MAX_THREADS * 2];
+	xthreadInfo threads[LFQ_MAX_THREADS * 2];
+	xthreadInfo *threadList[MAX_THREADS];
+	int threadCount = 0;
+	int numThreads = 0;
+	int startTime, endTime;
+
+	test->numProducers = numProducers;
+	test->threadsRunning.SetValue( numProducers + numConsumers );
+
+	startTime = Sys_Milliseconds();
+	for ( int i = 0; i < numConsumers; i++, numThreads++ ) {
+		parms[numThreads].test = test;
+		parms[numThreads].num = i;
+		Sys_CreateThread( (xthread_t)idQueueStressTest<queueType>::ConsumerThread, &parms[numThreads], THREAD_NORMAL, threads[numThreads], "queueConsumer", threadList, &threadCount );
+	}
+	for ( int i = 0; i < numProducers; i++, numThreads++ ) {
+		parms[numThreads].test = test;
+		parms[numThreads].num = i;
+		Sys_CreateThread( (xthread_t)idQueueStressTest<queueType>::ProducerThread, &parms[numThreads], THREAD_NORMAL, threads[numThreads], "queueProducer", threadList, &threadCount );
+	}
+	while( test->threadsRunning.GetValue() > 0 ) {
+		Sys_Sleep( 1 );
+	}
+	endTime = Sys_Milliseconds();
+
+	for ( int i = 0; i < numThreads; i++ ) {
+		Sys_DestroyThread( threads[i] );
+	}
+
+	// the sequence numbers of every producer sum up to n * ( n - 1 ) / 2, wrapping is fine
+	const int expectedCount = numProducers * LFQ_ITEMS_PER_THREAD;
+	const int expectedSum = (int)( (unsigned int)numProducers * (unsigned int)( LFQ_ITEMS_PER_THREAD / 2 ) * (unsigned int)( LFQ_ITEMS_PER_THREAD - 1 ) );
+	const bool ok = test->numErrors.GetValue() == 0 && test->numPopped.GetValue() == expectedCount && test->sumPopped.GetValue() == expectedSum;
+	const int msec = Max( endTime - startTime, 1 );
+
+	common->Printf( "%-24s %dP/%dC: %6d msec %8.2f Mitems/s %s\n", name, numProducers, numConsumers, msec,
+						(float)expectedCount / ( msec * 1000.0f ), ok ? "ok" : S_COLOR_RED"X" );
+	if ( !ok ) {
+		common->Printf( "    popped %d of %d items, %d out of order\n", test->numPopped.GetValue(), expectedCount, test->numErrors.GetValue() );
+	}
+
+	delete test;
+}
+
+/*
+=================
+Com_BenchLockFreeQueue_f
+=================
+*/
+static void Com_BenchLockFreeQueue_f( const idCmdArgs &args ) {
+	common->Printf( "%d items per producer through a %d element queue\n", LFQ_ITEMS_PER_THREAD, LFQ_QUEUE_SIZE );
+	Com_RunQueueStressTest< idSPSCQueue<int,LFQ_QUEUE_SIZE> >( "idSPSCQueue", 1, 1 );
+	Com_RunQueueStressTest< idMPMCQueue<int,LFQ_QUEUE_SIZE> >( "idMPMCQueue", 1, 1 );
+	Com_RunQueueStressTest< idMPMCQueue<int,LFQ_QUEUE_SIZE> >( "idMPMCQueue", 2, 2 );
+	Com_RunQueueStressTest< idMPMCQueue<int,LFQ_QUEUE_SIZE> >( "idMPMCQueue", 4, 4 );
+	Com_RunQueueStressTest< idLockedTestQueue >( "critical section queue", 1, 1 );
+	Com_RunQueueStressTest< idLockedTestQueue >( "critical section queue", 2, 2 );
+	Com_RunQueueStressTest< idLockedTestQueue >( "critical section queue", 4, 4 );
+}
+
 /*
 ==============
 Com_Help_f
@@ -2367,11 +2575,20 @@ void idCommonLocal::InitCommands( void ) {
 	// idLib commands
 	cmdSystem->AddCommand( "memoryDump", Mem_Dump_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "creates a memory dump" );
 	cmdSystem->AddCommand( "memoryDumpCompressed", Mem_DumpCompressed_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "creates a compressed memory dump" );
-	cmdSystem->AddCommand( "showStringMemory", idStr::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by strings" );
+	cmdSystem->AddCommand( "memoryThreadCaches", Mem_ThreadCacheStats_f, CMD_FL_SYSTEM, "shows the hit rates of the per-thread memory caches" );
+	cmdSystem->AddCommand( "showStringMemory", idStr::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by strings and string allocation counts" );
 	cmdSystem->AddCommand( "showDictMemory", idDict::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by dictionaries" );
 	cmdSystem->AddCommand( "listDictKeys", idDict::ListKeys_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all keys used by dictionaries" );
 	cmdSystem->AddCommand( "listDictValues", idDict::ListValues_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all values used by dictionaries" );
 	cmdSystem->AddCommand( "testSIMD", idSIMD::Test_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "test SIMD code" );
+	cmdSystem->AddCommand( "benchSIMD", idSIMD::Bench_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "regression test and benchmark SIMD code" );
+	cmdSystem->AddCommand( "benchHashTable", FlatHashTable_Bench_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "compares the speed of the hash table containers" );
+	cmdSystem->AddCommand( "benchBTree", PackedBTree_Bench_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "compares the speed of idPackedBTree and idBTree" );
+	cmdSystem->AddCommand( "benchWinding", Winding_Bench_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "compares the speed of single and multi-plane winding clipping" );
+	cmdSystem->AddCommand( "benchMatX", MatX_Bench_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "compares the speed of the blocked and parallel idMatX factorizations" );
+	cmdSystem->AddCommand( "benchHash", Hash_Bench_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "compares the throughput of the checksum and hash functions" );
+	cmdSystem->AddCommand( "benchBitMsg", BitMsg_Bench_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "encodes and decodes snapshot payloads with idBitMsg" );
+	cmdSystem->AddCommand( "benchLockFreeQueue", Com_BenchLockFreeQueue_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "stress tests and compares the throughput of the lock-free queues" );
 
 	// localization
 	cmdSystem->AddCommand( "localizeGuis", Com_LocalizeGuis_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "localize guis" );
@@ -2481,6 +2698,9 @@ void idCommonLocal::Frame( void ) {
 
 		com_frameNumber++;
 
+		// keep the cvar changes of this frame for subsystems that poll the journal next frame
+		cvarSystem->AdvanceChangeJournal();
+
 		// set idLib frame number for frame based memory dumps
 		idLib::frameNumber = com_frameNumber;
 
@@ -2669,6 +2889,7 @@ void idCommonLocal::LoadGameDLL( void ) {
 	gameImport.declManager				= ::declManager;
 	gameImport.AASFileManager			= ::AASFileManager;
 	gameImport.collisionModelManager	= ::collisionModelManager;
+	gameImport.parallelJobManager		= ::parallelJobManager;
 
 	gameExport							= *GetGameAPI( &gameImport );
 
@@ -2769,6 +2990,7 @@ void idCommonLocal::Init( int argc, const char **argv, const char *cmdline ) {
 		idLib::common		= common;
 		idLib::cvarSystem	= cvarSystem;
 		idLib::fileSystem	= fileSystem;
+		idLib::parallelJobManager = parallelJobManager;
 
 		// initialize idLib
 		idLib::Init();
@@ -2822,6 +3044,9 @@ void idCommonLocal::Init( int argc, const char **argv, const char *cmdline ) {
 		// initialize processor specific SIMD implementation
 		InitSIMD();
 
+		// start the parallel job threads
+		parallelJobManager->Init();
+
 		// init commands
 		InitCommands();
 
@@ -2880,6 +3105,9 @@ void idCommonLocal::Shutdown( void ) {
 	// game specific shut down
 	ShutdownGame( false );
 
+	// stop the parallel job threads
+	parallelJobManager->Shutdown();
+
 	// shut down non-portable system services
 	Sys_Shutdown();
 
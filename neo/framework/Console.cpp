@@ -224,6 +224,8 @@ SCR_DrawMemoryUsage
 */
 float SCR_DrawMemoryUsage( float y ) {
 	memoryStats_t allocs, frees;
+	memThreadCacheStats_t cacheStats[MAX_THREADS+1];
+	int i, numCaches;
 	
 	Mem_GetStats( allocs );
 	SCR_DrawTextRightAlign( y, "total allocated memory: %4d, %4dkB", allocs.num, allocs.totalSize>>10 );
@@ -231,6 +233,13 @@ float SCR_DrawMemoryUsage( float y ) {
 	Mem_GetFrameStats( allocs, frees );
 	SCR_DrawTextRightAlign( y, "frame alloc: %4d, %4dkB  frame free: %4d, %4dkB", allocs.num, allocs.totalSize>>10, frees.num, frees.totalSize>>10 );
 
+	numCaches = Mem_GetThreadCacheStats( cacheStats, MAX_THREADS+1 );
+	for ( i = 0; i < numCaches; i++ ) {
+		int total = cacheStats[i].hits + cacheStats[i].misses;
+		SCR_DrawTextRightAlign( y, "thread cache %d: %3d%% hits, %4dkB cached", cacheStats[i].threadNum,
+								total ? (int)( cacheStats[i].hits * 100.0f / total ) : 0, cacheStats[i].cachedBytes>>10 );
+	}
+
 	Mem_ClearFrameStats();
 
 	return y;
@@ -64,6 +64,10 @@ missing reload over a previously explicit definition
 #define USE_COMPRESSED_DECLS
 //#define GET_HUFFMAN_FREQUENCIES
 
+#define DECL_CACHE_DIR			"declcache"
+#define DECL_CACHE_ID			( ( 'C' << 24 ) | ( 'L' << 16 ) | ( 'C' << 8 ) | 'D' )
+#define DECL_CACHE_VERSION		2
+
 class idDeclType {
 public:
 	idStr						typeName;
@@ -76,6 +80,8 @@ public:
 	idStr						folder;
 	idStr						extension;
 	declType_t					defaultType;
+	const void *				cacheData;				// mapped decl cache the decl text of this folder may point into
+	int							cacheLength;
 };
 
 class idDeclFile;
@@ -118,9 +124,9 @@ protected:
 protected:
 	void						AllocateSelf( void );
 
-								// Parses the decl definition.
+								// Parses the decl definition, optionally from text that was already decompressed.
 								// After calling parse, a decl will be guaranteed usable.
-	void						ParseLocal( void );
+	void						ParseLocal( const char *declText = NULL );
 
 								// Does a MakeDefualt, but flags the decl so that it
 								// will Parse() the next time the decl is found.
@@ -128,6 +134,12 @@ protected:
 
 								// Set textSource possible with compression.
 	void						SetTextLocal( const char *text, const int length );
+								// Takes ownership of text compressed with CompressText, mapped text is never freed.
+	void						SetCompressedTextLocal( char *source, const int compressedLength, const int length, const int checksum, const bool mapped = false );
+								// Frees textSource unless it points into a mapped decl cache.
+	void						FreeText( void );
+								// Returns the text compressed into a Mem_Alloc buffer, can be called from any thread.
+	static char *				CompressText( const char *text, const int length, int *compressedLength );
 
 private:
 	idDecl *					self;
@@ -136,6 +148,7 @@ private:
 	char *						textSource;				// decl text definition
 	int							textLength;				// length of textSource
 	int							compressedLength;		// compressed length
+	bool						textMapped;				// textSource points into a mapped decl cache
 	idDeclFile *				sourceFile;				// source file in which the decl was defined
 	int							sourceTextOffset;		// offset in source file to decl text
 	int							sourceTextLength;		// length of decl text in source file
@@ -153,14 +166,34 @@ private:
 	idDeclLocal *				nextInFile;				// next decl in the decl file
 };
 
+typedef struct {
+	declType_t					type;
+	idStr						name;
+	int							textOffset;				// offset in source file to decl text
+	int							textLength;				// length of decl text in source file
+	int							sourceLine;
+	int							checksum;				// checksum of the decl text
+	char *						textSource;				// compressed decl text
+	int							compressedLength;
+} declScan_t;
+
 class idDeclFile {
 public:
 								idDeclFile();
 								idDeclFile( const char *fileName, declType_t defaultType );
+								~idDeclFile();
 
 	void						Reload( bool force );
 	int							LoadAndParse();
 
+								// Finds the decls in the file text without touching the decl manager, so
+								// any number of files can be scanned at the same time. A quiet scan returns
+								// false if anything would have been printed and has to be done again.
+	bool						Scan( const char *buffer, int length, bool quiet );
+								// Adds the decls found by Scan or read from a decl cache to the decl manager.
+	void						AddScannedDecls( const char *buffer, bool textMapped = false );
+	void						FreeScan( void );
+
 public:
 	idStr						fileName;
 	declType_t					defaultType;
@@ -171,6 +204,7 @@ public:
 	int							numLines;
 
 	idDeclLocal *				decls;
+	idList<declScan_t>			scanned;				// decls found by the last scan
 };
 
 class idDeclManagerLocal : public idDeclManager {
@@ -221,6 +255,14 @@ public:
 	idDeclType *				GetDeclType( int type ) const { return declTypes[type]; }
 	const idDeclFile *			GetImplicitDeclFile( void ) const { return &implicitDecls; }
 
+private:
+	void						LoadDeclFiles( idDeclFolder *declFolder, const idList<idDeclFile *> &files );
+	void						GetDeclCacheName( const idDeclFolder *declFolder, idStr &cacheName ) const;
+	bool						LoadDeclCache( idDeclFolder *declFolder, const idList<idDeclFile *> &files );
+	void						WriteDeclCacheTypes( idFile *f ) const;
+	bool						ReadDeclCacheTypes( idFile *f ) const;
+	void						ParseReferencedDecls( void );
+
 private:
 	idList<idDeclType *>		declTypes;
 	idList<idDeclFolder *>		declFolders;
@@ -236,6 +278,8 @@ private:
 	bool						insideLevelLoad;
 
 	static idCVar				decl_show;
+	static idCVar				decl_parseAtLevelLoad;
+	static idCVar				decl_cache;
 
 private:
 	static void					ListDecls_f( const idCmdArgs &args );
@@ -244,6 +288,8 @@ private:
 };
 
 idCVar idDeclManagerLocal::decl_show( "decl_show", "0", CVAR_SYSTEM, "set to 1 to print parses, 2 to also print references", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar idDeclManagerLocal::decl_parseAtLevelLoad( "decl_parseAtLevelLoad", "0", CVAR_SYSTEM | CVAR_BOOL, "parse decls used in earlier levels at the end of a level load instead of when they are first used" );
+idCVar idDeclManagerLocal::decl_cache( "decl_cache", "1", CVAR_SYSTEM | CVAR_BOOL, "keep the scanned decl files of each decl folder in a binary cache under the save path" );
 
 idDeclManagerLocal	declManagerLocal;
 idDeclManager *		declManager = &declManagerLocal;
@@ -487,6 +533,8 @@ int HuffmanCompressText( const char *text, int textLength, byte *compressed, int
 /*
 ================
 HuffmanDecompressText
+
+  Returns -1 if the compressed data ends before textLength characters are decompressed.
 ================
 */
 int HuffmanDecompressText( char *text, int textLength, const byte *compressed, int compressedSize ) {
@@ -501,6 +549,10 @@ int HuffmanDecompressText( char *text, int textLength, const byte *compressed, i
 		node = huffmanTree;
 		do {
 			bit = msg.ReadBits( 1 );
+			if ( bit < 0 ) {
+				text[i] = '\0';
+				return -1;
+			}
 			node = node->children[bit];
 		} while( node->symbol == -1 );
 		text[i] = node->symbol;
@@ -568,6 +620,15 @@ idDeclFile::idDeclFile() {
 	this->decls = NULL;
 }
 
+/*
+================
+idDeclFile::~idDeclFile
+================
+*/
+idDeclFile::~idDeclFile() {
+	FreeScan();
+}
+
 /*
 ================
 idDeclFile::Reload
@@ -600,16 +661,8 @@ This is used during both the initial load, and any reloads
 int c_savedMemory = 0;
 
 int idDeclFile::LoadAndParse() {
-	int			i, numTypes;
-	idLexer		src;
-	idToken		token;
-	int			startMarker;
 	char *		buffer;
-	int			length, size;
-	int			sourceLine;
-	idStr		name;
-	idDeclLocal *newDecl;
-	bool		reparse;
+	int			length;
 
 	// load the text
 	common->DPrintf( "...loading '%s'\n", fileName.c_str() );
@@ -619,18 +672,45 @@ int idDeclFile::LoadAndParse() {
 		return 0;
 	}
 
-	if ( !src.LoadMemory( buffer, length, fileName ) ) {
-		common->Error( "Couldn't parse %s", fileName.c_str() );
+	if ( !Scan( buffer, length, false ) ) {
 		Mem_Free( buffer );
 		return 0;
 	}
 
-	// mark all the defs that were from the last reload of this file
-	for ( idDeclLocal *decl = decls; decl; decl = decl->nextInFile ) {
-		decl->redefinedInReload = false;
+	AddScannedDecls( buffer );
+
+	Mem_Free( buffer );
+
+	return checksum;
+}
+
+/*
+================
+idDeclFile::Scan
+================
+*/
+bool idDeclFile::Scan( const char *buffer, int length, bool quiet ) {
+	int			i, numTypes;
+	idLexer		src;
+	idTokenView	token;
+	int			startMarker;
+	int			sourceLine;
+	declType_t	identifiedType;
+
+	FreeScan();
+
+	if ( !src.LoadMemory( buffer, length, fileName ) ) {
+		if ( !quiet ) {
+			common->Error( "Couldn't parse %s", fileName.c_str() );
+		}
+		return false;
 	}
 
-	src.SetFlags( DECL_LEXER_FLAGS );
+	if ( quiet ) {
+		src.SetFlags( DECL_LEXER_FLAGS | LEXFL_NOERRORS | LEXFL_NOWARNINGS );
+	} else {
+		src.SetFlags( DECL_LEXER_FLAGS );
+	}
 
 	checksum = MD5_BlockChecksum( buffer, length );
 
@@ -647,13 +727,13 @@ int idDeclFile::LoadAndParse() {
 			break;
 		}
 
-		declType_t identifiedType = DECL_MAX_TYPES;
+		identifiedType = DECL_MAX_TYPES;
 
 		// get the decl type from the type name
 		numTypes = declManagerLocal.GetNumDeclTypes();
 		for ( i = 0; i < numTypes; i++ ) {
 			idDeclType *typeInfo = declManagerLocal.GetDeclType( i );
-			if ( typeInfo && typeInfo->typeName.Icmp( token ) == 0 ) {
+			if ( typeInfo && token.Icmp( typeInfo->typeName ) == 0 ) {
 				identifiedType = (declType_t) typeInfo->type;
 				break;
 			}
@@ -699,31 +779,69 @@ int idDeclFile::LoadAndParse() {
 			continue;
 		}
 
-		name = token;
+		declScan_t &scan = scanned.Alloc();
+		scan.type = identifiedType;
+		scan.name = token;
+		scan.sourceLine = sourceLine;
+		scan.textSource = NULL;
 
 		// make sure there's a '{'
 		if ( !src.ReadToken( &token ) ) {
 			src.Warning( "Type without definition at end of file" );
+			scanned.RemoveIndex( scanned.Num() - 1 );
 			break;
 		}
 		if ( token != "{" ) {
-			src.Warning( "Expecting '{' but found '%s'", token.c_str() );
+			src.Warning( "Expecting '{' but found '%s'", idStr( token ).c_str() );
+			scanned.RemoveIndex( scanned.Num() - 1 );
 			continue;
 		}
 		src.UnreadToken( &token );
 
 		// now take everything until a matched closing brace
 		src.SkipBracedSection();
-		size = src.GetFileOffset() - startMarker;
+
+		scan.textOffset = startMarker;
+		scan.textLength = src.GetFileOffset() - startMarker;
+		scan.checksum = MD5_BlockChecksum( buffer + startMarker, scan.textLength );
+		scan.textSource = idDeclLocal::CompressText( buffer + startMarker, scan.textLength, &scan.compressedLength );
+	}
+
+	numLines = src.GetLineNum();
+
+	if ( quiet && ( src.HadWarning() || src.HadError() ) ) {
+		FreeScan();
+		return false;
+	}
+	return true;
+}
+
+/*
+================
+idDeclFile::AddScannedDecls
+================
+*/
+void idDeclFile::AddScannedDecls( const char *buffer, bool textMapped ) {
+	int			i;
+	idDeclLocal *newDecl;
+	bool		reparse;
+
+	// mark all the defs that were from the last reload of this file
+	for ( idDeclLocal *decl = decls; decl; decl = decl->nextInFile ) {
+		decl->redefinedInReload = false;
+	}
+
+	for ( i = 0; i < scanned.Num(); i++ ) {
+		declScan_t &scan = scanned[i];
 
 		// look it up, possibly getting a newly created default decl
 		reparse = false;
-		newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, false );
+		newDecl = declManagerLocal.FindTypeWithoutParsing( scan.type, scan.name, false );
 		if ( newDecl ) {
 			// update the existing copy
 			if ( newDecl->sourceFile != this || newDecl->redefinedInReload ) {
-				src.Warning( "%s '%s' previously defined at %s:%i", declManagerLocal.GetDeclNameFromType( identifiedType ),
-								name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
+				common->Warning( "file %s, line %d: %s '%s' previously defined at %s:%i", fileName.c_str(), scan.sourceLine,
+								declManagerLocal.GetDeclNameFromType( scan.type ), scan.name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
 				continue;
 			}
 			if ( newDecl->declState != DS_UNPARSED ) {
@@ -731,23 +849,25 @@ int idDeclFile::LoadAndParse() {
 			}
 		} else {
 			// allow it to be created as a default, then add it to the per-file list
-			newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, true );
+			newDecl = declManagerLocal.FindTypeWithoutParsing( scan.type, scan.name, true );
 			newDecl->nextInFile = this->decls;
 			this->decls = newDecl;
 		}
 
 		newDecl->redefinedInReload = true;
 
-		if ( newDecl->textSource ) {
-			Mem_Free( newDecl->textSource );
-			newDecl->textSource = NULL;
+#ifdef GET_HUFFMAN_FREQUENCIES
+		for ( int j = 0; buffer != NULL && j < scan.textLength; j++ ) {
+			huffmanFrequencies[((const unsigned char *)buffer)[scan.textOffset + j]]++;
 		}
+#endif
 
-		newDecl->SetTextLocal( buffer + startMarker, size );
+		newDecl->SetCompressedTextLocal( scan.textSource, scan.compressedLength, scan.textLength, scan.checksum, textMapped );
+		scan.textSource = NULL;
 		newDecl->sourceFile = this;
-		newDecl->sourceTextOffset = startMarker;
-		newDecl->sourceTextLength = size;
-		newDecl->sourceLine = sourceLine;
+		newDecl->sourceTextOffset = scan.textOffset;
+		newDecl->sourceTextLength = scan.textLength;
+		newDecl->sourceLine = scan.sourceLine;
 		newDecl->declState = DS_UNPARSED;
 
 		// if it is currently in use, reparse it immedaitely
@@ -756,9 +876,11 @@ int idDeclFile::LoadAndParse() {
 		}
 	}
 
-	numLines = src.GetLineNum();
-
-	Mem_Free( buffer );
+	if ( textMapped ) {
+		scanned.Clear();
+	} else {
+		FreeScan();
+	}
 
 	// any defs that weren't redefinedInReload should now be defaulted
 	for ( idDeclLocal *decl = decls ; decl ; decl = decl->nextInFile ) {
@@ -769,8 +891,18 @@ int idDeclFile::LoadAndParse() {
 			decl->sourceLine = decl->sourceFile->numLines;
 		}
 	}
+}
 
-	return checksum;
+/*
+================
+idDeclFile::FreeScan
+================
+*/
+void idDeclFile::FreeScan( void ) {
+	for ( int i = 0; i < scanned.Num(); i++ ) {
+		Mem_Free( scanned[i].textSource );
+	}
+	scanned.Clear();
 }
 
 /*
@@ -880,10 +1012,7 @@ void idDeclManagerLocal::Shutdown( void ) {
 				decl->self->FreeData();
 				delete decl->self;
 			}
-			if ( decl->textSource ) {
-				Mem_Free( decl->textSource );
-				decl->textSource = NULL;
-			}
+			decl->FreeText();
 			delete decl;
 		}
 		linearLists[i].Clear();
@@ -893,6 +1022,14 @@ void idDeclManagerLocal::Shutdown( void ) {
 	// free decl files
 	loadedFiles.DeleteContents( true );
 
+	// free the decl caches now that no decl text points into them
+	for ( i = 0; i < declFolders.Num(); i++ ) {
+		if ( declFolders[i]->cacheData != NULL ) {
+			fileSystem->FreeFileMapped( declFolders[i]->cacheData );
+			declFolders[i]->cacheData = NULL;
+		}
+	}
+
 	// free the decl types and folders
 	declTypes.DeleteContents( true );
 	declFolders.DeleteContents( true );
@@ -938,12 +1075,81 @@ idDeclManagerLocal::EndLevelLoad
 ===================
 */
 void idDeclManagerLocal::EndLevelLoad() {
+	if ( decl_parseAtLevelLoad.GetBool() ) {
+		ParseReferencedDecls();
+	}
+
 	insideLevelLoad = false;
 
 	// we don't need to do anything here, but the image manager, model manager,
 	// and sound sample manager will need to free media that was not referenced
 }
 
+/*
+===================
+DeclTextJob
+===================
+*/
+typedef struct {
+	idDeclLocal **		decls;
+	char **				texts;
+} declTextJob_t;
+
+static void DeclTextJob( void *data, int index ) {
+	declTextJob_t *job = (declTextJob_t *)data;
+	idDeclLocal *decl = job->decls[index];
+
+	job->texts[index] = (char *) Mem_Alloc( decl->GetTextLength() + 1 );
+	decl->GetText( job->texts[index] );
+}
+
+/*
+===================
+idDeclManagerLocal::ParseReferencedDecls
+
+Parses the decls that were used before but not yet during this level, so the
+game does not stall on them when it first asks for them. Parsing touches
+other decls and the media managers so only the text is decompressed in
+parallel. The decls are not marked as referenced this level, and this runs
+before the media managers end the level load so the media they use is not
+kept past the next level load.
+===================
+*/
+void idDeclManagerLocal::ParseReferencedDecls( void ) {
+	int i, j;
+	idList<idDeclLocal *> decls;
+	declTextJob_t job;
+
+	for ( i = 0; i < DECL_MAX_TYPES; i++ ) {
+		for ( j = 0; j < linearLists[i].Num(); j++ ) {
+			idDeclLocal *decl = linearLists[i][j];
+			if ( decl->declState == DS_UNPARSED && decl->everReferenced && decl->textSource != NULL ) {
+				decls.Append( decl );
+			}
+		}
+	}
+	if ( decls.Num() == 0 ) {
+		return;
+	}
+
+	job.decls = decls.Ptr();
+	job.texts = (char **) _alloca16( decls.Num() * sizeof( char * ) );
+	idLib::ParallelFor( DeclTextJob, &job, decls.Num() );
+
+	for ( i = 0; i < decls.Num(); i++ ) {
+		idDeclLocal *decl = decls[i];
+		// parsing an earlier decl may have pulled this one in already
+		if ( decl->declState == DS_UNPARSED ) {
+			decl->AllocateSelf();
+			decl->ParseLocal( job.texts[i] );
+			decl->parsedOutsideLevelLoad = false;
+		}
+		Mem_Free( job.texts[i] );
+	}
+
+	common->DPrintf( "%d decls parsed at level load\n", decls.Num() );
+}
+
 /*
 ===================
 idDeclManagerLocal::RegisterDeclType
@@ -979,6 +1185,7 @@ void idDeclManagerLocal::RegisterDeclFolder( const char *folder, const char *ext
 	idDeclFolder *declFolder;
 	idFileList *fileList;
 	idDeclFile *df;
+	idList<idDeclFile *> files;
 
 	// check whether this folder / extension combination already exists
 	for ( i = 0; i < declFolders.Num(); i++ ) {
@@ -993,6 +1200,8 @@ void idDeclManagerLocal::RegisterDeclFolder( const char *folder, const char *ext
 		declFolder->folder = folder;
 		declFolder->extension = extension;
 		declFolder->defaultType = defaultType;
+		declFolder->cacheData = NULL;
+		declFolder->cacheLength = 0;
 		declFolders.Append( declFolder );
 	}
 
@@ -1015,10 +1224,381 @@ void idDeclManagerLocal::RegisterDeclFolder( const char *folder, const char *ext
 			df = new idDeclFile( fileName, defaultType );
 			loadedFiles.Append( df );
 		}
-		df->LoadAndParse();
+		files.Append( df );
 	}
 
 	fileSystem->FreeFileList( fileList );
+
+	if ( !LoadDeclCache( declFolder, files ) ) {
+		LoadDeclFiles( declFolder, files );
+	}
+}
+
+/*
+===================
+DeclFileScanJob
+===================
+*/
+typedef struct {
+	idDeclFile *		file;
+	char *				buffer;
+	int					length;
+	bool				scanned;
+} declFileLoad_t;
+
+static void DeclFileScanJob( void *data, int index ) {
+	declFileLoad_t *load = ( (declFileLoad_t *)data ) + index;
+
+	load->scanned = load->file->Scan( load->buffer, load->length, true );
+}
+
+/*
+===================
+GetDeclFileStamp
+
+Files in paks have no timestamp, they are identified by the checksum of the
+pak which changes with the contents of any file in it.
+===================
+*/
+static bool GetDeclFileStamp( const char *fileName, int &length, int &timestamp, int &pakChecksum ) {
+	idFile *f;
+	idFile_InZip *inZip;
+
+	f = fileSystem->OpenFileRead( fileName );
+	if ( !f ) {
+		return false;
+	}
+	length = f->Length();
+	timestamp = (int)f->Timestamp();
+	inZip = dynamic_cast<idFile_InZip *>( f );
+	pakChecksum = inZip ? inZip->GetPakChecksum() : 0;
+	fileSystem->CloseFile( f );
+	return true;
+}
+
+/*
+===================
+idDeclManagerLocal::LoadDeclFiles
+
+Reads the files on the file system I/O threads and scans them in parallel.
+Decls are added to the manager in file order so a decl defined in more than
+one file is taken from the same file as with a sequential load. Files that
+would print warnings are scanned again on this thread to get the messages.
+The scans are written to the decl cache of the folder on the way.
+===================
+*/
+void idDeclManagerLocal::LoadDeclFiles( idDeclFolder *declFolder, const idList<idDeclFile *> &files ) {
+	int i, j, dataLength, fileLength, timestamp, pakChecksum;
+	declFileLoad_t *loads;
+	idList<asyncReadHandle_t> handles;
+	idFile_Memory table, blocks;
+	idStr cacheName;
+	idFile *f;
+	bool writeCache;
+
+	if ( files.Num() == 0 ) {
+		return;
+	}
+
+	handles.SetNum( files.Num() );
+	for ( i = 0; i < files.Num(); i++ ) {
+		handles[i] = fileSystem->ReadFileAsync( files[i]->fileName, ASYNC_READ_HIGH );
+	}
+
+	loads = (declFileLoad_t *) _alloca16( files.Num() * sizeof( loads[0] ) );
+	for ( i = 0; i < files.Num(); i++ ) {
+		common->DPrintf( "...loading '%s'\n", files[i]->fileName.c_str() );
+		loads[i].file = files[i];
+		loads[i].length = fileSystem->WaitAsyncRead( handles[i], (void **)&loads[i].buffer, &files[i]->timestamp );
+		loads[i].scanned = false;
+		if ( loads[i].length == -1 ) {
+			common->FatalError( "couldn't load %s", files[i]->fileName.c_str() );
+		}
+	}
+
+	idLib::ParallelFor( DeclFileScanJob, loads, files.Num() );
+
+	// decls may still point into a cache mapped when the folder was registered before
+	writeCache = decl_cache.GetBool() && declFolder->cacheData == NULL;
+
+	for ( i = 0; i < files.Num(); i++ ) {
+		idDeclFile *df = loads[i].file;
+		if ( loads[i].scanned || df->Scan( loads[i].buffer, loads[i].length, false ) ) {
+			if ( writeCache && ( !GetDeclFileStamp( df->fileName, fileLength, timestamp, pakChecksum ) || fileLength != loads[i].length ) ) {
+				writeCache = false;
+			}
+			if ( writeCache ) {
+				table.WriteString( df->fileName );
+				table.WriteInt( fileLength );
+				table.WriteInt( timestamp );
+				table.WriteInt( pakChecksum );
+				table.WriteInt( df->checksum );
+				table.WriteInt( df->numLines );
+				blocks.WriteInt( df->scanned.Num() );
+				for ( j = 0; j < df->scanned.Num(); j++ ) {
+					const declScan_t &scan = df->scanned[j];
+#ifdef USE_COMPRESSED_DECLS
+					dataLength = scan.compressedLength;
+#else
+					dataLength = scan.textLength + 1;
+#endif
+					blocks.WriteInt( scan.type );
+					blocks.WriteString( scan.name );
+					blocks.WriteInt( scan.textOffset );
+					blocks.WriteInt( scan.textLength );
+					blocks.WriteInt( scan.sourceLine );
+					blocks.WriteInt( scan.checksum );
+					blocks.WriteInt( scan.compressedLength );
+					blocks.WriteInt( dataLength );
+					blocks.Write( scan.textSource, dataLength );
+				}
+			}
+			df->AddScannedDecls( loads[i].buffer );
+		} else {
+			writeCache = false;
+		}
+		fileSystem->FreeFile( loads[i].buffer );
+	}
+
+	if ( !writeCache ) {
+		return;
+	}
+
+	GetDeclCacheName( declFolder, cacheName );
+	f = fileSystem->OpenFileWrite( cacheName );
+	if ( !f ) {
+		return;
+	}
+	f->WriteInt( DECL_CACHE_ID );
+	f->WriteInt( DECL_CACHE_VERSION );
+	WriteDeclCacheTypes( f );
+	f->WriteInt( files.Num() );
+	f->Write( table.GetDataPtr(), table.Length() );
+	f->Write( blocks.GetDataPtr(), blocks.Length() );
+	fileSystem->CloseFile( f );
+}
+
+/*
+===================
+idDeclManagerLocal::GetDeclCacheName
+===================
+*/
+void idDeclManagerLocal::GetDeclCacheName( const idDeclFolder *declFolder, idStr &cacheName ) const {
+	idStr folder = declFolder->folder;
+	idStr extension = declFolder->extension;
+
+	folder.Replace( "/", "_" );
+	extension.Strip( '.' );
+	sprintf( cacheName, "%s/%s_%s.dat", DECL_CACHE_DIR, folder.c_str(), extension.c_str() );
+}
+
+/*
+===================
+idDeclManagerLocal::WriteDeclCacheTypes
+
+The decl types decide how files are split into decls, so a cache is only valid for the same set of types.
+===================
+*/
+void idDeclManagerLocal::WriteDeclCacheTypes( idFile *f ) const {
+	int i;
+
+	f->WriteInt( declTypes.Num() );
+	for ( i = 0; i < declTypes.Num(); i++ ) {
+		f->WriteString( declTypes[i] ? declTypes[i]->typeName.c_str() : "" );
+	}
+}
+
+/*
+===================
+idDeclManagerLocal::ReadDeclCacheTypes
+===================
+*/
+bool idDeclManagerLocal::ReadDeclCacheTypes( idFile *f ) const {
+	int i, numTypes;
+	idStr typeName;
+
+	numTypes = 0;
+	f->ReadInt( numTypes );
+	if ( numTypes != declTypes.Num() ) {
+		return false;
+	}
+	for ( i = 0; i < numTypes; i++ ) {
+		f->ReadString( typeName );
+		if ( typeName.Cmp( declTypes[i] ? declTypes[i]->typeName.c_str() : "" ) != 0 ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+===================
+DeclCache_ReadString
+
+Reads a string from the decl cache, fails if the length is bad or runs past the end of the cache.
+===================
+*/
+static bool DeclCache_ReadString( idFile_Memory &src, idStr &string ) {
+	int len;
+
+	len = -1;
+	if ( src.ReadInt( len ) != sizeof( len ) || len < 0 || len > MAX_STRING_CHARS || len > src.Length() - src.Tell() ) {
+		return false;
+	}
+	string.Fill( ' ', len );
+	src.Read( &string[0], len );
+	return true;
+}
+
+/*
+===================
+idDeclManagerLocal::LoadDeclCache
+
+Adds the decls of a folder from its decl cache instead of reading and scanning
+the files. The cache stays mapped and the decl text is paged in from it when a
+decl is parsed. Returns false if the cache is missing or any of the files was
+added, removed or changed since the cache was written. Loose files are checked
+by length and timestamp, files in paks by length and the pak checksum. The
+whole cache is thrown away on the first damaged record.
+===================
+*/
+bool idDeclManagerLocal::LoadDeclCache( idDeclFolder *declFolder, const idList<idDeclFile *> &files ) {
+	idStr			cacheName, fileName;
+	const void *	data;
+	int				length, id, version, numFiles, fileLength, timestamp, pakChecksum, numDecls, type, dataLength, i, j;
+	int				curLength, curTimestamp, curPakChecksum;
+	bool			mappedHere, valid;
+
+	if ( !decl_cache.GetBool() || files.Num() == 0 ) {
+		return false;
+	}
+
+	mappedHere = false;
+	if ( declFolder->cacheData == NULL ) {
+		GetDeclCacheName( declFolder, cacheName );
+		length = fileSystem->ReadFileMapped( cacheName, &data );
+		if ( length == -1 ) {
+			return false;
+		}
+		declFolder->cacheData = data;
+		declFolder->cacheLength = length;
+		mappedHere = true;
+	}
+
+	idFile_Memory src( cacheName, (const char *)declFolder->cacheData, declFolder->cacheLength );
+
+	id = version = numFiles = 0;
+	src.ReadInt( id );
+	src.ReadInt( version );
+	valid = ( id == DECL_CACHE_ID && version == DECL_CACHE_VERSION && ReadDeclCacheTypes( &src ) );
+	if ( valid ) {
+		src.ReadInt( numFiles );
+		valid = ( numFiles == files.Num() );
+	}
+
+	// check the files against the file system
+	for ( i = 0; valid && i < numFiles; i++ ) {
+		idDeclFile *df = files[i];
+		if ( !DeclCache_ReadString( src, fileName ) || src.Length() - src.Tell() < 5 * (int)sizeof( int ) ) {
+			valid = false;
+			break;
+		}
+		src.ReadInt( fileLength );
+		src.ReadInt( timestamp );
+		src.ReadInt( pakChecksum );
+		src.ReadInt( df->checksum );
+		src.ReadInt( df->numLines );
+		if ( fileName.Icmp( df->fileName ) != 0 ) {
+			valid = false;
+			break;
+		}
+		if ( !GetDeclFileStamp( df->fileName, curLength, curTimestamp, curPakChecksum ) ||
+				curLength != fileLength || curTimestamp != timestamp || curPakChecksum != pakChecksum ) {
+			valid = false;
+			break;
+		}
+		df->timestamp = timestamp;
+		df->fileSize = fileLength;
+	}
+
+	// read the decl records, the text stays in the mapped cache
+	for ( i = 0; valid && i < numFiles; i++ ) {
+		idDeclFile *df = files[i];
+		numDecls = -1;
+		src.ReadInt( numDecls );
+		// every record takes at least eight ints
+		if ( numDecls < 0 || numDecls > ( src.Length() - src.Tell() ) / ( 8 * (int)sizeof( int ) ) ) {
+			valid = false;
+			break;
+		}
+		df->FreeScan();
+		df->scanned.SetNum( numDecls );
+		for ( j = 0; j < numDecls; j++ ) {
+			declScan_t &scan = df->scanned[j];
+			type = -1;
+			src.ReadInt( type );
+			if ( type < 0 || type >= declTypes.Num() || type >= DECL_MAX_TYPES || declTypes[type] == NULL ) {
+				valid = false;
+				break;
+			}
+			scan.type = (declType_t)type;
+			if ( !DeclCache_ReadString( src, scan.name ) || scan.name.Length() == 0 || src.Length() - src.Tell() < 6 * (int)sizeof( int ) ) {
+				valid = false;
+				break;
+			}
+			src.ReadInt( scan.textOffset );
+			src.ReadInt( scan.textLength );
+			src.ReadInt( scan.sourceLine );
+			src.ReadInt( scan.checksum );
+			src.ReadInt( scan.compressedLength );
+			src.ReadInt( dataLength );
+			if ( scan.textOffset < 0 || scan.textLength < 0 || scan.textLength > df->fileSize - scan.textOffset ) {
+				valid = false;
+				break;
+			}
+#ifdef USE_COMPRESSED_DECLS
+			// every character takes at least one bit
+			if ( dataLength != scan.compressedLength || dataLength <= 0 || scan.textLength > dataLength * 8 ) {
+#else
+			if ( dataLength != scan.textLength + 1 ) {
+#endif
+				valid = false;
+				break;
+			}
+			if ( dataLength > src.Length() - src.Tell() ) {
+				valid = false;
+				break;
+			}
+#ifndef USE_COMPRESSED_DECLS
+			if ( ( (const char *)declFolder->cacheData )[src.Tell() + scan.textLength] != '\0' ) {
+				valid = false;
+				break;
+			}
+#endif
+			scan.textSource = (char *)declFolder->cacheData + src.Tell();
+			src.Seek( dataLength, FS_SEEK_CUR );
+		}
+	}
+
+	if ( !valid ) {
+		for ( i = 0; i < files.Num(); i++ ) {
+			files[i]->scanned.Clear();
+		}
+		if ( mappedHere ) {
+			common->DPrintf( "decl cache %s is out of date\n", cacheName.c_str() );
+			fileSystem->FreeFileMapped( declFolder->cacheData );
+			declFolder->cacheData = NULL;
+			declFolder->cacheLength = 0;
+		}
+		return false;
+	}
+
+	for ( i = 0; i < files.Num(); i++ ) {
+		common->DPrintf( "...loading '%s' from decl cache\n", files[i]->fileName.c_str() );
+		files[i]->AddScannedDecls( NULL, true );
+	}
+
+	return true;
 }
 
 /*
@@ -1755,6 +2335,7 @@ idDeclLocal::idDeclLocal( void ) {
 	textSource = NULL;
 	textLength = 0;
 	compressedLength = 0;
+	textMapped = false;
 	sourceFile = NULL;
 	sourceTextOffset = 0;
 	sourceTextLength = 0;
@@ -1908,10 +2489,8 @@ idDeclLocal::SetTextLocal
 =================
 */
 void idDeclLocal::SetTextLocal( const char *text, const int length ) {
-
-	Mem_Free( textSource );
-
-	checksum = MD5_BlockChecksum( text, length );
+	char *source;
+	int sourceLength;
 
 #ifdef GET_HUFFMAN_FREQUENCIES
 	for( int i = 0; i < length; i++ ) {
@@ -1919,19 +2498,59 @@ void idDeclLocal::SetTextLocal( const char *text, const int length ) {
 	}
 #endif
 
+	source = CompressText( text, length, &sourceLength );
+	SetCompressedTextLocal( source, sourceLength, length, MD5_BlockChecksum( text, length ) );
+}
+
+/*
+=================
+idDeclLocal::SetCompressedTextLocal
+=================
+*/
+void idDeclLocal::SetCompressedTextLocal( char *source, const int compressedLength, const int length, const int checksum, const bool mapped ) {
+	FreeText();
+
+	this->textSource = source;
+	this->textMapped = mapped;
+	this->compressedLength = compressedLength;
+	this->textLength = length;
+	this->checksum = checksum;
+}
+
+/*
+=================
+idDeclLocal::FreeText
+=================
+*/
+void idDeclLocal::FreeText( void ) {
+	if ( !textMapped ) {
+		Mem_Free( textSource );
+	}
+	textSource = NULL;
+	textMapped = false;
+}
+
+/*
+=================
+idDeclLocal::CompressText
+=================
+*/
+char *idDeclLocal::CompressText( const char *text, const int length, int *compressedLength ) {
+	char *source;
+
 #ifdef USE_COMPRESSED_DECLS
 	int maxBytesPerCode = ( maxHuffmanBits + 7 ) >> 3;
 	byte *compressed = (byte *)_alloca( length * maxBytesPerCode );
-	compressedLength = HuffmanCompressText( text, length, compressed, length * maxBytesPerCode );
-	textSource = (char *)Mem_Alloc( compressedLength );
-	memcpy( textSource, compressed, compressedLength );
+	*compressedLength = HuffmanCompressText( text, length, compressed, length * maxBytesPerCode );
+	source = (char *)Mem_Alloc( *compressedLength );
+	memcpy( source, compressed, *compressedLength );
 #else
-	compressedLength = length;
-	textSource = (char *) Mem_Alloc( length + 1 );
-	memcpy( textSource, text, length );
-	textSource[length] = '\0';
+	*compressedLength = length;
+	source = (char *) Mem_Alloc( length + 1 );
+	memcpy( source, text, length );
+	source[length] = '\0';
 #endif
-	textLength = length;
+	return source;
 }
 
 /*
@@ -2159,7 +2778,7 @@ void idDeclLocal::AllocateSelf( void ) {
 idDeclLocal::ParseLocal
 =================
 */
-void idDeclLocal::ParseLocal( void ) {
+void idDeclLocal::ParseLocal( const char *declText ) {
 	bool generatedDefaultText = false;
 
 	AllocateSelf();
@@ -2187,14 +2806,16 @@ void idDeclLocal::ParseLocal( void ) {
 	declState = DS_PARSED;
 
 	// parse
-	char *declText = (char *) _alloca( ( GetTextLength() + 1 ) * sizeof( char ) );
-	GetText( declText );
+	if ( declText == NULL ) {
+		char *text = (char *) _alloca( ( GetTextLength() + 1 ) * sizeof( char ) );
+		GetText( text );
+		declText = text;
+	}
 	self->Parse( declText, GetTextLength() );
 
 	// free generated text
 	if ( generatedDefaultText ) {
-		Mem_Free( textSource );
-		textSource = 0;
+		FreeText();
 		textLength = 0;
 	}
 
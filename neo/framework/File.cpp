@@ -30,6 +30,7 @@ If you have questions concerning this license or the applicable additional terms
 #pragma hdrstop
 
 #include "Unzip.h"
+#include "ZipCache.h"
 
 #define	MAX_PRINT_MSG		4096
 
@@ -877,6 +878,66 @@ void idFile_Memory::SetData( const char *data, int length ) {
 }
 
 
+/*
+=================================================================================
+
+idFile_Mapped
+
+=================================================================================
+*/
+
+/*
+=================
+idFile_Mapped::idFile_Mapped
+=================
+*/
+idFile_Mapped::idFile_Mapped( const char *name, const char *fullPath, ID_TIME_T timestamp, void *mapBase, int mapLength, const char *data, int length ) :
+	idFile_Memory( name, data, length ) {
+	this->fullPath = fullPath;
+	this->timestamp = timestamp;
+	this->mapBase = mapBase;
+	this->mapLength = mapLength;
+}
+
+/*
+=================
+idFile_Mapped::~idFile_Mapped
+=================
+*/
+idFile_Mapped::~idFile_Mapped( void ) {
+	Release();
+}
+
+/*
+=================
+idFile_Mapped::Clear
+=================
+*/
+void idFile_Mapped::Clear( bool freeMemory ) {
+	if ( freeMemory ) {
+		Release();
+		SetData( NULL, 0 );
+	} else {
+		Rewind();
+	}
+}
+
+/*
+=================
+idFile_Mapped::Release
+=================
+*/
+void idFile_Mapped::Release( void ) {
+	if ( mapBase ) {
+		Sys_UnmapFile( mapBase, mapLength );
+		mapBase = NULL;
+		mapLength = 0;
+	} else if ( GetDataPtr() ) {
+		Mem_Free( const_cast<char *>( GetDataPtr() ) );
+	}
+}
+
+
 /*
 =================================================================================
 
@@ -1237,9 +1298,14 @@ idFile_InZip::idFile_InZip
 */
 idFile_InZip::idFile_InZip( void ) {
 	name = "invalid";
+	pakChecksum = 0;
 	zipFilePos = 0;
 	fileSize = 0;
 	memset( &z, 0, sizeof( z ) );
+	cacheEntry = -1;
+	filePos = 0;
+	streamPos = 0;
+	closing = false;
 }
 
 /*
@@ -1248,6 +1314,11 @@ idFile_InZip::~idFile_InZip
 =================
 */
 idFile_InZip::~idFile_InZip( void ) {
+	// wait for a pending read ahead job, it gives up as soon as it sees the file closing
+	closing = true;
+	while ( readAhead.GetValue() > 0 ) {
+		idSysAtomic::YieldThread();
+	}
 	unzCloseCurrentFile( z );
 	unzClose( z );
 }
@@ -1260,9 +1331,146 @@ Properly handles partial reads
 =================
 */
 int idFile_InZip::Read( void *buffer, int len ) {
-	int l = unzReadCurrentFile( z, buffer, len );
-	fileSystem->AddToReadCount( l );
-	return l;
+	int l, total, block, offset;
+	bool direct;
+	byte *dest;
+
+	if ( cacheEntry == -1 ) {
+		l = unzReadCurrentFile( z, buffer, len );
+		fileSystem->AddToReadCount( l );
+		return l;
+	}
+
+	len = Min( len, fileSize - filePos );
+	dest = (byte *)buffer;
+	direct = false;
+
+	for ( total = 0; total < len; total += l ) {
+		block = filePos >> ZIP_BLOCK_SHIFT;
+		offset = filePos & ( ZIP_BLOCK_SIZE - 1 );
+		l = zipBlockCache.CopyBlock( cacheEntry, block, offset, dest + total, len - total );
+		if ( l == -1 ) {
+			streamLock.Lock();
+			// the block may have been inflated ahead while waiting for the stream
+			if ( zipBlockCache.HasBlock( cacheEntry, block ) ) {
+				l = zipBlockCache.CopyBlock( cacheEntry, block, offset, dest + total, len - total );
+			}
+			if ( l == -1 ) {
+				// whole blocks or the rest of the file read at the stream position skip the cache
+				if ( filePos == streamPos && ( len - total >= ZIP_BLOCK_SIZE || filePos + len - total == fileSize ) ) {
+					l = InflateDirect( dest + total, len - total );
+					direct = true;
+				} else {
+					l = InflateToBlock( block, offset, dest + total, len - total, false );
+				}
+			}
+			streamLock.Unlock();
+		}
+		if ( l <= 0 ) {
+			break;
+		}
+		filePos += l;
+	}
+
+	if ( filePos < fileSize && !direct ) {
+		zipBlockCache.ReadAhead( this );
+	}
+
+	fileSystem->AddToReadCount( total );
+	return total;
+}
+
+/*
+=================
+idFile_InZip::InflateToBlock
+
+  Inflates blocks up to and including the given one and adds them to the
+  zip block cache. Copies up to len bytes of the last block starting at
+  offset to dest and returns the number of bytes copied, or -1 on failure.
+  The caller must hold the stream lock.
+=================
+*/
+int idFile_InZip::InflateToBlock( int block, int offset, byte *dest, int len, bool ahead ) {
+	int start, length, copied;
+	byte *data;
+
+	start = block << ZIP_BLOCK_SHIFT;
+
+	// the stream can only move forward, reopen it to go back or to get back to a block boundary
+	if ( streamPos > start || ( streamPos & ( ZIP_BLOCK_SIZE - 1 ) ) != 0 ) {
+		unzSetCurrentFileInfoPosition( z, zipFilePos );
+		unzOpenCurrentFile( z );
+		streamPos = 0;
+	}
+
+	copied = -1;
+	while ( streamPos <= start && streamPos < fileSize ) {
+		length = Min( ZIP_BLOCK_SIZE, fileSize - streamPos );
+		data = (byte *)Mem_Alloc( length );
+		if ( unzReadCurrentFile( z, data, length ) != length ) {
+			Mem_Free( data );
+			streamPos = fileSize;
+			return -1;
+		}
+		if ( streamPos == start && dest != NULL ) {
+			copied = Min( len, length - offset );
+			memcpy( dest, data + offset, copied );
+		}
+		zipBlockCache.AddBlock( cacheEntry, streamPos >> ZIP_BLOCK_SHIFT, data, length, ahead );
+		streamPos += length;
+	}
+	return copied;
+}
+
+/*
+=================
+idFile_InZip::InflateDirect
+
+  Inflates len bytes at the stream position straight into dest without
+  going through the zip block cache. Returns the number of bytes inflated,
+  or -1 on failure. The caller must hold the stream lock.
+=================
+*/
+int idFile_InZip::InflateDirect( byte *dest, int len ) {
+	if ( unzReadCurrentFile( z, dest, len ) != len ) {
+		streamPos = fileSize;
+		return -1;
+	}
+	streamPos += len;
+	return len;
+}
+
+/*
+=================
+idFile_InZip::InflateAhead
+
+  Called from a zip block cache thread. Inflates blocks one at a time
+  and gives the stream back to the reader as soon as it wants it.
+=================
+*/
+void idFile_InZip::InflateAhead( void ) {
+	int end;
+
+	end = ( filePos & ~( ZIP_BLOCK_SIZE - 1 ) ) + ( ( zipBlockCache.GetReadAheadBlocks() + 1 ) << ZIP_BLOCK_SHIFT );
+	end = Min( end, fileSize );
+	if ( end <= 0 || zipBlockCache.HasBlock( cacheEntry, ( end - 1 ) >> ZIP_BLOCK_SHIFT ) ) {
+		return;
+	}
+
+	while ( !closing && streamPos < end ) {
+		if ( !streamLock.TryLock() ) {
+			break;
+		}
+		// leave a stream that was inflated directly to the reader
+		if ( ( streamPos & ( ZIP_BLOCK_SIZE - 1 ) ) != 0 ) {
+			streamLock.Unlock();
+			break;
+		}
+		if ( streamPos < end ) {
+			InflateToBlock( streamPos >> ZIP_BLOCK_SHIFT, 0, NULL, 0, true );
+		}
+		streamLock.Unlock();
+	}
 }
 
 /*
@@ -1299,6 +1507,9 @@ idFile_InZip::Tell
 =================
 */
 int idFile_InZip::Tell( void ) {
+	if ( cacheEntry != -1 ) {
+		return filePos;
+	}
 	return unztell( z );
 }
 
@@ -1333,6 +1544,32 @@ int idFile_InZip::Seek( long offset, fsOrigin_t origin ) {
 	int res, i;
 	char *buf;
 
+	// cached files only move the read position, the blocks are inflated on the next read
+	if ( cacheEntry != -1 ) {
+		switch( origin ) {
+			case FS_SEEK_END: {
+				offset = fileSize - offset;
+				break;
+			}
+			case FS_SEEK_SET: {
+				break;
+			}
+			case FS_SEEK_CUR: {
+				offset += filePos;
+				break;
+			}
+			default: {
+				common->FatalError( "idFile_InZip::Seek: bad origin for %s\n", name.c_str() );
+				break;
+			}
+		}
+		if ( offset < 0 || offset > fileSize ) {
+			return -1;
+		}
+		filePos = offset;
+		return 0;
+	}
+
 	switch( origin ) {
 		case FS_SEEK_END: {
 			offset = fileSize - offset;
@@ -157,6 +157,31 @@ private:
 };
 
 
+class idFile_Mapped : public idFile_Memory {
+	friend class			idFileSystemLocal;
+
+public:
+							// mapBase and mapLength come from Sys_MapFile, without a mapping the data is owned and freed with Mem_Free
+							idFile_Mapped( const char *name, const char *fullPath, ID_TIME_T timestamp, void *mapBase, int mapLength, const char *data, int length );
+	virtual					~idFile_Mapped( void );
+
+	virtual const char *	GetFullPath( void ) { return fullPath.c_str(); }
+	virtual ID_TIME_T		Timestamp( void ) { return timestamp; }
+	virtual void			Clear( bool freeMemory = true );
+
+							// returns true if the data is a view of the file mapped into memory
+	bool					IsMapped( void ) const { return mapBase != NULL; }
+
+private:
+	idStr					fullPath;		// full file path
+	ID_TIME_T				timestamp;		// timestamp of the file
+	void *					mapBase;		// start of the mapped pages
+	int						mapLength;		// length of the mapped pages
+
+	void					Release( void );
+};
+
+
 class idFile_BitMsg : public idFile {
 	friend class			idFileSystemLocal;
 
@@ -216,6 +241,7 @@ private:
 
 class idFile_InZip : public idFile {
 	friend class			idFileSystemLocal;
+	friend class			idZipBlockCache;
 
 public:
 							idFile_InZip( void );
@@ -232,12 +258,27 @@ public:
 	virtual void			Flush( void );
 	virtual int				Seek( long offset, fsOrigin_t origin );
 
+	int						GetPakChecksum( void ) const { return pakChecksum; }
+
 private:
 	idStr					name;			// name of the file in the pak
 	idStr					fullPath;		// full file path including pak file name
+	int						pakChecksum;	// checksum of the pak, changes with the contents of any file in it
 	int						zipFilePos;		// zip file info position in pak
 	int						fileSize;		// size of the file
 	void *					z;				// unzip info
+
+							// deflated files are read through the zip block cache
+	int						cacheEntry;		// zip block cache entry, -1 = read the stream directly
+	int						filePos;		// read position
+	int						streamPos;		// position of the inflate stream, at a block boundary unless it was inflated directly
+	idSysSpinLock			streamLock;		// held while the inflate stream is in use
+	idSysInterlockedInteger	readAhead;		// set while a read ahead job is pending
+	volatile bool			closing;
+
+	int						InflateToBlock( int block, int offset, byte *dest, int len, bool ahead );
+	int						InflateDirect( byte *dest, int len );
+	void					InflateAhead( void );
 };
 
 #endif /* !__FILE_H__ */
@@ -30,6 +30,7 @@ If you have questions concerning this license or the applicable additional terms
 #pragma hdrstop
 
 #include "Unzip.h"
+#include "ZipCache.h"
 
 #ifdef WIN32
 	#include <io.h>	// for _read
@@ -255,10 +256,18 @@ static idInitExclusions	initExclusions;
 #define MAX_ZIPPED_FILE_NAME	2048
 #define FILE_HASH_SIZE			1024
 
+// pak directories are cached in the save path so unchanged paks are not parsed at startup
+#define PAK_INDEX_CACHE			"pakindex.dat"
+#define PAK_INDEX_CACHE_ID		( ( 'X' << 24 ) | ( 'D' << 16 ) | ( 'I' << 8 ) | 'P' )
+#define PAK_INDEX_CACHE_VERSION	1
+
 typedef struct fileInPack_s {
 	idStr				name;						// name of the file
 	unsigned long		pos;						// file info position in zip
+	int					pathHash;					// hash of the full name for the pak index
+	struct pack_s *		pack;						// pak the file is in
 	struct fileInPack_s * next;						// next file in the hash
+	struct fileInPack_s * nextInSearch;				// same file in the next pak on the search path
 } fileInPack_t;
 
 typedef enum {
@@ -279,12 +288,13 @@ typedef struct {
 	idList<idDict *>	mapDecls;
 } addonInfo_t;
 
-typedef struct {
+typedef struct pack_s {
 	idStr				pakFilename;				// c:\doom\base\pak0.pk4
 	unzFile				handle;
 	int					checksum;
 	int					numfiles;
 	int					length;
+	ID_TIME_T			timestamp;
 	bool				referenced;
 	binaryStatus_t		binary;
 	bool				addon;						// this is an addon pack - addon_search tells if it's 'active'
@@ -301,12 +311,48 @@ typedef struct {
 	idStr				gamedir;					// base
 } directory_t;
 
+typedef struct {
+	idStr				pakFilename;				// pak the directory was read from
+	int					length;
+	ID_TIME_T			timestamp;
+	int					checksum;
+	int					numfiles;
+	int					offset;						// offset of the file list in the cache data
+	bool				used;						// a pak was loaded from this entry
+} pakCacheEntry_t;
+
 typedef struct searchpath_s {
 	pack_t *			pack;						// only one of pack / dir will be non NULL
 	directory_t *		dir;
 	struct searchpath_s *next;
 } searchpath_t;
 
+typedef enum {
+	ASYNC_FREE,
+	ASYNC_QUEUED,
+	ASYNC_READING,
+	ASYNC_DONE
+} asyncStatus_t;
+
+typedef struct {
+	idStr				relativePath;
+	idStr				fullPath;
+	idFile *			f;							// NULL once the file is read and closed
+	int					length;						// -1 if the file could not be opened or read
+	ID_TIME_T			timestamp;
+	byte *				buffer;
+	asyncReadCallback_t	callback;
+	void *				userData;
+	asyncReadPriority_t	priority;
+	int					sequence;					// makes handles of reused reads invalid
+	bool				prefetch;					// can be taken by OpenFileRead
+	bool				cancelled;					// cancelled while an I/O thread was reading
+	volatile int		status;						// asyncStatus_t
+	int					next;						// next free read
+} asyncRead_t;
+
+#define ASYNC_HANDLE_INDEX_BITS		16
+
 // search flags when opening a file
 #define FSFLAG_SEARCH_DIRS		( 1 << 0 )
 #define FSFLAG_SEARCH_PAKS		( 1 << 1 )
@@ -366,10 +412,13 @@ public:
 	virtual int				GetOSMask( void );
 	virtual int				ReadFile( const char *relativePath, void **buffer, ID_TIME_T *timestamp );
 	virtual void			FreeFile( void *buffer );
+	virtual int				ReadFileMapped( const char *relativePath, const void **buffer, ID_TIME_T *timestamp );
+	virtual void			FreeFileMapped( const void *buffer );
 	virtual int				WriteFile( const char *relativePath, const void *buffer, int size, const char *basePath = "fs_savepath" );
 	virtual void			RemoveFile( const char *relativePath );	
 	virtual idFile *		OpenFileReadFlags( const char *relativePath, int searchFlags, pack_t **foundInPak = NULL, bool allowCopyFiles = true, const char* gamedir = NULL );
 	virtual idFile *		OpenFileRead( const char *relativePath, bool allowCopyFiles = true, const char* gamedir = NULL );
+	virtual idFile_Mapped *	OpenFileMapped( const char *relativePath );
 	virtual idFile *		OpenFileWrite( const char *relativePath, const char *basePath = "fs_savepath" );
 	virtual idFile *		OpenFileAppend( const char *relativePath, bool sync = false, const char *basePath = "fs_basepath"   );
 	virtual idFile *		OpenFileByMode( const char *relativePath, fsMode_t mode );
@@ -377,8 +426,13 @@ public:
 	virtual idFile *		OpenExplicitFileWrite( const char *OSPath );
 	virtual void			CloseFile( idFile *f );
 	virtual void			BackgroundDownload( backgroundDownload_t *bgl );
+	virtual asyncReadHandle_t	ReadFileAsync( const char *relativePath, asyncReadPriority_t priority, asyncReadCallback_t callback, void *userData );
+	virtual bool			AsyncReadDone( asyncReadHandle_t handle );
+	virtual int				WaitAsyncRead( asyncReadHandle_t handle, void **buffer, ID_TIME_T *timestamp );
+	virtual void			CancelAsyncRead( asyncReadHandle_t handle );
+	virtual asyncReadHandle_t	PrefetchFile( const char *relativePath, asyncReadPriority_t priority );
 	virtual void			ResetReadCount( void ) { readCount = 0; }
-	virtual void			AddToReadCount( int c ) { readCount += c; }
+	virtual void			AddToReadCount( int c ) { idSysAtomic::Add( &readCount, c ); }
 	virtual int				GetReadCount( void ) { return readCount; }
 	virtual void			FindDLL( const char *basename, char dllPath[ MAX_OSPATH ], bool updateChecksum );
 	virtual void			ClearDirCache( void );
@@ -404,9 +458,19 @@ private:
 	friend dword 			BackgroundDownloadThread( void *parms );
 
 	searchpath_t *			searchPaths;
-	int						readCount;			// total bytes read
+	volatile int			readCount;			// total bytes read, also added to by I/O threads
 	int						loadCount;			// total files read
 	int						loadStack;			// total files in memory
+	idList<idFile_Mapped *>	mappedFiles;		// files with buffers returned by ReadFileMapped
+
+	idHashIndex				pakIndex;			// full name hash of every file in the paks on the search path
+	idList<fileInPack_t *>	pakIndexFiles;		// files in the pak index
+	bool					pakIndexValid;		// false when the search path changed since the index was built
+
+	idList<pakCacheEntry_t>	pakCache;			// pak directories read from the cache at startup
+	char *					pakCacheData;		// contents of the cache file
+	int						pakCacheLength;
+	bool					pakCacheDirty;		// a pak directory was parsed from the zip
 	idStr					gameFolder;			// this will be a single name without separators
 
 	searchpath_t			*addonPaks;			// not loaded up, but we saw them
@@ -424,11 +488,26 @@ private:
 	static idCVar			fs_game_base;
 	static idCVar			fs_caseSensitiveOS;
 	static idCVar			fs_searchAddons;
+	static idCVar			fs_mapFiles;
+	static idCVar			fs_pakIndexCache;
 
 	backgroundDownload_t *	backgroundDownloads;
 	backgroundDownload_t	defaultBackgroundDownload;
 	xthreadInfo				backgroundThread;
 
+	idList<asyncRead_t *>	asyncReads;			// all async reads, released ones are on the free list
+	int						asyncFree;			// first free async read
+	idList<int>				asyncQueue[ ASYNC_READ_NUM_PRIORITIES ];	// reads waiting for an I/O thread
+	int						numPrefetches;		// prefetched files OpenFileRead has not taken yet
+	idSysSpinLock			asyncLock;
+	idJobSemaphore			asyncWakeup;
+	int						numAsyncThreads;
+	xthreadInfo				asyncThreads[ MAX_THREADS ];
+	xthreadInfo *			asyncThreadList[ MAX_THREADS ];
+	int						asyncThreadCount;
+	volatile bool			asyncQuit;
+	static idCVar			fs_ioThreads;
+
 	idList<pack_t *>		serverPaks;
 	bool					loadedFileFromDir;		// set to true once a file was loaded from a directory - can't switch to pure anymore
 	idList<int>				restartChecksums;		// used during a restart to set things in right order
@@ -447,7 +526,9 @@ private:
 
 private:
 	void					ReplaceSeparators( idStr &path, char sep = PATHSEPERATOR_CHAR );
+	void					ReplaceSeparators( char *path, char sep = PATHSEPERATOR_CHAR );
 	long					HashFileName( const char *fname ) const;
+	int						HashPathName( const char *fname ) const;
 	int						ListOSFiles( const char *directory, const char *extension, idStrList &list );
 	FILE *					OpenOSFile( const char *name, const char *mode, idStr *caseSensitiveName = NULL );
 	FILE *					OpenOSFileCorrectName( idStr &path, const char *mode );
@@ -459,6 +540,12 @@ private:
 
 	int						GetFileListTree( const char *relativePath, const idStrList &extensions, idStrList &list, idHashIndex &hashIndex, const char* gamedir = NULL );
 	pack_t *				LoadZipFile( const char *zipfile );
+	void					BuildPakIndex( void );
+	fileInPack_t *			FindInPakIndex( const char *relativePath, int pathHash ) const;
+	void					LoadPakIndexCache( void );
+	void					FreePakIndexCache( void );
+	void					WritePakIndexCache( void );
+	bool					ReadPakFromCache( pack_t *pack );
 	void					AddGameDirectory( const char *path, const char *dir );
 	void					SetupGameDirectories( const char *gameName );
 	void					Startup( void );
@@ -470,6 +557,14 @@ private:
 							// searches all the paks, no pure check
 	pack_t *				FindPakForFileChecksum( const char *relativePath, int fileChecksum, bool bReference );
 	idFile_InZip *			ReadFileFromZip( pack_t *pak, fileInPack_t *pakFile, const char *relativePath );
+	void					StartAsyncReadThreads( void );
+	void					StopAsyncReadThreads( void );
+	asyncRead_t *			GetAsyncRead( asyncReadHandle_t handle ) const;
+	void					FreeAsyncRead( int index );
+	void					ReadAsync( int index, asyncRead_t *read );
+	int						FinishAsyncRead( asyncReadHandle_t handle, void **buffer, ID_TIME_T *timestamp, idStr *fullPath );
+	idFile *				TakePrefetchedFile( const char *relativePath );
+	static unsigned int		AsyncReadThread( void *parm );
 	int						GetFileChecksum( idFile *file );
 	pureStatus_t			GetPackStatus( pack_t *pak );
 	addonInfo_t *			ParseAddonDef( const char *buf, const int len );
@@ -495,6 +590,9 @@ idCVar	idFileSystemLocal::fs_caseSensitiveOS( "fs_caseSensitiveOS", "0", CVAR_SY
 idCVar	idFileSystemLocal::fs_caseSensitiveOS( "fs_caseSensitiveOS", "1", CVAR_SYSTEM | CVAR_BOOL, "" );
 #endif
 idCVar	idFileSystemLocal::fs_searchAddons( "fs_searchAddons", "0", CVAR_SYSTEM | CVAR_BOOL, "search all addon pk4s ( disables addon functionality )" );
+idCVar	idFileSystemLocal::fs_pakIndexCache( "fs_pakIndexCache", "1", CVAR_SYSTEM | CVAR_BOOL, "cache pak directories in the save path" );
+idCVar	idFileSystemLocal::fs_ioThreads( "fs_ioThreads", "2", CVAR_SYSTEM | CVAR_INTEGER | CVAR_INIT, "number of threads reading files for ReadFileAsync, 0 = read when the file is asked for", 0, 4 );
+idCVar	idFileSystemLocal::fs_mapFiles( "fs_mapFiles", "1", CVAR_SYSTEM | CVAR_BOOL, "map files on disk and uncompressed files in paks into memory instead of reading them" );
 
 idFileSystemLocal	fileSystemLocal;
 idFileSystem *		fileSystem = &fileSystemLocal;
@@ -516,6 +614,15 @@ idFileSystemLocal::idFileSystemLocal( void ) {
 	restartGamePakChecksum = 0;
 	memset( &backgroundThread, 0, sizeof( backgroundThread ) );
 	addonPaks = NULL;
+	pakIndexValid = false;
+	pakCacheData = NULL;
+	pakCacheLength = 0;
+	pakCacheDirty = false;
+	asyncFree = -1;
+	numPrefetches = 0;
+	numAsyncThreads = 0;
+	asyncThreadCount = 0;
+	asyncQuit = false;
 }
 
 /*
@@ -547,6 +654,29 @@ long idFileSystemLocal::HashFileName( const char *fname ) const {
 	return hash;
 }
 
+/*
+================
+idFileSystemLocal::HashPathName
+
+return a hash value for the full filename including the extension
+================
+*/
+int idFileSystemLocal::HashPathName( const char *fname ) const {
+	int		i;
+	int		hash;
+	char	letter;
+
+	hash = 0;
+	for ( i = 0; fname[i] != '\0'; i++ ) {
+		letter = idStr::ToLower( fname[i] );
+		if ( letter == '\\' || letter == ':' ) {
+			letter = '/';
+		}
+		hash = hash * 31 + letter;
+	}
+	return hash;
+}
+
 /*
 ===========
 idFileSystemLocal::FilenameCompare
@@ -619,8 +749,7 @@ FILE *idFileSystemLocal::OpenOSFile( const char *fileName, const char *mode, idS
 				fp = fopen( entry, mode );
 				if ( fp ) {
 					if ( caseSensitiveName ) {
-						*caseSensitiveName = entry;
-						caseSensitiveName->StripPath();
+						*caseSensitiveName = idStrView( entry ).StripPath();
 					}
 					if ( fs_debug.GetInteger() ) {
 						common->Printf( "idFileSystemLocal::OpenFileRead: changed %s to %s\n", fileName, entry.c_str() );
@@ -633,8 +762,7 @@ FILE *idFileSystemLocal::OpenOSFile( const char *fileName, const char *mode, idS
 			}
 		}
 	} else if ( caseSensitiveName ) {
-		*caseSensitiveName = fileName;
-		caseSensitiveName->StripPath();
+		*caseSensitiveName = idStrView( fileName ).StripPath();
 	}
 	return fp;
 }
@@ -784,9 +912,18 @@ Fix things up differently for win/unix/mac
 ====================
 */
 void idFileSystemLocal::ReplaceSeparators( idStr &path, char sep ) {
+	ReplaceSeparators( &path[ 0 ], sep );
+}
+
+/*
+====================
+idFileSystemLocal::ReplaceSeparators
+====================
+*/
+void idFileSystemLocal::ReplaceSeparators( char *path, char sep ) {
 	char *s;
 
-	for( s = &path[ 0 ]; *s ; s++ ) {
+	for( s = path; *s ; s++ ) {
 		if ( *s == '/' || *s == '\\' ) {
 			*s = sep;
 		}
@@ -804,7 +941,7 @@ const char *idFileSystemLocal::BuildOSPath( const char *base, const char *game,
 
 	if ( fs_caseSensitiveOS.GetBool() || com_developer.GetBool() ) {
 		// extract the path, make sure it's all lowercase
-		idStr testPath, fileName;
+		idStr testPath;
 
 		sprintf( testPath, "%s/%s", game , relativePath );
 		testPath.StripFilename();
@@ -816,9 +953,9 @@ const char *idFileSystemLocal::BuildOSPath( const char *base, const char *game,
 			// attempt a fixup on the fly
 			if ( fs_caseSensitiveOS.GetBool() ) {
 				testPath.ToLower();
-				fileName = relativePath;
+				idStrView fileName( relativePath );
 				fileName.StripPath();
-				sprintf( newPath, "%s/%s/%s", base, testPath.c_str(), fileName.c_str() );
+				sprintf( newPath, "%s/%s/%.*s", base, testPath.c_str(), fileName.Length(), fileName.Ptr() );
 				ReplaceSeparators( newPath );
 				common->DPrintf( "Fixed up to %s\n", newPath.c_str() );
 				idStr::Copynz( OSPath, newPath, sizeof( OSPath ) );
@@ -827,12 +964,16 @@ const char *idFileSystemLocal::BuildOSPath( const char *base, const char *game,
 		}
 	}
 
-	idStr strBase = base;
+	// this is done for every search path of every file opened, build the path without any temporary strings
+	idStrView strBase( base );
 	strBase.StripTrailing( '/' );
 	strBase.StripTrailing( '\\' );
-	sprintf( newPath, "%s/%s/%s", strBase.c_str(), game, relativePath );
-	ReplaceSeparators( newPath );
-	idStr::Copynz( OSPath, newPath, sizeof( OSPath ) );
+	strBase.Copynz( OSPath, sizeof( OSPath ) );
+	idStr::Append( OSPath, sizeof( OSPath ), "/" );
+	idStr::Append( OSPath, sizeof( OSPath ), game );
+	idStr::Append( OSPath, sizeof( OSPath ), "/" );
+	idStr::Append( OSPath, sizeof( OSPath ), relativePath );
+	ReplaceSeparators( OSPath );
 	return OSPath;
 }
 
@@ -1095,8 +1236,12 @@ int idFileSystemLocal::ReadFile( const char *relativePath, void **buffer, ID_TIM
 		isConfig = false;
 	}
 
-	// look for it in the filesystem or pack files
-	f = OpenFileRead( relativePath, ( buffer != NULL ) );
+	// look for it in the filesystem or pack files, only take prefetched data when reading the file
+	if ( buffer ) {
+		f = OpenFileRead( relativePath, true );
+	} else {
+		f = OpenFileReadFlags( relativePath, FSFLAG_SEARCH_DIRS | FSFLAG_SEARCH_PAKS, NULL, false );
+	}
 	if ( f == NULL ) {
 		if ( buffer ) {
 			*buffer = NULL;
@@ -1154,6 +1299,68 @@ void idFileSystemLocal::FreeFile( void *buffer ) {
 	Mem_Free( buffer );
 }
 
+/*
+============
+idFileSystemLocal::ReadFileMapped
+============
+*/
+int idFileSystemLocal::ReadFileMapped( const char *relativePath, const void **buffer, ID_TIME_T *timestamp ) {
+	idFile_Mapped *	f;
+
+	if ( !buffer ) {
+		return ReadFile( relativePath, NULL, timestamp );
+	}
+
+	*buffer = NULL;
+
+	f = OpenFileMapped( relativePath );
+	if ( f == NULL ) {
+		if ( timestamp ) {
+			*timestamp = FILE_NOT_FOUND_TIMESTAMP;
+		}
+		return -1;
+	}
+
+	if ( timestamp ) {
+		*timestamp = f->Timestamp();
+	}
+
+	loadCount++;
+	loadStack++;
+
+	mappedFiles.Append( f );
+	*buffer = f->GetDataPtr();
+
+	return f->Length();
+}
+
+/*
+=============
+idFileSystemLocal::FreeFileMapped
+=============
+*/
+void idFileSystemLocal::FreeFileMapped( const void *buffer ) {
+	int i;
+
+	if ( !buffer ) {
+		common->FatalError( "idFileSystemLocal::FreeFileMapped( NULL )" );
+	}
+
+	for ( i = mappedFiles.Num() - 1; i >= 0; i-- ) {
+		if ( mappedFiles[i]->GetDataPtr() == buffer ) {
+			break;
+		}
+	}
+	if ( i < 0 ) {
+		common->FatalError( "idFileSystemLocal::FreeFileMapped: buffer not returned by ReadFileMapped" );
+	}
+
+	loadStack--;
+
+	delete mappedFiles[i];
+	mappedFiles.RemoveIndex( i );
+}
+
 /*
 ============
 idFileSystemLocal::WriteFile
@@ -1301,6 +1508,7 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 	int *			fs_headerLongs;
 	FILE			*f;
 	int				len;
+	ID_TIME_T		timestamp;
 	int				confHash;
 	fileInPack_t	*pakFile;
 
@@ -1310,6 +1518,7 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 	}
 	fseek( f, 0, SEEK_END );
 	len = ftell( f );
+	timestamp = Sys_FileTimeStamp( f );
 	fclose( f );
 
 	fs_numHeaderLongs = 0;
@@ -1340,28 +1549,45 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 	pack->isNew = false;
 
 	pack->length = len;
-
-	unzGoToFirstFile(uf);
-	fs_headerLongs = (int *)Mem_ClearedAlloc( gi.number_entry * sizeof(int) );
-	for ( i = 0; i < (int)gi.number_entry; i++ ) {
-		err = unzGetCurrentFileInfo( uf, &file_info, filename_inzip, sizeof(filename_inzip), NULL, 0, NULL, 0 );
-		if ( err != UNZ_OK ) {
-			break;
-		}
-		if ( file_info.uncompressed_size > 0 ) {
-			fs_headerLongs[fs_numHeaderLongs++] = LittleLong( file_info.crc );
+	pack->timestamp = timestamp;
+
+	if ( !ReadPakFromCache( pack ) ) {
+		unzGoToFirstFile(uf);
+		fs_headerLongs = (int *)Mem_ClearedAlloc( gi.number_entry * sizeof(int) );
+		for ( i = 0; i < (int)gi.number_entry; i++ ) {
+			err = unzGetCurrentFileInfo( uf, &file_info, filename_inzip, sizeof(filename_inzip), NULL, 0, NULL, 0 );
+			if ( err != UNZ_OK ) {
+				break;
+			}
+			if ( file_info.uncompressed_size > 0 ) {
+				fs_headerLongs[fs_numHeaderLongs++] = LittleLong( file_info.crc );
+			}
+			buildBuffer[i].name = filename_inzip;
+			buildBuffer[i].name.ToLower();
+			buildBuffer[i].name.BackSlashesToSlashes();
+			buildBuffer[i].pathHash = HashPathName( buildBuffer[i].name );
+			// store the file position in the zip
+			unzGetCurrentFileInfoPosition( uf, &buildBuffer[i].pos );
+			// go to the next file in the zip
+			unzGoToNextFile(uf);
 		}
-		hash = HashFileName( filename_inzip );
-		buildBuffer[i].name = filename_inzip;
-		buildBuffer[i].name.ToLower();
-		buildBuffer[i].name.BackSlashesToSlashes();
-		// store the file position in the zip
-		unzGetCurrentFileInfoPosition( uf, &buildBuffer[i].pos );
+		pack->numfiles = i;
+
+		pack->checksum = MD4_BlockChecksum( fs_headerLongs, 4 * fs_numHeaderLongs );
+		pack->checksum = LittleLong( pack->checksum );
+
+		Mem_Free( fs_headerLongs );
+
+		pakCacheDirty = true;
+	}
+
+	for ( i = 0; i < pack->numfiles; i++ ) {
+		hash = HashFileName( buildBuffer[i].name );
+		buildBuffer[i].pack = pack;
+		buildBuffer[i].nextInSearch = NULL;
 		// add the file to the hash
 		buildBuffer[i].next = pack->hashTable[hash];
 		pack->hashTable[hash] = &buildBuffer[i];
-		// go to the next file in the zip
-		unzGoToNextFile(uf);
 	}
 
 	// check if this is an addon pak
@@ -1387,12 +1613,258 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 		}
 	}
 
-	pack->checksum = MD4_BlockChecksum( fs_headerLongs, 4 * fs_numHeaderLongs );
-	pack->checksum = LittleLong( pack->checksum );
+	return pack;
+}
 
-	Mem_Free( fs_headerLongs );
+/*
+================
+idFileSystemLocal::BuildPakIndex
 
-	return pack;
+Adds every file in the paks on the search path to a single hash index.
+Files with the same name are linked in search order so one lookup finds
+all the paks holding a file.
+================
+*/
+void idFileSystemLocal::BuildPakIndex( void ) {
+	searchpath_t *		search;
+	idList<pack_t *>	packs;
+	fileInPack_t *		pakFile;
+	fileInPack_t *		next;
+	int					i, j, numFiles;
+
+	numFiles = 0;
+	for ( search = searchPaths; search; search = search->next ) {
+		if ( search->pack ) {
+			packs.Append( search->pack );
+			numFiles += search->pack->numfiles;
+		}
+	}
+
+	pakIndex.Clear( idMath::CeilPowerOfTwo( Max( numFiles, 1024 ) ), numFiles );
+	pakIndexFiles.SetNum( 0, false );
+	pakIndexFiles.Resize( numFiles );
+
+	// add the paks in reverse search order so a lookup finds the first pak on the search path
+	for ( i = packs.Num() - 1; i >= 0; i-- ) {
+		for ( j = packs[i]->numfiles - 1; j >= 0; j-- ) {
+			pakFile = &packs[i]->buildBuffer[j];
+			next = FindInPakIndex( pakFile->name, pakFile->pathHash );
+			if ( next && next->pack == pakFile->pack ) {
+				// the same name twice in one pak, the last one in the zip is used
+				pakFile->nextInSearch = NULL;
+				continue;
+			}
+			pakFile->nextInSearch = next;
+			pakIndex.Add( pakFile->pathHash, pakIndexFiles.Append( pakFile ) );
+		}
+	}
+
+	pakIndexValid = true;
+
+	if ( fs_debug.GetInteger() ) {
+		common->Printf( "pak index: %d files in %d paks\n", pakIndexFiles.Num(), packs.Num() );
+	}
+}
+
+/*
+================
+idFileSystemLocal::FindInPakIndex
+
+Returns the file in the first pak on the search path, the other paks holding it follow through nextInSearch.
+================
+*/
+fileInPack_t *idFileSystemLocal::FindInPakIndex( const char *relativePath, int pathHash ) const {
+	int i;
+
+	for ( i = pakIndex.First( pathHash ); i != -1; i = pakIndex.Next( i ) ) {
+		if ( pakIndexFiles[i]->pathHash == pathHash && !FilenameCompare( pakIndexFiles[i]->name, relativePath ) ) {
+			return pakIndexFiles[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+================
+idFileSystemLocal::LoadPakIndexCache
+
+Reads the pak directories cached by the last startup. The file lists are parsed when a matching pak is loaded.
+================
+*/
+void idFileSystemLocal::LoadPakIndexCache( void ) {
+	FILE *			fp;
+	idStr			path;
+	pakCacheEntry_t	entry;
+	int				id, version, numPaks, timestamp, listLength, i;
+
+	FreePakIndexCache();
+
+	if ( !fs_pakIndexCache.GetBool() || !fs_savepath.GetString()[0] ) {
+		return;
+	}
+
+	path = BuildOSPath( fs_savepath.GetString(), BASE_GAMEDIR, PAK_INDEX_CACHE );
+	fp = OpenOSFile( path, "rb" );
+	if ( !fp ) {
+		pakCacheDirty = true;
+		return;
+	}
+	pakCacheLength = DirectFileLength( fp );
+	pakCacheData = (char *)Mem_Alloc( pakCacheLength );
+	if ( (int)fread( pakCacheData, 1, pakCacheLength, fp ) != pakCacheLength ) {
+		pakCacheLength = 0;
+	}
+	fclose( fp );
+
+	idFile_Memory src( PAK_INDEX_CACHE, pakCacheData, pakCacheLength );
+	id = version = 0;
+	src.ReadInt( id );
+	src.ReadInt( version );
+	if ( id != PAK_INDEX_CACHE_ID || version != PAK_INDEX_CACHE_VERSION ) {
+		common->DPrintf( "ignoring out of date %s\n", path.c_str() );
+		FreePakIndexCache();
+		pakCacheDirty = true;
+		return;
+	}
+
+	src.ReadInt( numPaks );
+	for ( i = 0; i < numPaks; i++ ) {
+		src.ReadString( entry.pakFilename );
+		src.ReadInt( entry.length );
+		src.ReadInt( timestamp );
+		src.ReadInt( entry.checksum );
+		src.ReadInt( entry.numfiles );
+		src.ReadInt( listLength );
+		entry.timestamp = timestamp;
+		entry.offset = src.Tell();
+		entry.used = false;
+		if ( listLength < 0 || entry.offset + listLength > pakCacheLength ) {
+			common->DPrintf( "ignoring corrupt %s\n", path.c_str() );
+			FreePakIndexCache();
+			pakCacheDirty = true;
+			return;
+		}
+		pakCache.Append( entry );
+		src.Seek( listLength, FS_SEEK_CUR );
+	}
+}
+
+/*
+================
+idFileSystemLocal::FreePakIndexCache
+================
+*/
+void idFileSystemLocal::FreePakIndexCache( void ) {
+	pakCache.Clear();
+	Mem_Free( pakCacheData );
+	pakCacheData = NULL;
+	pakCacheLength = 0;
+	pakCacheDirty = false;
+}
+
+/*
+================
+idFileSystemLocal::ReadPakFromCache
+
+Fills in the pak directory from the cache if the pak did not change since it was cached.
+================
+*/
+bool idFileSystemLocal::ReadPakFromCache( pack_t *pack ) {
+	pakCacheEntry_t *	entry;
+	unsigned int		pos;
+	int					i;
+
+	for ( i = 0; i < pakCache.Num(); i++ ) {
+		if ( !pakCache[i].pakFilename.Cmp( pack->pakFilename ) ) {
+			break;
+		}
+	}
+	if ( i >= pakCache.Num() ) {
+		return false;
+	}
+
+	entry = &pakCache[i];
+	if ( entry->length != pack->length || entry->timestamp != pack->timestamp || entry->numfiles != pack->numfiles ) {
+		return false;
+	}
+
+	idFile_Memory src( PAK_INDEX_CACHE, pakCacheData + entry->offset, pakCacheLength - entry->offset );
+	for ( i = 0; i < pack->numfiles; i++ ) {
+		src.ReadString( pack->buildBuffer[i].name );
+		src.ReadInt( pack->buildBuffer[i].pathHash );
+		src.ReadUnsignedInt( pos );
+		pack->buildBuffer[i].pos = pos;
+	}
+
+	pack->checksum = entry->checksum;
+	entry->used = true;
+
+	return true;
+}
+
+/*
+================
+idFileSystemLocal::WritePakIndexCache
+
+Rewrites the cache when a pak directory had to be parsed or a cached pak is gone.
+================
+*/
+void idFileSystemLocal::WritePakIndexCache( void ) {
+	searchpath_t *		search;
+	searchpath_t *		loop;
+	idList<pack_t *>	packs;
+	idFile *			f;
+	int					i, j;
+
+	if ( !fs_pakIndexCache.GetBool() || !fs_savepath.GetString()[0] ) {
+		return;
+	}
+
+	for ( i = 0; i < pakCache.Num(); i++ ) {
+		if ( !pakCache[i].used ) {
+			pakCacheDirty = true;
+		}
+	}
+	if ( !pakCacheDirty ) {
+		return;
+	}
+
+	for ( loop = searchPaths; loop; loop == searchPaths ? loop = addonPaks : loop = NULL ) {
+		for ( search = loop; search; search = search->next ) {
+			if ( search->pack ) {
+				packs.Append( search->pack );
+			}
+		}
+	}
+
+	f = OpenExplicitFileWrite( BuildOSPath( fs_savepath.GetString(), BASE_GAMEDIR, PAK_INDEX_CACHE ) );
+	if ( !f ) {
+		return;
+	}
+
+	f->WriteInt( PAK_INDEX_CACHE_ID );
+	f->WriteInt( PAK_INDEX_CACHE_VERSION );
+	f->WriteInt( packs.Num() );
+	for ( i = 0; i < packs.Num(); i++ ) {
+		const pack_t *pak = packs[i];
+		idFile_Memory list;
+		for ( j = 0; j < pak->numfiles; j++ ) {
+			list.WriteString( pak->buildBuffer[j].name );
+			list.WriteInt( pak->buildBuffer[j].pathHash );
+			list.WriteUnsignedInt( pak->buildBuffer[j].pos );
+		}
+		f->WriteString( pak->pakFilename );
+		f->WriteInt( pak->length );
+		f->WriteInt( pak->timestamp );
+		f->WriteInt( pak->checksum );
+		f->WriteInt( pak->numfiles );
+		f->WriteInt( list.Length() );
+		f->Write( list.GetDataPtr(), list.Length() );
+	}
+
+	CloseFile( f );
+
+	pakCacheDirty = false;
 }
 
 /*
@@ -1424,6 +1896,7 @@ int idFileSystemLocal::AddZipFile( const char *path ) {
 		last = last->next;
 	}
 	last->next = search;
+	pakIndexValid = false;
 	common->Printf( "Appended pk4 %s with checksum 0x%x\n", pak->pakFilename.c_str(), pak->checksum );
 	return pak->checksum;
 }
@@ -2135,6 +2608,7 @@ void idFileSystemLocal::AddGameDirectory( const char *path, const char *dir ) {
 	search->dir->gamedir = dir;
 	search->next = searchPaths;
 	searchPaths = search;
+	pakIndexValid = false;
 
 	// find all pak files in this directory
 	pakfile = BuildOSPath( path, dir, "" );
@@ -2245,6 +2719,8 @@ void idFileSystemLocal::Startup( void ) {
 		common->Printf( "restarting filesystem with %d addon pak file(s) to include\n", addonChecksums.Num() );
 	}
 
+	LoadPakIndexCache();
+
 	SetupGameDirectories( BASE_GAMEDIR );
 
 	// fs_game_base override
@@ -2390,12 +2866,18 @@ void idFileSystemLocal::Startup( void ) {
 		gamePakChecksum = restartGamePakChecksum;
 	}
 
+	// the search order is final, index the paks and remember their directories for the next startup
+	BuildPakIndex();
+	WritePakIndexCache();
+	FreePakIndexCache();
+
 	// add our commands
 	cmdSystem->AddCommand( "dir", Dir_f, CMD_FL_SYSTEM, "lists a folder", idCmdSystem::ArgCompletion_FileName );
 	cmdSystem->AddCommand( "dirtree", DirTree_f, CMD_FL_SYSTEM, "lists a folder with subfolders" );
 	cmdSystem->AddCommand( "path", Path_f, CMD_FL_SYSTEM, "lists search paths" );
 	cmdSystem->AddCommand( "touchFile", TouchFile_f, CMD_FL_SYSTEM, "touches a file" );
 	cmdSystem->AddCommand( "touchFileList", TouchFileList_f, CMD_FL_SYSTEM, "touches a list of files" );
+	cmdSystem->AddCommand( "zipCacheStats", idZipBlockCache::ZipCacheStats_f, CMD_FL_SYSTEM, "prints zip block cache statistics" );
 
 	// print the current search paths
 	Path_f( idCmdArgs() );
@@ -2850,6 +3332,7 @@ void idFileSystemLocal::Init( void ) {
 	common->StartupVariable( "fs_copyfiles", false );
 	common->StartupVariable( "fs_restrict", false );
 	common->StartupVariable( "fs_searchAddons", false );
+	common->StartupVariable( "fs_pakIndexCache", false );
 
 #if !ID_ALLOW_D3XP
 	if ( fs_game.GetString()[0] && !idStr::Icmp( fs_game.GetString(), "d3xp" ) ) {
@@ -2878,6 +3361,12 @@ void idFileSystemLocal::Init( void ) {
 #endif
 	}
 
+	// start the threads inflating pak files ahead of use
+	zipBlockCache.Init();
+
+	// start the threads for ReadFileAsync
+	StartAsyncReadThreads();
+
 	// try to start up normally
 	Startup( );
 
@@ -2962,6 +3451,18 @@ void idFileSystemLocal::Shutdown( bool reloading ) {
 		}
 	}
 
+	pakIndex.Free();
+	pakIndexFiles.Clear();
+	pakIndexValid = false;
+
+	// paks may change on disk between restarts
+	if ( reloading ) {
+		zipBlockCache.Clear();
+	} else {
+		StopAsyncReadThreads();
+		zipBlockCache.Shutdown();
+	}
+
 	// any FS_ calls will now be an error until reinitialized
 	searchPaths = NULL;
 	addonPaks = NULL;
@@ -2970,6 +3471,7 @@ void idFileSystemLocal::Shutdown( bool reloading ) {
 	cmdSystem->RemoveCommand( "dir" );
 	cmdSystem->RemoveCommand( "dirtree" );
 	cmdSystem->RemoveCommand( "touchFile" );
+	cmdSystem->RemoveCommand( "zipCacheStats" );
 
 	mapDict.Clear();
 }
@@ -3112,6 +3614,7 @@ idFile_InZip * idFileSystemLocal::ReadFileFromZip( pack_t *pak, fileInPack_t *pa
 	}
 	file->name = relativePath;
 	file->fullPath = pak->pakFilename + "/" + relativePath;
+	file->pakChecksum = pak->checksum;
 	zfi = (unz_s *)file->z;
 	// in case the file was new
 	fp = zfi->file;
@@ -3125,6 +3628,10 @@ idFile_InZip * idFileSystemLocal::ReadFileFromZip( pack_t *pak, fileInPack_t *pa
 	unzOpenCurrentFile( file->z );
 	file->zipFilePos = pakFile->pos;
 	file->fileSize = zfi->cur_file_info.uncompressed_size;
+	// deflated files are inflated a block at a time through the shared block cache
+	if ( zfi->cur_file_info.compression_method != 0 && zipBlockCache.IsEnabled() ) {
+		file->cacheEntry = zipBlockCache.FindEntry( pak->pakFilename, pakFile->pos );
+	}
 	return file;
 }
 
@@ -3146,6 +3653,7 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 	directory_t *	dir;
 	long			hash;
 	FILE *			fp;
+	fileInPack_t *	indexed;
 	
 	if ( !searchPaths ) {
 		common->FatalError( "Filesystem call made without initialization\n" );
@@ -3188,6 +3696,15 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 
 	hash = HashFileName( relativePath );
 
+	// a single lookup gives all the paks holding the file in search order
+	indexed = NULL;
+	if ( searchFlags & FSFLAG_SEARCH_PAKS ) {
+		if ( !pakIndexValid ) {
+			BuildPakIndex();
+		}
+		indexed = FindInPakIndex( relativePath, HashPathName( relativePath ) );
+	}
+
 	for ( search = searchPaths; search; search = search->next ) {
 		if ( search->dir && ( searchFlags & FSFLAG_SEARCH_DIRS ) ) {
 			// check a file in the directory tree
@@ -3292,9 +3809,11 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 			return file;
 		} else if ( search->pack && ( searchFlags & FSFLAG_SEARCH_PAKS ) ) {
 
-			if ( !search->pack->hashTable[hash] ) {
+			if ( !indexed || indexed->pack != search->pack ) {
 				continue;
 			}
+			pakFile = indexed;
+			indexed = indexed->nextInSearch;
 
 			// disregard if it doesn't match one of the allowed pure pak files
 			if ( serverPaks.Num() ) {
@@ -3326,29 +3845,24 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 				}
 			}
 
-			for ( pakFile = pak->hashTable[hash]; pakFile; pakFile = pakFile->next ) {
-				// case and separator insensitive comparisons
-				if ( !FilenameCompare( pakFile->name, relativePath ) ) {
-					idFile_InZip *file = ReadFileFromZip( pak, pakFile, relativePath );
+			idFile_InZip *file = ReadFileFromZip( pak, pakFile, relativePath );
 
-					if ( foundInPak ) {
-						*foundInPak = pak;
-					}
-
-					if ( !pak->referenced && !( searchFlags & FSFLAG_PURE_NOREF ) ) {
-						// mark this pak referenced
-						if ( fs_debug.GetInteger( ) ) {
-							common->Printf( "idFileSystem::OpenFileRead: %s -> adding %s to referenced paks\n", relativePath, pak->pakFilename.c_str() );
-						}
-						pak->referenced = true;
-					}
+			if ( foundInPak ) {
+				*foundInPak = pak;
+			}
 
-					if ( fs_debug.GetInteger( ) ) {
-						common->Printf( "idFileSystem::OpenFileRead: %s (found in '%s')\n", relativePath, pak->pakFilename.c_str() );
-					}
-					return file;
+			if ( !pak->referenced && !( searchFlags & FSFLAG_PURE_NOREF ) ) {
+				// mark this pak referenced
+				if ( fs_debug.GetInteger( ) ) {
+					common->Printf( "idFileSystem::OpenFileRead: %s -> adding %s to referenced paks\n", relativePath, pak->pakFilename.c_str() );
 				}
+				pak->referenced = true;
 			}
+
+			if ( fs_debug.GetInteger( ) ) {
+				common->Printf( "idFileSystem::OpenFileRead: %s (found in '%s')\n", relativePath, pak->pakFilename.c_str() );
+			}
+			return file;
 		}
 	}
 
@@ -3386,9 +3900,89 @@ idFileSystemLocal::OpenFileRead
 ===========
 */
 idFile *idFileSystemLocal::OpenFileRead( const char *relativePath, bool allowCopyFiles, const char* gamedir ) {
+	idFile *f;
+
+	if ( gamedir == NULL ) {
+		f = TakePrefetchedFile( relativePath );
+		if ( f != NULL ) {
+			return f;
+		}
+	}
 	return OpenFileReadFlags( relativePath, FSFLAG_SEARCH_DIRS | FSFLAG_SEARCH_PAKS, NULL, allowCopyFiles, gamedir );
 }
 
+/*
+===========
+idFileSystemLocal::OpenFileMapped
+
+Files in the directory tree and files stored without compression in
+a pak are mapped into memory, anything else is read into a buffer.
+===========
+*/
+idFile_Mapped *idFileSystemLocal::OpenFileMapped( const char *relativePath ) {
+	idFile *		f;
+	idFile_Mapped *	file;
+	FILE *			fp;
+	int				offset;
+	int				len;
+	const void *	data;
+	void *			mapBase;
+	int				mapLength;
+
+	f = OpenFileRead( relativePath );
+	if ( f == NULL ) {
+		return NULL;
+	}
+
+	// prefetched files are already in memory
+	file = dynamic_cast<idFile_Mapped *>( f );
+	if ( file ) {
+		return file;
+	}
+
+	len = f->Length();
+
+	fp = NULL;
+	offset = 0;
+	if ( fs_mapFiles.GetBool() ) {
+		idFile_Permanent *permanent = dynamic_cast<idFile_Permanent *>( f );
+		idFile_InZip *inZip = dynamic_cast<idFile_InZip *>( f );
+		if ( permanent ) {
+			fp = permanent->o;
+		} else if ( inZip ) {
+			unz_s *zfi = (unz_s *)inZip->z;
+			if ( zfi->pfile_in_zip_read && zfi->cur_file_info.compression_method == 0 ) {
+				fp = zfi->file;
+				offset = zfi->pfile_in_zip_read->pos_in_zipfile + zfi->pfile_in_zip_read->byte_before_the_zipfile;
+			}
+		}
+	}
+
+	data = NULL;
+	mapBase = NULL;
+	mapLength = 0;
+	if ( fp ) {
+		data = Sys_MapFile( fp, offset, len, &mapBase, &mapLength );
+	}
+
+	if ( data ) {
+		if ( fs_debug.GetInteger() ) {
+			common->Printf( "idFileSystem::OpenFileMapped: %s mapped\n", relativePath );
+		}
+	} else {
+		char *buf = (char *)Mem_Alloc( len + 1 );
+		f->Read( buf, len );
+		// guarantee that it will have a trailing 0 for string operations
+		buf[len] = 0;
+		data = buf;
+	}
+
+	file = new idFile_Mapped( f->GetName(), f->GetFullPath(), f->Timestamp(), mapBase, mapLength, (const char *)data, len );
+	CloseFile( f );
+
+	return file;
+}
+
 /*
 ===========
 idFileSystemLocal::OpenFileWrite
@@ -3784,6 +4378,480 @@ void idFileSystemLocal::BackgroundDownload( backgroundDownload_t *bgl ) {
 	}
 }
 
+/*
+=================================================================================
+
+asynchronous reads
+
+=================================================================================
+*/
+
+/*
+=================
+idFileSystemLocal::StartAsyncReadThreads
+=================
+*/
+void idFileSystemLocal::StartAsyncReadThreads( void ) {
+	int i;
+
+	asyncQuit = false;
+	asyncThreadCount = 0;
+	asyncWakeup.Init();
+
+	numAsyncThreads = idMath::ClampInt( 0, MAX_THREADS, fs_ioThreads.GetInteger() );
+	for ( i = 0; i < numAsyncThreads; i++ ) {
+		Sys_CreateThread( (xthread_t)AsyncReadThread, this, THREAD_NORMAL, asyncThreads[i], "AsyncRead", asyncThreadList, &asyncThreadCount );
+	}
+}
+
+/*
+=================
+idFileSystemLocal::StopAsyncReadThreads
+
+Stops the I/O threads and releases every read that was not waited for.
+=================
+*/
+void idFileSystemLocal::StopAsyncReadThreads( void ) {
+	int i;
+
+	asyncQuit = true;
+	asyncWakeup.Post( numAsyncThreads );
+	for ( i = 0; i < numAsyncThreads; i++ ) {
+		Sys_JoinThread( asyncThreads[i] );
+	}
+	numAsyncThreads = 0;
+	asyncThreadCount = 0;
+
+	for ( i = 0; i < asyncReads.Num(); i++ ) {
+		delete asyncReads[i]->f;
+		Mem_Free( asyncReads[i]->buffer );
+	}
+	asyncReads.DeleteContents( true );
+	for ( i = 0; i < ASYNC_READ_NUM_PRIORITIES; i++ ) {
+		asyncQueue[i].Clear();
+	}
+	asyncFree = -1;
+	numPrefetches = 0;
+
+	asyncWakeup.Shutdown();
+}
+
+/*
+=================
+idFileSystemLocal::GetAsyncRead
+
+Returns NULL if the handle was released. The caller must hold the async lock.
+=================
+*/
+asyncRead_t *idFileSystemLocal::GetAsyncRead( asyncReadHandle_t handle ) const {
+	int index = handle & ( ( 1 << ASYNC_HANDLE_INDEX_BITS ) - 1 );
+
+	if ( handle <= 0 || index >= asyncReads.Num() ) {
+		return NULL;
+	}
+	asyncRead_t *read = asyncReads[index];
+	if ( read->status == ASYNC_FREE || read->sequence != ( handle >> ASYNC_HANDLE_INDEX_BITS ) ) {
+		return NULL;
+	}
+	return read;
+}
+
+/*
+=================
+idFileSystemLocal::FreeAsyncRead
+
+The caller must hold the async lock.
+=================
+*/
+void idFileSystemLocal::FreeAsyncRead( int index ) {
+	asyncRead_t *read = asyncReads[index];
+
+	if ( read->prefetch ) {
+		numPrefetches--;
+	}
+	Mem_Free( read->buffer );
+	read->buffer = NULL;
+	read->relativePath.Clear();
+	read->fullPath.Clear();
+	read->callback = NULL;
+	read->userData = NULL;
+	read->prefetch = false;
+	read->cancelled = false;
+	read->status = ASYNC_FREE;
+	read->next = asyncFree;
+	asyncFree = index;
+}
+
+/*
+=================
+idFileSystemLocal::ReadAsync
+
+Reads the whole file of a read that was taken off the queue.
+=================
+*/
+void idFileSystemLocal::ReadAsync( int index, asyncRead_t *read ) {
+	byte *buf;
+
+	if ( read->f ) {
+		buf = (byte *)Mem_ClearedAlloc( read->length + 1 );
+		if ( read->f->Read( buf, read->length ) == read->length ) {
+			// guarantee that it will have a trailing 0 for string operations
+			buf[read->length] = 0;
+		} else {
+			Mem_Free( buf );
+			buf = NULL;
+			read->length = -1;
+		}
+		// not CloseFile, the search paths may be reloading
+		delete read->f;
+		read->f = NULL;
+		read->buffer = buf;
+	}
+
+	if ( read->callback && !read->cancelled ) {
+		read->callback( read->relativePath, read->buffer, read->length, read->userData );
+	}
+
+	asyncLock.Lock();
+	if ( read->cancelled ) {
+		FreeAsyncRead( index );
+	} else {
+		read->status = ASYNC_DONE;
+	}
+	asyncLock.Unlock();
+}
+
+/*
+=================
+idFileSystemLocal::AsyncReadThread
+=================
+*/
+unsigned int idFileSystemLocal::AsyncReadThread( void *parm ) {
+	idFileSystemLocal *fs = static_cast<idFileSystemLocal *>( parm );
+	asyncRead_t *read;
+	int i, index;
+
+	while( 1 ) {
+		fs->asyncWakeup.Wait();
+		if ( fs->asyncQuit ) {
+			break;
+		}
+
+		// the waiting thread may have taken the read already
+		read = NULL;
+		index = -1;
+		fs->asyncLock.Lock();
+		for ( i = ASYNC_READ_NUM_PRIORITIES - 1; i >= 0; i-- ) {
+			if ( fs->asyncQueue[i].Num() ) {
+				index = fs->asyncQueue[i][0];
+				fs->asyncQueue[i].RemoveIndex( 0 );
+				read = fs->asyncReads[index];
+				read->status = ASYNC_READING;
+				break;
+			}
+		}
+		fs->asyncLock.Unlock();
+
+		if ( read ) {
+			fs->ReadAsync( index, read );
+		}
+	}
+	return 0;
+}
+
+/*
+=================
+idFileSystemLocal::ReadFileAsync
+=================
+*/
+asyncReadHandle_t idFileSystemLocal::ReadFileAsync( const char *relativePath, asyncReadPriority_t priority, asyncReadCallback_t callback, void *userData ) {
+	idFile *		f;
+	asyncRead_t *	read;
+	int				index;
+	int				handle;
+
+	if ( !searchPaths ) {
+		common->FatalError( "Filesystem call made without initialization\n" );
+	}
+
+	if ( !relativePath || !relativePath[0] ) {
+		common->FatalError( "idFileSystemLocal::ReadFileAsync with empty name\n" );
+	}
+
+	// opening the file walks the search paths, which only the main thread can do
+	f = OpenFileRead( relativePath );
+
+	asyncLock.Lock();
+
+	if ( asyncFree != -1 ) {
+		index = asyncFree;
+		read = asyncReads[index];
+		asyncFree = read->next;
+	} else {
+		index = asyncReads.Num();
+		if ( index >= ( 1 << ASYNC_HANDLE_INDEX_BITS ) ) {
+			common->FatalError( "idFileSystemLocal::ReadFileAsync: too many async reads" );
+		}
+		read = new asyncRead_t;
+		read->buffer = NULL;
+		read->sequence = 0;
+		asyncReads.Append( read );
+	}
+
+	read->sequence = ( read->sequence & 0x7fff ) + 1;
+	read->relativePath = relativePath;
+	read->f = f;
+	read->buffer = NULL;
+	read->callback = callback;
+	read->userData = userData;
+	read->priority = priority;
+	read->prefetch = false;
+	read->cancelled = false;
+	read->next = -1;
+	if ( f ) {
+		read->fullPath = f->GetFullPath();
+		read->length = f->Length();
+		read->timestamp = f->Timestamp();
+	} else {
+		read->length = -1;
+		read->timestamp = FILE_NOT_FOUND_TIMESTAMP;
+	}
+
+	handle = ( read->sequence << ASYNC_HANDLE_INDEX_BITS ) | index;
+
+	if ( f && numAsyncThreads > 0 ) {
+		read->status = ASYNC_QUEUED;
+		asyncQueue[priority].Append( index );
+		asyncLock.Unlock();
+		asyncWakeup.Post( 1 );
+	} else {
+		read->status = ASYNC_READING;
+		asyncLock.Unlock();
+		ReadAsync( index, read );
+	}
+
+	if ( fs_debug.GetInteger() ) {
+		common->Printf( "idFileSystem::ReadFileAsync: %s\n", relativePath );
+	}
+
+	return handle;
+}
+
+/*
+=================
+idFileSystemLocal::AsyncReadDone
+=================
+*/
+bool idFileSystemLocal::AsyncReadDone( asyncReadHandle_t handle ) {
+	asyncRead_t *read;
+	bool done;
+
+	asyncLock.Lock();
+	read = GetAsyncRead( handle );
+	done = ( read == NULL || read->status == ASYNC_DONE );
+	asyncLock.Unlock();
+
+	return done;
+}
+
+/*
+=================
+idFileSystemLocal::FinishAsyncRead
+
+Waits for the read and releases it. A read that is still queued is done
+right away by the calling thread.
+=================
+*/
+int idFileSystemLocal::FinishAsyncRead( asyncReadHandle_t handle, void **buffer, ID_TIME_T *timestamp, idStr *fullPath ) {
+	asyncRead_t *	read;
+	int				index;
+	int				len;
+	int				i;
+
+	if ( buffer ) {
+		*buffer = NULL;
+	}
+	if ( timestamp ) {
+		*timestamp = FILE_NOT_FOUND_TIMESTAMP;
+	}
+
+	index = handle & ( ( 1 << ASYNC_HANDLE_INDEX_BITS ) - 1 );
+
+	asyncLock.Lock();
+	read = GetAsyncRead( handle );
+	if ( read == NULL ) {
+		asyncLock.Unlock();
+		common->Warning( "idFileSystemLocal::WaitAsyncRead: invalid handle" );
+		return -1;
+	}
+	if ( read->status == ASYNC_QUEUED ) {
+		asyncQueue[read->priority].Remove( index );
+		read->status = ASYNC_READING;
+		asyncLock.Unlock();
+		ReadAsync( index, read );
+	} else {
+		asyncLock.Unlock();
+	}
+
+	for ( i = 0; read->status != ASYNC_DONE; i++ ) {
+		if ( i < 64 ) {
+			idSysAtomic::Pause();
+		} else {
+			idSysAtomic::YieldThread();
+		}
+	}
+
+	asyncLock.Lock();
+	len = read->length;
+	if ( timestamp ) {
+		*timestamp = read->timestamp;
+	}
+	if ( fullPath ) {
+		*fullPath = read->fullPath;
+	}
+	if ( buffer ) {
+		*buffer = read->buffer;
+		read->buffer = NULL;
+	}
+	FreeAsyncRead( index );
+	asyncLock.Unlock();
+
+	return len;
+}
+
+/*
+=================
+idFileSystemLocal::WaitAsyncRead
+=================
+*/
+int idFileSystemLocal::WaitAsyncRead( asyncReadHandle_t handle, void **buffer, ID_TIME_T *timestamp ) {
+	int len;
+
+	len = FinishAsyncRead( handle, buffer, timestamp, NULL );
+	if ( buffer && *buffer ) {
+		loadCount++;
+		loadStack++;
+	}
+	return len;
+}
+
+/*
+=================
+idFileSystemLocal::CancelAsyncRead
+=================
+*/
+void idFileSystemLocal::CancelAsyncRead( asyncReadHandle_t handle ) {
+	asyncRead_t *	read;
+	idFile *		f;
+	int				index;
+
+	index = handle & ( ( 1 << ASYNC_HANDLE_INDEX_BITS ) - 1 );
+	f = NULL;
+
+	asyncLock.Lock();
+	read = GetAsyncRead( handle );
+	if ( read != NULL ) {
+		switch( read->status ) {
+			case ASYNC_QUEUED: {
+				asyncQueue[read->priority].Remove( index );
+				f = read->f;
+				read->f = NULL;
+				FreeAsyncRead( index );
+				break;
+			}
+			case ASYNC_READING: {
+				// the reading thread releases it
+				if ( read->prefetch ) {
+					read->prefetch = false;
+					numPrefetches--;
+				}
+				read->cancelled = true;
+				break;
+			}
+			case ASYNC_DONE: {
+				FreeAsyncRead( index );
+				break;
+			}
+		}
+	}
+	asyncLock.Unlock();
+
+	delete f;
+}
+
+/*
+=================
+idFileSystemLocal::PrefetchFile
+=================
+*/
+asyncReadHandle_t idFileSystemLocal::PrefetchFile( const char *relativePath, asyncReadPriority_t priority ) {
+	asyncReadHandle_t handle;
+	asyncRead_t *read;
+
+	handle = ReadFileAsync( relativePath, priority, NULL, NULL );
+
+	asyncLock.Lock();
+	read = GetAsyncRead( handle );
+	if ( read != NULL && read->length >= 0 ) {
+		read->prefetch = true;
+		numPrefetches++;
+	}
+	asyncLock.Unlock();
+
+	return handle;
+}
+
+/*
+=================
+idFileSystemLocal::TakePrefetchedFile
+
+Returns a memory file with the data of a prefetch of the same file,
+waiting for the read if it is not done yet.
+=================
+*/
+idFile *idFileSystemLocal::TakePrefetchedFile( const char *relativePath ) {
+	asyncRead_t *	read;
+	void *			buffer;
+	ID_TIME_T		timestamp;
+	idStr			fullPath;
+	int				handle;
+	int				len;
+	int				i;
+
+	if ( numPrefetches == 0 ) {
+		return NULL;
+	}
+
+	handle = 0;
+	asyncLock.Lock();
+	for ( i = 0; i < asyncReads.Num(); i++ ) {
+		read = asyncReads[i];
+		if ( read->status != ASYNC_FREE && read->prefetch && !FilenameCompare( read->relativePath, relativePath ) ) {
+			read->prefetch = false;
+			numPrefetches--;
+			handle = ( read->sequence << ASYNC_HANDLE_INDEX_BITS ) | i;
+			break;
+		}
+	}
+	asyncLock.Unlock();
+
+	if ( handle == 0 ) {
+		return NULL;
+	}
+
+	len = FinishAsyncRead( handle, &buffer, &timestamp, &fullPath );
+	if ( len < 0 ) {
+		return NULL;
+	}
+
+	if ( fs_debug.GetInteger() ) {
+		common->Printf( "idFileSystem::OpenFileRead: %s prefetched\n", relativePath );
+	}
+
+	loadCount++;
+	return new idFile_Mapped( relativePath, fullPath, timestamp, NULL, 0, (const char *)buffer, len );
+}
+
 /*
 =================
 idFileSystemLocal::PerformingCopyFiles
@@ -118,6 +118,20 @@ typedef struct backgroundDownload_s {
 	volatile bool		completed;
 } backgroundDownload_t;
 
+typedef enum {
+	ASYNC_READ_LOW,
+	ASYNC_READ_NORMAL,
+	ASYNC_READ_HIGH,
+	ASYNC_READ_NUM_PRIORITIES
+} asyncReadPriority_t;
+
+// handle of a file read on an I/O thread, 0 is never a valid handle
+typedef int asyncReadHandle_t;
+
+// called once the whole file is in memory, from an I/O thread or from the thread waiting for a read no I/O thread
+// has started yet, length is -1 if the file could not be read
+typedef void (*asyncReadCallback_t)( const char *relativePath, void *buffer, int length, void *userData );
+
 // file list for directory listings
 class idFileList {
 	friend class idFileSystemLocal;
@@ -220,6 +234,14 @@ public:
 	virtual int				ReadFile( const char *relativePath, void **buffer, ID_TIME_T *timestamp = NULL ) = 0;
 							// Frees the memory allocated by ReadFile.
 	virtual void			FreeFile( void *buffer ) = 0;
+							// Reads a complete file without copying it where possible.
+							// Files on disk and files stored uncompressed in paks are mapped into memory,
+							// anything else is read like ReadFile.
+							// Returns the length of the file, or -1 on failure.
+							// The buffer is read-only and is not guaranteed to be 0 terminated.
+	virtual int				ReadFileMapped( const char *relativePath, const void **buffer, ID_TIME_T *timestamp = NULL ) = 0;
+							// Frees a buffer returned by ReadFileMapped.
+	virtual void			FreeFileMapped( const void *buffer ) = 0;
 							// Writes a complete file, will create any needed subdirectories.
 							// Returns the length of the file, or -1 on failure.
 	virtual int				WriteFile( const char *relativePath, const void *buffer, int size, const char *basePath = "fs_savepath" ) = 0;
@@ -227,6 +249,8 @@ public:
 	virtual void			RemoveFile( const char *relativePath ) = 0;
 							// Opens a file for reading.
 	virtual idFile *		OpenFileRead( const char *relativePath, bool allowCopyFiles = true, const char* gamedir = NULL ) = 0;
+							// Opens a file for reading as a read-only memory file, mapped where possible like ReadFileMapped.
+	virtual idFile_Mapped *	OpenFileMapped( const char *relativePath ) = 0;
 							// Opens a file for writing, will create any needed subdirectories.
 	virtual idFile *		OpenFileWrite( const char *relativePath, const char *basePath = "fs_savepath" ) = 0;
 							// Opens a file for writing at the end.
@@ -241,6 +265,20 @@ public:
 	virtual void			CloseFile( idFile *f ) = 0;
 							// Returns immediately, performing the read from a background thread.
 	virtual void			BackgroundDownload( backgroundDownload_t *bgl ) = 0;
+							// Opens the file and returns immediately, the file is read into memory by an I/O thread.
+							// Higher priority reads are started first. The callback can work on the data from the
+							// I/O thread but must not call anything that is not thread safe.
+	virtual asyncReadHandle_t	ReadFileAsync( const char *relativePath, asyncReadPriority_t priority = ASYNC_READ_NORMAL, asyncReadCallback_t callback = NULL, void *userData = NULL ) = 0;
+							// Returns true once the read is complete, WaitAsyncRead will not block after that.
+	virtual bool			AsyncReadDone( asyncReadHandle_t handle ) = 0;
+							// Waits for the read and releases the handle. Returns the length like ReadFile
+							// and the buffer has to be freed with FreeFile.
+	virtual int				WaitAsyncRead( asyncReadHandle_t handle, void **buffer, ID_TIME_T *timestamp = NULL ) = 0;
+							// Releases the handle and any data read so far.
+	virtual void			CancelAsyncRead( asyncReadHandle_t handle ) = 0;
+							// Reads the file on an I/O thread. The next OpenFileRead or ReadFile of the same path
+							// takes the data instead of going to disk. Cancel the handle if the file is not used.
+	virtual asyncReadHandle_t	PrefetchFile( const char *relativePath, asyncReadPriority_t priority = ASYNC_READ_LOW ) = 0;
 							// resets the bytes read counter
 	virtual void			ResetReadCount( void ) = 0;
 							// retrieves the current read count
@@ -0,0 +1,271 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#include "../idlib/precompiled.h"
+#pragma hdrstop
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/*
+===============================================================================
+
+	idJobSemaphore
+
+===============================================================================
+*/
+
+void idJobSemaphore::Init( void ) {
+	handle = Sys_CreateSemaphore();
+}
+
+void idJobSemaphore::Shutdown( void ) {
+	Sys_DestroySemaphore( handle );
+	handle = NULL;
+}
+
+void idJobSemaphore::Post( int count ) {
+	Sys_PostSemaphore( handle, count );
+}
+
+void idJobSemaphore::Wait( void ) {
+	Sys_WaitSemaphore( handle );
+}
+
+
+/*
+===============================================================================
+
+	idParallelJobManagerLocal
+
+===============================================================================
+*/
+
+class idParallelJobManagerLocal : public idParallelJobManager {
+public:
+							idParallelJobManagerLocal( void );
+
+	virtual void			Init( void );
+	virtual void			Shutdown( void );
+	virtual int				GetNumThreads( void ) const;
+	virtual void			ParallelFor( parallelJob_t job, void *data, int count );
+
+	static idCVar			com_parallelJobThreads;
+
+private:
+	int						numThreads;
+	xthreadInfo				threads[MAX_THREADS];
+	xthreadInfo *			threadList[MAX_THREADS];
+	int						threadCount;
+	idJobSemaphore			wakeup;
+	volatile bool			quit;
+
+	idSysSpinLock			busy;				// held by the thread issuing the current loop
+	parallelJob_t			job;
+	void *					data;
+	int						count;
+	idSysInterlockedInteger	nextIndex;			// next loop index to hand out
+	idSysInterlockedInteger	numActive;			// woken workers that have not finished the current loop
+
+	void					RunJobs( void );
+	static int				GetProcessorCount( void );
+	static unsigned int		WorkerThread( void *parm );
+};
+
+idCVar idParallelJobManagerLocal::com_parallelJobThreads( "com_parallelJobThreads", "-1", CVAR_SYSTEM | CVAR_INTEGER | CVAR_INIT, "number of parallel job worker threads, -1 = one less than the number of processors", -1, MAX_THREADS );
+
+idParallelJobManagerLocal	parallelJobManagerLocal;
+idParallelJobManager *		parallelJobManager = &parallelJobManagerLocal;
+
+/*
+================
+idParallelJobManagerLocal::idParallelJobManagerLocal
+================
+*/
+idParallelJobManagerLocal::idParallelJobManagerLocal( void ) {
+	numThreads = 0;
+	threadCount = 0;
+	quit = false;
+	job = NULL;
+	data = NULL;
+	count = 0;
+}
+
+/*
+================
+idParallelJobManagerLocal::GetProcessorCount
+================
+*/
+int idParallelJobManagerLocal::GetProcessorCount( void ) {
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo( &info );
+	return info.dwNumberOfProcessors;
+#elif defined( _SC_NPROCESSORS_ONLN )
+	return sysconf( _SC_NPROCESSORS_ONLN );
+#else
+	return 1;
+#endif
+}
+
+/*
+================
+idParallelJobManagerLocal::Init
+================
+*/
+void idParallelJobManagerLocal::Init( void ) {
+	int i;
+
+	numThreads = com_parallelJobThreads.GetInteger();
+	if ( numThreads < 0 ) {
+		numThreads = GetProcessorCount() - 1;
+	}
+	numThreads = idMath::ClampInt( 0, MAX_THREADS, numThreads );
+
+	quit = false;
+	threadCount = 0;
+	wakeup.Init();
+
+	for ( i = 0; i < numThreads; i++ ) {
+		Sys_CreateThread( (xthread_t)WorkerThread, this, THREAD_NORMAL, threads[i], "ParallelJob", threadList, &threadCount );
+	}
+
+	common->Printf( "%d parallel job threads\n", numThreads );
+}
+
+/*
+================
+idParallelJobManagerLocal::Shutdown
+================
+*/
+void idParallelJobManagerLocal::Shutdown( void ) {
+	int i;
+
+	if ( numThreads == 0 ) {
+		wakeup.Shutdown();
+		return;
+	}
+
+	busy.Lock();
+	quit = true;
+	wakeup.Post( numThreads );
+	for ( i = 0; i < numThreads; i++ ) {
+		// the workers leave on their own, Sys_DestroyThread would cancel them inside the wait
+		Sys_JoinThread( threads[i] );
+	}
+	numThreads = 0;
+	threadCount = 0;
+	busy.Unlock();
+
+	wakeup.Shutdown();
+}
+
+/*
+================
+idParallelJobManagerLocal::GetNumThreads
+================
+*/
+int idParallelJobManagerLocal::GetNumThreads( void ) const {
+	return numThreads;
+}
+
+/*
+================
+idParallelJobManagerLocal::RunJobs
+================
+*/
+void idParallelJobManagerLocal::RunJobs( void ) {
+	for ( int i = nextIndex.Increment() - 1; i < count; i = nextIndex.Increment() - 1 ) {
+		job( data, i );
+	}
+}
+
+/*
+================
+idParallelJobManagerLocal::WorkerThread
+================
+*/
+unsigned int idParallelJobManagerLocal::WorkerThread( void *parm ) {
+	idParallelJobManagerLocal *manager = static_cast<idParallelJobManagerLocal *>( parm );
+
+	while( 1 ) {
+		manager->wakeup.Wait();
+		if ( manager->quit ) {
+			break;
+		}
+		manager->RunJobs();
+		manager->numActive.Decrement();
+	}
+	return 0;
+}
+
+/*
+================
+idParallelJobManagerLocal::ParallelFor
+
+  Wakes at most one worker per loop index beyond the first and works on the
+  loop from the calling thread as well. Returns once every woken worker has
+  run out of indices, so the loop state can be reused by the next call.
+================
+*/
+void idParallelJobManagerLocal::ParallelFor( parallelJob_t job, void *data, int count ) {
+	int i, numWake;
+
+	if ( count <= 0 ) {
+		return;
+	}
+	if ( numThreads == 0 || count == 1 || !busy.TryLock() ) {
+		for ( i = 0; i < count; i++ ) {
+			job( data, i );
+		}
+		return;
+	}
+
+	this->job = job;
+	this->data = data;
+	this->count = count;
+	nextIndex.SetValue( 0 );
+
+	numWake = Min( numThreads, count - 1 );
+	numActive.SetValue( numWake );
+	wakeup.Post( numWake );
+
+	RunJobs();
+
+	for ( i = 0; numActive.GetValue() > 0; i++ ) {
+		if ( i < 64 ) {
+			idSysAtomic::Pause();
+		} else {
+			idSysAtomic::YieldThread();
+		}
+	}
+
+	busy.Unlock();
+}
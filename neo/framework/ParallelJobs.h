@@ -0,0 +1,87 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#ifndef __PARALLELJOBS_H__
+#define __PARALLELJOBS_H__
+
+/*
+===============================================================================
+
+	Parallel job manager
+
+	Runs data parallel loops on a small pool of worker threads. ParallelFor
+	calls job( data, i ) for every i in [0, count) and returns once all of
+	the calls have completed. The calling thread takes part in the work.
+
+	Only one loop runs on the pool at a time. A ParallelFor issued while the
+	pool is busy, including one issued from inside a job, runs on the calling
+	thread. Jobs should therefore be reasonably coarse and must not depend on
+	being executed concurrently.
+
+===============================================================================
+*/
+
+/*
+===============================================================================
+
+	Counting semaphore that worker threads sleep on while there is no work.
+
+===============================================================================
+*/
+
+class idJobSemaphore {
+public:
+							idJobSemaphore( void ) : handle( NULL ) {}
+
+	void					Init( void );
+	void					Shutdown( void );
+	void					Post( int count );
+	void					Wait( void );
+
+private:
+	void *					handle;				// from Sys_CreateSemaphore
+};
+
+class idParallelJobManager {
+public:
+	virtual					~idParallelJobManager( void ) {}
+
+	virtual void			Init( void ) = 0;
+	virtual void			Shutdown( void ) = 0;
+
+							// number of worker threads, not counting the calling thread
+	virtual int				GetNumThreads( void ) const = 0;
+
+							// calls job( data, i ) for i in [0, count) and waits for completion
+	virtual void			ParallelFor( parallelJob_t job, void *data, int count ) = 0;
+};
+
+extern idParallelJobManager *	parallelJobManager;
+
+#endif /* !__PARALLELJOBS_H__ */
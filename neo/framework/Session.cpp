@@ -1608,10 +1608,17 @@ void idSessionLocal::ExecuteMapChange( bool noFadeWipe ) {
 	} 
 	
 	int start = Sys_Milliseconds();
+	strAllocStats_t strStart;
+	idStr::GetAllocStats( strStart );
 
 	common->Printf( "--------- Map Initialization ---------\n" );
 	common->Printf( "Map: %s\n", mapString.c_str() );
 
+	// read the map and collision model files while the renderer parses the geometry
+	idList<asyncReadHandle_t> prefetches;
+	prefetches.Append( fileSystem->PrefetchFile( fullMapName + ".map", ASYNC_READ_HIGH ) );
+	prefetches.Append( fileSystem->PrefetchFile( fullMapName + ".cm", ASYNC_READ_NORMAL ) );
+
 	// let the renderSystem load all the geometry
 	if ( !rw->InitFromMap( fullMapName ) ) {
 		common->Error( "couldn't load %s", fullMapName.c_str() );
@@ -1653,13 +1660,19 @@ void idSessionLocal::ExecuteMapChange( bool noFadeWipe ) {
 
 	// actually purge/load the media
 	if ( !reloadingSameMap ) {
+		// the decl manager goes first so media used by decls it parses is still part of the level load
+		declManager->EndLevelLoad();
 		renderSystem->EndLevelLoad();
 		soundSystem->EndLevelLoad( mapString.c_str() );
-		declManager->EndLevelLoad();
 		SetBytesNeededForMapLoad( mapString.c_str(), fileSystem->GetReadCount() );
 	}
 	uiManager->EndLevelLoad();
 
+	// release prefetched files nothing asked for
+	for ( i = 0; i < prefetches.Num(); i++ ) {
+		fileSystem->CancelAsyncRead( prefetches[i] );
+	}
+
 	if ( !idAsyncNetwork::IsActive() && !loadingSaveGame ) {
 		// run a few frames to allow everything to settle
 		for ( i = 0; i < 10; i++ ) {
@@ -1672,6 +1685,11 @@ void idSessionLocal::ExecuteMapChange( bool noFadeWipe ) {
 	int	msec = Sys_Milliseconds() - start;
 	common->Printf( "%6d msec to load %s\n", msec, mapString.c_str() );
 
+	strAllocStats_t strEnd;
+	idStr::GetAllocStats( strEnd );
+	common->DPrintf( "%6d string allocations (%d KB), %d moves\n", strEnd.numAllocs - strStart.numAllocs,
+						(int)( ( strEnd.totalSize - strStart.totalSize ) >> 10 ), strEnd.numMoves - strStart.numMoves );
+
 	// let the renderSystem generate interactions now that everything is spawned
 	rw->GenerateAllInteractions();
 
@@ -0,0 +1,405 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#include "../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "ZipCache.h"
+
+idCVar idZipBlockCache::fs_zipCacheSize( "fs_zipCacheSize", "16", CVAR_SYSTEM | CVAR_INTEGER, "megabytes of inflated pak data to cache, 0 = read deflated files directly", 0, 512 );
+idCVar idZipBlockCache::fs_zipReadAhead( "fs_zipReadAhead", "4", CVAR_SYSTEM | CVAR_INTEGER, "number of blocks to inflate ahead of the read position", 0, 64 );
+idCVar idZipBlockCache::fs_zipThreads( "fs_zipThreads", "1", CVAR_SYSTEM | CVAR_INTEGER | CVAR_INIT, "number of threads inflating pak files ahead of use", 0, 4 );
+
+idZipBlockCache				zipBlockCache;
+
+/*
+================
+idZipBlockCache::idZipBlockCache
+================
+*/
+idZipBlockCache::idZipBlockCache( void ) {
+	freeBlock = -1;
+	lruHead = -1;
+	lruTail = -1;
+	cacheSize = 0;
+	numHits = 0;
+	numMisses = 0;
+	numEvicted = 0;
+	bytesInflated = 0;
+	bytesInflatedAhead = 0;
+	numThreads = 0;
+	threadCount = 0;
+	quit = false;
+}
+
+/*
+================
+idZipBlockCache::Init
+================
+*/
+void idZipBlockCache::Init( void ) {
+	int i;
+
+	quit = false;
+	threadCount = 0;
+	wakeup.Init();
+
+	numThreads = idMath::ClampInt( 0, MAX_THREADS, fs_zipThreads.GetInteger() );
+	for ( i = 0; i < numThreads; i++ ) {
+		Sys_CreateThread( (xthread_t)WorkerThread, this, THREAD_NORMAL, threads[i], "ZipInflate", threadList, &threadCount );
+	}
+}
+
+/*
+================
+idZipBlockCache::Shutdown
+================
+*/
+void idZipBlockCache::Shutdown( void ) {
+	int i;
+
+	quit = true;
+	wakeup.Post( numThreads );
+	for ( i = 0; i < numThreads; i++ ) {
+		Sys_JoinThread( threads[i] );
+	}
+	numThreads = 0;
+	threadCount = 0;
+
+	// files still waiting for a worker must not wait on close
+	queueLock.Lock();
+	for ( i = 0; i < queue.Num(); i++ ) {
+		queue[i]->readAhead.Decrement();
+	}
+	queue.Clear();
+	queueLock.Unlock();
+
+	wakeup.Shutdown();
+
+	Clear();
+	entries.Clear();
+	entryHash.Free();
+}
+
+/*
+================
+idZipBlockCache::Clear
+================
+*/
+void idZipBlockCache::Clear( void ) {
+	int i;
+
+	idScopedSpinLock scopedLock( lock );
+
+	for ( i = 0; i < blocks.Num(); i++ ) {
+		Mem_Free( blocks[i].data );
+	}
+	blocks.Clear();
+	blockHash.Free();
+	freeBlock = -1;
+	lruHead = -1;
+	lruTail = -1;
+	cacheSize = 0;
+}
+
+/*
+================
+idZipBlockCache::IsEnabled
+================
+*/
+bool idZipBlockCache::IsEnabled( void ) const {
+	return ( fs_zipCacheSize.GetInteger() > 0 );
+}
+
+/*
+================
+idZipBlockCache::GetReadAheadBlocks
+================
+*/
+int idZipBlockCache::GetReadAheadBlocks( void ) const {
+	return fs_zipReadAhead.GetInteger();
+}
+
+/*
+================
+idZipBlockCache::FindEntry
+================
+*/
+int idZipBlockCache::FindEntry( const char *pakFilename, int zipFilePos ) {
+	int i, key;
+
+	idScopedSpinLock scopedLock( lock );
+
+	key = entryHash.GenerateKey( pakFilename, false ) ^ zipFilePos;
+	for ( i = entryHash.First( key ); i != -1; i = entryHash.Next( i ) ) {
+		if ( entries[i].zipFilePos == zipFilePos && !entries[i].pakFilename.Icmp( pakFilename ) ) {
+			return i;
+		}
+	}
+
+	i = entries.Num();
+	zipCacheEntry_t &entry = entries.Alloc();
+	entry.pakFilename = pakFilename;
+	entry.zipFilePos = zipFilePos;
+	entryHash.Add( key, i );
+
+	return i;
+}
+
+/*
+================
+idZipBlockCache::FindBlock
+================
+*/
+int idZipBlockCache::FindBlock( int entry, int block ) const {
+	int i;
+
+	for ( i = blockHash.First( blockHash.GenerateKey( entry, block ) ); i != -1; i = blockHash.Next( i ) ) {
+		if ( blocks[i].entry == entry && blocks[i].block == block ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idZipBlockCache::LinkBlock
+
+  Makes the block the most recently used one.
+================
+*/
+void idZipBlockCache::LinkBlock( int index ) {
+	blocks[index].prev = -1;
+	blocks[index].next = lruHead;
+	if ( lruHead != -1 ) {
+		blocks[lruHead].prev = index;
+	} else {
+		lruTail = index;
+	}
+	lruHead = index;
+}
+
+/*
+================
+idZipBlockCache::UnlinkBlock
+================
+*/
+void idZipBlockCache::UnlinkBlock( int index ) {
+	zipCacheBlock_t &b = blocks[index];
+
+	if ( b.prev != -1 ) {
+		blocks[b.prev].next = b.next;
+	} else {
+		lruHead = b.next;
+	}
+	if ( b.next != -1 ) {
+		blocks[b.next].prev = b.prev;
+	} else {
+		lruTail = b.prev;
+	}
+}
+
+/*
+================
+idZipBlockCache::FreeBlock
+================
+*/
+void idZipBlockCache::FreeBlock( int index ) {
+	zipCacheBlock_t &b = blocks[index];
+
+	UnlinkBlock( index );
+	blockHash.Remove( blockHash.GenerateKey( b.entry, b.block ), index );
+	Mem_Free( b.data );
+	cacheSize -= b.length;
+	b.data = NULL;
+	b.entry = -1;
+	b.next = freeBlock;
+	freeBlock = index;
+}
+
+/*
+================
+idZipBlockCache::CopyBlock
+================
+*/
+int idZipBlockCache::CopyBlock( int entry, int block, int offset, void *dest, int len ) {
+	int i;
+
+	idScopedSpinLock scopedLock( lock );
+
+	i = FindBlock( entry, block );
+	if ( i == -1 ) {
+		numMisses++;
+		return -1;
+	}
+	numHits++;
+
+	if ( i != lruHead ) {
+		UnlinkBlock( i );
+		LinkBlock( i );
+	}
+
+	len = Min( len, blocks[i].length - offset );
+	if ( len <= 0 ) {
+		return 0;
+	}
+	memcpy( dest, blocks[i].data + offset, len );
+	return len;
+}
+
+/*
+================
+idZipBlockCache::HasBlock
+================
+*/
+bool idZipBlockCache::HasBlock( int entry, int block ) {
+	idScopedSpinLock scopedLock( lock );
+
+	return ( FindBlock( entry, block ) != -1 );
+}
+
+/*
+================
+idZipBlockCache::AddBlock
+================
+*/
+void idZipBlockCache::AddBlock( int entry, int block, byte *data, int length, bool readAhead ) {
+	int i, maxSize;
+
+	idScopedSpinLock scopedLock( lock );
+
+	bytesInflated += length;
+	if ( readAhead ) {
+		bytesInflatedAhead += length;
+	}
+
+	// another reader of the same file may have inflated the block already
+	if ( FindBlock( entry, block ) != -1 ) {
+		Mem_Free( data );
+		return;
+	}
+
+	maxSize = Max( fs_zipCacheSize.GetInteger() << 20, 2 * ZIP_BLOCK_SIZE );
+	while ( lruTail != -1 && cacheSize + length > maxSize ) {
+		FreeBlock( lruTail );
+		numEvicted++;
+	}
+
+	if ( freeBlock != -1 ) {
+		i = freeBlock;
+		freeBlock = blocks[i].next;
+	} else {
+		i = blocks.Num();
+		blocks.Alloc();
+	}
+
+	zipCacheBlock_t &b = blocks[i];
+	b.entry = entry;
+	b.block = block;
+	b.length = length;
+	b.data = data;
+	blockHash.Add( blockHash.GenerateKey( entry, block ), i );
+	LinkBlock( i );
+	cacheSize += length;
+}
+
+/*
+================
+idZipBlockCache::ReadAhead
+================
+*/
+void idZipBlockCache::ReadAhead( idFile_InZip *file ) {
+	if ( numThreads == 0 || fs_zipReadAhead.GetInteger() <= 0 ) {
+		return;
+	}
+	// only one pending job per file
+	if ( file->readAhead.CompareExchange( 0, 1 ) != 0 ) {
+		return;
+	}
+	queueLock.Lock();
+	queue.Append( file );
+	queueLock.Unlock();
+	wakeup.Post( 1 );
+}
+
+/*
+================
+idZipBlockCache::WorkerThread
+================
+*/
+unsigned int idZipBlockCache::WorkerThread( void *parm ) {
+	idZipBlockCache *cache = static_cast<idZipBlockCache *>( parm );
+	idFile_InZip *file;
+
+	while( 1 ) {
+		cache->wakeup.Wait();
+		if ( cache->quit ) {
+			break;
+		}
+
+		cache->queueLock.Lock();
+		if ( cache->queue.Num() ) {
+			file = cache->queue[0];
+			cache->queue.RemoveIndex( 0 );
+		} else {
+			file = NULL;
+		}
+		cache->queueLock.Unlock();
+
+		if ( file ) {
+			file->InflateAhead();
+			file->readAhead.Decrement();
+		}
+	}
+	return 0;
+}
+
+/*
+================
+idZipBlockCache::PrintStats
+================
+*/
+void idZipBlockCache::PrintStats( void ) const {
+	int lookups = numHits + numMisses;
+
+	common->Printf( "%d blocks, %d kB cached of %d kB\n", blocks.Num(), cacheSize >> 10, fs_zipCacheSize.GetInteger() << 10 );
+	common->Printf( "%d hits, %d misses, %.1f%% hit ratio\n", numHits, numMisses, lookups ? numHits * 100.0f / lookups : 0.0f );
+	common->Printf( "%d blocks evicted\n", numEvicted );
+	common->Printf( "%d kB inflated, %d kB ahead of use by %d threads\n", (int)( bytesInflated >> 10 ), (int)( bytesInflatedAhead >> 10 ), numThreads );
+}
+
+/*
+================
+idZipBlockCache::ZipCacheStats_f
+================
+*/
+void idZipBlockCache::ZipCacheStats_f( const idCmdArgs &args ) {
+	zipBlockCache.PrintStats();
+}
@@ -0,0 +1,138 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#ifndef __ZIPCACHE_H__
+#define __ZIPCACHE_H__
+
+/*
+===============================================================================
+
+	Decompressed pk4 block cache
+
+	Deflated files in paks are inflated in blocks of ZIP_BLOCK_SIZE bytes that
+	are kept in a least recently used cache shared by all open files. Cached
+	blocks also serve as seek points, so seeking back into a file only
+	restarts inflation when the blocks in between were evicted.
+
+	A small pool of worker threads inflates the blocks following the read
+	position of files that are read piece by piece, while the reader works
+	on the data it already has.
+
+===============================================================================
+*/
+
+#define ZIP_BLOCK_SHIFT			16
+#define ZIP_BLOCK_SIZE			( 1 << ZIP_BLOCK_SHIFT )
+
+class idFile_InZip;
+
+class idZipBlockCache {
+public:
+							idZipBlockCache( void );
+
+	void					Init( void );
+	void					Shutdown( void );
+							// frees all cached blocks
+	void					Clear( void );
+							// returns true if deflated files should be read through the cache
+	bool					IsEnabled( void ) const;
+
+							// returns the cache handle for a file in a pak
+	int						FindEntry( const char *pakFilename, int zipFilePos );
+							// copies up to len bytes of a cached block starting at offset
+							// returns the number of bytes copied or -1 if the block is not cached
+	int						CopyBlock( int entry, int block, int offset, void *dest, int len );
+							// returns true if the block is cached without touching the statistics
+	bool					HasBlock( int entry, int block );
+							// adds a block allocated with Mem_Alloc, the cache takes ownership of the data
+	void					AddBlock( int entry, int block, byte *data, int length, bool readAhead );
+
+							// queues the file for inflating ahead of its read position
+	void					ReadAhead( idFile_InZip *file );
+							// number of blocks inflated ahead of the read position
+	int						GetReadAheadBlocks( void ) const;
+
+	void					PrintStats( void ) const;
+
+	static void				ZipCacheStats_f( const idCmdArgs &args );
+
+private:
+	typedef struct {
+		idStr				pakFilename;
+		int					zipFilePos;
+	} zipCacheEntry_t;
+
+	typedef struct {
+		int					entry;
+		int					block;
+		int					length;
+		byte *				data;
+		int					prev;				// more recently used block
+		int					next;				// less recently used block, or next free block
+	} zipCacheBlock_t;
+
+	idSysSpinLock			lock;				// guards everything below but the worker state
+	idList<zipCacheEntry_t>	entries;
+	idHashIndex				entryHash;
+	idList<zipCacheBlock_t>	blocks;
+	idHashIndex				blockHash;
+	int						freeBlock;
+	int						lruHead;
+	int						lruTail;
+	int						cacheSize;			// bytes of block data in the cache
+
+	int						numHits;
+	int						numMisses;
+	int						numEvicted;
+	qword					bytesInflated;
+	qword					bytesInflatedAhead;
+
+	int						numThreads;
+	xthreadInfo				threads[MAX_THREADS];
+	xthreadInfo *			threadList[MAX_THREADS];
+	int						threadCount;
+	idJobSemaphore			wakeup;
+	volatile bool			quit;
+	idSysSpinLock			queueLock;
+	idList<idFile_InZip *>	queue;
+
+	static idCVar			fs_zipCacheSize;
+	static idCVar			fs_zipReadAhead;
+	static idCVar			fs_zipThreads;
+
+	int						FindBlock( int entry, int block ) const;
+	void					LinkBlock( int index );
+	void					UnlinkBlock( int index );
+	void					FreeBlock( int index );
+	static unsigned int		WorkerThread( void *parm );
+};
+
+extern idZipBlockCache		zipBlockCache;
+
+#endif /* !__ZIPCACHE_H__ */
@@ -186,7 +186,7 @@ public:
 
 	virtual void			ShowEditingDialog( void );
 
-	static void				DropAFs( idEntity *ent, const char *type, idList<idEntity *> *list );
+	static void				DropAFs( idEntity *ent, const char *type, idList<idEntity *, idListFrameAllocator> *list );
 
 protected:
 	idAF					af;				// articulated figure
@@ -46,6 +46,7 @@ idUserInterfaceManager *	uiManager = NULL;
 idDeclManager *				declManager = NULL;
 idAASFileManager *			AASFileManager = NULL;
 idCollisionModelManager *	collisionModelManager = NULL;
+idParallelJobManager *		parallelJobManager = NULL;
 idCVar *					idCVar::staticVars = NULL;
 
 idCVar com_forceGenericSIMD( "com_forceGenericSIMD", "0", CVAR_BOOL|CVAR_SYSTEM, "force generic platform independent SIMD" );
@@ -101,6 +102,7 @@ extern "C" gameExport_t *GetGameAPI( gameImport_t *import ) {
 		declManager					= import->declManager;
 		AASFileManager				= import->AASFileManager;
 		collisionModelManager		= import->collisionModelManager;
+		parallelJobManager			= import->parallelJobManager;
 	}
 
 	// set interface pointers used by idLib
@@ -108,6 +110,7 @@ extern "C" gameExport_t *GetGameAPI( gameImport_t *import ) {
 	idLib::common				= common;
 	idLib::cvarSystem			= cvarSystem;
 	idLib::fileSystem			= fileSystem;
+	idLib::parallelJobManager	= parallelJobManager;
 
 	// setup export interface
 	gameExport.version = GAME_API_VERSION;
@@ -142,6 +145,7 @@ void TestGameAPI( void ) {
 	testImport.declManager				= ::declManager;
 	testImport.AASFileManager			= ::AASFileManager;
 	testImport.collisionModelManager	= ::collisionModelManager;
+	testImport.parallelJobManager		= ::parallelJobManager;
 
 	testExport = *GetGameAPI( &testImport );
 }
@@ -2354,6 +2358,9 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 	RunDebugInfo();
 	D_DrawDebugLines();
 
+	// release the temporary memory of the previous frame
+	ToggleFrameAllocator();
+
 	return ret;
 }
 
@@ -2636,6 +2643,19 @@ void idGameLocal::ShowTargets( void ) {
 	}
 }
 
+/*
+================
+idGameLocal::ToggleFrameAllocator
+================
+*/
+void idGameLocal::ToggleFrameAllocator( void ) {
+	if ( g_frameAllocStats.GetBool() ) {
+		Printf( "game %d: frame alloc %d, %dkB  highwater %dkB  blocks %dkB\n", time, frameAllocator.GetFrameAllocs(),
+				frameAllocator.GetFrameBytes() >> 10, frameAllocator.GetHighwater() >> 10, frameAllocator.GetBlockMemory() >> 10 );
+	}
+	frameAllocator.ToggleFrame();
+}
+
 /*
 ================
 idGameLocal::RunDebugInfo
@@ -3000,6 +3020,16 @@ idEntity *idGameLocal::SpawnEntityType( const idTypeInfo &classdef, const idDict
 	return static_cast<idEntity *>(obj);
 }
 
+// spawn args read for every entity, looked up with precomputed keys
+static const idDictKey	KEY_NAME( "name" );
+static const idDictKey	KEY_CLASSNAME( "classname" );
+static const idDictKey	KEY_SPAWNCLASS( "spawnclass" );
+static const idDictKey	KEY_SPAWNFUNC( "spawnfunc" );
+static const idDictKey	KEY_NOT_MULTIPLAYER( "not_multiplayer" );
+static const idDictKey	KEY_NOT_EASY( "not_easy" );
+static const idDictKey	KEY_NOT_MEDIUM( "not_medium" );
+static const idDictKey	KEY_NOT_HARD( "not_hard" );
+
 /*
 ===================
 idGameLocal::SpawnEntityDef
@@ -3022,11 +3052,11 @@ bool idGameLocal::SpawnEntityDef( const idDict &args, idEntity **ent, bool setDe
 
 	spawnArgs = args;
 
-	if ( spawnArgs.GetString( "name", "", &name ) ) {
+	if ( spawnArgs.GetString( KEY_NAME, "", &name ) ) {
 		sprintf( error, " on '%s'", name);
 	}
 
-	spawnArgs.GetString( "classname", NULL, &classname );
+	spawnArgs.GetString( KEY_CLASSNAME, NULL, &classname );
 
 	const idDeclEntityDef *def = FindEntityDef( classname, false );
 
@@ -3038,7 +3068,7 @@ bool idGameLocal::SpawnEntityDef( const idDict &args, idEntity **ent, bool setDe
 	spawnArgs.SetDefaults( &def->dict );
 
 	// check if we should spawn a class object
-	spawnArgs.GetString( "spawnclass", NULL, &spawn );
+	spawnArgs.GetString( KEY_SPAWNCLASS, NULL, &spawn );
 	if ( spawn ) {
 
 		cls = idClass::GetClass( spawn );
@@ -3063,7 +3093,7 @@ bool idGameLocal::SpawnEntityDef( const idDict &args, idEntity **ent, bool setDe
 	}
 
 	// check if we should call a script function to spawn
-	spawnArgs.GetString( "spawnfunc", NULL, &spawn );
+	spawnArgs.GetString( KEY_SPAWNFUNC, NULL, &spawn );
 	if ( spawn ) {
 		const function_t *func = program.FindFunction( spawn );
 		if ( !func ) {
@@ -3115,19 +3145,19 @@ bool idGameLocal::InhibitEntitySpawn( idDict &spawnArgs ) {
 	bool result = false;
 
 	if ( isMultiplayer ) {
-		spawnArgs.GetBool( "not_multiplayer", "0", result );
+		spawnArgs.GetBool( KEY_NOT_MULTIPLAYER, "0", result );
 	} else if ( g_skill.GetInteger() == 0 ) {
-		spawnArgs.GetBool( "not_easy", "0", result );
+		spawnArgs.GetBool( KEY_NOT_EASY, "0", result );
 	} else if ( g_skill.GetInteger() == 1 ) {
-		spawnArgs.GetBool( "not_medium", "0", result );
+		spawnArgs.GetBool( KEY_NOT_MEDIUM, "0", result );
 	} else {
-		spawnArgs.GetBool( "not_hard", "0", result );
+		spawnArgs.GetBool( KEY_NOT_HARD, "0", result );
 	}
 
 	const char *name;
 #ifndef ID_DEMO_BUILD
 	if ( g_skill.GetInteger() == 3 ) { 
-		name = spawnArgs.GetString( "classname" );
+		name = spawnArgs.GetString( KEY_CLASSNAME );
 		if ( idStr::Icmp( name, "item_medkit" ) == 0 || idStr::Icmp( name, "item_medkit_small" ) == 0 ) {
 			result = true;
 		}
@@ -3135,7 +3165,7 @@ bool idGameLocal::InhibitEntitySpawn( idDict &spawnArgs ) {
 #endif
 
 	if ( gameLocal.isMultiplayer ) {
-		name = spawnArgs.GetString( "classname" );
+		name = spawnArgs.GetString( KEY_CLASSNAME );
 		if ( idStr::Icmp( name, "weapon_bfg" ) == 0 || idStr::Icmp( name, "weapon_soulcube" ) == 0 ) {
 			result = true;
 		}
@@ -535,6 +535,7 @@ private:
 	void					SortActiveEntityList( void );
 	void					ShowTargets( void );
 	void					RunDebugInfo( void );
+	void					ToggleFrameAllocator( void );
 
 	void					InitScriptForMap( void );
 
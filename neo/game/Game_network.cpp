@@ -1514,6 +1514,9 @@ gameReturn_t idGameLocal::ClientPrediction( int clientNum, const usercmd_t *clie
 		D_DrawDebugLines();
 	}
 
+	// release the temporary memory of the previous frame
+	ToggleFrameAllocator();
+
 	if ( sessionCommand.Length() ) {
 		strncpy( ret.sessionCommand, sessionCommand, sizeof( ret.sessionCommand ) );
 	}
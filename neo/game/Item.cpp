@@ -1065,7 +1065,7 @@ idMoveableItem::DropItems
   where <X> is an aribtrary string.
 ================
 */
-void idMoveableItem::DropItems( idAnimatedEntity  *ent, const char *type, idList<idEntity *> *list ) {
+void idMoveableItem::DropItems( idAnimatedEntity  *ent, const char *type, idList<idEntity *, idListFrameAllocator> *list ) {
 	const idKeyValue *kv;
 	const char *skinName, *c, *jointName;
 	idStr key, key2;
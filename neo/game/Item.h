@@ -161,7 +161,7 @@ public:
 	virtual void			Think( void );
 	virtual bool			Pickup( idPlayer *player );
 
-	static void				DropItems( idAnimatedEntity *ent, const char *type, idList<idEntity *> *list );
+	static void				DropItems( idAnimatedEntity *ent, const char *type, idList<idEntity *, idListFrameAllocator> *list );
 	static idEntity	*		DropItem( const char *classname, const idVec3 &origin, const idMat3 &axis, const idVec3 &velocity, int activateDelay, int removeDelay );
 
 	virtual void			WriteToSnapshot( idBitMsgDelta &msg ) const;
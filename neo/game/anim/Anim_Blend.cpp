@@ -1731,6 +1731,8 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
 	idJointQuat		*mixFrame;
 	int				numAnims;
 	int				time;
+	idJointQuatSoA	mixSoA;
+	idJointQuatSoA	ptrSoA;
 
 	const idAnim *anim = Anim();
 	if ( !anim ) {
@@ -1776,6 +1778,11 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
 		// allocate a temporary buffer to copy the joints to
 		mixFrame = ( idJointQuat * )_alloca16( numJoints * sizeof( *jointFrame ) );
 
+		if ( channel == ANIMCHANNEL_ALL ) {
+			mixSoA.SetData( numJoints, JOINTQUATSOA_ALLOCA( numJoints ) );
+			ptrSoA.SetData( numJoints, JOINTQUATSOA_ALLOCA( numJoints ) );
+		}
+
 		if ( !frame ) {
 			anim->MD5Anim( 0 )->ConvertTimeToFrame( time, cycle, frametime );
 		}
@@ -1793,8 +1800,16 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
 					md5anim->GetInterpolatedFrame( frametime, ptr, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
 				}
 
-				// only blend after the first anim is mixed in
-				if ( ptr != jointFrame ) {
+				if ( channel == ANIMCHANNEL_ALL ) {
+					// all joints are mixed, so blend in SoA layout without the joint index
+					if ( ptr == jointFrame ) {
+						SIMDProcessor->ConvertJointQuatsToSoA( mixSoA, jointFrame, numJoints );
+					} else {
+						SIMDProcessor->ConvertJointQuatsToSoA( ptrSoA, ptr, numJoints );
+						SIMDProcessor->BlendJointsSoA( mixSoA, ptrSoA, lerp, numJoints );
+					}
+				} else if ( ptr != jointFrame ) {
+					// only blend after the first anim is mixed in
 					SIMDProcessor->BlendJoints( jointFrame, ptr, lerp, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
 				}
 
@@ -1805,6 +1820,10 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
 		if ( !mixWeight ) {
 			return false;
 		}
+
+		if ( channel == ANIMCHANNEL_ALL ) {
+			SIMDProcessor->ConvertSoAToJointQuats( jointFrame, mixSoA, numJoints );
+		}
 	}
 
 	if ( removeOriginOffset ) {
@@ -82,6 +82,7 @@ extern idCVar	g_showActiveEntities;
 extern idCVar	g_showEnemies;
 
 extern idCVar	g_frametime;
+extern idCVar	g_frameAllocStats;
 extern idCVar	g_timeentities;
 
 extern idCVar	ai_debugScript;
@@ -105,11 +105,14 @@ byte *idBitMsg::GetByteSpace( int length ) {
 idBitMsg::WriteBits
 
   If the number of bits is negative a sign is included.
+  The bits are assembled in a 64 bit word and stored with one write per
+  touched byte instead of looping over partial bytes.
 ================
 */
 void idBitMsg::WriteBits( int value, int numBits ) {
-	int		put;
-	int		fraction;
+	int		i, start, totalBits, numBytes;
+	qword	bits;
+	byte *	ptr;
 
 	if ( !writeData ) {
 		idLib::common->Error( "idBitMsg::WriteBits: cannot write to message" );
@@ -148,22 +151,22 @@ void idBitMsg::WriteBits( int value, int numBits ) {
 		return;
 	}
 
-	// write the bits
-	while( numBits ) {
-		if ( writeBit == 0 ) {
-			writeData[curSize] = 0;
-			curSize++;
-		}
-		put = 8 - writeBit;
-		if ( put > numBits ) {
-			put = numBits;
-		}
-		fraction = value & ( ( 1 << put ) - 1 );
-		writeData[curSize - 1] |= fraction << writeBit;
-		numBits -= put;
-		value >>= put;
-		writeBit = ( writeBit + put ) & 7;
+	// the first byte is only partially written when the write bit is not zero
+	start = writeBit ? curSize - 1 : curSize;
+	totalBits = writeBit + numBits;
+	numBytes = ( totalBits + 7 ) >> 3;
+	ptr = writeData + start;
+
+	bits = ( (qword)(dword)value & ( ( (qword)1 << numBits ) - 1 ) ) << writeBit;
+	if ( writeBit ) {
+		bits |= ptr[0];
+	}
+	for ( i = 0; i < numBytes; i++ ) {
+		ptr[i] = (byte)( bits >> ( i << 3 ) );
 	}
+
+	curSize = start + numBytes;
+	writeBit = totalBits & 7;
 }
 
 /*
@@ -357,13 +360,13 @@ bool idBitMsg::WriteDeltaDict( const idDict &dict, const idDict *base ) {
 idBitMsg::ReadBits
 
   If the number of bits is negative a sign is included.
+  All touched bytes are gathered into a 64 bit word and the value is
+  extracted with a single shift and mask.
 ================
 */
 int idBitMsg::ReadBits( int numBits ) const {
-	int		value;
-	int		valueBits;
-	int		get;
-	int		fraction;
+	int		i, value, start, totalBits, numBytes;
+	qword	bits;
 	bool	sgn;
 
 	if ( !readData ) {
@@ -375,9 +378,6 @@ int idBitMsg::ReadBits( int numBits ) const {
 		idLib::common->FatalError( "idBitMsg::ReadBits: bad numBits %i", numBits );
 	}
 
-	value = 0;
-	valueBits = 0;
-
 	if ( numBits < 0 ) {
 		numBits = -numBits;
 		sgn = true;
@@ -390,22 +390,19 @@ int idBitMsg::ReadBits( int numBits ) const {
 		return -1;
 	}
 
-	while ( valueBits < numBits ) {
-		if ( readBit == 0 ) {
-			readCount++;
-		}
-		get = 8 - readBit;
-		if ( get > (numBits - valueBits) ) {
-			get = numBits - valueBits;
-		}
-		fraction = readData[readCount - 1];
-		fraction >>= readBit;
-		fraction &= ( 1 << get ) - 1;
-		value |= fraction << valueBits;
+	// the first byte is partially read already when the read bit is not zero
+	start = readBit ? readCount - 1 : readCount;
+	totalBits = readBit + numBits;
+	numBytes = ( totalBits + 7 ) >> 3;
 
-		valueBits += get;
-		readBit = ( readBit + get ) & 7;
+	bits = 0;
+	for ( i = 0; i < numBytes; i++ ) {
+		bits |= (qword)readData[start + i] << ( i << 3 );
 	}
+	value = (int)(dword)( ( bits >> readBit ) & ( ( (qword)1 << numBits ) - 1 ) );
+
+	readCount = start + numBytes;
+	readBit = totalBits & 7;
 
 	if ( sgn ) {
 		if ( value & ( 1 << ( numBits - 1 ) ) ) {
@@ -426,9 +423,10 @@ int idBitMsg::ReadString( char *buffer, int bufferSize ) const {
 	
 	ReadByteAlign();
 	l = 0;
-	while( 1 ) {
-		c = ReadByte();
-		if ( c <= 0 || c >= 255 ) {
+	// byte aligned so the characters can be taken straight from the buffer
+	while( readCount < curSize ) {
+		c = readData[readCount++];
+		if ( c == 0 || c == 255 ) {
 			break;
 		}
 		// translate all fmt spec to avoid crash bugs in string routines
@@ -1065,3 +1063,174 @@ int idBitMsgDelta::ReadDeltaLongCounter( int oldValue ) const {
 	}
 	return value;
 }
+
+//===============================================================
+//
+//	BitMsg_Bench_f
+//
+//===============================================================
+
+#define BITMSG_BENCH_MOMENTUM_EXPONENT_BITS		5
+#define BITMSG_BENCH_MOMENTUM_MANTISSA_BITS		10
+#define BITMSG_BENCH_FORCE_EXPONENT_BITS		6
+#define BITMSG_BENCH_FORCE_MANTISSA_BITS		9
+
+typedef struct {
+	int			entityNum;
+	int			spawnId;
+	int			atRest;
+	idVec3		origin;
+	idVec3		quat;
+	idVec3		momentum;
+	idVec3		localOrigin;
+	idVec3		force;
+	int			health;
+	int			frame;
+	int			eventSequence;
+	int			team;
+} bitMsgBenchEntity_t;
+
+/*
+================
+BitMsg_BenchWriteEntity
+
+  Mirrors the mix of fields written for a rigid body entity in a snapshot.
+================
+*/
+static void BitMsg_BenchWriteEntity( idBitMsg &msg, const bitMsgBenchEntity_t &ent, const bitMsgBenchEntity_t &base ) {
+	int i;
+
+	msg.WriteBits( ent.entityNum, 12 );
+	msg.WriteBits( ent.spawnId, 32 - 12 );
+	msg.WriteLong( ent.atRest );
+	for ( i = 0; i < 3; i++ ) {
+		msg.WriteFloat( ent.origin[i] );
+	}
+	for ( i = 0; i < 3; i++ ) {
+		msg.WriteFloat( ent.quat[i] );
+	}
+	for ( i = 0; i < 3; i++ ) {
+		msg.WriteFloat( ent.momentum[i], BITMSG_BENCH_MOMENTUM_EXPONENT_BITS, BITMSG_BENCH_MOMENTUM_MANTISSA_BITS );
+	}
+	for ( i = 0; i < 3; i++ ) {
+		msg.WriteDeltaFloat( ent.origin[i], ent.localOrigin[i] );
+	}
+	for ( i = 0; i < 3; i++ ) {
+		msg.WriteDeltaFloat( 0.0f, ent.force[i], BITMSG_BENCH_FORCE_EXPONENT_BITS, BITMSG_BENCH_FORCE_MANTISSA_BITS );
+	}
+	msg.WriteDeltaShort( base.health, ent.health );
+	msg.WriteDeltaByte( base.frame, ent.frame );
+	msg.WriteDeltaByteCounter( base.eventSequence, ent.eventSequence );
+	msg.WriteBits( ent.team, 2 );
+	msg.WriteBits( ent.atRest != 0, 1 );
+}
+
+/*
+================
+BitMsg_BenchReadEntity
+================
+*/
+static void BitMsg_BenchReadEntity( const idBitMsg &msg, bitMsgBenchEntity_t &ent, const bitMsgBenchEntity_t &base ) {
+	int i;
+
+	ent.entityNum = msg.ReadBits( 12 );
+	ent.spawnId = msg.ReadBits( 32 - 12 );
+	ent.atRest = msg.ReadLong();
+	for ( i = 0; i < 3; i++ ) {
+		ent.origin[i] = msg.ReadFloat();
+	}
+	for ( i = 0; i < 3; i++ ) {
+		ent.quat[i] = msg.ReadFloat();
+	}
+	for ( i = 0; i < 3; i++ ) {
+		ent.momentum[i] = msg.ReadFloat( BITMSG_BENCH_MOMENTUM_EXPONENT_BITS, BITMSG_BENCH_MOMENTUM_MANTISSA_BITS );
+	}
+	for ( i = 0; i < 3; i++ ) {
+		ent.localOrigin[i] = msg.ReadDeltaFloat( ent.origin[i] );
+	}
+	for ( i = 0; i < 3; i++ ) {
+		ent.force[i] = msg.ReadDeltaFloat( 0.0f, BITMSG_BENCH_FORCE_EXPONENT_BITS, BITMSG_BENCH_FORCE_MANTISSA_BITS );
+	}
+	ent.health = msg.ReadDeltaShort( base.health );
+	ent.frame = msg.ReadDeltaByte( base.frame );
+	ent.eventSequence = msg.ReadDeltaByteCounter( base.eventSequence );
+	ent.team = msg.ReadBits( 2 );
+	msg.ReadBits( 1 );
+}
+
+/*
+================
+BitMsg_Bench_f
+
+  benchBitMsg [numEntities]
+================
+*/
+void BitMsg_Bench_f( const idCmdArgs &args ) {
+	const int numSnapshots = 256;
+	int i, j, numEntities, numErrors;
+	idRandom random( 0x5EED );
+	idTimer writeTimer, readTimer;
+	idBitMsg msg;
+	bitMsgBenchEntity_t base, decoded;
+	char name[64];
+
+	numEntities = 256;
+	if ( args.Argc() > 1 ) {
+		numEntities = idMath::ClampInt( 1, 4096, atoi( args.Argv( 1 ) ) );
+	}
+
+	bitMsgBenchEntity_t *entities = new bitMsgBenchEntity_t[numEntities];
+	for ( i = 0; i < numEntities; i++ ) {
+		bitMsgBenchEntity_t &ent = entities[i];
+		ent.entityNum = i;
+		ent.spawnId = random.RandomInt( 1 << 20 );
+		ent.atRest = random.RandomInt( 4 ) ? -1 : random.RandomInt( 100000 );
+		for ( j = 0; j < 3; j++ ) {
+			ent.origin[j] = random.CRandomFloat() * 4096.0f;
+			ent.quat[j] = random.CRandomFloat() * 0.5f;
+			ent.momentum[j] = random.RandomInt( 2 ) ? 0.0f : random.CRandomFloat() * 1000.0f;
+			ent.localOrigin[j] = random.RandomInt( 4 ) ? ent.origin[j] : random.CRandomFloat() * 4096.0f;
+			ent.force[j] = random.RandomInt( 8 ) ? 0.0f : random.CRandomFloat() * 100.0f;
+		}
+		ent.health = random.RandomInt( 200 );
+		ent.frame = random.RandomInt( 256 );
+		// WriteDeltaByteCounter doesn't transmit a change of only the lowest bit
+		ent.eventSequence = random.RandomInt( 64 ) & ~1;
+		ent.team = random.RandomInt( 4 );
+	}
+	memset( &base, 0, sizeof( base ) );
+	base.health = 100;
+
+	const int bufferSize = numEntities * sizeof( bitMsgBenchEntity_t ) + 1024;
+	byte *buffer = (byte *) Mem_Alloc( bufferSize );
+	msg.Init( buffer, bufferSize );
+
+	numErrors = 0;
+	for ( i = 0; i < numSnapshots; i++ ) {
+		writeTimer.Start();
+		msg.BeginWriting();
+		for ( j = 0; j < numEntities; j++ ) {
+			BitMsg_BenchWriteEntity( msg, entities[j], base );
+		}
+		msg.WriteString( "snapshot" );
+		writeTimer.Stop();
+
+		readTimer.Start();
+		msg.BeginReading();
+		for ( j = 0; j < numEntities; j++ ) {
+			BitMsg_BenchReadEntity( msg, decoded, base );
+			numErrors += ( decoded.spawnId != entities[j].spawnId || decoded.origin != entities[j].origin ||
+							decoded.localOrigin != entities[j].localOrigin || decoded.health != entities[j].health ||
+							decoded.eventSequence != entities[j].eventSequence || decoded.team != entities[j].team );
+		}
+		msg.ReadString( name, sizeof( name ) );
+		readTimer.Stop();
+	}
+
+	idLib::common->Printf( "%d entities, %d bytes per snapshot: write %.1f us, read %.1f us per snapshot, %d errors\n",
+				numEntities, msg.GetSize(), writeTimer.Milliseconds() * 1000.0 / numSnapshots,
+				readTimer.Milliseconds() * 1000.0 / numSnapshots, numErrors );
+
+	Mem_Free( buffer );
+	delete[] entities;
+}
@@ -673,4 +673,7 @@ ID_INLINE float idBitMsgDelta::ReadDeltaFloat( float oldValue, int exponentBits,
 	return idMath::BitsToFloat( newBits, exponentBits, mantissaBits );
 }
 
+// encodes and decodes snapshot like payloads with idBitMsg
+void BitMsg_Bench_f( const class idCmdArgs &args );
+
 #endif /* !__BITMSG_H__ */
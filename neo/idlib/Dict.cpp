@@ -31,6 +31,7 @@ If you have questions concerning this license or the applicable additional terms
 
 idStrPool		idDict::globalKeys;
 idStrPool		idDict::globalValues;
+int				idDict::globalKeysGeneration;
 
 /*
 ================
@@ -81,7 +82,7 @@ void idDict::Copy( const idDict &other ) {
 	if ( args.Num() ) {
 		found = (int *) _alloca16( other.args.Num() * sizeof( int ) );
         for ( i = 0; i < n; i++ ) {
-			found[i] = FindKeyIndex( other.args[i].GetKey() );
+			found[i] = FindPoolKeyIndex( other.args[i].key );
 		}
 	} else {
 		found = NULL;
@@ -96,7 +97,7 @@ void idDict::Copy( const idDict &other ) {
 		} else {
 			kv.key = globalKeys.CopyString( other.args[i].key );
 			kv.value = globalValues.CopyString( other.args[i].value );
-			argHash.Add( argHash.GenerateKey( kv.GetKey(), false ), args.Append( kv ) );
+			argHash.Add( kv.key->GetHash(), args.Append( kv ) );
 		}
 	}
 }
@@ -178,17 +179,16 @@ idDict::SetDefaults
 */
 void idDict::SetDefaults( const idDict *dict ) {
 	int i, n;
-	const idKeyValue *kv, *def;
+	const idKeyValue *def;
 	idKeyValue newkv;
 
 	n = dict->args.Num();
 	for( i = 0; i < n; i++ ) {
 		def = &dict->args[i];
-		kv = FindKey( def->GetKey() );
-		if ( !kv ) {
+		if ( FindPoolKeyIndex( def->key ) == -1 ) {
 			newkv.key = globalKeys.CopyString( def->key );
 			newkv.value = globalValues.CopyString( def->value );
-			argHash.Add( argHash.GenerateKey( newkv.GetKey(), false ), args.Append( newkv ) );
+			argHash.Add( newkv.key->GetHash(), args.Append( newkv ) );
 		}
 	}
 }
@@ -280,16 +280,19 @@ void idDict::Set( const char *key, const char *value ) {
 		return;
 	}
 
-	i = FindKeyIndex( key );
+	// allocating the key first hashes the key string only once
+	kv.key = globalKeys.AllocString( key );
+
+	i = FindPoolKeyIndex( kv.key );
 	if ( i != -1 ) {
+		globalKeys.FreeString( kv.key );
 		// first set the new value and then free the old value to allow proper self copying
 		const idPoolStr *oldValue = args[i].value;
 		args[i].value = globalValues.AllocString( value );
 		globalValues.FreeString( oldValue );
 	} else {
-		kv.key = globalKeys.AllocString( key );
 		kv.value = globalValues.AllocString( value );
-		argHash.Add( argHash.GenerateKey( kv.GetKey(), false ), args.Append( kv ) );
+		argHash.Add( kv.key->GetHash(), args.Append( kv ) );
 	}
 }
 
@@ -335,6 +338,56 @@ bool idDict::GetBool( const char *key, const char *defaultString, bool &out ) co
 	return found;
 }
 
+/*
+================
+ParseAngles
+================
+*/
+static void ParseAngles( const char *s, idAngles &out ) {
+	out.Zero();
+	sscanf( s, "%f %f %f", &out.pitch, &out.yaw, &out.roll );
+}
+
+/*
+================
+ParseVector
+================
+*/
+static void ParseVector( const char *s, idVec3 &out ) {
+	out.Zero();
+	sscanf( s, "%f %f %f", &out.x, &out.y, &out.z );
+}
+
+/*
+================
+ParseVec2
+================
+*/
+static void ParseVec2( const char *s, idVec2 &out ) {
+	out.Zero();
+	sscanf( s, "%f %f", &out.x, &out.y );
+}
+
+/*
+================
+ParseVec4
+================
+*/
+static void ParseVec4( const char *s, idVec4 &out ) {
+	out.Zero();
+	sscanf( s, "%f %f %f %f", &out.x, &out.y, &out.z, &out.w );
+}
+
+/*
+================
+ParseMatrix
+================
+*/
+static void ParseMatrix( const char *s, idMat3 &out ) {
+	out.Identity();		// sccanf has a bug in it on Mac OS 9.  Sigh.
+	sscanf( s, "%f %f %f %f %f %f %f %f %f", &out[0].x, &out[0].y, &out[0].z, &out[1].x, &out[1].y, &out[1].z, &out[2].x, &out[2].y, &out[2].z );
+}
+
 /*
 ================
 idDict::GetAngles
@@ -349,8 +402,7 @@ bool idDict::GetAngles( const char *key, const char *defaultString, idAngles &ou
 	}
 
 	found = GetString( key, defaultString, &s );
-	out.Zero();	
-	sscanf( s, "%f %f %f", &out.pitch, &out.yaw, &out.roll );
+	ParseAngles( s, out );
 	return found;
 }
 
@@ -368,8 +420,7 @@ bool idDict::GetVector( const char *key, const char *defaultString, idVec3 &out
 	}
 
 	found = GetString( key, defaultString, &s );
-	out.Zero();
-	sscanf( s, "%f %f %f", &out.x, &out.y, &out.z );
+	ParseVector( s, out );
 	return found;
 }
 
@@ -387,8 +438,7 @@ bool idDict::GetVec2( const char *key, const char *defaultString, idVec2 &out )
 	}
 
 	found = GetString( key, defaultString, &s );
-	out.Zero();
-	sscanf( s, "%f %f", &out.x, &out.y );
+	ParseVec2( s, out );
 	return found;
 }
 
@@ -406,8 +456,7 @@ bool idDict::GetVec4( const char *key, const char *defaultString, idVec4 &out )
 	}
 
 	found = GetString( key, defaultString, &s );
-	out.Zero();
-	sscanf( s, "%f %f %f %f", &out.x, &out.y, &out.z, &out.w );
+	ParseVec4( s, out );
 	return found;
 }
 
@@ -425,8 +474,119 @@ bool idDict::GetMatrix( const char *key, const char *defaultString, idMat3 &out
 	}
 
 	found = GetString( key, defaultString, &s );
-	out.Identity();		// sccanf has a bug in it on Mac OS 9.  Sigh.
-	sscanf( s, "%f %f %f %f %f %f %f %f %f", &out[0].x, &out[0].y, &out[0].z, &out[1].x, &out[1].y, &out[1].z, &out[2].x, &out[2].y, &out[2].z );
+	ParseMatrix( s, out );
+	return found;
+}
+
+/*
+================
+idDict::GetFloat
+================
+*/
+bool idDict::GetFloat( const idDictKey &key, const char *defaultString, float &out ) const {
+	const char	*s;
+	bool		found;
+
+	found = GetString( key, defaultString, &s );
+	out = atof( s );
+	return found;
+}
+
+/*
+================
+idDict::GetInt
+================
+*/
+bool idDict::GetInt( const idDictKey &key, const char *defaultString, int &out ) const {
+	const char	*s;
+	bool		found;
+
+	found = GetString( key, defaultString, &s );
+	out = atoi( s );
+	return found;
+}
+
+/*
+================
+idDict::GetBool
+================
+*/
+bool idDict::GetBool( const idDictKey &key, const char *defaultString, bool &out ) const {
+	const char	*s;
+	bool		found;
+
+	found = GetString( key, defaultString, &s );
+	out = ( atoi( s ) != 0 );
+	return found;
+}
+
+/*
+================
+idDict::GetAngles
+================
+*/
+bool idDict::GetAngles( const idDictKey &key, const char *defaultString, idAngles &out ) const {
+	bool		found;
+	const char	*s;
+
+	found = GetString( key, defaultString ? defaultString : "0 0 0", &s );
+	ParseAngles( s, out );
+	return found;
+}
+
+/*
+================
+idDict::GetVector
+================
+*/
+bool idDict::GetVector( const idDictKey &key, const char *defaultString, idVec3 &out ) const {
+	bool		found;
+	const char	*s;
+
+	found = GetString( key, defaultString ? defaultString : "0 0 0", &s );
+	ParseVector( s, out );
+	return found;
+}
+
+/*
+================
+idDict::GetVec2
+================
+*/
+bool idDict::GetVec2( const idDictKey &key, const char *defaultString, idVec2 &out ) const {
+	bool		found;
+	const char	*s;
+
+	found = GetString( key, defaultString ? defaultString : "0 0", &s );
+	ParseVec2( s, out );
+	return found;
+}
+
+/*
+================
+idDict::GetVec4
+================
+*/
+bool idDict::GetVec4( const idDictKey &key, const char *defaultString, idVec4 &out ) const {
+	bool		found;
+	const char	*s;
+
+	found = GetString( key, defaultString ? defaultString : "0 0 0 0", &s );
+	ParseVec4( s, out );
+	return found;
+}
+
+/*
+================
+idDict::GetMatrix
+================
+*/
+bool idDict::GetMatrix( const idDictKey &key, const char *defaultString, idMat3 &out ) const {
+	const char	*s;
+	bool		found;
+
+	found = GetString( key, defaultString ? defaultString : "1 0 0 0 1 0 0 0 1", &s );
+	ParseMatrix( s, out );
 	return found;
 }
 
@@ -619,6 +779,16 @@ void idDict::ReadFromFileHandle( idFile *f ) {
 	}
 }
 
+/*
+================
+idDictKey::Resolve
+================
+*/
+void idDictKey::Resolve( void ) const {
+	poolStr = idDict::globalKeys.AllocString( name );
+	generation = idDict::globalKeysGeneration;
+}
+
 /*
 ================
 idDict::Init
@@ -627,6 +797,7 @@ idDict::Init
 void idDict::Init( void ) {
 	globalKeys.SetCaseSensitive( false );
 	globalValues.SetCaseSensitive( true );
+	globalKeysGeneration++;
 }
 
 /*
@@ -637,6 +808,7 @@ idDict::Shutdown
 void idDict::Shutdown( void ) {
 	globalKeys.Clear();
 	globalValues.Clear();
+	globalKeysGeneration++;
 }
 
 /*
@@ -62,7 +62,42 @@ private:
 	const idPoolStr *	value;
 };
 
+/*
+===============================================================================
+
+	Precomputed dictionary key.
+
+	All dictionary keys are allocated from a case insensitive string pool so
+	every key that matches the name of the handle is the same pooled string.
+	The handle allocates its name from the pool the first time it is used and
+	after that lookups only compare pool pointers instead of key strings.
+
+	static const idDictKey KEY_ORIGIN( "origin" );
+	idVec3 origin = spawnArgs.GetVector( KEY_ORIGIN );
+
+===============================================================================
+*/
+
+class idDictKey {
+	friend class idDict;
+
+public:
+	explicit			idDictKey( const char *name );
+
+	const char *		GetName( void ) const { return name; }
+						operator const char *( void ) const { return name; }
+
+private:
+	const char *		name;
+	mutable const idPoolStr *poolStr;		// reference is kept until the key pool is cleared
+	mutable int			generation;			// poolStr is valid while this matches idDict::globalKeysGeneration
+
+	void				Resolve( void ) const;
+};
+
 class idDict {
+	friend class idDictKey;
+
 public:
 						idDict( void );
 						idDict( const idDict &other );	// allow declaration with assignment
@@ -122,6 +157,28 @@ public:
 	bool				GetAngles( const char *key, const char *defaultString, idAngles &out ) const;
 	bool				GetMatrix( const char *key, const char *defaultString, idMat3 &out ) const;
 
+						// lookups with a precomputed key
+	const char *		GetString( const idDictKey &key, const char *defaultString = "" ) const;
+	float				GetFloat( const idDictKey &key, const char *defaultString = "0" ) const;
+	int					GetInt( const idDictKey &key, const char *defaultString = "0" ) const;
+	bool				GetBool( const idDictKey &key, const char *defaultString = "0" ) const;
+	idVec3				GetVector( const idDictKey &key, const char *defaultString = NULL ) const;
+	idVec2				GetVec2( const idDictKey &key, const char *defaultString = NULL ) const;
+	idVec4				GetVec4( const idDictKey &key, const char *defaultString = NULL ) const;
+	idAngles			GetAngles( const idDictKey &key, const char *defaultString = NULL ) const;
+	idMat3				GetMatrix( const idDictKey &key, const char *defaultString = NULL ) const;
+
+	bool				GetString( const idDictKey &key, const char *defaultString, const char **out ) const;
+	bool				GetString( const idDictKey &key, const char *defaultString, idStr &out ) const;
+	bool				GetFloat( const idDictKey &key, const char *defaultString, float &out ) const;
+	bool				GetInt( const idDictKey &key, const char *defaultString, int &out ) const;
+	bool				GetBool( const idDictKey &key, const char *defaultString, bool &out ) const;
+	bool				GetVector( const idDictKey &key, const char *defaultString, idVec3 &out ) const;
+	bool				GetVec2( const idDictKey &key, const char *defaultString, idVec2 &out ) const;
+	bool				GetVec4( const idDictKey &key, const char *defaultString, idVec4 &out ) const;
+	bool				GetAngles( const idDictKey &key, const char *defaultString, idAngles &out ) const;
+	bool				GetMatrix( const idDictKey &key, const char *defaultString, idMat3 &out ) const;
+
 	int					GetNumKeyVals( void ) const;
 	const idKeyValue *	GetKeyVal( int index ) const;
 						// returns the key/value pair with the given key
@@ -130,6 +187,8 @@ public:
 						// returns the index to the key/value pair with the given key
 						// returns -1 if the key/value pair does not exist
 	int					FindKeyIndex( const char *key ) const;
+	const idKeyValue *	FindKey( const idDictKey &key ) const;
+	int					FindKeyIndex( const idDictKey &key ) const;
 						// delete the key/value pair with the given key
 	void				Delete( const char *key );
 						// finds the next key/value pair with the given key prefix.
@@ -157,8 +216,19 @@ private:
 
 	static idStrPool	globalKeys;
 	static idStrPool	globalValues;
+	static int			globalKeysGeneration;	// incremented every time the key pool is cleared
+
+						// returns the index to the key/value pair with the given pooled key
+	int					FindPoolKeyIndex( const idPoolStr *key ) const;
 };
 
+ID_INLINE idDictKey::idDictKey( const char *name ) {
+	assert( name != NULL && name[0] != '\0' );
+	this->name = name;
+	poolStr = NULL;
+	generation = -1;
+}
+
 
 ID_INLINE idDict::idDict( void ) {
 	args.SetGranularity( 16 );
@@ -287,6 +357,99 @@ ID_INLINE idMat3 idDict::GetMatrix( const char *key, const char *defaultString )
 	return out;
 }
 
+ID_INLINE int idDict::FindPoolKeyIndex( const idPoolStr *key ) const {
+	// keys from the same pool are equal only if they are the same string, keys from
+	// the pool on the other side of a DLL boundary have to be compared
+	for ( int i = argHash.First( key->GetHash() ); i != -1; i = argHash.Next( i ) ) {
+		if ( args[i].key == key || ( args[i].key->GetPool() != key->GetPool() && args[i].key->Icmp( *key ) == 0 ) ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+ID_INLINE int idDict::FindKeyIndex( const idDictKey &key ) const {
+	if ( key.generation != globalKeysGeneration ) {
+		key.Resolve();
+	}
+	return FindPoolKeyIndex( key.poolStr );
+}
+
+ID_INLINE const idKeyValue *idDict::FindKey( const idDictKey &key ) const {
+	int i = FindKeyIndex( key );
+	return ( i != -1 ) ? &args[i] : NULL;
+}
+
+ID_INLINE bool idDict::GetString( const idDictKey &key, const char *defaultString, const char **out ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		*out = kv->GetValue();
+		return true;
+	}
+	*out = defaultString;
+	return false;
+}
+
+ID_INLINE bool idDict::GetString( const idDictKey &key, const char *defaultString, idStr &out ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		out = kv->GetValue();
+		return true;
+	}
+	out = defaultString;
+	return false;
+}
+
+ID_INLINE const char *idDict::GetString( const idDictKey &key, const char *defaultString ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->GetValue();
+	}
+	return defaultString;
+}
+
+ID_INLINE float idDict::GetFloat( const idDictKey &key, const char *defaultString ) const {
+	return atof( GetString( key, defaultString ) );
+}
+
+ID_INLINE int idDict::GetInt( const idDictKey &key, const char *defaultString ) const {
+	return atoi( GetString( key, defaultString ) );
+}
+
+ID_INLINE bool idDict::GetBool( const idDictKey &key, const char *defaultString ) const {
+	return ( atoi( GetString( key, defaultString ) ) != 0 );
+}
+
+ID_INLINE idVec3 idDict::GetVector( const idDictKey &key, const char *defaultString ) const {
+	idVec3 out;
+	GetVector( key, defaultString, out );
+	return out;
+}
+
+ID_INLINE idVec2 idDict::GetVec2( const idDictKey &key, const char *defaultString ) const {
+	idVec2 out;
+	GetVec2( key, defaultString, out );
+	return out;
+}
+
+ID_INLINE idVec4 idDict::GetVec4( const idDictKey &key, const char *defaultString ) const {
+	idVec4 out;
+	GetVec4( key, defaultString, out );
+	return out;
+}
+
+ID_INLINE idAngles idDict::GetAngles( const idDictKey &key, const char *defaultString ) const {
+	idAngles out;
+	GetAngles( key, defaultString, out );
+	return out;
+}
+
+ID_INLINE idMat3 idDict::GetMatrix( const idDictKey &key, const char *defaultString ) const {
+	idMat3 out;
+	GetMatrix( key, defaultString, out );
+	return out;
+}
+
 ID_INLINE int idDict::GetNumKeyVals( void ) const {
 	return args.Num();
 }
@@ -51,6 +51,8 @@ If you have questions concerning this license or the applicable additional terms
 #define SMALL_ALIGN( bytes )	( ALIGN_SIZE( (bytes) + SMALL_HEADER_SIZE ) - SMALL_HEADER_SIZE )
 #define MEDIUM_SMALLEST_SIZE	( ALIGN_SIZE( 256 ) + ALIGN_SIZE( MEDIUM_HEADER_SIZE ) )
 
+#define THREAD_CACHE_MAX_BYTES	( 256 * 1024 )		// maximum number of bytes held by a single thread cache
+
 
 class idHeap {
 
@@ -67,6 +69,9 @@ public:
 
 	void 			AllocDefragBlock( void );		// hack for huge renderbumps
 
+	void			FlushThreadCache( void );		// return all blocks cached by the calling thread
+	int				GetThreadCacheStats( memThreadCacheStats_t *stats, int maxStats );
+
 private:
 
 	enum {
@@ -99,6 +104,32 @@ private:
 		dword				freeBlock;				// non-zero if free block
 	};
 
+	enum {
+		SMALL_CACHE_BINS	= 256 / ALIGN + 1,		// one bin for each small heap size
+		MEDIUM_CACHE_BINS	= 28					// four bins per power of two from 256 to 28672 bytes
+	};
+
+	// Small and medium blocks freed by a thread are kept in a per-thread cache and
+	// handed out again on the next allocation of the same size by that thread.
+	// Blocks are moved between the cache and the shared heap in batches so the
+	// heap lock is only taken once for many allocations. A cached block is still
+	// an allocated block as far as the shared heap is concerned, which means a
+	// block allocated by one thread can be freed into the cache of another thread
+	// without synchronization.
+	struct threadCache_s {
+		void *				smallFree[SMALL_CACHE_BINS];	// free lists linked through the first pointer of each block
+		int					smallCount[SMALL_CACHE_BINS];
+		void *				mediumFree[MEDIUM_CACHE_BINS];
+		int					mediumCount[MEDIUM_CACHE_BINS];
+		int					cachedBytes;			// number of bytes in all free lists
+		int					threadNum;
+		int					hits;
+		int					misses;
+		int					frees;
+		int					flushes;
+		threadCache_s *		next;					// next thread cache of this heap
+	};
+
 	// variables
 	void *			smallFirstFree[256/ALIGN+1];	// small heap allocator lists (for allocs of 1-255 bytes)
 	page_s *		smallCurPage;					// current page for small allocations
@@ -124,6 +155,11 @@ private:
 	void			*defragBlock;					// a single huge block that can be allocated
 													// at startup, then freed when needed
 
+	idSysSpinLock	lock;							// guards everything but the thread caches
+	threadCache_s *	threadCaches;					// all thread caches created for this heap
+	int				numThreadCaches;
+	int				generation;						// invalidates thread caches of a previous heap
+
 	// methods
 	page_s *		AllocatePage( dword bytes );	// allocate page from the OS
 	void			FreePage( idHeap::page_s *p );	// free an OS allocated page
@@ -140,8 +176,19 @@ private:
 
 	void			ReleaseSwappedPages( void );
 	void			FreePageReal( idHeap::page_s *p );
+
+	threadCache_s *	GetThreadCache( void );			// get the cache of the calling thread
+	void *			CachedSmallAllocate( dword bytes );
+	void			CachedSmallFree( void *ptr );
+	void *			CachedMediumAllocate( dword bytes );
+	void			CachedMediumFree( void *ptr );
+	void			ReleaseCachedBlocks( threadCache_s *tc, void **list, int *count, int numRelease );
 };
 
+static int							heap_generation = 0;
+static ID_THREAD_LOCAL void *		heap_threadCache = NULL;
+static ID_THREAD_LOCAL int			heap_threadCacheGeneration = 0;
+
 
 /*
 ================
@@ -170,6 +217,10 @@ void idHeap::Init () {
 	mediumFirstUsedPage	= NULL;
 
 	c_heapAllocRunningCount = 0;
+
+	threadCaches		= NULL;								// init thread caches
+	numThreadCaches		= 0;
+	generation			= ++heap_generation;
 }
 
 /*
@@ -225,6 +276,12 @@ idHeap::~idHeap( void ) {
 
 	ReleaseSwappedPages();			
 
+	while( threadCaches ) {					// free the thread caches, the cached blocks went with the pages
+		threadCache_s *next = threadCaches->next;
+		::free( threadCaches );
+		threadCaches = next;
+	}
+
 	if ( defragBlock ) {
 		free( defragBlock );
 	}
@@ -268,11 +325,12 @@ void *idHeap::Allocate( const dword bytes ) {
 	return malloc( bytes );
 #else
 	if ( !(bytes & ~255) ) {
-		return SmallAllocate( bytes );
+		return CachedSmallAllocate( bytes );
 	}
 	if ( !(bytes & ~32767) ) {
-		return MediumAllocate( bytes );
+		return CachedMediumAllocate( bytes );
 	}
+	idScopedSpinLock scopedLock( lock );
 	return LargeAllocate( bytes );
 #endif
 }
@@ -293,15 +351,17 @@ void idHeap::Free( void *p ) {
 #else
 	switch( ((byte *)(p))[-1] ) {
 		case SMALL_ALLOC: {
-			SmallFree( p );
+			CachedSmallFree( p );
 			break;
 		}
 		case MEDIUM_ALLOC: {
-			MediumFree( p );
+			CachedMediumFree( p );
 			break;
 		}
 		case LARGE_ALLOC: {
+			lock.Lock();
 			LargeFree( p );
+			lock.Unlock();
 			break;
 		}
 		default: {
@@ -400,6 +460,7 @@ idHeap::Dump
 */
 void idHeap::Dump( void ) {
 	idHeap::page_s	*pg;
+	idScopedSpinLock scopedLock( lock );
 
 	for ( pg = smallFirstUsedPage; pg; pg = pg->next ) {
 		idLib::common->Printf( "%p  bytes %-8d  (in use by small heap)\n", pg->data, pg->dataSize);
@@ -975,6 +1036,472 @@ void idHeap::LargeFree( void *ptr) {
 	FreePage(pg);
 }
 
+//===============================================================
+//
+//	thread cache code
+//
+//===============================================================
+
+/*
+================
+SmallCacheBatch
+
+  returns the number of blocks moved at once between a small cache bin and the shared heap
+================
+*/
+ID_INLINE static int SmallCacheBatch( dword ix ) {
+	return Min( 32, Max( 4, (int)( 512 / ix ) ) );
+}
+
+/*
+================
+MediumCacheBin
+
+  returns the cache bin with the largest block size smaller or equal to 'size'
+================
+*/
+ID_INLINE static int MediumCacheBin( dword size ) {
+	int n = idMath::ILog2( (int)size );
+	return ( n - 8 ) * 4 + ( ( size >> ( n - 2 ) ) & 3 );
+}
+
+/*
+================
+MediumCacheBinSize
+
+  returns the size of the blocks in a medium cache bin
+================
+*/
+ID_INLINE static dword MediumCacheBinSize( int bin ) {
+	return ( 4 + ( bin & 3 ) ) << ( ( bin >> 2 ) + 6 );
+}
+
+/*
+================
+MediumCacheBatch
+
+  returns the number of blocks moved at once between a medium cache bin and the shared heap
+================
+*/
+ID_INLINE static int MediumCacheBatch( int bin ) {
+	return Min( 8, Max( 1, (int)( 16384 / MediumCacheBinSize( bin ) ) ) );
+}
+
+/*
+================
+idHeap::GetThreadCache
+
+  returns the cache of the calling thread, creates one if the thread does not have one yet
+================
+*/
+idHeap::threadCache_s *idHeap::GetThreadCache( void ) {
+	threadCache_s *tc = (threadCache_s *)heap_threadCache;
+
+	if ( tc && heap_threadCacheGeneration == generation ) {
+		return tc;
+	}
+
+	tc = (threadCache_s *) ::malloc( sizeof( threadCache_s ) );
+	if ( !tc ) {
+		idLib::common->FatalError( "malloc failure for thread cache" );
+	}
+	memset( tc, 0, sizeof( threadCache_s ) );
+
+	lock.Lock();
+	tc->threadNum = numThreadCaches++;
+	tc->next = threadCaches;
+	threadCaches = tc;
+	lock.Unlock();
+
+	heap_threadCache = tc;
+	heap_threadCacheGeneration = generation;
+	return tc;
+}
+
+/*
+================
+idHeap::ReleaseCachedBlocks
+
+  returns blocks from one of the free lists of a thread cache to the shared heap
+================
+*/
+void idHeap::ReleaseCachedBlocks( threadCache_s *tc, void **list, int *count, int numRelease ) {
+	if ( numRelease <= 0 ) {
+		return;
+	}
+	tc->flushes++;
+
+	lock.Lock();
+	for ( ; numRelease > 0 && *list; numRelease-- ) {
+		void *p = *list;
+		*list = *(void **)p;
+		(*count)--;
+		tc->cachedBytes -= Msize( p );
+		if ( ((byte *)(p))[-1] == SMALL_ALLOC ) {
+			SmallFree( p );
+		} else {
+			MediumFree( p );
+		}
+	}
+	lock.Unlock();
+}
+
+/*
+================
+idHeap::CachedSmallAllocate
+
+  allocate memory (1-255 bytes) from the thread cache, refills the cache from the small heap manager
+================
+*/
+void *idHeap::CachedSmallAllocate( dword bytes ) {
+	// we need the at least sizeof( void * ) bytes for the free list
+	if ( bytes < sizeof( void * ) ) {
+		bytes = sizeof( void * );
+	}
+
+	// use the same rounding as the small heap manager so all blocks in a bin have the same size
+	bytes = SMALL_ALIGN( bytes );
+
+	threadCache_s *tc = GetThreadCache();
+	dword ix = bytes / ALIGN;
+
+	if ( tc->smallFree[ix] ) {
+		tc->hits++;
+	} else {
+		int batch = SmallCacheBatch( ix );
+
+		tc->misses++;
+
+		lock.Lock();
+		for ( int i = 0; i < batch; i++ ) {
+			void *p = SmallAllocate( bytes );
+			if ( !p ) {
+				break;
+			}
+			*(void **)p = tc->smallFree[ix];
+			tc->smallFree[ix] = p;
+			tc->smallCount[ix]++;
+			tc->cachedBytes += Msize( p );
+		}
+		lock.Unlock();
+
+		if ( !tc->smallFree[ix] ) {
+			return NULL;
+		}
+	}
+
+	void *p = tc->smallFree[ix];
+	tc->smallFree[ix] = *(void **)p;
+	tc->smallCount[ix]--;
+	tc->cachedBytes -= Msize( p );
+	return p;
+}
+
+/*
+================
+idHeap::CachedSmallFree
+
+  frees a block of memory allocated by CachedSmallAllocate() to the thread cache
+================
+*/
+void idHeap::CachedSmallFree( void *ptr ) {
+	threadCache_s *tc = GetThreadCache();
+	dword ix = ( (byte *)ptr )[-SMALL_HEADER_SIZE];
+
+	// check if the index is correct
+	if ( ix > (256 / ALIGN) ) {
+		idLib::common->FatalError( "CachedSmallFree: invalid memory block" );
+	}
+
+	tc->frees++;
+	*(void **)ptr = tc->smallFree[ix];
+	tc->smallFree[ix] = ptr;
+	tc->smallCount[ix]++;
+	tc->cachedBytes += Msize( ptr );
+
+	if ( tc->cachedBytes > THREAD_CACHE_MAX_BYTES ) {
+		ReleaseCachedBlocks( tc, &tc->smallFree[ix], &tc->smallCount[ix], tc->smallCount[ix] );
+	} else {
+		int batch = SmallCacheBatch( ix );
+		if ( tc->smallCount[ix] > 2 * batch ) {
+			ReleaseCachedBlocks( tc, &tc->smallFree[ix], &tc->smallCount[ix], batch );
+		}
+	}
+}
+
+/*
+================
+idHeap::CachedMediumAllocate
+
+  allocate memory (256-32768 bytes) from the thread cache, refills the cache from the medium heap manager
+================
+*/
+void *idHeap::CachedMediumAllocate( dword bytes ) {
+	int bin = MediumCacheBin( bytes );
+
+	// round up to the next bin size
+	if ( MediumCacheBinSize( bin ) < bytes ) {
+		bin++;
+	}
+
+	// allocations larger than the largest bin go straight to the medium heap manager
+	if ( bin >= MEDIUM_CACHE_BINS ) {
+		idScopedSpinLock scopedLock( lock );
+		return MediumAllocate( bytes );
+	}
+
+	threadCache_s *tc = GetThreadCache();
+
+	if ( tc->mediumFree[bin] ) {
+		tc->hits++;
+	} else {
+		dword binSize = MediumCacheBinSize( bin );
+		int batch = MediumCacheBatch( bin );
+
+		tc->misses++;
+
+		lock.Lock();
+		for ( int i = 0; i < batch; i++ ) {
+			void *p = MediumAllocate( binSize );
+			if ( !p ) {
+				break;
+			}
+			*(void **)p = tc->mediumFree[bin];
+			tc->mediumFree[bin] = p;
+			tc->mediumCount[bin]++;
+			tc->cachedBytes += Msize( p );
+		}
+		lock.Unlock();
+
+		if ( !tc->mediumFree[bin] ) {
+			return NULL;
+		}
+	}
+
+	void *p = tc->mediumFree[bin];
+	tc->mediumFree[bin] = *(void **)p;
+	tc->mediumCount[bin]--;
+	tc->cachedBytes -= Msize( p );
+	return p;
+}
+
+/*
+================
+idHeap::CachedMediumFree
+
+  frees a block of memory allocated by CachedMediumAllocate() to the thread cache
+================
+*/
+void idHeap::CachedMediumFree( void *ptr ) {
+	threadCache_s *tc = GetThreadCache();
+	dword size = Msize( ptr );
+
+	// blocks larger than the largest bin size can still serve requests for that bin
+	int bin = Min( MediumCacheBin( size ), (int)MEDIUM_CACHE_BINS - 1 );
+
+	tc->frees++;
+	*(void **)ptr = tc->mediumFree[bin];
+	tc->mediumFree[bin] = ptr;
+	tc->mediumCount[bin]++;
+	tc->cachedBytes += size;
+
+	if ( tc->cachedBytes > THREAD_CACHE_MAX_BYTES ) {
+		ReleaseCachedBlocks( tc, &tc->mediumFree[bin], &tc->mediumCount[bin], tc->mediumCount[bin] );
+	} else {
+		int batch = MediumCacheBatch( bin );
+		if ( tc->mediumCount[bin] > 2 * batch ) {
+			ReleaseCachedBlocks( tc, &tc->mediumFree[bin], &tc->mediumCount[bin], batch );
+		}
+	}
+}
+
+/*
+================
+idHeap::FlushThreadCache
+
+  returns all blocks in the cache of the calling thread to the shared heap,
+  called by Sys_CreateThread threads before they exit
+================
+*/
+void idHeap::FlushThreadCache( void ) {
+#if !USE_LIBC_MALLOC
+	threadCache_s *tc = (threadCache_s *)heap_threadCache;
+	int i;
+
+	// don't create a cache for a thread that never allocated
+	if ( !tc || heap_threadCacheGeneration != generation ) {
+		return;
+	}
+
+	for ( i = 0; i < SMALL_CACHE_BINS; i++ ) {
+		ReleaseCachedBlocks( tc, &tc->smallFree[i], &tc->smallCount[i], tc->smallCount[i] );
+	}
+	for ( i = 0; i < MEDIUM_CACHE_BINS; i++ ) {
+		ReleaseCachedBlocks( tc, &tc->mediumFree[i], &tc->mediumCount[i], tc->mediumCount[i] );
+	}
+#endif
+}
+
+/*
+================
+idHeap::GetThreadCacheStats
+
+  returns the number of thread caches without filling in stats when stats is NULL
+================
+*/
+int idHeap::GetThreadCacheStats( memThreadCacheStats_t *stats, int maxStats ) {
+	threadCache_s *tc;
+	int num = 0;
+
+	idScopedSpinLock scopedLock( lock );
+
+	if ( !stats ) {
+		return numThreadCaches;
+	}
+
+	for ( tc = threadCaches; tc && num < maxStats; tc = tc->next, num++ ) {
+		stats[num].threadNum = tc->threadNum;
+		stats[num].hits = tc->hits;
+		stats[num].misses = tc->misses;
+		stats[num].frees = tc->frees;
+		stats[num].flushes = tc->flushes;
+		stats[num].cachedBytes = tc->cachedBytes;
+	}
+	return num;
+}
+
+//===============================================================
+//
+//	idFrameAllocator
+//
+//===============================================================
+
+#define FRAME_BLOCK_SIZE		0x40000
+#define FRAME_BLOCK_HEADER		( ( (int)sizeof( frameBlock_t ) + 15 ) & ~15 )
+
+idFrameAllocator				frameAllocator;
+
+/*
+================
+idFrameAllocator::idFrameAllocator
+
+  does not allocate any memory so it can be constructed before Mem_Init
+================
+*/
+idFrameAllocator::idFrameAllocator( void ) {
+	memset( frames, 0, sizeof( frames ) );
+	current = 0;
+	frameCount = 0;
+	highwater = 0;
+	blockMemory = 0;
+}
+
+/*
+================
+idFrameAllocator::Shutdown
+================
+*/
+void idFrameAllocator::Shutdown( void ) {
+	frameBlock_t *block, *next;
+
+	for ( int i = 0; i < 2; i++ ) {
+		for ( block = frames[i].memory; block; block = next ) {
+			next = block->next;
+			Mem_Free16( block );
+		}
+	}
+	memset( frames, 0, sizeof( frames ) );
+	blockMemory = 0;
+}
+
+/*
+================
+idFrameAllocator::ToggleFrame
+
+  switches to the other frame and resets its memory
+================
+*/
+void idFrameAllocator::ToggleFrame( void ) {
+	frameBlock_t *block;
+
+	// update the highwater mark
+	if ( frames[current].numBytes > highwater ) {
+		highwater = frames[current].numBytes;
+	}
+
+	frameCount++;
+	current ^= 1;
+
+	frameMemory_t &frame = frames[current];
+
+	// reset the memory allocation to the first block
+	frame.alloc = frame.memory;
+	for ( block = frame.memory; block; block = block->next ) {
+		block->used = 0;
+	}
+	frame.numAllocs = 0;
+	frame.numBytes = 0;
+}
+
+/*
+================
+idFrameAllocator::Alloc
+================
+*/
+void *idFrameAllocator::Alloc( const int bytes ) {
+	frameMemory_t &frame = frames[current];
+	int alignedBytes = ( bytes + 15 ) & ~15;
+	frameBlock_t *block = frame.alloc;
+
+	// see if it can be satisfied in the current block
+	if ( !block || block->size - block->used < alignedBytes ) {
+		frameBlock_t *last = block;
+
+		// advance to the next memory block that is large enough
+		for ( block = block ? block->next : NULL; block; block = block->next ) {
+			if ( block->size >= alignedBytes ) {
+				break;
+			}
+			last = block;
+		}
+
+		// create a new block at the end of the chain
+		if ( !block ) {
+			int size = Max( FRAME_BLOCK_SIZE, alignedBytes );
+
+			block = (frameBlock_t *) Mem_Alloc16( FRAME_BLOCK_HEADER + size );
+			block->size = size;
+			block->used = 0;
+			block->next = NULL;
+			if ( last ) {
+				last->next = block;
+			} else {
+				frame.memory = block;
+			}
+			blockMemory += size;
+		}
+
+		frame.alloc = block;
+	}
+
+	void *ptr = ( (byte *) block ) + FRAME_BLOCK_HEADER + block->used;
+	block->used += alignedBytes;
+	frame.numAllocs++;
+	frame.numBytes += alignedBytes;
+	return ptr;
+}
+
+/*
+================
+idFrameAllocator::ClearedAlloc
+================
+*/
+void *idFrameAllocator::ClearedAlloc( const int bytes ) {
+	void *ptr = Alloc( bytes );
+	SIMDProcessor->Memset( ptr, 0, bytes );
+	return ptr;
+}
+
 //===============================================================
 //
 //	memory allocation all in one place
@@ -1056,6 +1583,53 @@ void Mem_UpdateFreeStats( int size ) {
 	mem_total_allocs.totalSize -= size;
 }
 
+/*
+==================
+Mem_GetThreadCacheStats
+==================
+*/
+int Mem_GetThreadCacheStats( memThreadCacheStats_t *stats, int maxStats ) {
+	if ( !mem_heap ) {
+		return 0;
+	}
+	return mem_heap->GetThreadCacheStats( stats, maxStats );
+}
+
+/*
+==================
+Mem_FlushThreadCache
+==================
+*/
+void Mem_FlushThreadCache( void ) {
+	if ( !mem_heap ) {
+		return;
+	}
+	mem_heap->FlushThreadCache();
+}
+
+/*
+==================
+Mem_ThreadCacheStats_f
+==================
+*/
+void Mem_ThreadCacheStats_f( const idCmdArgs &args ) {
+	idList<memThreadCacheStats_t> stats;
+	int i, num, total;
+
+	// caches can be added between the two calls, those are left out
+	num = Mem_GetThreadCacheStats( NULL, 0 );
+	stats.SetNum( Max( num, 1 ) );
+	num = Mem_GetThreadCacheStats( stats.Ptr(), num );
+
+	idLib::common->Printf( "cache     hits   misses   hit%%    frees  flushes  cached\n" );
+	for ( i = 0; i < num; i++ ) {
+		total = stats[i].hits + stats[i].misses;
+		idLib::common->Printf( "%5d %8d %8d %5.1f%% %8d %8d %5dkB\n", stats[i].threadNum, stats[i].hits, stats[i].misses,
+								total ? stats[i].hits * 100.0f / total : 0.0f, stats[i].frees, stats[i].flushes, stats[i].cachedBytes >> 10 );
+	}
+	idLib::common->Printf( "%d thread caches\n", num );
+}
+
 
 #ifndef ID_DEBUG_MEMORY
 
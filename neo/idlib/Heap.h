@@ -49,6 +49,15 @@ typedef struct {
 	int		totalSize;
 } memoryStats_t;
 
+typedef struct {
+	int		threadNum;		// order in which threads first allocated memory
+	int		hits;			// allocations served from the thread cache
+	int		misses;			// allocations that required a refill from the shared heap
+	int		frees;			// frees into the thread cache
+	int		flushes;		// batches returned to the shared heap
+	int		cachedBytes;	// bytes currently held by the thread cache
+} memThreadCacheStats_t;
+
 
 void		Mem_Init( void );
 void		Mem_Shutdown( void );
@@ -59,6 +68,9 @@ void		Mem_GetStats( memoryStats_t &stats );
 void		Mem_Dump_f( const class idCmdArgs &args );
 void		Mem_DumpCompressed_f( const class idCmdArgs &args );
 void		Mem_AllocDefragBlock( void );
+int			Mem_GetThreadCacheStats( memThreadCacheStats_t *stats, int maxStats );
+void		Mem_FlushThreadCache( void );
+void		Mem_ThreadCacheStats_f( const class idCmdArgs &args );
 
 
 #ifndef ID_DEBUG_MEMORY
@@ -139,6 +151,64 @@ __inline void operator delete[]( void *p ) {
 #endif /* ID_DEBUG_MEMORY */
 
 
+/*
+===============================================================================
+
+	Frame allocator.
+
+	Linear allocator for temporary memory that is used within a single frame.
+	Memory is never freed individually. Instead the owner calls ToggleFrame at
+	the end of each frame which works like the double buffered renderer frame
+	data: the memory of the frame that just ended stays valid until the next
+	toggle and the memory of the frame before is reused.
+	Not thread safe, only the thread that toggles the allocator may use it.
+
+===============================================================================
+*/
+
+class idFrameAllocator {
+public:
+							idFrameAllocator( void );
+
+	void					Shutdown( void );				// frees all memory, must be called before Mem_Shutdown
+	void					ToggleFrame( void );			// call at the end of each frame
+
+	void *					Alloc( const int bytes );		// allocated memory is 16 byte aligned
+	void *					ClearedAlloc( const int bytes );
+	void					Free( void *ptr ) {}			// memory is only released by ToggleFrame
+
+	int						GetFrameCount( void ) const { return frameCount; }
+	int						GetFrameAllocs( void ) const { return frames[current].numAllocs; }
+	int						GetFrameBytes( void ) const { return frames[current].numBytes; }
+	int						GetLastFrameAllocs( void ) const { return frames[current^1].numAllocs; }
+	int						GetLastFrameBytes( void ) const { return frames[current^1].numBytes; }
+	int						GetHighwater( void ) const { return highwater; }
+	int						GetBlockMemory( void ) const { return blockMemory; }
+
+private:
+	typedef struct frameBlock_s {
+		struct frameBlock_s *	next;
+		int						size;				// size in bytes of the memory after the header
+		int						used;
+	} frameBlock_t;
+
+	typedef struct {
+		frameBlock_t *		memory;					// all blocks of this frame
+		frameBlock_t *		alloc;					// current block in the chain
+		int					numAllocs;				// number of allocations served this frame
+		int					numBytes;				// number of bytes served this frame
+	} frameMemory_t;
+
+	frameMemory_t			frames[2];
+	int						current;				// index of the frame being allocated from
+	int						frameCount;				// number of toggles
+	int						highwater;				// max bytes used on any frame
+	int						blockMemory;			// total memory in blocks
+};
+
+extern idFrameAllocator		frameAllocator;
+
+
 /*
 ===============================================================================
 
@@ -242,6 +242,8 @@ void idLexer::Warning( const char *str, ... ) {
 	char text[MAX_STRING_CHARS];
 	va_list ap;
 
+	hadWarning = true;
+
 	if ( idLexer::flags & LEXFL_NOWARNINGS ) {
 		return;
 	}
@@ -532,13 +534,23 @@ idLexer::ReadName
 ================
 */
 int idLexer::ReadName( idToken *token ) {
-	char c;
-
 	token->type = TT_NAME;
 	do {
 		token->AppendDirty( *idLexer::script_p++ );
-		c = *idLexer::script_p;
-	} while ((c >= 'a' && c <= 'z') ||
+	} while ( IsNameChar( *idLexer::script_p ) );
+	token->data[token->len] = '\0';
+	//the sub type is the length of the name
+	token->subtype = token->Length();
+	return 1;
+}
+
+/*
+================
+idLexer::IsNameChar
+================
+*/
+ID_INLINE bool idLexer::IsNameChar( char c ) const {
+	return ( (c >= 'a' && c <= 'z') ||
 				(c >= 'A' && c <= 'Z') ||
 				(c >= '0' && c <= '9') ||
 				c == '_' ||
@@ -546,10 +558,6 @@ int idLexer::ReadName( idToken *token ) {
 				((idLexer::flags & LEXFL_ONLYSTRINGS) && (c == '-')) ||
 				// if special path name characters are allowed
 				((idLexer::flags & LEXFL_ALLOWPATHNAMES) && (c == '/' || c == '\\' || c == ':' || c == '.')) );
-	token->data[token->len] = '\0';
-	//the sub type is the length of the name
-	token->subtype = token->Length();
-	return 1;
 }
 
 /*
@@ -769,15 +777,19 @@ int idLexer::ReadNumber( idToken *token ) {
 
 /*
 ================
-idLexer::ReadPunctuation
+idLexer::FindPunctuation
+
+  Returns the punctuation at the current script position or NULL.
 ================
 */
-int idLexer::ReadPunctuation( idToken *token ) {
-	int l, n, i;
-	char *p;
+const punctuation_t *idLexer::FindPunctuation( int *length ) const {
+	int l;
+	const char *p;
 	const punctuation_t *punc;
 
 #ifdef PUNCTABLE
+	int n;
+
 	for (n = idLexer::punctuationtable[(unsigned int)*(idLexer::script_p)]; n >= 0; n = idLexer::nextpunctuation[n])
 	{
 		punc = &(idLexer::punctuations[n]);
@@ -795,21 +807,214 @@ int idLexer::ReadPunctuation( idToken *token ) {
 			}
 		}
 		if ( !p[l] ) {
-			//
-			token->EnsureAlloced( l+1, false );
-			for ( i = 0; i <= l; i++ ) {
-				token->data[i] = p[i];
+			*length = l;
+			return punc;
+		}
+	}
+	return NULL;
+}
+
+/*
+================
+idLexer::ReadPunctuation
+================
+*/
+int idLexer::ReadPunctuation( idToken *token ) {
+	int l, i;
+	const punctuation_t *punc;
+
+	punc = FindPunctuation( &l );
+	if ( !punc ) {
+		return 0;
+	}
+	//
+	token->EnsureAlloced( l+1, false );
+	for ( i = 0; i <= l; i++ ) {
+		token->data[i] = punc->p[i];
+	}
+	token->len = l;
+	//
+	idLexer::script_p += l;
+	token->type = TT_PUNCTUATION;
+	// sub type is the punctuation id
+	token->subtype = punc->n;
+	return 1;
+}
+
+/*
+================
+idLexer::ReadStringView
+
+Only copies the string when it contains escape characters or is
+concatenated with the next string.
+================
+*/
+int idLexer::ReadStringView( idTokenView *token, int quote ) {
+	int tmpline, startline;
+	const char *tmpscript_p, *start, *end;
+
+	start = idLexer::script_p;
+	startline = idLexer::line;
+	end = NULL;
+
+	// leading quote
+	idLexer::script_p++;
+
+	while(1) {
+		// escape characters need a copy
+		if (*idLexer::script_p == '\\' && !(idLexer::flags & LEXFL_NOSTRINGESCAPECHARS)) {
+			break;
+		}
+		// if a trailing quote
+		else if (*idLexer::script_p == quote) {
+			end = idLexer::script_p;
+			// step over the quote
+			idLexer::script_p++;
+			// if consecutive strings should not be concatenated
+			if ( (idLexer::flags & LEXFL_NOSTRINGCONCAT) &&
+					(!(idLexer::flags & LEXFL_ALLOWBACKSLASHSTRINGCONCAT) || (quote != '\"')) ) {
+				break;
 			}
-			token->len = l;
-			//
-			idLexer::script_p += l;
-			token->type = TT_PUNCTUATION;
-			// sub type is the punctuation id
-			token->subtype = punc->n;
-			return 1;
+
+			tmpscript_p = idLexer::script_p;
+			tmpline = idLexer::line;
+			// read white space between possible two consecutive strings
+			if ( !idLexer::ReadWhiteSpace() ) {
+				idLexer::script_p = tmpscript_p;
+				idLexer::line = tmpline;
+				break;
+			}
+			// if there's no string to concatenate
+			if ( ( idLexer::flags & LEXFL_NOSTRINGCONCAT ) ? ( *idLexer::script_p != '\\' ) : ( *idLexer::script_p != quote ) ) {
+				idLexer::script_p = tmpscript_p;
+				idLexer::line = tmpline;
+				break;
+			}
+			// concatenated strings need a copy
+			end = NULL;
+			break;
+		}
+		else {
+			if (*idLexer::script_p == '\0') {
+				idLexer::Error( "missing trailing quote" );
+				return 0;
+			}
+			if (*idLexer::script_p == '\n') {
+				idLexer::Error( "newline inside string" );
+				return 0;
+			}
+			idLexer::script_p++;
 		}
 	}
-	return 0;
+
+	if ( end ) {
+		token->SetText( start + 1, end - start - 1 );
+		if ( quote == '\"' ) {
+			token->type = TT_STRING;
+			// the sub type is the length of the string
+			token->subtype = token->Length();
+		} else {
+			token->type = TT_LITERAL;
+			if ( !(idLexer::flags & LEXFL_ALLOWMULTICHARLITERALS) ) {
+				if ( token->Length() != 1 ) {
+					idLexer::Warning( "literal is not one character long" );
+				}
+			}
+			token->subtype = token->Length() ? start[1] : 0;
+		}
+		return 1;
+	}
+
+	// read the string again into a token owned by the lexer
+	idLexer::script_p = start;
+	idLexer::line = startline;
+	viewToken.data[0] = '\0';
+	viewToken.len = 0;
+	if ( !idLexer::ReadString( &viewToken, quote ) ) {
+		return 0;
+	}
+	token->SetText( viewToken.c_str(), viewToken.Length() );
+	token->type = viewToken.type;
+	token->subtype = viewToken.subtype;
+	return 1;
+}
+
+/*
+================
+idLexer::ReadNameView
+================
+*/
+int idLexer::ReadNameView( idTokenView *token ) {
+	const char *start;
+
+	start = idLexer::script_p;
+	do {
+		idLexer::script_p++;
+	} while ( IsNameChar( *idLexer::script_p ) );
+	token->SetText( start, idLexer::script_p - start );
+	token->type = TT_NAME;
+	//the sub type is the length of the name
+	token->subtype = token->Length();
+	return 1;
+}
+
+/*
+================
+idLexer::ReadNumberView
+
+Numbers are short, they are classified by ReadNumber in a token owned by
+the lexer which never needs to allocate memory.
+================
+*/
+int idLexer::ReadNumberView( idTokenView *token ) {
+	const char *start;
+	int c;
+
+	start = idLexer::script_p;
+	viewToken.data[0] = '\0';
+	viewToken.len = 0;
+	if ( !idLexer::ReadNumber( &viewToken ) ) {
+		return 0;
+	}
+	// if names are allowed to start with a number
+	if ( idLexer::flags & LEXFL_ALLOWNUMBERNAMES ) {
+		c = *idLexer::script_p;
+		if ( (c >= 'a' && c <= 'z') ||	(c >= 'A' && c <= 'Z') || c == '_' ) {
+			if ( !idLexer::ReadName( &viewToken ) ) {
+				return 0;
+			}
+		}
+	}
+	// point into the script unless a number suffix was dropped from the middle of the text
+	if ( memcmp( start, viewToken.c_str(), viewToken.Length() ) == 0 ) {
+		token->SetText( start, viewToken.Length() );
+	} else {
+		token->SetText( viewToken.c_str(), viewToken.Length() );
+	}
+	token->type = viewToken.type;
+	token->subtype = viewToken.subtype;
+	return 1;
+}
+
+/*
+================
+idLexer::ReadPunctuationView
+================
+*/
+int idLexer::ReadPunctuationView( idTokenView *token ) {
+	int l;
+	const punctuation_t *punc;
+
+	punc = FindPunctuation( &l );
+	if ( !punc ) {
+		return 0;
+	}
+	token->SetText( idLexer::script_p, l );
+	idLexer::script_p += l;
+	token->type = TT_PUNCTUATION;
+	// sub type is the punctuation id
+	token->subtype = punc->n;
+	return 1;
 }
 
 /*
@@ -911,20 +1116,112 @@ int idLexer::ReadToken( idToken *token ) {
 	return 1;
 }
 
+/*
+================
+idLexer::ReadToken
+================
+*/
+int idLexer::ReadToken( idTokenView *token ) {
+	int c;
+
+	if ( !loaded ) {
+		idLib::common->Error( "idLexer::ReadToken: no file loaded" );
+		return 0;
+	}
+
+	// if there is a token available (from unreadToken)
+	if ( tokenavailable ) {
+		tokenavailable = 0;
+		token->SetText( idLexer::token.c_str(), idLexer::token.Length() );
+		token->type = idLexer::token.type;
+		token->subtype = idLexer::token.subtype & ~TT_VALUESVALID;
+		token->line = idLexer::token.line;
+		token->linesCrossed = idLexer::token.linesCrossed;
+		token->flags = idLexer::token.flags;
+		return 1;
+	}
+	// save script pointer
+	lastScript_p = script_p;
+	// save line counter
+	lastline = line;
+	// clear the token stuff
+	token->SetText( "", 0 );
+	// start of the white space
+	whiteSpaceStart_p = script_p;
+	// read white space before token
+	if ( !ReadWhiteSpace() ) {
+		return 0;
+	}
+	// end of the white space
+	idLexer::whiteSpaceEnd_p = script_p;
+	// line the token is on
+	token->line = line;
+	// number of lines crossed before token
+	token->linesCrossed = line - lastline;
+	// clear token flags
+	token->flags = 0;
+
+	c = *idLexer::script_p;
+
+	// if we're keeping everything as whitespace deliminated strings
+	if ( idLexer::flags & LEXFL_ONLYSTRINGS ) {
+		// if there is a leading quote
+		if ( c == '\"' || c == '\'' ) {
+			if (!idLexer::ReadStringView( token, c )) {
+				return 0;
+			}
+		} else if ( !idLexer::ReadNameView( token ) ) {
+			return 0;
+		}
+	}
+	// if there is a number
+	else if ( (c >= '0' && c <= '9') ||
+			(c == '.' && (*(idLexer::script_p + 1) >= '0' && *(idLexer::script_p + 1) <= '9')) ) {
+		if ( !idLexer::ReadNumberView( token ) ) {
+			return 0;
+		}
+	}
+	// if there is a leading quote
+	else if ( c == '\"' || c == '\'' ) {
+		if (!idLexer::ReadStringView( token, c )) {
+			return 0;
+		}
+	}
+	// if there is a name
+	else if ( (c >= 'a' && c <= 'z') ||	(c >= 'A' && c <= 'Z') || c == '_' ) {
+		if ( !idLexer::ReadNameView( token ) ) {
+			return 0;
+		}
+	}
+	// names may also start with a slash when pathnames are allowed
+	else if ( ( idLexer::flags & LEXFL_ALLOWPATHNAMES ) && ( (c == '/' || c == '\\') || c == '.' ) ) {
+		if ( !idLexer::ReadNameView( token ) ) {
+			return 0;
+		}
+	}
+	// check for punctuations
+	else if ( !idLexer::ReadPunctuationView( token ) ) {
+		idLexer::Error( "unknown punctuation %c", c );
+		return 0;
+	}
+	// succesfully read a token
+	return 1;
+}
+
 /*
 ================
 idLexer::ExpectTokenString
 ================
 */
 int idLexer::ExpectTokenString( const char *string ) {
-	idToken token;
+	idTokenView token;
 
 	if (!idLexer::ReadToken( &token )) {
 		idLexer::Error( "couldn't find expected '%s'", string );
 		return 0;
 	}
 	if ( token != string ) {
-		idLexer::Error( "expected '%s' but found '%s'", string, token.c_str() );
+		idLexer::Error( "expected '%s' but found '%s'", string, idStr( token ).c_str() );
 		return 0;
 	}
 	return 1;
@@ -1005,7 +1302,7 @@ idLexer::CheckTokenString
 ================
 */
 int idLexer::CheckTokenString( const char *string ) {
-	idToken tok;
+	idTokenView tok;
 
 	if ( !ReadToken( &tok ) ) {
 		return 0;
@@ -1048,7 +1345,7 @@ idLexer::PeekTokenString
 ================
 */
 int idLexer::PeekTokenString( const char *string ) {
-	idToken tok;
+	idTokenView tok;
 
 	if ( !ReadToken( &tok ) ) {
 		return 0;
@@ -1095,7 +1392,7 @@ idLexer::SkipUntilString
 ================
 */
 int idLexer::SkipUntilString( const char *string ) {
-	idToken token;
+	idTokenView token;
 
 	while(idLexer::ReadToken( &token )) {
 		if ( token == string ) {
@@ -1111,7 +1408,7 @@ idLexer::SkipRestOfLine
 ================
 */
 int idLexer::SkipRestOfLine( void ) {
-	idToken token;
+	idTokenView token;
 
 	while(idLexer::ReadToken( &token )) {
 		if ( token.linesCrossed ) {
@@ -1132,7 +1429,7 @@ Internal brace depths are properly skipped.
 =================
 */
 int idLexer::SkipBracedSection( bool parseFirstBrace ) {
-	idToken token;
+	idTokenView token;
 	int depth;
 
 	depth = parseFirstBrace ? 0 : 1;
@@ -1164,6 +1461,22 @@ void idLexer::UnreadToken( const idToken *token ) {
 	idLexer::tokenavailable = 1;
 }
 
+/*
+================
+idLexer::UnreadToken
+================
+*/
+void idLexer::UnreadToken( const idTokenView *token ) {
+	if ( idLexer::tokenavailable ) {
+		idLib::common->FatalError( "idLexer::unreadToken, unread token twice\n" );
+	}
+	// the view may point into the available token
+	token->ToToken( &this->token );
+	idLexer::token.whiteSpaceStart_p = whiteSpaceStart_p;
+	idLexer::token.whiteSpaceEnd_p = whiteSpaceEnd_p;
+	idLexer::tokenavailable = 1;
+}
+
 /*
 ================
 idLexer::ReadTokenOnLine
@@ -1189,6 +1502,31 @@ int idLexer::ReadTokenOnLine( idToken *token ) {
 	return false;
 }
 
+/*
+================
+idLexer::ReadTokenOnLine
+================
+*/
+int idLexer::ReadTokenOnLine( idTokenView *token ) {
+	idTokenView tok;
+
+	if (!idLexer::ReadToken( &tok )) {
+		idLexer::script_p = lastScript_p;
+		idLexer::line = lastline;
+		return false;
+	}
+	// if no lines were crossed before this token
+	if ( !tok.linesCrossed ) {
+		*token = tok;
+		return true;
+	}
+	// restore our position
+	idLexer::script_p = lastScript_p;
+	idLexer::line = lastline;
+	token->SetText( "", 0 );
+	return false;
+}
+
 /*
 ================
 idLexer::ReadRestOfLine
@@ -1225,18 +1563,19 @@ idLexer::ParseInt
 ================
 */
 int idLexer::ParseInt( void ) {
-	idToken token;
+	idTokenView token;
 
 	if ( !idLexer::ReadToken( &token ) ) {
 		idLexer::Error( "couldn't read expected integer" );
 		return 0;
 	}
 	if ( token.type == TT_PUNCTUATION && token == "-" ) {
-		idLexer::ExpectTokenType( TT_NUMBER, TT_INTEGER, &token );
-		return -((signed int) token.GetIntValue());
+		idToken number;
+		idLexer::ExpectTokenType( TT_NUMBER, TT_INTEGER, &number );
+		return -((signed int) number.GetIntValue());
 	}
 	else if ( token.type != TT_NUMBER || token.subtype == TT_FLOAT ) {
-		idLexer::Error( "expected integer value, found '%s'", token.c_str() );
+		idLexer::Error( "expected integer value, found '%s'", idStr( token ).c_str() );
 	}
 	return token.GetIntValue();
 }
@@ -1262,7 +1601,7 @@ idLexer::ParseFloat
 ================
 */
 float idLexer::ParseFloat( bool *errorFlag ) {
-	idToken token;
+	idTokenView token;
 
 	if ( errorFlag ) {
 		*errorFlag = false;
@@ -1278,15 +1617,16 @@ float idLexer::ParseFloat( bool *errorFlag ) {
 		return 0;
 	}
 	if ( token.type == TT_PUNCTUATION && token == "-" ) {
-		idLexer::ExpectTokenType( TT_NUMBER, 0, &token );
-		return -token.GetFloatValue();
+		idToken number;
+		idLexer::ExpectTokenType( TT_NUMBER, 0, &number );
+		return -number.GetFloatValue();
 	}
 	else if ( token.type != TT_NUMBER ) {
 		if ( errorFlag ) {
-			idLexer::Warning( "expected float value, found '%s'", token.c_str() );
+			idLexer::Warning( "expected float value, found '%s'", idStr( token ).c_str() );
 			*errorFlag = true;
 		} else {
-			idLexer::Error( "expected float value, found '%s'", token.c_str() );
+			idLexer::Error( "expected float value, found '%s'", idStr( token ).c_str() );
 		}
 	}
 	return token.GetFloatValue();
@@ -1445,7 +1785,7 @@ Internal brace depths are properly skipped.
 =================
 */
 const char *idLexer::ParseBracedSection( idStr &out ) {
-	idToken token;
+	idTokenView token;
 	int i, depth;
 
 	out.Empty();
@@ -1475,10 +1815,12 @@ const char *idLexer::ParseBracedSection( idStr &out ) {
 		}
 
 		if ( token.type == TT_STRING ) {
-			out += "\"" + token + "\"";
+			out += "\"";
+			out.Append( token );
+			out += "\"";
 		}
 		else {
-			out += token;
+			out.Append( token );
 		}
 		out += " ";
 	} while( depth );
@@ -1494,7 +1836,7 @@ idLexer::ParseRestOfLine
 =================
 */
 const char *idLexer::ParseRestOfLine( idStr &out ) {
-	idToken token;
+	idTokenView token;
 
 	out.Empty();
 	while(idLexer::ReadToken( &token )) {
@@ -1506,7 +1848,7 @@ const char *idLexer::ParseRestOfLine( idStr &out ) {
 		if ( out.Length() ) {
 			out += " ";
 		}
-		out += token;
+		out.Append( token );
 	}
 	return out.c_str();
 }
@@ -1517,9 +1859,23 @@ idLexer::GetLastWhiteSpace
 ================
 */
 int idLexer::GetLastWhiteSpace( idStr &whiteSpace ) const {
-	whiteSpace.Clear();
-	for ( const char *p = whiteSpaceStart_p; p < whiteSpaceEnd_p; p++ ) {
-		whiteSpace.Append( *p );
+	idStrView view;
+
+	GetLastWhiteSpace( view );
+	whiteSpace = view;
+	return whiteSpace.Length();
+}
+
+/*
+================
+idLexer::GetLastWhiteSpace
+================
+*/
+int idLexer::GetLastWhiteSpace( idStrView &whiteSpace ) const {
+	if ( whiteSpaceStart_p && whiteSpaceEnd_p > whiteSpaceStart_p ) {
+		whiteSpace = idStrView( whiteSpaceStart_p, whiteSpaceEnd_p - whiteSpaceStart_p );
+	} else {
+		whiteSpace = idStrView();
 	}
 	return whiteSpace.Length();
 }
@@ -1713,6 +2069,7 @@ idLexer::idLexer( void ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 }
 
 /*
@@ -1734,6 +2091,7 @@ idLexer::idLexer( int flags ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 }
 
 /*
@@ -1749,6 +2107,7 @@ idLexer::idLexer( const char *filename, int flags, bool OSPath ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 	idLexer::LoadFile( filename, OSPath );
 }
 
@@ -1765,6 +2124,7 @@ idLexer::idLexer( const char *ptr, int length, const char *name, int flags ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 	idLexer::LoadMemory( ptr, length, name );
 }
 
@@ -1795,3 +2155,12 @@ bool idLexer::HadError( void ) const {
 	return hadError;
 }
 
+/*
+================
+idLexer::HadWarning
+================
+*/
+bool idLexer::HadWarning( void ) const {
+	return hadWarning;
+}
+
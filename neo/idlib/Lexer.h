@@ -37,6 +37,8 @@ If you have questions concerning this license or the applicable additional terms
 	Does not use memory allocation during parsing. The lexer uses no
 	memory allocation if a source is loaded with LoadMemory().
 	However, idToken may still allocate memory for large strings.
+	Tokens read as idTokenView are not copied at all, they point into
+	the script buffer.
 	
 	A number directly following the escape character '\' in a string is
 	assumed to be in decimal format instead of octal. Binary numbers of
@@ -158,6 +160,8 @@ public:
 	int				IsLoaded( void ) { return idLexer::loaded; };
 					// read a token
 	int				ReadToken( idToken *token );
+					// read a token without copying the text
+	int				ReadToken( idTokenView *token );
 					// expect a certain token, reads the token when available
 	int				ExpectTokenString( const char *string );
 					// expect a certain token type
@@ -180,8 +184,10 @@ public:
 	int				SkipBracedSection( bool parseFirstBrace = true );
 					// unread the given token
 	void			UnreadToken( const idToken *token );
+	void			UnreadToken( const idTokenView *token );
 					// read a token only if on the same line
 	int				ReadTokenOnLine( idToken *token );
+	int				ReadTokenOnLine( idTokenView *token );
 		
 					//Returns the rest of the current line
 	const char*		ReadRestOfLine(idStr& out);
@@ -205,6 +211,8 @@ public:
 	const char *	ParseRestOfLine( idStr &out );
 					// retrieves the white space characters before the last read token
 	int				GetLastWhiteSpace( idStr &whiteSpace ) const;
+					// same as above without copying, the view points into the script buffer
+	int				GetLastWhiteSpace( idStrView &whiteSpace ) const;
 					// returns start index into text buffer of last white space
 	int				GetLastWhiteSpaceStart( void ) const;
 					// returns end index into text buffer of last white space
@@ -237,6 +245,8 @@ public:
 	void			Warning( const char *str, ... ) id_attribute((format(printf,2,3)));
 					// returns true if Error() was called with LEXFL_NOFATALERRORS or LEXFL_NOERRORS set
 	bool			HadError( void ) const;
+					// returns true if Warning() was called, even with LEXFL_NOWARNINGS set
+	bool			HadWarning( void ) const;
 
 					// set the base folder to load files from
 	static void		SetBaseFolder( const char *path );
@@ -261,8 +271,10 @@ private:
 	int *			punctuationtable;		// ASCII table with punctuations
 	int *			nextpunctuation;		// next punctuation in chain
 	idToken			token;					// available token
+	idToken			viewToken;				// text of token views that can't point into the script
 	idLexer *		next;					// next script in a chain
 	bool			hadError;				// set by idLexer::Error, even if the error is supressed
+	bool			hadWarning;				// set by idLexer::Warning, even if the warning is supressed
 
 	static char		baseFolder[ 256 ];		// base folder to load files from
 
@@ -274,6 +286,12 @@ private:
 	int				ReadName( idToken *token );
 	int				ReadNumber( idToken *token );
 	int				ReadPunctuation( idToken *token );
+	int				ReadStringView( idTokenView *token, int quote );
+	int				ReadNameView( idTokenView *token );
+	int				ReadNumberView( idTokenView *token );
+	int				ReadPunctuationView( idTokenView *token );
+	bool			IsNameChar( char c ) const;
+	const punctuation_t *FindPunctuation( int *length ) const;
 	int				ReadPrimitive( idToken *token );
 	int				CheckString( const char *str ) const;
 	int				NumLinesCrossed( void );
@@ -47,6 +47,7 @@ idSys *			idLib::sys			= NULL;
 idCommon *		idLib::common		= NULL;
 idCVarSystem *	idLib::cvarSystem	= NULL;
 idFileSystem *	idLib::fileSystem	= NULL;
+idParallelJobManager *	idLib::parallelJobManager = NULL;
 int				idLib::frameNumber	= 0;
 
 /*
@@ -73,6 +74,9 @@ void idLib::Init( void ) {
 	// initialize math
 	idMath::Init();
 
+	// initialize the CRC-32 slicing tables
+	CRC32_Init();
+
 	// test idMatX
 	//idMatX::Test();
 
@@ -99,10 +103,28 @@ void idLib::ShutDown( void ) {
 	// shut down the SIMD engine
 	idSIMD::Shutdown();
 
+	// free the frame allocator memory
+	frameAllocator.Shutdown();
+
 	// shut down the memory manager
 	Mem_Shutdown();
 }
 
+/*
+================
+idLib::ParallelFor
+================
+*/
+void idLib::ParallelFor( parallelJob_t job, void *data, int count ) {
+	if ( parallelJobManager == NULL ) {
+		for ( int i = 0; i < count; i++ ) {
+			job( data, i );
+		}
+		return;
+	}
+	parallelJobManager->ParallelFor( job, data, count );
+}
+
 
 /*
 ===============================================================================
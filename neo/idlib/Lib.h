@@ -41,23 +41,33 @@ If you have questions concerning this license or the applicable additional terms
 	should be set before using idLib. The pointers stored here should not
 	be used by any part of the engine except for idLib.
 
+	The idParallelJobManager pointer is optional. Without it ParallelFor
+	runs all jobs on the calling thread.
+
 	The frameNumber should be continuously set to the number of the current
 	frame if frame base memory logging is required.
 
 ===============================================================================
 */
 
+// job function run by idLib::ParallelFor
+typedef void (*parallelJob_t)( void *data, int index );
+
 class idLib {
 public:
 	static class idSys *		sys;
 	static class idCommon *		common;
 	static class idCVarSystem *	cvarSystem;
 	static class idFileSystem *	fileSystem;
+	static class idParallelJobManager *	parallelJobManager;
 	static int					frameNumber;
 
 	static void					Init( void );
 	static void					ShutDown( void );
 
+	// calls job( data, i ) for i in [0, count), in parallel when possible
+	static void					ParallelFor( parallelJob_t job, void *data, int count );
+
 	// wrapper to idCommon functions 
 	static void					Error( const char *fmt, ... );
 	static void					Warning( const char *fmt, ... );
@@ -75,6 +85,11 @@ public:
 typedef unsigned char			byte;		// 8 bits
 typedef unsigned short			word;		// 16 bits
 typedef unsigned int			dword;		// 32 bits
+#ifdef _MSC_VER
+typedef unsigned __int64		qword;		// 64 bits
+#else
+typedef unsigned long long		qword;		// 64 bits
+#endif
 typedef unsigned int			uint;
 typedef unsigned long			ulong;
 
@@ -166,6 +181,9 @@ template<class T> ID_INLINE T	Min( T x, T y ) { return ( x < y ) ? x : y; }
 ===============================================================================
 */
 
+// thread synchronization
+#include "Thread.h"
+
 // memory management and arrays
 #include "Heap.h"
 #include "containers/List.h"
@@ -214,26 +232,30 @@ template<class T> ID_INLINE T	Min( T x, T y ) { return ( x < y ) ? x : y; }
 #include "Base64.h"
 #include "CmdArgs.h"
 
+// hashing
+#include "hashing/CRC32.h"
+#include "hashing/MD4.h"
+#include "hashing/MD5.h"
+#include "hashing/XXHash.h"
+
 // containers
 #include "containers/BTree.h"
+#include "containers/PackedBTree.h"
 #include "containers/BinSearch.h"
 #include "containers/HashIndex.h"
 #include "containers/HashTable.h"
+#include "containers/FlatHashTable.h"
 #include "containers/StaticList.h"
 #include "containers/LinkList.h"
 #include "containers/Hierarchy.h"
 #include "containers/Queue.h"
+#include "containers/LockFreeQueue.h"
 #include "containers/Stack.h"
 #include "containers/StrList.h"
 #include "containers/StrPool.h"
 #include "containers/VectorSet.h"
 #include "containers/PlaneSet.h"
 
-// hashing
-#include "hashing/CRC32.h"
-#include "hashing/MD4.h"
-#include "hashing/MD5.h"
-
 // misc
 #include "Dict.h"
 #include "LangDict.h"
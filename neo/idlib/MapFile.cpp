@@ -276,7 +276,7 @@ idMapBrush::Parse
 idMapBrush *idMapBrush::Parse( idLexer &src, const idVec3 &origin, bool newFormat, float version ) {
 	int i;
 	idVec3 planepts[3];
-	idToken token;
+	idTokenView token;
 	idList<idMapBrushSide*> sides;
 	idMapBrushSide	*side;
 	idDict epairs;
@@ -303,12 +303,12 @@ idMapBrush *idMapBrush::Parse( idLexer &src, const idVec3 &origin, bool newForma
 			}
 			// the token should be a key string for a key/value pair
 			if ( token.type != TT_STRING ) {
-				src.Error( "idMapBrush::Parse: unexpected %s, expected ( or epair key string", token.c_str() );
+				src.Error( "idMapBrush::Parse: unexpected %s, expected ( or epair key string", idStr( token ).c_str() );
 				sides.DeleteContents( true );
 				return NULL;
 			}
 
-			idStr key = token;
+			idStr key( token );
 
 			if ( !src.ReadTokenOnLine( &token ) || token.type != TT_STRING ) {
 				src.Error( "idMapBrush::Parse: expected epair value string not found" );
@@ -316,7 +316,7 @@ idMapBrush *idMapBrush::Parse( idLexer &src, const idVec3 &origin, bool newForma
 				return NULL;
 			}
 
-			epairs.Set( key, token );
+			epairs.Set( key, idStr( token ) );
 
 			// try to read the next key
 			if ( !src.ReadToken( &token ) ) {
@@ -372,7 +372,8 @@ idMapBrush *idMapBrush::Parse( idLexer &src, const idVec3 &origin, bool newForma
 
 		// we had an implicit 'textures/' in the old format...
 		if ( version < 2.0f ) {
-			side->material = "textures/" + token;
+			side->material = "textures/";
+			side->material.Append( token );
 		} else {
 			side->material = token;
 		}
@@ -536,7 +537,7 @@ idMapEntity::Parse
 ================
 */
 idMapEntity *idMapEntity::Parse( idLexer &src, bool worldSpawn, float version ) {
-	idToken	token;
+	idTokenView	token;
 	idMapEntity *mapEnt;
 	idMapPatch *mapPatch;
 	idMapBrush *mapBrush;
@@ -549,7 +550,7 @@ idMapEntity *idMapEntity::Parse( idLexer &src, bool worldSpawn, float version )
 	}
 
 	if ( token != "{" ) {
-		src.Error( "idMapEntity::Parse: { not found, found %s", token.c_str() );
+		src.Error( "idMapEntity::Parse: { not found, found %s", idStr( token ).c_str() );
 		return NULL;
 	}
 
@@ -582,7 +583,7 @@ idMapEntity *idMapEntity::Parse( idLexer &src, bool worldSpawn, float version )
 			}
 
 			// if is it a brush: brush, brushDef, brushDef2, brushDef3
-			if ( token.Icmpn( "brush", 5 ) == 0 ) {
+			if ( token.IcmpPrefix( "brush" ) == 0 ) {
 				mapBrush = idMapBrush::Parse( src, origin, ( !token.Icmp( "brushDef2" ) || !token.Icmp( "brushDef3" ) ), version );
 				if ( !mapBrush ) {
 					return NULL;
@@ -590,7 +591,7 @@ idMapEntity *idMapEntity::Parse( idLexer &src, bool worldSpawn, float version )
 				mapEnt->AddPrimitive( mapBrush );
 			}
 			// if is it a patch: patchDef2, patchDef3
-			else if ( token.Icmpn( "patch", 5 ) == 0 ) {
+			else if ( token.IcmpPrefix( "patch" ) == 0 ) {
 				mapPatch = idMapPatch::Parse( src, origin, !token.Icmp( "patchDef3" ), version );
 				if ( !mapPatch ) {
 					return NULL;
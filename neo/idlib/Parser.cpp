@@ -2910,6 +2910,20 @@ int idParser::GetLastWhiteSpace( idStr &whiteSpace ) const {
 	return whiteSpace.Length();
 }
 
+/*
+================
+idParser::GetLastWhiteSpace
+================
+*/
+int idParser::GetLastWhiteSpace( idStrView &whiteSpace ) const {
+	if ( scriptstack ) {
+		scriptstack->GetLastWhiteSpace( whiteSpace );
+	} else {
+		whiteSpace = idStrView();
+	}
+	return whiteSpace.Length();
+}
+
 /*
 ================
 idParser::SetMarker
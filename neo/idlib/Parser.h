@@ -136,6 +136,8 @@ public:
 	int				Parse3DMatrix( int z, int y, int x, float *m );
 					// get the white space before the last read token
 	int				GetLastWhiteSpace( idStr &whiteSpace ) const;
+					// same as above without copying, the view points into the script buffer
+	int				GetLastWhiteSpace( idStrView &whiteSpace ) const;
 					// Set a marker in the source file (there is only one marker)
 	void			SetMarker( void );
 					// Get the string from the marker to the current position
@@ -35,8 +35,11 @@ If you have questions concerning this license or the applicable additional terms
 
 #ifdef USE_STRING_DATA_ALLOCATOR
 static idDynamicBlockAlloc<char, 1<<18, 128>	stringDataAllocator;
+static idSysSpinLock							stringDataLock;		// strings are also built by job threads
 #endif
 
+strAllocCounters_t idStr::allocStats;
+
 idVec4	g_color_table[16] =
 {
 	idVec4(0.0f, 0.0f, 0.0f, 1.0f),
@@ -95,18 +98,29 @@ void idStr::ReAllocate( int amount, bool keepold ) {
 	alloced = newsize;
 
 #ifdef USE_STRING_DATA_ALLOCATOR
+	stringDataLock.Lock();
 	newbuffer = stringDataAllocator.Alloc( alloced );
+	stringDataLock.Unlock();
 #else
 	newbuffer = new char[ alloced ];
 #endif
+	allocStats.numAllocs.Increment();
+	allocStats.numGranules.Add( alloced / STR_ALLOC_GRAN );
+
 	if ( keepold && data ) {
 		data[ len ] = '\0';
 		strcpy( newbuffer, data );
+		if ( len > 0 ) {
+			allocStats.numGrows.Increment();
+		}
 	}
 
 	if ( data && data != baseBuffer ) {
+		allocStats.numFrees.Increment();
 #ifdef USE_STRING_DATA_ALLOCATOR
+		stringDataLock.Lock();
 		stringDataAllocator.Free( data );
+		stringDataLock.Unlock();
 #else
 		delete [] data;
 #endif
@@ -122,8 +136,11 @@ idStr::FreeData
 */
 void idStr::FreeData( void ) {
 	if ( data && data != baseBuffer ) {
+		allocStats.numFrees.Increment();
 #ifdef USE_STRING_DATA_ALLOCATOR
+		stringDataLock.Lock();
 		stringDataAllocator.Free( data );
+		stringDataLock.Unlock();
 #else
 		delete[] data;
 #endif
@@ -890,7 +907,9 @@ idStr &idStr::StripPath( void ) {
 		pos--;
 	}
 
-	*this = Right( Length() - pos );
+	// move the file name down in place instead of going through a temporary
+	len -= pos;
+	memmove( data, data + pos, len + 1 );
 	return *this;
 }
 
@@ -1642,6 +1661,7 @@ idStr::PurgeMemory
 */
 void idStr::PurgeMemory( void ) {
 #ifdef USE_STRING_DATA_ALLOCATOR
+	idScopedSpinLock scopedLock( stringDataLock );
 	stringDataAllocator.FreeEmptyBaseBlocks();
 #endif
 }
@@ -1652,11 +1672,47 @@ idStr::ShowMemoryUsage_f
 ================
 */
 void idStr::ShowMemoryUsage_f( const idCmdArgs &args ) {
+	strAllocStats_t stats;
+
 #ifdef USE_STRING_DATA_ALLOCATOR
 	idLib::common->Printf( "%6d KB string memory (%d KB free in %d blocks, %d empty base blocks)\n",
 		stringDataAllocator.GetBaseBlockMemory() >> 10, stringDataAllocator.GetFreeBlockMemory() >> 10,
 			stringDataAllocator.GetNumFreeBlocks(), stringDataAllocator.GetNumEmptyBaseBlocks() );
 #endif
+	GetAllocStats( stats );
+	idLib::common->Printf( "%6d allocs, %d frees, %d grows, %d moves, %d KB allocated since the last reset\n",
+		stats.numAllocs, stats.numFrees, stats.numGrows, stats.numMoves, (int)( stats.totalSize >> 10 ) );
+	if ( args.Argc() > 1 && idStr::Icmp( args.Argv( 1 ), "reset" ) == 0 ) {
+		ResetAllocStats();
+	}
+}
+
+/*
+================
+idStr::GetAllocStats
+
+  Only counts the strings allocated by the module this idLib is linked into.
+================
+*/
+void idStr::GetAllocStats( strAllocStats_t &stats ) {
+	stats.numAllocs = allocStats.numAllocs.GetValue();
+	stats.numFrees = allocStats.numFrees.GetValue();
+	stats.numGrows = allocStats.numGrows.GetValue();
+	stats.numMoves = allocStats.numMoves.GetValue();
+	stats.totalSize = (size_t)(unsigned int)allocStats.numGranules.GetValue() * STR_ALLOC_GRAN;
+}
+
+/*
+================
+idStr::ResetAllocStats
+================
+*/
+void idStr::ResetAllocStats( void ) {
+	allocStats.numAllocs.SetValue( 0 );
+	allocStats.numFrees.SetValue( 0 );
+	allocStats.numGrows.SetValue( 0 );
+	allocStats.numMoves.SetValue( 0 );
+	allocStats.numGranules.SetValue( 0 );
 }
 
 /*
@@ -73,6 +73,7 @@ If you have questions concerning this license or the applicable additional terms
 #define _vsnprintf		use_idStr_vsnPrintf
 
 class idVec4;
+class idStrView;
 
 #ifndef FILE_HASH_SIZE
 #define FILE_HASH_SIZE		1024
@@ -113,11 +114,32 @@ typedef enum {
 	MEASURE_BANDWIDTH
 } Measure_t;
 
+// idStr heap allocation counters, used to measure string churn
+typedef struct {
+	int					numAllocs;			// heap buffers allocated
+	int					numFrees;			// heap buffers freed
+	int					numGrows;			// allocations that had to keep the old contents
+	int					numMoves;			// heap buffers handed over by a move instead of copied
+	size_t				totalSize;			// bytes allocated
+} strAllocStats_t;
+
+// the counters behind strAllocStats_t, strings are also built by job threads
+typedef struct {
+	idSysInterlockedInteger	numAllocs;
+	idSysInterlockedInteger	numFrees;
+	idSysInterlockedInteger	numGrows;
+	idSysInterlockedInteger	numMoves;
+	idSysInterlockedInteger	numGranules;		// bytes allocated / STR_ALLOC_GRAN
+} strAllocCounters_t;
+
 class idStr {
 
 public:
 						idStr( void );
 						idStr( const idStr &text );
+#ifdef ID_RVALUE_REFERENCES
+						idStr( idStr &&text );
+#endif
 						idStr( const idStr &text, int start, int end );
 						idStr( const char *text );
 						idStr( const char *text, int start, int end );
@@ -126,6 +148,7 @@ public:
 						explicit idStr( const int i );
 						explicit idStr( const unsigned u );
 						explicit idStr( const float f );
+						explicit idStr( const idStrView &text );
 						~idStr( void );
 
 	size_t				Size( void ) const;
@@ -138,6 +161,10 @@ public:
 
 	void				operator=( const idStr &text );
 	void				operator=( const char *text );
+	void				operator=( const idStrView &text );
+#ifdef ID_RVALUE_REFERENCES
+	void				operator=( idStr &&text );
+#endif
 
 	friend idStr		operator+( const idStr &a, const idStr &b );
 	friend idStr		operator+( const idStr &a, const char *b );
@@ -194,6 +221,7 @@ public:
 	void				Append( const idStr &text );
 	void				Append( const char *text );
 	void				Append( const char *text, int len );
+	void				Append( const idStrView &text );
 	void				Insert( const char a, int index );
 	void				Insert( const char *text, int index );
 	void				ToLower( void );
@@ -308,6 +336,8 @@ public:
 	static void			ShutdownMemory( void );
 	static void			PurgeMemory( void );
 	static void			ShowMemoryUsage_f( const idCmdArgs &args );
+	static void			GetAllocStats( strAllocStats_t &stats );
+	static void			ResetAllocStats( void );
 
 	int					DynamicMemoryUsed() const;
 	static idStr		FormatNumber( int number );
@@ -318,6 +348,8 @@ protected:
 	int					alloced;
 	char				baseBuffer[ STR_ALLOC_BASE ];
 
+	static strAllocCounters_t	allocStats;
+
 	void				Init( void );										// initialize string using base buffer
 	void				EnsureAlloced( int amount, bool keepold = true );	// ensure string data buffer is large anough
 };
@@ -325,6 +357,68 @@ protected:
 char *					va( const char *fmt, ... ) id_attribute((format(printf,1,2)));
 
 
+/*
+===============================================================================
+
+	Non-owning string view
+
+	A pointer and a length into characters owned by someone else, for example
+	an idStr, a lexer buffer or a path passed in as a const char *. The view
+	never allocates and is only valid as long as the characters it points to.
+	The characters are not necessarily '\0' terminated, use Copynz or
+	construct an idStr when a C string is needed.
+
+===============================================================================
+*/
+
+class idStrView {
+public:
+						idStrView( void );
+						idStrView( const char *text );
+						idStrView( const char *text, int length );
+						idStrView( const idStr &text );
+
+	const char *		Ptr( void ) const;								// not necessarily '\0' terminated
+	int					Length( void ) const;
+	bool				IsEmpty( void ) const;
+	char				operator[]( int index ) const;
+
+						// case sensitive compare
+	int					Cmp( const idStrView &text ) const;
+	int					CmpPrefix( const idStrView &text ) const;
+
+						// case insensitive compare
+	int					Icmp( const idStrView &text ) const;
+	int					IcmpPrefix( const idStrView &text ) const;
+
+	int					Find( const char c, int start = 0 ) const;
+	int					Last( const char c ) const;						// return the index to the last occurance of 'c', returns -1 if not found
+	idStrView			Left( int len ) const;							// the leftmost 'len' characters
+	idStrView			Right( int len ) const;							// the rightmost 'len' characters
+	idStrView			Mid( int start, int len ) const;				// 'len' characters starting at 'start'
+	idStrView &			StripLeading( const char c );					// strip char from front as many times as the char occurs
+	idStrView &			StripTrailing( const char c );					// strip char from end as many times as the char occurs
+
+	// file name methods, same results as the idStr methods without copying
+	idStrView &			StripFileExtension( void );						// remove any file extension
+	idStrView &			StripFilename( void );							// remove the filename from a path
+	idStrView &			StripPath( void );								// remove the path from the filename
+	idStrView			FileExtension( void ) const;					// the file extension without the '.'
+
+	int					Hash( void ) const;
+	int					IHash( void ) const;							// case insensitive
+	void				Copynz( char *dest, int destsize ) const;		// copy to a '\0' terminated buffer
+
+private:
+	const char *		ptr;
+	int					len;
+};
+
+						// case sensitive compare
+bool					operator==( const idStrView &a, const idStrView &b );
+bool					operator!=( const idStrView &a, const idStrView &b );
+
+
 ID_INLINE void idStr::EnsureAlloced( int amount, bool keepold ) {
 	if ( amount > alloced ) {
 		ReAllocate( amount, keepold );
@@ -355,6 +449,31 @@ ID_INLINE idStr::idStr( const idStr &text ) {
 	len = l;
 }
 
+#ifdef ID_RVALUE_REFERENCES
+ID_INLINE idStr::idStr( idStr &&text ) {
+	Init();
+	if ( text.data == text.baseBuffer ) {
+		memcpy( data, text.data, text.len + 1 );
+		len = text.len;
+		return;
+	}
+	// take over the heap buffer
+	len = text.len;
+	data = text.data;
+	alloced = text.alloced;
+	text.Init();
+	allocStats.numMoves.Increment();
+}
+#endif
+
+ID_INLINE idStr::idStr( const idStrView &text ) {
+	Init();
+	EnsureAlloced( text.Length() + 1 );
+	memcpy( data, text.Ptr(), text.Length() );
+	data[ text.Length() ] = '\0';
+	len = text.Length();
+}
+
 ID_INLINE idStr::idStr( const idStr &text, int start, int end ) {
 	int i;
 	int l;
@@ -516,6 +635,36 @@ ID_INLINE void idStr::operator=( const idStr &text ) {
 	len = l;
 }
 
+ID_INLINE void idStr::operator=( const idStrView &text ) {
+	int l;
+
+	// the view may point into this string, it never needs a larger buffer then
+	l = text.Length();
+	EnsureAlloced( l + 1, false );
+	memmove( data, text.Ptr(), l );
+	data[l] = '\0';
+	len = l;
+}
+
+#ifdef ID_RVALUE_REFERENCES
+ID_INLINE void idStr::operator=( idStr &&text ) {
+	if ( text.data == text.baseBuffer ) {
+		operator=( static_cast<const idStr &>( text ) );
+		return;
+	}
+	if ( this == &text ) {
+		return;
+	}
+	// take over the heap buffer
+	FreeData();
+	len = text.len;
+	data = text.data;
+	alloced = text.alloced;
+	text.Init();
+	allocStats.numMoves.Increment();
+}
+#endif
+
 ID_INLINE idStr operator+( const idStr &a, const idStr &b ) {
 	idStr result( a );
 	result.Append( b );
@@ -776,6 +925,16 @@ ID_INLINE void idStr::Append( const char *text, int l ) {
 	}
 }
 
+ID_INLINE void idStr::Append( const idStrView &text ) {
+	int newLen;
+
+	newLen = len + text.Length();
+	EnsureAlloced( newLen + 1 );
+	memcpy( data + len, text.Ptr(), text.Length() );
+	len = newLen;
+	data[ len ] = '\0';
+}
+
 ID_INLINE void idStr::Insert( const char a, int index ) {
 	int i, l;
 
@@ -1041,4 +1200,189 @@ ID_INLINE int idStr::DynamicMemoryUsed() const {
 	return ( data == baseBuffer ) ? 0 : alloced;
 }
 
+ID_INLINE idStrView::idStrView( void ) {
+	ptr = "";
+	len = 0;
+}
+
+ID_INLINE idStrView::idStrView( const char *text ) {
+	ptr = text ? text : "";
+	len = idStr::Length( ptr );
+}
+
+ID_INLINE idStrView::idStrView( const char *text, int length ) {
+	assert( length >= 0 );
+	ptr = text;
+	len = length;
+}
+
+ID_INLINE idStrView::idStrView( const idStr &text ) {
+	ptr = text.c_str();
+	len = text.Length();
+}
+
+ID_INLINE const char *idStrView::Ptr( void ) const {
+	return ptr;
+}
+
+ID_INLINE int idStrView::Length( void ) const {
+	return len;
+}
+
+ID_INLINE bool idStrView::IsEmpty( void ) const {
+	return ( len == 0 );
+}
+
+ID_INLINE char idStrView::operator[]( int index ) const {
+	assert( ( index >= 0 ) && ( index < len ) );
+	return ptr[ index ];
+}
+
+ID_INLINE bool operator==( const idStrView &a, const idStrView &b ) {
+	return ( a.Length() == b.Length() && memcmp( a.Ptr(), b.Ptr(), a.Length() ) == 0 );
+}
+
+ID_INLINE bool operator!=( const idStrView &a, const idStrView &b ) {
+	return !( a == b );
+}
+
+ID_INLINE int idStrView::Cmp( const idStrView &text ) const {
+	int d = memcmp( ptr, text.ptr, Min( len, text.len ) );
+	if ( d != 0 ) {
+		return ( d < 0 ) ? -1 : 1;
+	}
+	return ( len < text.len ) ? -1 : ( len > text.len );
+}
+
+ID_INLINE int idStrView::CmpPrefix( const idStrView &text ) const {
+	if ( len < text.len ) {
+		return Cmp( text );
+	}
+	return memcmp( ptr, text.ptr, text.len );
+}
+
+ID_INLINE int idStrView::Icmp( const idStrView &text ) const {
+	int d = idStr::Icmpn( ptr, text.ptr, Min( len, text.len ) );
+	if ( d != 0 ) {
+		return d;
+	}
+	return ( len < text.len ) ? -1 : ( len > text.len );
+}
+
+ID_INLINE int idStrView::IcmpPrefix( const idStrView &text ) const {
+	if ( len < text.len ) {
+		return Icmp( text );
+	}
+	return idStr::Icmpn( ptr, text.ptr, text.len );
+}
+
+ID_INLINE int idStrView::Find( const char c, int start ) const {
+	for ( int i = start; i < len; i++ ) {
+		if ( ptr[i] == c ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+ID_INLINE int idStrView::Last( const char c ) const {
+	for ( int i = len - 1; i >= 0; i-- ) {
+		if ( ptr[i] == c ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+ID_INLINE idStrView idStrView::Left( int l ) const {
+	return idStrView( ptr, idMath::ClampInt( 0, len, l ) );
+}
+
+ID_INLINE idStrView idStrView::Right( int l ) const {
+	l = idMath::ClampInt( 0, len, l );
+	return idStrView( ptr + len - l, l );
+}
+
+ID_INLINE idStrView idStrView::Mid( int start, int l ) const {
+	start = idMath::ClampInt( 0, len, start );
+	return idStrView( ptr + start, idMath::ClampInt( 0, len - start, l ) );
+}
+
+ID_INLINE idStrView &idStrView::StripLeading( const char c ) {
+	while( len > 0 && ptr[0] == c ) {
+		ptr++;
+		len--;
+	}
+	return *this;
+}
+
+ID_INLINE idStrView &idStrView::StripTrailing( const char c ) {
+	while( len > 0 && ptr[len - 1] == c ) {
+		len--;
+	}
+	return *this;
+}
+
+ID_INLINE idStrView &idStrView::StripFileExtension( void ) {
+	int i = Last( '.' );
+	if ( i >= 0 ) {
+		len = i;
+	}
+	return *this;
+}
+
+ID_INLINE idStrView &idStrView::StripFilename( void ) {
+	int pos;
+
+	pos = len - 1;
+	while( ( pos > 0 ) && ( ptr[ pos ] != '/' ) && ( ptr[ pos ] != '\\' ) ) {
+		pos--;
+	}
+	len = Max( pos, 0 );
+	return *this;
+}
+
+ID_INLINE idStrView &idStrView::StripPath( void ) {
+	int pos;
+
+	pos = len;
+	while( ( pos > 0 ) && ( ptr[ pos - 1 ] != '/' ) && ( ptr[ pos - 1 ] != '\\' ) ) {
+		pos--;
+	}
+	ptr += pos;
+	len -= pos;
+	return *this;
+}
+
+ID_INLINE idStrView idStrView::FileExtension( void ) const {
+	int pos;
+
+	pos = len - 1;
+	while( ( pos > 0 ) && ( ptr[ pos - 1 ] != '.' ) ) {
+		pos--;
+	}
+	if ( pos <= 0 ) {
+		// no extension
+		return idStrView();
+	}
+	return idStrView( ptr + pos, len - pos );
+}
+
+ID_INLINE int idStrView::Hash( void ) const {
+	return idStr::Hash( ptr, len );
+}
+
+ID_INLINE int idStrView::IHash( void ) const {
+	return idStr::IHash( ptr, len );
+}
+
+ID_INLINE void idStrView::Copynz( char *dest, int destsize ) const {
+	int l;
+
+	assert( destsize > 0 );
+	l = Min( len, destsize - 1 );
+	memcpy( dest, ptr, l );
+	dest[l] = '\0';
+}
+
 #endif /* !__STR_H__ */
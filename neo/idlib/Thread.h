@@ -0,0 +1,282 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __THREAD_H__
+#define __THREAD_H__
+
+/*
+===============================================================================
+
+	Thread synchronization primitives.
+
+	Implemented inline with compiler intrinsics so idLib can use them in both
+	the engine and the game module without going through the idSys interface.
+	None of these ever block in the operating system. Use the Sys_ critical
+	sections and events for anything that has to wait for a long time.
+
+===============================================================================
+*/
+
+#ifdef _WIN32
+	#define ID_THREAD_LOCAL				__declspec( thread )
+#else
+	#include <sched.h>
+	#define ID_THREAD_LOCAL				__thread
+#endif
+
+// size of a cache line, used to pad data touched by different threads
+#define ID_CACHE_LINE_SIZE				64
+
+
+class idSysAtomic {
+public:
+	static int				Increment( volatile int *value );					// returns the new value
+	static int				Decrement( volatile int *value );					// returns the new value
+	static int				Add( volatile int *value, int i );					// returns the new value
+	static int				Exchange( volatile int *value, int exchange );		// returns the previous value
+	static int				CompareExchange( volatile int *value, int comparand, int exchange );	// returns the previous value
+	static void *			ExchangePointer( void * volatile *ptr, void *exchange );
+	static void *			CompareExchangePointer( void * volatile *ptr, void *comparand, void *exchange );
+	static int				LoadAcquire( const volatile int *value );			// later loads and stores are not moved before this
+	static void				StoreRelease( volatile int *value, int i );			// earlier loads and stores are not moved after this
+
+	static void				FullBarrier( void );								// no loads or stores are moved across this
+	static void				Pause( void );										// spin wait hint
+	static void				YieldThread( void );								// give up the rest of the time slice
+};
+
+ID_INLINE int idSysAtomic::Increment( volatile int *value ) {
+#ifdef _WIN32
+	return InterlockedIncrement( (volatile LONG *)value );
+#else
+	return __sync_add_and_fetch( value, 1 );
+#endif
+}
+
+ID_INLINE int idSysAtomic::Decrement( volatile int *value ) {
+#ifdef _WIN32
+	return InterlockedDecrement( (volatile LONG *)value );
+#else
+	return __sync_sub_and_fetch( value, 1 );
+#endif
+}
+
+ID_INLINE int idSysAtomic::Add( volatile int *value, int i ) {
+#ifdef _WIN32
+	return InterlockedExchangeAdd( (volatile LONG *)value, i ) + i;
+#else
+	return __sync_add_and_fetch( value, i );
+#endif
+}
+
+ID_INLINE int idSysAtomic::Exchange( volatile int *value, int exchange ) {
+#ifdef _WIN32
+	return InterlockedExchange( (volatile LONG *)value, exchange );
+#else
+	return __sync_lock_test_and_set( value, exchange );
+#endif
+}
+
+ID_INLINE int idSysAtomic::CompareExchange( volatile int *value, int comparand, int exchange ) {
+#ifdef _WIN32
+	return InterlockedCompareExchange( (volatile LONG *)value, exchange, comparand );
+#else
+	return __sync_val_compare_and_swap( value, comparand, exchange );
+#endif
+}
+
+ID_INLINE void *idSysAtomic::ExchangePointer( void * volatile *ptr, void *exchange ) {
+#ifdef _WIN32
+	return InterlockedExchangePointer( ptr, exchange );
+#else
+	return __sync_lock_test_and_set( ptr, exchange );
+#endif
+}
+
+ID_INLINE void *idSysAtomic::CompareExchangePointer( void * volatile *ptr, void *comparand, void *exchange ) {
+#ifdef _WIN32
+	return InterlockedCompareExchangePointer( ptr, exchange, comparand );
+#else
+	return __sync_val_compare_and_swap( ptr, comparand, exchange );
+#endif
+}
+
+// x86 does not reorder loads with other loads or stores with other stores, so acquire and release
+// only have to keep the compiler from reordering. MSVC already gives volatile accesses these semantics.
+ID_INLINE int idSysAtomic::LoadAcquire( const volatile int *value ) {
+#ifdef _WIN32
+	return *value;
+#elif defined( __i386__ ) || defined( __x86_64__ )
+	int i = *value;
+	__asm__ __volatile__( "" : : : "memory" );
+	return i;
+#else
+	int i = *value;
+	__sync_synchronize();
+	return i;
+#endif
+}
+
+ID_INLINE void idSysAtomic::StoreRelease( volatile int *value, int i ) {
+#ifdef _WIN32
+	*value = i;
+#elif defined( __i386__ ) || defined( __x86_64__ )
+	__asm__ __volatile__( "" : : : "memory" );
+	*value = i;
+#else
+	__sync_synchronize();
+	*value = i;
+#endif
+}
+
+ID_INLINE void idSysAtomic::FullBarrier( void ) {
+#ifdef _WIN32
+	MemoryBarrier();
+#else
+	__sync_synchronize();
+#endif
+}
+
+ID_INLINE void idSysAtomic::Pause( void ) {
+#ifdef _WIN32
+	YieldProcessor();
+#elif defined( __i386__ ) || defined( __x86_64__ )
+	__asm__ __volatile__( "pause" );
+#endif
+}
+
+ID_INLINE void idSysAtomic::YieldThread( void ) {
+#ifdef _WIN32
+	SwitchToThread();
+#else
+	sched_yield();
+#endif
+}
+
+
+/*
+===============================================================================
+
+	Integer that can be modified by multiple threads.
+
+===============================================================================
+*/
+
+class idSysInterlockedInteger {
+public:
+							idSysInterlockedInteger( void ) : value( 0 ) {}
+
+	int						Increment( void ) { return idSysAtomic::Increment( &value ); }
+	int						Decrement( void ) { return idSysAtomic::Decrement( &value ); }
+	int						Add( int i ) { return idSysAtomic::Add( &value, i ); }
+	int						Sub( int i ) { return idSysAtomic::Add( &value, -i ); }
+	int						CompareExchange( int comparand, int exchange ) { return idSysAtomic::CompareExchange( &value, comparand, exchange ); }
+
+	int						GetValue( void ) const { return value; }
+	void					SetValue( int i ) { idSysAtomic::Exchange( &value, i ); }
+
+private:
+	volatile int			value;
+};
+
+
+/*
+===============================================================================
+
+	Pointer that can be modified by multiple threads.
+
+===============================================================================
+*/
+
+template<class type>
+class idSysInterlockedPointer {
+public:
+							idSysInterlockedPointer( void ) : ptr( NULL ) {}
+
+	type *					Set( type *newPtr ) { return (type *)idSysAtomic::ExchangePointer( &ptr, newPtr ); }
+	type *					CompareExchange( type *comparand, type *exchange ) { return (type *)idSysAtomic::CompareExchangePointer( &ptr, comparand, exchange ); }
+	type *					Get( void ) const { return (type *)ptr; }
+
+private:
+	void * volatile			ptr;
+};
+
+
+/*
+===============================================================================
+
+	Spin lock.
+
+	Only meant to guard short sections of code. A thread that fails to get
+	the lock spins for a little while and then yields its time slice.
+
+===============================================================================
+*/
+
+class idSysSpinLock {
+public:
+							idSysSpinLock( void ) : locked( 0 ) {}
+
+	bool					TryLock( void );
+	void					Lock( void );
+	void					Unlock( void );
+
+private:
+	volatile int			locked;
+};
+
+ID_INLINE bool idSysSpinLock::TryLock( void ) {
+	return ( locked == 0 && idSysAtomic::Exchange( &locked, 1 ) == 0 );
+}
+
+ID_INLINE void idSysSpinLock::Lock( void ) {
+	for ( int spin = 0; !TryLock(); spin++ ) {
+		if ( spin < 64 ) {
+			idSysAtomic::Pause();
+		} else {
+			idSysAtomic::YieldThread();
+		}
+	}
+}
+
+ID_INLINE void idSysSpinLock::Unlock( void ) {
+	assert( locked );
+	idSysAtomic::FullBarrier();
+	locked = 0;
+}
+
+class idScopedSpinLock {
+public:
+							idScopedSpinLock( idSysSpinLock &l ) : lock( l ) { lock.Lock(); }
+							~idScopedSpinLock( void ) { lock.Unlock(); }
+
+private:
+	idSysSpinLock &			lock;
+};
+
+#endif /* !__THREAD_H__ */
@@ -32,16 +32,15 @@ If you have questions concerning this license or the applicable additional terms
 
 /*
 ================
-idToken::NumberValue
+TokenNumberValue
+
+  Calculates the values for the '\0' terminated text of a TT_NUMBER.
 ================
 */
-void idToken::NumberValue( void ) {
+static void TokenNumberValue( const char *p, int subtype, unsigned long &intvalue, double &floatvalue ) {
 	int i, pow, div, c;
-	const char *p;
 	double m;
 
-	assert( type == TT_NUMBER );
-	p = c_str();
 	floatvalue = 0;
 	intvalue = 0;
 	// floating point number
@@ -164,6 +163,16 @@ void idToken::NumberValue( void ) {
 		}
 		floatvalue = intvalue;
 	}
+}
+
+/*
+================
+idToken::NumberValue
+================
+*/
+void idToken::NumberValue( void ) {
+	assert( type == TT_NUMBER );
+	TokenNumberValue( c_str(), subtype, intvalue, floatvalue );
 	subtype |= TT_VALUESVALID;
 }
 
@@ -177,3 +186,33 @@ void idToken::ClearTokenWhiteSpace( void ) {
 	whiteSpaceEnd_p = NULL;
 	linesCrossed = 0;
 }
+
+/*
+================
+idTokenView::NumberValue
+================
+*/
+void idTokenView::NumberValue( unsigned long &intvalue, double &floatvalue ) const {
+	char text[128];
+
+	// the view is not '\0' terminated, numbers are short enough to copy
+	assert( type == TT_NUMBER );
+	Copynz( text, sizeof( text ) );
+	TokenNumberValue( text, subtype, intvalue, floatvalue );
+}
+
+/*
+================
+idTokenView::ToToken
+================
+*/
+void idTokenView::ToToken( idToken *token ) const {
+	*static_cast<idStr *>( token ) = *this;
+	token->type = type;
+	token->subtype = subtype & ~TT_VALUESVALID;
+	token->line = line;
+	token->linesCrossed = linesCrossed;
+	token->flags = flags;
+	token->whiteSpaceStart_p = NULL;
+	token->whiteSpaceEnd_p = NULL;
+}
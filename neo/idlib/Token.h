@@ -72,6 +72,7 @@ class idToken : public idStr {
 
 	friend class idParser;
 	friend class idLexer;
+	friend class idTokenView;
 
 public:
 	int				type;								// token type
@@ -162,4 +163,85 @@ ID_INLINE void idToken::AppendDirty( const char a ) {
 	data[len++] = a;
 }
 
+
+/*
+===============================================================================
+
+	idTokenView is a token read with idLexer without copying the text
+
+	The view points into the script buffer and stays valid as long as the
+	script is loaded. Strings with escape characters and concatenated strings
+	are the exception, they are built in a buffer owned by the lexer and are
+	only valid until the next token is read. Use ToToken to keep a copy.
+
+===============================================================================
+*/
+
+class idTokenView : public idStrView {
+
+	friend class idLexer;
+
+public:
+	int				type;								// token type
+	int				subtype;							// token sub type
+	int				line;								// line in script the token was on
+	int				linesCrossed;						// number of lines crossed in white space before token
+	int				flags;								// token flags
+
+public:
+					idTokenView( void );
+
+	double			GetDoubleValue( void ) const;		// double value of TT_NUMBER
+	float			GetFloatValue( void ) const;		// float value of TT_NUMBER
+	unsigned long	GetUnsignedLongValue( void ) const;	// unsigned long value of TT_NUMBER
+	int				GetIntValue( void ) const;			// int value of TT_NUMBER
+	void			ToToken( idToken *token ) const;	// copy to a token that owns the text
+
+private:
+	void			NumberValue( unsigned long &intvalue, double &floatvalue ) const;
+	void			SetText( const char *text, int length );
+};
+
+ID_INLINE idTokenView::idTokenView( void ) {
+	type = 0;
+	subtype = 0;
+	line = 0;
+	linesCrossed = 0;
+	flags = 0;
+}
+
+ID_INLINE void idTokenView::SetText( const char *text, int length ) {
+	*static_cast<idStrView *>( this ) = idStrView( text, length );
+}
+
+ID_INLINE double idTokenView::GetDoubleValue( void ) const {
+	unsigned long intvalue;
+	double floatvalue;
+
+	if ( type != TT_NUMBER ) {
+		return 0.0;
+	}
+	NumberValue( intvalue, floatvalue );
+	return floatvalue;
+}
+
+ID_INLINE float idTokenView::GetFloatValue( void ) const {
+	return (float) GetDoubleValue();
+}
+
+ID_INLINE unsigned long idTokenView::GetUnsignedLongValue( void ) const {
+	unsigned long intvalue;
+	double floatvalue;
+
+	if ( type != TT_NUMBER ) {
+		return 0;
+	}
+	NumberValue( intvalue, floatvalue );
+	return intvalue;
+}
+
+ID_INLINE int idTokenView::GetIntValue( void ) const {
+	return (int) GetUnsignedLongValue();
+}
+
 #endif /* !__TOKEN_H__ */
@@ -229,6 +229,22 @@ bool idFrustum::CullBounds( const idBounds &bounds ) const {
 	return CullLocalBox( localOrigin, extents, localAxis );
 }
 
+/*
+============
+idFrustum::CullBounds
+
+  Culls a whole array of bounds at once with the planes CullLocalBox tests.
+  Bit i of cullBits is set when bounds[i] is culled, ( numBounds + 31 ) >> 5
+  words are written.
+============
+*/
+int idFrustum::CullBounds( dword *cullBits, const idBounds *bounds, const int numBounds ) const {
+	idPlane planes[6];
+
+	ToCullPlanes( planes );
+	return SIMDProcessor->CullBounds( cullBits, planes, 6, bounds, numBounds );
+}
+
 /*
 ============
 idFrustum::CullBounds
@@ -1515,6 +1531,38 @@ void idFrustum::ToPlanes( idPlane planes[6] ) const {
 	}
 }
 
+/*
+============
+idFrustum::ToCullPlanes
+
+  Same planes as tested in CullLocalBox, positive sides are out. Unlike
+  ToPlanes the side planes go through the frustum origin.
+============
+*/
+void idFrustum::ToCullPlanes( idPlane planes[6] ) const {
+	int i;
+	idVec3 normal;
+
+	planes[0].SetNormal( -axis[0] );
+	planes[0].FitThroughPoint( origin + dNear * axis[0] );
+	planes[1].SetNormal( axis[0] );
+	planes[1].FitThroughPoint( origin + dFar * axis[0] );
+
+	normal = dFar * axis[1] - dLeft * axis[0];
+	planes[2].SetNormal( normal );
+	normal = -dFar * axis[1] - dLeft * axis[0];
+	planes[3].SetNormal( normal );
+	normal = dFar * axis[2] - dUp * axis[0];
+	planes[4].SetNormal( normal );
+	normal = -dFar * axis[2] - dUp * axis[0];
+	planes[5].SetNormal( normal );
+
+	for ( i = 2; i < 6; i++ ) {
+		planes[i].Normalize();
+		planes[i].FitThroughPoint( origin );
+	}
+}
+
 /*
 ============
 idFrustum::ToPoints
@@ -71,6 +71,8 @@ public:
 					// fast culling but might not cull everything outside the frustum
 	bool			CullPoint( const idVec3 &point ) const;
 	bool			CullBounds( const idBounds &bounds ) const;
+					// sets bit i in cullBits for every culled bounds[i] and returns the number of culled bounds
+	int				CullBounds( dword *cullBits, const idBounds *bounds, const int numBounds ) const;
 	bool			CullBox( const idBox &box ) const;
 	bool			CullSphere( const idSphere &sphere ) const;
 	bool			CullFrustum( const idFrustum &frustum ) const;
@@ -133,6 +135,7 @@ private:
 	bool			LocalFrustumIntersectsFrustum( const idVec3 points[8], const bool testFirstSide ) const;
 	bool			LocalFrustumIntersectsBounds( const idVec3 points[8], const idBounds &bounds ) const;
 	void			ToClippedPoints( const float fractions[4], idVec3 points[8] ) const;
+	void			ToCullPlanes( idPlane planes[6] ) const;
 	void			ToIndexPoints( idVec3 indexPoints[8] ) const;
 	void			ToIndexPointsAndCornerVecs( idVec3 indexPoints[8], idVec3 cornerVecs[4] ) const;
 	void			AxisProjection( const idVec3 indexPoints[8], const idVec3 cornerVecs[4], const idVec3 &dir, float &min, float &max ) const;
@@ -0,0 +1,307 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../precompiled.h"
+#pragma hdrstop
+
+#define BENCH_DEFAULT_KEYS		4096
+#define BENCH_MAX_KEYS			( 1 << 20 )
+
+static const char *benchKeyFormats[] = {
+	"textures/base_wall/lfwall%d",
+	"models/mapobjects/filler/tech%d_d",
+	"sound/ed/player_step%d",
+	"editor_var%d",
+	"def_%d_projectile"
+};
+
+typedef struct {
+	double		insert;
+	double		hit;
+	double		miss;
+	double		remove;
+	int			found;
+} hashBenchTimes_t;
+
+/*
+================
+HashBench_Print
+================
+*/
+static void HashBench_Print( const char *name, const hashBenchTimes_t &t, int numKeys, size_t memory ) {
+	idLib::common->Printf( "%-16s insert %7.1f ns  hit %7.1f ns  miss %7.1f ns  remove %7.1f ns  %6d KB  (%d found)\n", name,
+				t.insert * 1e6 / numKeys, t.hit * 1e6 / numKeys, t.miss * 1e6 / numKeys, t.remove * 1e6 / ( numKeys / 2 ),
+				(int)( memory >> 10 ), t.found );
+}
+
+/*
+================
+HashBench_HashTable
+================
+*/
+static void HashBench_HashTable( const idStrList &keys, const idStrList &missing, const idList<int> &order, int tableSize ) {
+	hashBenchTimes_t t;
+	idTimer timer;
+	int i, *value;
+
+	idHashTable<int> *table = new idHashTable<int>( tableSize );
+
+	timer.Start();
+	for ( i = 0; i < keys.Num(); i++ ) {
+		table->Set( keys[i], i );
+	}
+	timer.Stop();
+	t.insert = timer.Milliseconds();
+
+	t.found = 0;
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < order.Num(); i++ ) {
+		if ( table->Get( keys[order[i]], &value ) ) {
+			t.found += ( *value == order[i] );
+		}
+	}
+	timer.Stop();
+	t.hit = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < missing.Num(); i++ ) {
+		t.found += table->Get( missing[i] );
+	}
+	timer.Stop();
+	t.miss = timer.Milliseconds();
+
+	const size_t memory = table->Allocated();
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < keys.Num(); i += 2 ) {
+		table->Remove( keys[order[i]] );
+	}
+	timer.Stop();
+	t.remove = timer.Milliseconds();
+
+	HashBench_Print( "idHashTable", t, keys.Num(), memory );
+
+	delete table;
+}
+
+/*
+================
+HashBench_HashIndex
+
+  The usual idHashIndex setup with the keys stored in a parallel list.
+================
+*/
+static void HashBench_HashIndex( const idStrList &keys, const idStrList &missing, const idList<int> &order, int tableSize ) {
+	hashBenchTimes_t t;
+	idTimer timer;
+	int i, j;
+
+	idHashIndex *hash = new idHashIndex( tableSize, tableSize );
+	idStrList *list = new idStrList;
+
+	// size the key list up front so the insert time doesn't include copying the strings on growth
+	list->Resize( keys.Num() );
+
+	timer.Start();
+	for ( i = 0; i < keys.Num(); i++ ) {
+		const char *key = keys[i];
+		const int hashKey = hash->GenerateKey( key );
+		for ( j = hash->First( hashKey ); j != -1; j = hash->Next( j ) ) {
+			if ( (*list)[j].Cmp( key ) == 0 ) {
+				break;
+			}
+		}
+		if ( j == -1 ) {
+			hash->Add( hashKey, list->Append( key ) );
+		}
+	}
+	timer.Stop();
+	t.insert = timer.Milliseconds();
+
+	t.found = 0;
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < order.Num(); i++ ) {
+		const char *key = keys[order[i]];
+		for ( j = hash->First( hash->GenerateKey( key ) ); j != -1; j = hash->Next( j ) ) {
+			if ( (*list)[j].Cmp( key ) == 0 ) {
+				t.found += ( j == order[i] );
+				break;
+			}
+		}
+	}
+	timer.Stop();
+	t.hit = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < missing.Num(); i++ ) {
+		const char *key = missing[i];
+		for ( j = hash->First( hash->GenerateKey( key ) ); j != -1; j = hash->Next( j ) ) {
+			if ( (*list)[j].Cmp( key ) == 0 ) {
+				t.found++;
+				break;
+			}
+		}
+	}
+	timer.Stop();
+	t.miss = timer.Milliseconds();
+
+	const size_t memory = hash->Allocated() + list->Allocated();
+
+	// the list entries stay in place, removing them would shift all indexes
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < keys.Num(); i += 2 ) {
+		const char *key = keys[order[i]];
+		const int hashKey = hash->GenerateKey( key );
+		for ( j = hash->First( hashKey ); j != -1; j = hash->Next( j ) ) {
+			if ( (*list)[j].Cmp( key ) == 0 ) {
+				hash->Remove( hashKey, j );
+				break;
+			}
+		}
+	}
+	timer.Stop();
+	t.remove = timer.Milliseconds();
+
+	HashBench_Print( "idHashIndex", t, keys.Num(), memory );
+
+	delete hash;
+	delete list;
+}
+
+/*
+================
+HashBench_FlatHashTable
+================
+*/
+static void HashBench_FlatHashTable( const idStrList &keys, const idStrList &missing, const idList<int> &order, int tableSize ) {
+	hashBenchTimes_t t;
+	idTimer timer;
+	int i, *value;
+
+	idFlatHashTable<int> *table = new idFlatHashTable<int>( tableSize );
+
+	timer.Start();
+	for ( i = 0; i < keys.Num(); i++ ) {
+		table->Set( keys[i], i );
+	}
+	timer.Stop();
+	t.insert = timer.Milliseconds();
+
+	t.found = 0;
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < order.Num(); i++ ) {
+		if ( table->Get( keys[order[i]], &value ) ) {
+			t.found += ( *value == order[i] );
+		}
+	}
+	timer.Stop();
+	t.hit = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < missing.Num(); i++ ) {
+		t.found += table->Get( missing[i] );
+	}
+	timer.Stop();
+	t.miss = timer.Milliseconds();
+
+	const size_t memory = table->Allocated();
+	const int spread = table->GetSpread();
+	const int maxProbe = table->GetMaxProbeLength();
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < keys.Num(); i += 2 ) {
+		table->Remove( keys[order[i]] );
+	}
+	timer.Stop();
+	t.remove = timer.Milliseconds();
+
+	// the other half must still be there
+	for ( i = 1; i < keys.Num(); i += 2 ) {
+		if ( !table->Get( keys[order[i]], &value ) || *value != order[i] ) {
+			idLib::common->Warning( "idFlatHashTable lost key '%s'", keys[order[i]].c_str() );
+			break;
+		}
+	}
+
+	HashBench_Print( "idFlatHashTable", t, keys.Num(), memory );
+	idLib::common->Printf( "%-16s %d%% in their own slot, max probe length %d\n", "", spread, maxProbe );
+
+	delete table;
+}
+
+/*
+================
+FlatHashTable_Bench_f
+
+  benchHashTable [numKeys] [tableSize]
+================
+*/
+void FlatHashTable_Bench_f( const idCmdArgs &args ) {
+	int i, j, numKeys, tableSize;
+	idStrList keys, missing;
+	idList<int> order;
+	idRandom random( 0x5EED );
+
+	numKeys = BENCH_DEFAULT_KEYS;
+	if ( args.Argc() > 1 ) {
+		numKeys = idMath::ClampInt( 16, BENCH_MAX_KEYS, atoi( args.Argv( 1 ) ) );
+	}
+	// same table size for all containers, idHashTable never grows
+	tableSize = idMath::CeilPowerOfTwo( numKeys );
+	if ( args.Argc() > 2 ) {
+		tableSize = idMath::CeilPowerOfTwo( Max( atoi( args.Argv( 2 ) ), 16 ) );
+	}
+
+	keys.Resize( numKeys );
+	missing.Resize( numKeys );
+	order.SetNum( numKeys );
+	for ( i = 0; i < numKeys; i++ ) {
+		const char *format = benchKeyFormats[i % ( sizeof( benchKeyFormats ) / sizeof( benchKeyFormats[0] ) )];
+		keys.Append( va( format, i ) );
+		missing.Append( va( format, numKeys + i ) );
+		order[i] = i;
+	}
+	for ( i = numKeys - 1; i > 0; i-- ) {
+		j = random.RandomInt( i + 1 );
+		idSwap( order[i], order[j] );
+	}
+
+	idLib::common->Printf( "%d keys, table size %d, times per operation\n", numKeys, tableSize );
+	HashBench_HashTable( keys, missing, order, tableSize );
+	HashBench_HashIndex( keys, missing, order, tableSize );
+	HashBench_FlatHashTable( keys, missing, order, tableSize );
+}
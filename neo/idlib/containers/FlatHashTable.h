@@ -0,0 +1,524 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __FLATHASHTABLE_H__
+#define __FLATHASHTABLE_H__
+
+/*
+===============================================================================
+
+	Open addressing hash table with the same interface as idHashTable.
+
+	The elements are stored in a dense array and the table only stores the
+	full hash and the element index per slot, so a lookup usually touches a
+	single cache line of the table before comparing the key. Collisions are
+	resolved with robin hood linear probing which keeps the probe sequences
+	short up to high loads. Elements are not allocated individually.
+
+	Does not allocate memory until the first element is added.
+
+===============================================================================
+*/
+
+template< class Type >
+class idFlatHashTable {
+public:
+					idFlatHashTable( int newtablesize = 256, bool caseSensitive = true );
+					idFlatHashTable( const idFlatHashTable<Type> &map );
+					~idFlatHashTable( void );
+
+					// returns total size of allocated memory
+	size_t			Allocated( void ) const;
+					// returns total size of allocated memory including size of hash table type
+	size_t			Size( void ) const;
+
+	idFlatHashTable<Type> &	operator=( const idFlatHashTable<Type> &map );
+
+	void			Set( const char *key, Type &value );
+	bool			Get( const char *key, Type **value = NULL ) const;
+	bool			Remove( const char *key );
+
+	void			Clear( void );
+	void			DeleteContents( void );
+
+					// the entire contents can be iterated over, but note that the
+					// exact index for a given element may change when elements are removed
+	int				Num( void ) const;
+	Type *			GetIndex( int index ) const;
+	const idStr &	GetKey( int index ) const;
+
+					// percentage of the elements stored in the slot they hash to
+	int				GetSpread( void ) const;
+					// longest number of slots tested by a lookup
+	int				GetMaxProbeLength( void ) const;
+
+private:
+	struct flatSlot_s {
+		int			hash;
+		int			index;				// -1 if the slot is empty
+	};
+
+	struct flatEntry_s {
+		idStr		key;
+		Type		value;
+		int			hash;
+	};
+
+	flatSlot_s *	slots;
+	int				tablesize;
+	int				tablesizemask;
+	bool			caseSensitive;
+	idList<flatEntry_s>	entries;
+
+	int				GetHash( const char *key ) const;
+	int				FindSlot( const char *key, int hash ) const;
+	void			InsertSlot( int hash, int index );
+	void			RemoveSlot( int slot );
+	void			Resize( int newtablesize );
+};
+
+/*
+================
+idFlatHashTable<Type>::idFlatHashTable
+================
+*/
+template< class Type >
+ID_INLINE idFlatHashTable<Type>::idFlatHashTable( int newtablesize, bool caseSensitive ) {
+
+	assert( idMath::IsPowerOfTwo( newtablesize ) );
+
+	slots = NULL;
+	tablesize = newtablesize;
+	assert( tablesize > 0 );
+	tablesizemask = tablesize - 1;
+	this->caseSensitive = caseSensitive;
+	entries.SetGranularity( Max( tablesize / 2, 16 ) );
+}
+
+/*
+================
+idFlatHashTable<Type>::idFlatHashTable
+================
+*/
+template< class Type >
+ID_INLINE idFlatHashTable<Type>::idFlatHashTable( const idFlatHashTable<Type> &map ) {
+	slots = NULL;
+	*this = map;
+}
+
+/*
+================
+idFlatHashTable<Type>::~idFlatHashTable<Type>
+================
+*/
+template< class Type >
+ID_INLINE idFlatHashTable<Type>::~idFlatHashTable( void ) {
+	delete[] slots;
+}
+
+/*
+================
+idFlatHashTable<Type>::operator=
+================
+*/
+template< class Type >
+ID_INLINE idFlatHashTable<Type> &idFlatHashTable<Type>::operator=( const idFlatHashTable<Type> &map ) {
+	if ( this == &map ) {
+		return *this;
+	}
+
+	delete[] slots;
+	slots = NULL;
+
+	tablesize		= map.tablesize;
+	tablesizemask	= map.tablesizemask;
+	caseSensitive	= map.caseSensitive;
+	entries			= map.entries;
+
+	if ( map.slots ) {
+		slots = new flatSlot_s[ tablesize ];
+		memcpy( slots, map.slots, tablesize * sizeof( slots[0] ) );
+	}
+	return *this;
+}
+
+/*
+================
+idFlatHashTable<Type>::Allocated
+================
+*/
+template< class Type >
+ID_INLINE size_t idFlatHashTable<Type>::Allocated( void ) const {
+	size_t size = entries.Allocated() + ( slots ? tablesize * sizeof( slots[0] ) : 0 );
+	for ( int i = 0; i < entries.Num(); i++ ) {
+		size += entries[i].key.Allocated();
+	}
+	return size;
+}
+
+/*
+================
+idFlatHashTable<Type>::Size
+================
+*/
+template< class Type >
+ID_INLINE size_t idFlatHashTable<Type>::Size( void ) const {
+	return sizeof( idFlatHashTable<Type> ) + Allocated();
+}
+
+/*
+================
+idFlatHashTable<Type>::GetHash
+
+  FNV-1a with a final mix so the low bits used for the slot are well distributed.
+================
+*/
+template< class Type >
+ID_INLINE int idFlatHashTable<Type>::GetHash( const char *key ) const {
+	unsigned int hash = 2166136261U;
+
+	if ( caseSensitive ) {
+		while( *key ) {
+			hash = ( hash ^ (byte)*key++ ) * 16777619U;
+		}
+	} else {
+		while( *key ) {
+			hash = ( hash ^ (byte)idStr::ToLower( *key++ ) ) * 16777619U;
+		}
+	}
+	hash ^= hash >> 15;
+	hash *= 0x85EBCA6BU;
+	hash ^= hash >> 13;
+	return (int)hash;
+}
+
+/*
+================
+idFlatHashTable<Type>::FindSlot
+
+  Returns the slot with the key or -1 if the key is not in the table.
+================
+*/
+template< class Type >
+ID_INLINE int idFlatHashTable<Type>::FindSlot( const char *key, int hash ) const {
+	int slot, dist;
+
+	if ( !slots ) {
+		return -1;
+	}
+
+	slot = hash & tablesizemask;
+	for ( dist = 0; ; dist++ ) {
+		const flatSlot_s &s = slots[slot];
+		if ( s.index < 0 ) {
+			return -1;
+		}
+		// the key would have taken the place of an element closer to its own slot
+		if ( ( ( slot - s.hash ) & tablesizemask ) < dist ) {
+			return -1;
+		}
+		if ( s.hash == hash ) {
+			const idStr &entryKey = entries[s.index].key;
+			if ( ( caseSensitive ? entryKey.Cmp( key ) : entryKey.Icmp( key ) ) == 0 ) {
+				return slot;
+			}
+		}
+		slot = ( slot + 1 ) & tablesizemask;
+	}
+	return -1;
+}
+
+/*
+================
+idFlatHashTable<Type>::InsertSlot
+
+  Elements further away from their own slot take the place of elements closer to theirs.
+================
+*/
+template< class Type >
+ID_INLINE void idFlatHashTable<Type>::InsertSlot( int hash, int index ) {
+	flatSlot_s insert, temp;
+	int slot, dist, d;
+
+	insert.hash = hash;
+	insert.index = index;
+
+	slot = hash & tablesizemask;
+	for ( dist = 0; ; dist++ ) {
+		flatSlot_s &s = slots[slot];
+		if ( s.index < 0 ) {
+			s = insert;
+			return;
+		}
+		d = ( slot - s.hash ) & tablesizemask;
+		if ( d < dist ) {
+			temp = s;
+			s = insert;
+			insert = temp;
+			dist = d;
+		}
+		slot = ( slot + 1 ) & tablesizemask;
+	}
+}
+
+/*
+================
+idFlatHashTable<Type>::RemoveSlot
+
+  Shifts the following elements back so no tombstones are needed.
+================
+*/
+template< class Type >
+ID_INLINE void idFlatHashTable<Type>::RemoveSlot( int slot ) {
+	int next;
+
+	next = ( slot + 1 ) & tablesizemask;
+	while( slots[next].index >= 0 && ( ( next - slots[next].hash ) & tablesizemask ) != 0 ) {
+		slots[slot] = slots[next];
+		slot = next;
+		next = ( next + 1 ) & tablesizemask;
+	}
+	slots[slot].index = -1;
+}
+
+/*
+================
+idFlatHashTable<Type>::Resize
+================
+*/
+template< class Type >
+ID_INLINE void idFlatHashTable<Type>::Resize( int newtablesize ) {
+	int i;
+
+	assert( idMath::IsPowerOfTwo( newtablesize ) );
+
+	delete[] slots;
+	tablesize = newtablesize;
+	tablesizemask = tablesize - 1;
+	slots = new flatSlot_s[ tablesize ];
+	for ( i = 0; i < tablesize; i++ ) {
+		slots[i].index = -1;
+	}
+	for ( i = 0; i < entries.Num(); i++ ) {
+		InsertSlot( entries[i].hash, i );
+	}
+}
+
+/*
+================
+idFlatHashTable<Type>::Set
+================
+*/
+template< class Type >
+ID_INLINE void idFlatHashTable<Type>::Set( const char *key, Type &value ) {
+	int hash, slot;
+
+	hash = GetHash( key );
+	slot = FindSlot( key, hash );
+	if ( slot >= 0 ) {
+		entries[slots[slot].index].value = value;
+		return;
+	}
+
+	// keep the load below 7/8
+	if ( !slots ) {
+		Resize( tablesize );
+	} else if ( ( entries.Num() + 1 ) * 8 > tablesize * 7 ) {
+		Resize( tablesize * 2 );
+	}
+
+	flatEntry_s &entry = entries.Alloc();
+	entry.key = key;
+	entry.value = value;
+	entry.hash = hash;
+	InsertSlot( hash, entries.Num() - 1 );
+}
+
+/*
+================
+idFlatHashTable<Type>::Get
+================
+*/
+template< class Type >
+ID_INLINE bool idFlatHashTable<Type>::Get( const char *key, Type **value ) const {
+	int slot;
+
+	slot = FindSlot( key, GetHash( key ) );
+	if ( slot >= 0 ) {
+		if ( value ) {
+			*value = const_cast<Type *>( &entries[slots[slot].index].value );
+		}
+		return true;
+	}
+
+	if ( value ) {
+		*value = NULL;
+	}
+
+	return false;
+}
+
+/*
+================
+idFlatHashTable<Type>::GetIndex
+
+the entire contents can be iterated over, but note that the
+exact index for a given element may change when elements are removed
+================
+*/
+template< class Type >
+ID_INLINE Type *idFlatHashTable<Type>::GetIndex( int index ) const {
+	if ( ( index < 0 ) || ( index >= entries.Num() ) ) {
+		assert( 0 );
+		return NULL;
+	}
+	return const_cast<Type *>( &entries[index].value );
+}
+
+/*
+================
+idFlatHashTable<Type>::GetKey
+================
+*/
+template< class Type >
+ID_INLINE const idStr &idFlatHashTable<Type>::GetKey( int index ) const {
+	assert( ( index >= 0 ) && ( index < entries.Num() ) );
+	return entries[index].key;
+}
+
+/*
+================
+idFlatHashTable<Type>::Remove
+
+  The last element is moved into the place of the removed element.
+================
+*/
+template< class Type >
+ID_INLINE bool idFlatHashTable<Type>::Remove( const char *key ) {
+	int slot, index, last;
+
+	slot = FindSlot( key, GetHash( key ) );
+	if ( slot < 0 ) {
+		return false;
+	}
+
+	index = slots[slot].index;
+	RemoveSlot( slot );
+
+	last = entries.Num() - 1;
+	if ( index != last ) {
+		for ( slot = entries[last].hash & tablesizemask; slots[slot].index != last; slot = ( slot + 1 ) & tablesizemask ) {
+		}
+		slots[slot].index = index;
+		entries[index] = entries[last];
+	}
+	entries[last].key.Clear();
+	entries.SetNum( last, false );
+
+	return true;
+}
+
+/*
+================
+idFlatHashTable<Type>::Clear
+================
+*/
+template< class Type >
+ID_INLINE void idFlatHashTable<Type>::Clear( void ) {
+	delete[] slots;
+	slots = NULL;
+	entries.Clear();
+}
+
+/*
+================
+idFlatHashTable<Type>::DeleteContents
+================
+*/
+template< class Type >
+ID_INLINE void idFlatHashTable<Type>::DeleteContents( void ) {
+	for ( int i = 0; i < entries.Num(); i++ ) {
+		delete entries[i].value;
+	}
+	Clear();
+}
+
+/*
+================
+idFlatHashTable<Type>::Num
+================
+*/
+template< class Type >
+ID_INLINE int idFlatHashTable<Type>::Num( void ) const {
+	return entries.Num();
+}
+
+/*
+================
+idFlatHashTable<Type>::GetSpread
+================
+*/
+template< class Type >
+ID_INLINE int idFlatHashTable<Type>::GetSpread( void ) const {
+	int i, numIdeal;
+
+	// if no items in hash
+	if ( !entries.Num() ) {
+		return 100;
+	}
+	numIdeal = 0;
+	for ( i = 0; i < tablesize; i++ ) {
+		if ( slots[i].index >= 0 && ( slots[i].hash & tablesizemask ) == i ) {
+			numIdeal++;
+		}
+	}
+	return numIdeal * 100 / entries.Num();
+}
+
+/*
+================
+idFlatHashTable<Type>::GetMaxProbeLength
+================
+*/
+template< class Type >
+ID_INLINE int idFlatHashTable<Type>::GetMaxProbeLength( void ) const {
+	int i, maxDist;
+
+	maxDist = 0;
+	for ( i = 0; slots && i < tablesize; i++ ) {
+		if ( slots[i].index >= 0 ) {
+			maxDist = Max( maxDist, ( i - slots[i].hash ) & tablesizemask );
+		}
+	}
+	return maxDist + 1;
+}
+
+// compares the speed of idFlatHashTable, idHashTable and idHashIndex
+void FlatHashTable_Bench_f( const class idCmdArgs &args );
+
+#endif /* !__FLATHASHTABLE_H__ */
@@ -87,6 +87,8 @@ public:
 	int				GenerateKey( const idVec3 &v ) const;
 					// returns a key for two integers
 	int				GenerateKey( const int n1, const int n2 ) const;
+					// returns a key for a block of binary data
+	int				GenerateKey( const void *data, const int length ) const;
 
 private:
 	int				hashSize;
@@ -402,4 +404,13 @@ ID_INLINE int idHashIndex::GenerateKey( const int n1, const int n2 ) const {
 	return ( ( n1 + n2 ) & hashMask );
 }
 
+/*
+================
+idHashIndex::GenerateKey
+================
+*/
+ID_INLINE int idHashIndex::GenerateKey( const void *data, const int length ) const {
+	return ( XXH64_BlockHash( data, length ) & hashMask );
+}
+
 #endif /* !__HASHINDEX_H__ */
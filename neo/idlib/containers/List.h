@@ -35,9 +35,87 @@ If you have questions concerning this license or the applicable additional terms
 	List template
 	Does not allocate memory until the first item is added.
 
+	The allocator template argument selects where the elements are stored.
+	By default they are allocated from the heap. Lists that only live for the
+	duration of a frame can use idListFrameAllocator instead.
+
 ===============================================================================
 */
 
+/*
+================
+idListHeapAllocator
+================
+*/
+class idListHeapAllocator {
+public:
+	template< class type >
+	static type *	Alloc( int num ) { return new type[ num ]; }
+	template< class type >
+	static void		Free( type *ptr ) { delete[] ptr; }
+};
+
+/*
+================
+idListFrameAllocator
+
+Stores the elements in the memory of the frame allocator. The elements are
+constructed and destructed like with new[] and delete[] but the memory itself
+is only reclaimed when the frame allocator is toggled. The list must be freed
+or go out of scope before the end of the frame after the one it was filled in.
+================
+*/
+class idListFrameAllocator {
+public:
+	template< class type >
+	static type *	Alloc( int num );
+	template< class type >
+	static void		Free( type *ptr );
+
+private:
+	typedef struct {
+		int			num;					// number of constructed elements
+		int			frameCount;				// frame the memory was allocated in
+	} header_t;
+
+	enum {
+		HEADER_SIZE = ( sizeof( header_t ) + 15 ) & ~15
+	};
+};
+
+template< class type >
+ID_INLINE type *idListFrameAllocator::Alloc( int num ) {
+	byte *mem = (byte *)frameAllocator.Alloc( HEADER_SIZE + num * sizeof( type ) );
+	header_t *header = (header_t *)mem;
+	type *ptr = (type *)( mem + HEADER_SIZE );
+
+	header->num = num;
+	header->frameCount = frameAllocator.GetFrameCount();
+#ifdef ID_DEBUG_NEW
+#undef new
+#endif
+	for ( int i = 0; i < num; i++ ) {
+		new( &ptr[i] ) type;
+	}
+#ifdef ID_DEBUG_NEW
+#define new ID_DEBUG_NEW
+#endif
+	return ptr;
+}
+
+template< class type >
+ID_INLINE void idListFrameAllocator::Free( type *ptr ) {
+	header_t *header = (header_t *)( ( (byte *)ptr ) - HEADER_SIZE );
+
+	// the memory is reused after the frame allocator has been toggled twice
+	assert( frameAllocator.GetFrameCount() - header->frameCount <= 1 );
+
+	for ( int i = 0; i < header->num; i++ ) {
+		ptr[i].~type();
+	}
+	frameAllocator.Free( header );
+}
+
 
 /*
 ================
@@ -68,6 +146,26 @@ ID_INLINE type *idListNewElement( void ) {
 	return new type;
 }
 
+/*
+================
+idMove<type>
+
+  Lets the element be moved instead of copied when the compiler supports it.
+  The source is left in a valid but unspecified state.
+================
+*/
+#ifdef ID_RVALUE_REFERENCES
+template< class type >
+ID_INLINE type &&idMove( type &a ) {
+	return static_cast<type &&>( a );
+}
+#else
+template< class type >
+ID_INLINE type &idMove( type &a ) {
+	return a;
+}
+#endif
+
 /*
 ================
 idSwap<type>
@@ -75,12 +173,12 @@ idSwap<type>
 */
 template< class type >
 ID_INLINE void idSwap( type &a, type &b ) {
-	type c = a;
-	a = b;
-	b = c;
+	type c = idMove( a );
+	a = idMove( b );
+	b = idMove( c );
 }
 
-template< class type >
+template< class type, class allocator = idListHeapAllocator >
 class idList {
 public:
 
@@ -88,8 +186,8 @@ public:
 	typedef type	new_t( void );
 
 					idList( int newgranularity = 16 );
-					idList( const idList<type> &other );
-					~idList<type>( void );
+					idList( const idList<type,allocator> &other );
+					~idList( void );
 
 	void			Clear( void );										// clear the list
 	int				Num( void ) const;									// returns number of elements in list
@@ -101,7 +199,7 @@ public:
 	size_t			Size( void ) const;									// returns total size of allocated memory including size of list type
 	size_t			MemoryUsed( void ) const;							// returns size of the used elements in the list
 
-	idList<type> &	operator=( const idList<type> &other );
+	idList<type,allocator> &	operator=( const idList<type,allocator> &other );
 	const type &	operator[]( int index ) const;
 	type &			operator[]( int index );
 
@@ -111,13 +209,13 @@ public:
 	void			SetNum( int newnum, bool resize = true );			// set number of elements in list and resize to exactly this number if necessary
 	void			AssureSize( int newSize);							// assure list has given number of elements, but leave them uninitialized
 	void			AssureSize( int newSize, const type &initValue );	// assure list has given number of elements and initialize any new elements
-	void			AssureSizeAlloc( int newSize, new_t *allocator );	// assure the pointer list has the given number of elements and allocate any new elements
+	void			AssureSizeAlloc( int newSize, new_t *allocNew );	// assure the pointer list has the given number of elements and allocate any new elements
 
 	type *			Ptr( void );										// returns a pointer to the list
 	const type *	Ptr( void ) const;									// returns a pointer to the list
 	type &			Alloc( void );										// returns reference to a new data element at the end of the list
 	int				Append( const type & obj );							// append element
-	int				Append( const idList<type> &other );				// append list
+	int				Append( const idList<type,allocator> &other );		// append list
 	int				AddUnique( const type & obj );						// add unique element
 	int				Insert( const type & obj, int index = 0 );			// insert the element at the given index
 	int				FindIndex( const type & obj ) const;				// find the index for the given element
@@ -128,7 +226,7 @@ public:
 	bool			Remove( const type & obj );							// remove the element
 	void			Sort( cmp_t *compare = ( cmp_t * )&idListSortCompare<type> );
 	void			SortSubSection( int startIndex, int endIndex, cmp_t *compare = ( cmp_t * )&idListSortCompare<type> );
-	void			Swap( idList<type> &other );						// swap the contents of the lists
+	void			Swap( idList<type,allocator> &other );				// swap the contents of the lists
 	void			DeleteContents( bool clear );						// delete the contents of the list
 
 private:
@@ -143,8 +241,8 @@ private:
 idList<type>::idList( int )
 ================
 */
-template< class type >
-ID_INLINE idList<type>::idList( int newgranularity ) {
+template< class type, class allocator >
+ID_INLINE idList<type,allocator>::idList( int newgranularity ) {
 	assert( newgranularity > 0 );
 
 	list		= NULL;
@@ -157,8 +255,8 @@ ID_INLINE idList<type>::idList( int newgranularity ) {
 idList<type>::idList( const idList<type> &other )
 ================
 */
-template< class type >
-ID_INLINE idList<type>::idList( const idList<type> &other ) {
+template< class type, class allocator >
+ID_INLINE idList<type,allocator>::idList( const idList<type,allocator> &other ) {
 	list = NULL;
 	*this = other;
 }
@@ -168,8 +266,8 @@ ID_INLINE idList<type>::idList( const idList<type> &other ) {
 idList<type>::~idList<type>
 ================
 */
-template< class type >
-ID_INLINE idList<type>::~idList( void ) {
+template< class type, class allocator >
+ID_INLINE idList<type,allocator>::~idList( void ) {
 	Clear();
 }
 
@@ -180,10 +278,10 @@ idList<type>::Clear
 Frees up the memory allocated by the list.  Assumes that type automatically handles freeing up memory.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Clear( void ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::Clear( void ) {
 	if ( list ) {
-		delete[] list;
+		allocator::Free( list );
 	}
 
 	list	= NULL;
@@ -203,8 +301,8 @@ the pointers are still valid when this function is called.  Function will set al
 list to NULL.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::DeleteContents( bool clear ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::DeleteContents( bool clear ) {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -226,8 +324,8 @@ idList<type>::Allocated
 return total memory allocated for the list in bytes, but doesn't take into account additional memory allocated by type
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::Allocated( void ) const {
+template< class type, class allocator >
+ID_INLINE size_t idList<type,allocator>::Allocated( void ) const {
 	return size * sizeof( type );
 }
 
@@ -238,9 +336,9 @@ idList<type>::Size
 return total size of list in bytes, but doesn't take into account additional memory allocated by type
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::Size( void ) const {
-	return sizeof( idList<type> ) + Allocated();
+template< class type, class allocator >
+ID_INLINE size_t idList<type,allocator>::Size( void ) const {
+	return sizeof( idList<type,allocator> ) + Allocated();
 }
 
 /*
@@ -248,8 +346,8 @@ ID_INLINE size_t idList<type>::Size( void ) const {
 idList<type>::MemoryUsed
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::MemoryUsed( void ) const {
+template< class type, class allocator >
+ID_INLINE size_t idList<type,allocator>::MemoryUsed( void ) const {
 	return num * sizeof( *list );
 }
 
@@ -261,8 +359,8 @@ Returns the number of elements currently contained in the list.
 Note that this is NOT an indication of the memory allocated.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Num( void ) const {
+template< class type, class allocator >
+ID_INLINE int idList<type,allocator>::Num( void ) const {
 	return num;
 }
 
@@ -273,8 +371,8 @@ idList<type>::NumAllocated
 Returns the number of elements currently allocated for.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::NumAllocated( void ) const {
+template< class type, class allocator >
+ID_INLINE int idList<type,allocator>::NumAllocated( void ) const {
 	return size;
 }
 
@@ -285,8 +383,8 @@ idList<type>::SetNum
 Resize to the exact size specified irregardless of granularity
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SetNum( int newnum, bool resize ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::SetNum( int newnum, bool resize ) {
 	assert( newnum >= 0 );
 	if ( resize || newnum > size ) {
 		Resize( newnum );
@@ -301,8 +399,8 @@ idList<type>::SetGranularity
 Sets the base size of the array and resizes the array to match.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SetGranularity( int newgranularity ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::SetGranularity( int newgranularity ) {
 	int newsize;
 
 	assert( newgranularity > 0 );
@@ -325,8 +423,8 @@ idList<type>::GetGranularity
 Get the current granularity.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::GetGranularity( void ) const {
+template< class type, class allocator >
+ID_INLINE int idList<type,allocator>::GetGranularity( void ) const {
 	return granularity;
 }
 
@@ -337,8 +435,8 @@ idList<type>::Condense
 Resizes the array to exactly the number of elements it contains or frees up memory if empty.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Condense( void ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::Condense( void ) {
 	if ( list ) {
 		if ( num ) {
 			Resize( num );
@@ -353,11 +451,11 @@ ID_INLINE void idList<type>::Condense( void ) {
 idList<type>::Resize
 
 Allocates memory for the amount of elements requested while keeping the contents intact.
-Contents are copied using their = operator so that data is correnctly instantiated.
+Contents are moved or copied using their = operator so that data is correnctly instantiated.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Resize( int newsize ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::Resize( int newsize ) {
 	type	*temp;
 	int		i;
 
@@ -381,14 +479,14 @@ ID_INLINE void idList<type>::Resize( int newsize ) {
 	}
 
 	// copy the old list into our new one
-	list = new type[ size ];
+	list = allocator::template Alloc<type>( size );
 	for( i = 0; i < num; i++ ) {
-		list[ i ] = temp[ i ];
+		list[ i ] = idMove( temp[ i ] );
 	}
 
 	// delete the old list if it exists
 	if ( temp ) {
-		delete[] temp;
+		allocator::Free( temp );
 	}
 }
 
@@ -397,11 +495,11 @@ ID_INLINE void idList<type>::Resize( int newsize ) {
 idList<type>::Resize
 
 Allocates memory for the amount of elements requested while keeping the contents intact.
-Contents are copied using their = operator so that data is correnctly instantiated.
+Contents are moved or copied using their = operator so that data is correnctly instantiated.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Resize( int newsize, int newgranularity ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::Resize( int newsize, int newgranularity ) {
 	type	*temp;
 	int		i;
 
@@ -423,14 +521,14 @@ ID_INLINE void idList<type>::Resize( int newsize, int newgranularity ) {
 	}
 
 	// copy the old list into our new one
-	list = new type[ size ];
+	list = allocator::template Alloc<type>( size );
 	for( i = 0; i < num; i++ ) {
-		list[ i ] = temp[ i ];
+		list[ i ] = idMove( temp[ i ] );
 	}
 
 	// delete the old list if it exists
 	if ( temp ) {
-		delete[] temp;
+		allocator::Free( temp );
 	}
 }
 
@@ -441,8 +539,8 @@ idList<type>::AssureSize
 Makes sure the list has at least the given number of elements.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSize( int newSize ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::AssureSize( int newSize ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -466,8 +564,8 @@ idList<type>::AssureSize
 Makes sure the list has at least the given number of elements and initialize any elements not yet initialized.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSize( int newSize, const type &initValue ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::AssureSize( int newSize, const type &initValue ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -499,8 +597,8 @@ NOTE: This function can only be called on lists containing pointers. Calling it
 on non-pointer lists will cause a compiler error.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSizeAlloc( int newSize, new_t *allocator ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::AssureSizeAlloc( int newSize, new_t *allocNew ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -515,7 +613,7 @@ ID_INLINE void idList<type>::AssureSizeAlloc( int newSize, new_t *allocator ) {
 		Resize( newSize );
 
 		for ( int i = num; i < newSize; i++ ) {
-			list[i] = (*allocator)();
+			list[i] = (*allocNew)();
 		}
 	}
 
@@ -529,8 +627,8 @@ idList<type>::operator=
 Copies the contents and size attributes of another list.
 ================
 */
-template< class type >
-ID_INLINE idList<type> &idList<type>::operator=( const idList<type> &other ) {
+template< class type, class allocator >
+ID_INLINE idList<type,allocator> &idList<type,allocator>::operator=( const idList<type,allocator> &other ) {
 	int	i;
 
 	Clear();
@@ -540,7 +638,7 @@ ID_INLINE idList<type> &idList<type>::operator=( const idList<type> &other ) {
 	granularity	= other.granularity;
 
 	if ( size ) {
-		list = new type[ size ];
+		list = allocator::template Alloc<type>( size );
 		for( i = 0; i < num; i++ ) {
 			list[ i ] = other.list[ i ];
 		}
@@ -557,8 +655,8 @@ Access operator.  Index must be within range or an assert will be issued in debu
 Release builds do no range checking.
 ================
 */
-template< class type >
-ID_INLINE const type &idList<type>::operator[]( int index ) const {
+template< class type, class allocator >
+ID_INLINE const type &idList<type,allocator>::operator[]( int index ) const {
 	assert( index >= 0 );
 	assert( index < num );
 
@@ -573,8 +671,8 @@ Access operator.  Index must be within range or an assert will be issued in debu
 Release builds do no range checking.
 ================
 */
-template< class type >
-ID_INLINE type &idList<type>::operator[]( int index ) {
+template< class type, class allocator >
+ID_INLINE type &idList<type,allocator>::operator[]( int index ) {
 	assert( index >= 0 );
 	assert( index < num );
 
@@ -592,8 +690,8 @@ Note: may return NULL if the list is empty.
 FIXME: Create an iterator template for this kind of thing.
 ================
 */
-template< class type >
-ID_INLINE type *idList<type>::Ptr( void ) {
+template< class type, class allocator >
+ID_INLINE type *idList<type,allocator>::Ptr( void ) {
 	return list;
 }
 
@@ -608,8 +706,8 @@ Note: may return NULL if the list is empty.
 FIXME: Create an iterator template for this kind of thing.
 ================
 */
-template< class type >
-const ID_INLINE type *idList<type>::Ptr( void ) const {
+template< class type, class allocator >
+const ID_INLINE type *idList<type,allocator>::Ptr( void ) const {
 	return list;
 }
 
@@ -620,8 +718,8 @@ idList<type>::Alloc
 Returns a reference to a new data element at the end of the list.
 ================
 */
-template< class type >
-ID_INLINE type &idList<type>::Alloc( void ) {
+template< class type, class allocator >
+ID_INLINE type &idList<type,allocator>::Alloc( void ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -642,8 +740,8 @@ Increases the size of the list by one element and copies the supplied data into
 Returns the index of the new element.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Append( type const & obj ) {
+template< class type, class allocator >
+ID_INLINE int idList<type,allocator>::Append( type const & obj ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -675,8 +773,8 @@ and inserts the supplied data into it.
 Returns the index of the new element.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Insert( type const & obj, int index ) {
+template< class type, class allocator >
+ID_INLINE int idList<type,allocator>::Insert( type const & obj, int index ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -698,7 +796,7 @@ ID_INLINE int idList<type>::Insert( type const & obj, int index ) {
 		index = num;
 	}
 	for ( int i = num; i > index; --i ) {
-		list[i] = list[i-1];
+		list[i] = idMove( list[i-1] );
 	}
 	num++;
 	list[index] = obj;
@@ -714,8 +812,8 @@ adds the other list to this one
 Returns the size of the new combined list
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Append( const idList<type> &other ) {
+template< class type, class allocator >
+ID_INLINE int idList<type,allocator>::Append( const idList<type,allocator> &other ) {
 	if ( !list ) {
 		if ( granularity == 0 ) {	// this is a hack to fix our memset classes
 			granularity = 16;
@@ -738,8 +836,8 @@ idList<type>::AddUnique
 Adds the data to the list if it doesn't already exist.  Returns the index of the data in the list.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::AddUnique( type const & obj ) {
+template< class type, class allocator >
+ID_INLINE int idList<type,allocator>::AddUnique( type const & obj ) {
 	int index;
 
 	index = FindIndex( obj );
@@ -757,8 +855,8 @@ idList<type>::FindIndex
 Searches for the specified data in the list and returns it's index.  Returns -1 if the data is not found.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::FindIndex( type const & obj ) const {
+template< class type, class allocator >
+ID_INLINE int idList<type,allocator>::FindIndex( type const & obj ) const {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -778,8 +876,8 @@ idList<type>::Find
 Searches for the specified data in the list and returns it's address. Returns NULL if the data is not found.
 ================
 */
-template< class type >
-ID_INLINE type *idList<type>::Find( type const & obj ) const {
+template< class type, class allocator >
+ID_INLINE type *idList<type,allocator>::Find( type const & obj ) const {
 	int i;
 
 	i = FindIndex( obj );
@@ -800,8 +898,8 @@ NOTE: This function can only be called on lists containing pointers. Calling it
 on non-pointer lists will cause a compiler error.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::FindNull( void ) const {
+template< class type, class allocator >
+ID_INLINE int idList<type,allocator>::FindNull( void ) const {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -824,8 +922,8 @@ Function will assert in debug builds if pointer is outside the bounds of the lis
 but remains silent in release builds.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::IndexOf( type const *objptr ) const {
+template< class type, class allocator >
+ID_INLINE int idList<type,allocator>::IndexOf( type const *objptr ) const {
 	int index;
 
 	index = objptr - list;
@@ -845,8 +943,8 @@ The number of elements in the list is reduced by one.  Returns false if the inde
 Note that the element is not destroyed, so any memory used by it may not be freed until the destruction of the list.
 ================
 */
-template< class type >
-ID_INLINE bool idList<type>::RemoveIndex( int index ) {
+template< class type, class allocator >
+ID_INLINE bool idList<type,allocator>::RemoveIndex( int index ) {
 	int i;
 
 	assert( list != NULL );
@@ -859,7 +957,7 @@ ID_INLINE bool idList<type>::RemoveIndex( int index ) {
 
 	num--;
 	for( i = index; i < num; i++ ) {
-		list[ i ] = list[ i + 1 ];
+		list[ i ] = idMove( list[ i + 1 ] );
 	}
 
 	return true;
@@ -874,8 +972,8 @@ The number of elements in the list is reduced by one.  Returns false if the data
 the element is not destroyed, so any memory used by it may not be freed until the destruction of the list.
 ================
 */
-template< class type >
-ID_INLINE bool idList<type>::Remove( type const & obj ) {
+template< class type, class allocator >
+ID_INLINE bool idList<type,allocator>::Remove( type const & obj ) {
 	int index;
 
 	index = FindIndex( obj );
@@ -894,8 +992,8 @@ Performs a qsort on the list using the supplied comparison function.  Note that
 list, so any pointers to data within the list may no longer be valid.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Sort( cmp_t *compare ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::Sort( cmp_t *compare ) {
 	if ( !list ) {
 		return;
 	}
@@ -912,8 +1010,8 @@ idList<type>::SortSubSection
 Sorts a subsection of the list.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SortSubSection( int startIndex, int endIndex, cmp_t *compare ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::SortSubSection( int startIndex, int endIndex, cmp_t *compare ) {
 	if ( !list ) {
 		return;
 	}
@@ -939,8 +1037,8 @@ idList<type>::Swap
 Swaps the contents of two lists
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Swap( idList<type> &other ) {
+template< class type, class allocator >
+ID_INLINE void idList<type,allocator>::Swap( idList<type,allocator> &other ) {
 	idSwap( num, other.num );
 	idSwap( size, other.size );
 	idSwap( granularity, other.granularity );
@@ -0,0 +1,349 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __LOCKFREEQUEUE_H__
+#define __LOCKFREEQUEUE_H__
+
+/*
+===============================================================================
+
+	Bounded lock-free ring buffer queues.
+
+	idSPSCQueue can be used by exactly one producer and one consumer thread.
+	idMPMCQueue can be pushed to and popped from by any number of threads.
+
+	Both store a fixed number of elements in place, the size has to be a
+	power of two. Elements are copied in and out by assignment. Push fails
+	when the queue is full and Pop fails when it is empty, neither ever blocks.
+	The indices written by different threads are padded to separate cache lines.
+	The indices wrap around, only their difference is meaningful.
+
+===============================================================================
+*/
+
+ID_INLINE int idQueueIndexAdd( int index, int n ) {
+	return (int)( (unsigned int)index + (unsigned int)n );
+}
+
+ID_INLINE int idQueueIndexDiff( int a, int b ) {
+	return (int)( (unsigned int)a - (unsigned int)b );
+}
+
+/*
+===============================================================================
+
+	Single producer single consumer queue.
+
+	Each side keeps a cached copy of the other side's index so it only
+	touches the other side's cache line when the cached copy says the
+	queue is full or empty.
+
+===============================================================================
+*/
+
+template<class type,int size>
+class idSPSCQueue {
+public:
+							idSPSCQueue( void );
+
+	void					Clear( void );						// not thread safe
+	bool					Push( const type &element );		// producer thread only, returns false when full
+	bool					Pop( type &element );				// consumer thread only, returns false when empty
+	int						Num( void ) const;					// only exact when called from the producer or consumer
+	bool					IsEmpty( void ) const;
+	int						Max( void ) const;
+
+private:
+	volatile int			head;								// next element to pop, written by the consumer
+	int						tailCache;							// tail as last seen by the consumer
+	byte					pad0[ID_CACHE_LINE_SIZE - 2 * sizeof( int )];
+	volatile int			tail;								// next element to push, written by the producer
+	int						headCache;							// head as last seen by the producer
+	byte					pad1[ID_CACHE_LINE_SIZE - 2 * sizeof( int )];
+	type					elements[size];
+};
+
+/*
+================
+idSPSCQueue<type,size>::idSPSCQueue
+================
+*/
+template<class type,int size>
+ID_INLINE idSPSCQueue<type,size>::idSPSCQueue( void ) {
+	assert( size > 0 && ( size & ( size - 1 ) ) == 0 );
+	Clear();
+}
+
+/*
+================
+idSPSCQueue<type,size>::Clear
+================
+*/
+template<class type,int size>
+ID_INLINE void idSPSCQueue<type,size>::Clear( void ) {
+	head = 0;
+	tailCache = 0;
+	tail = 0;
+	headCache = 0;
+}
+
+/*
+================
+idSPSCQueue<type,size>::Push
+================
+*/
+template<class type,int size>
+ID_INLINE bool idSPSCQueue<type,size>::Push( const type &element ) {
+	const int t = tail;
+	if ( idQueueIndexDiff( t, headCache ) >= size ) {
+		headCache = idSysAtomic::LoadAcquire( &head );
+		if ( idQueueIndexDiff( t, headCache ) >= size ) {
+			return false;
+		}
+	}
+	elements[t & ( size - 1 )] = element;
+	idSysAtomic::StoreRelease( &tail, idQueueIndexAdd( t, 1 ) );
+	return true;
+}
+
+/*
+================
+idSPSCQueue<type,size>::Pop
+================
+*/
+template<class type,int size>
+ID_INLINE bool idSPSCQueue<type,size>::Pop( type &element ) {
+	const int h = head;
+	if ( h == tailCache ) {
+		tailCache = idSysAtomic::LoadAcquire( &tail );
+		if ( h == tailCache ) {
+			return false;
+		}
+	}
+	element = elements[h & ( size - 1 )];
+	idSysAtomic::StoreRelease( &head, idQueueIndexAdd( h, 1 ) );
+	return true;
+}
+
+/*
+================
+idSPSCQueue<type,size>::Num
+================
+*/
+template<class type,int size>
+ID_INLINE int idSPSCQueue<type,size>::Num( void ) const {
+	const int h = idSysAtomic::LoadAcquire( &head );
+	const int t = idSysAtomic::LoadAcquire( &tail );
+	return idMath::ClampInt( 0, size, idQueueIndexDiff( t, h ) );
+}
+
+/*
+================
+idSPSCQueue<type,size>::IsEmpty
+================
+*/
+template<class type,int size>
+ID_INLINE bool idSPSCQueue<type,size>::IsEmpty( void ) const {
+	return Num() == 0;
+}
+
+/*
+================
+idSPSCQueue<type,size>::Max
+================
+*/
+template<class type,int size>
+ID_INLINE int idSPSCQueue<type,size>::Max( void ) const {
+	return size;
+}
+
+/*
+===============================================================================
+
+	Multiple producer multiple consumer queue.
+
+	Every element has a sequence number that tells whether the slot is
+	ready to be written or read in the current pass over the ring. Threads
+	claim a slot by advancing the push or pop index with a compare-exchange
+	and then publish the element by updating the sequence number of the slot.
+
+===============================================================================
+*/
+
+template<class type,int size>
+class idMPMCQueue {
+public:
+							idMPMCQueue( void );
+
+	void					Clear( void );						// not thread safe
+	bool					Push( const type &element );		// returns false when full
+	bool					Pop( type &element );				// returns false when empty
+	int						Num( void ) const;					// approximate while other threads push or pop
+	bool					IsEmpty( void ) const;
+	int						Max( void ) const;
+
+private:
+	typedef struct {
+		volatile int		sequence;
+		type				element;
+	} cell_t;
+
+	volatile int			pushIndex;
+	byte					pad0[ID_CACHE_LINE_SIZE - sizeof( int )];
+	volatile int			popIndex;
+	byte					pad1[ID_CACHE_LINE_SIZE - sizeof( int )];
+	cell_t					cells[size];
+};
+
+/*
+================
+idMPMCQueue<type,size>::idMPMCQueue
+================
+*/
+template<class type,int size>
+ID_INLINE idMPMCQueue<type,size>::idMPMCQueue( void ) {
+	assert( size > 0 && ( size & ( size - 1 ) ) == 0 );
+	Clear();
+}
+
+/*
+================
+idMPMCQueue<type,size>::Clear
+================
+*/
+template<class type,int size>
+ID_INLINE void idMPMCQueue<type,size>::Clear( void ) {
+	for ( int i = 0; i < size; i++ ) {
+		cells[i].sequence = i;
+	}
+	pushIndex = 0;
+	popIndex = 0;
+	idSysAtomic::FullBarrier();
+}
+
+/*
+================
+idMPMCQueue<type,size>::Push
+================
+*/
+template<class type,int size>
+ID_INLINE bool idMPMCQueue<type,size>::Push( const type &element ) {
+	cell_t *cell;
+	int pos = pushIndex;
+
+	while( 1 ) {
+		cell = &cells[pos & ( size - 1 )];
+		const int diff = idQueueIndexDiff( idSysAtomic::LoadAcquire( &cell->sequence ), pos );
+		if ( diff == 0 ) {
+			// the slot is free in this pass, try to claim it
+			const int prev = idSysAtomic::CompareExchange( &pushIndex, pos, idQueueIndexAdd( pos, 1 ) );
+			if ( prev == pos ) {
+				break;
+			}
+			pos = prev;
+		} else if ( diff < 0 ) {
+			// the slot still holds an element from the previous pass
+			return false;
+		} else {
+			// another producer claimed the slot
+			pos = pushIndex;
+		}
+	}
+
+	cell->element = element;
+	idSysAtomic::StoreRelease( &cell->sequence, idQueueIndexAdd( pos, 1 ) );
+	return true;
+}
+
+/*
+================
+idMPMCQueue<type,size>::Pop
+================
+*/
+template<class type,int size>
+ID_INLINE bool idMPMCQueue<type,size>::Pop( type &element ) {
+	cell_t *cell;
+	int pos = popIndex;
+
+	while( 1 ) {
+		cell = &cells[pos & ( size - 1 )];
+		const int diff = idQueueIndexDiff( idSysAtomic::LoadAcquire( &cell->sequence ), idQueueIndexAdd( pos, 1 ) );
+		if ( diff == 0 ) {
+			// the slot holds an element, try to claim it
+			const int prev = idSysAtomic::CompareExchange( &popIndex, pos, idQueueIndexAdd( pos, 1 ) );
+			if ( prev == pos ) {
+				break;
+			}
+			pos = prev;
+		} else if ( diff < 0 ) {
+			// the slot has not been written in this pass
+			return false;
+		} else {
+			// another consumer claimed the slot
+			pos = popIndex;
+		}
+	}
+
+	element = cell->element;
+	idSysAtomic::StoreRelease( &cell->sequence, idQueueIndexAdd( pos, size ) );
+	return true;
+}
+
+/*
+================
+idMPMCQueue<type,size>::Num
+================
+*/
+template<class type,int size>
+ID_INLINE int idMPMCQueue<type,size>::Num( void ) const {
+	const int pop = idSysAtomic::LoadAcquire( &popIndex );
+	const int push = idSysAtomic::LoadAcquire( &pushIndex );
+	return idMath::ClampInt( 0, size, idQueueIndexDiff( push, pop ) );
+}
+
+/*
+================
+idMPMCQueue<type,size>::IsEmpty
+================
+*/
+template<class type,int size>
+ID_INLINE bool idMPMCQueue<type,size>::IsEmpty( void ) const {
+	return Num() == 0;
+}
+
+/*
+================
+idMPMCQueue<type,size>::Max
+================
+*/
+template<class type,int size>
+ID_INLINE int idMPMCQueue<type,size>::Max( void ) const {
+	return size;
+}
+
+#endif /* !__LOCKFREEQUEUE_H__ */
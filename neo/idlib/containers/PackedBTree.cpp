@@ -0,0 +1,258 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../precompiled.h"
+#pragma hdrstop
+
+#define BENCH_MAX_KEYS			( 1 << 20 )
+#define BENCH_KEYS_PER_NODE		32
+#define BENCH_RANGE_SIZE		64
+
+typedef struct {
+	double		insert;
+	double		find;
+	double		nearest;
+	double		range;
+	double		remove;
+	int			found;
+} btreeBenchTimes_t;
+
+typedef idBTree<int,int,BENCH_KEYS_PER_NODE>			benchBTree_t;
+typedef idPackedBTree<int,int,BENCH_KEYS_PER_NODE>		benchPackedBTree_t;
+
+/*
+================
+BTreeBench_Print
+================
+*/
+static void BTreeBench_Print( const char *name, const btreeBenchTimes_t &t, int numKeys, size_t memory ) {
+	idLib::common->Printf( "%-20s insert %7.1f ns  find %7.1f ns  nearest %7.1f ns  range %7.1f ns  remove %7.1f ns  %7d KB  (%d found)\n", name,
+				t.insert * 1e6 / numKeys, t.find * 1e6 / numKeys, t.nearest * 1e6 / numKeys, t.range * 1e6 / ( numKeys / BENCH_RANGE_SIZE ),
+				t.remove * 1e6 / ( numKeys / 2 ), (int)( memory >> 10 ), t.found );
+}
+
+/*
+================
+BTreeBench_BTree
+================
+*/
+static void BTreeBench_BTree( const idList<int> &keys, const idList<int> &order, int *objects ) {
+	btreeBenchTimes_t t;
+	idTimer timer;
+	int i, j;
+
+	benchBTree_t *tree = new benchBTree_t;
+	idBTreeNode<int,int> **nodes = new idBTreeNode<int,int> *[keys.Num()];
+
+	tree->Init();
+
+	timer.Start();
+	for ( i = 0; i < order.Num(); i++ ) {
+		nodes[order[i]] = tree->Add( &objects[order[i]], keys[order[i]] );
+	}
+	timer.Stop();
+	t.insert = timer.Milliseconds();
+
+	t.found = 0;
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < order.Num(); i++ ) {
+		t.found += ( tree->Find( keys[order[i]] ) == &objects[order[i]] );
+	}
+	timer.Stop();
+	t.find = timer.Milliseconds();
+
+	// the keys are even so searching odd keys never hits
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < order.Num(); i++ ) {
+		t.found += ( tree->FindSmallestLargerEqual( keys[order[i]] - 1 ) == &objects[order[i]] );
+	}
+	timer.Stop();
+	t.nearest = timer.Milliseconds();
+
+	// walk the leaves from the first node with a key larger equal the range start
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i + BENCH_RANGE_SIZE <= order.Num(); i += BENCH_RANGE_SIZE ) {
+		idBTreeNode<int,int> *node = nodes[order[i]];
+		for ( j = 0; node && j < BENCH_RANGE_SIZE; j++, node = tree->GetNextLeaf( node ) ) {
+			t.found += ( node->object != NULL );
+		}
+	}
+	timer.Stop();
+	t.range = timer.Milliseconds();
+
+	const size_t memory = tree->GetNodeCount() * sizeof( idBTreeNode<int,int> );
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < order.Num(); i += 2 ) {
+		tree->Remove( nodes[order[i]] );
+	}
+	timer.Stop();
+	t.remove = timer.Milliseconds();
+
+	// the other half must still be there
+	for ( i = 1; i < order.Num(); i += 2 ) {
+		if ( tree->Find( keys[order[i]] ) != &objects[order[i]] ) {
+			idLib::common->Warning( "idBTree lost key %d", keys[order[i]] );
+			break;
+		}
+	}
+
+	BTreeBench_Print( "idBTree", t, keys.Num(), memory );
+
+	delete[] nodes;
+	delete tree;
+}
+
+/*
+================
+BTreeBench_PackedBTree
+================
+*/
+static void BTreeBench_PackedBTree( const idList<int> &keys, const idList<int> &order, int *objects, bool bulk ) {
+	btreeBenchTimes_t t;
+	idTimer timer;
+	idList<int *> list;
+	int i;
+
+	benchPackedBTree_t *tree = new benchPackedBTree_t;
+
+	timer.Start();
+	if ( bulk ) {
+		int **sorted = new int *[keys.Num()];
+		for ( i = 0; i < keys.Num(); i++ ) {
+			sorted[i] = &objects[i];
+		}
+		tree->Build( sorted, keys.Ptr(), keys.Num() );
+		delete[] sorted;
+	} else {
+		for ( i = 0; i < order.Num(); i++ ) {
+			tree->Add( &objects[order[i]], keys[order[i]] );
+		}
+	}
+	timer.Stop();
+	t.insert = timer.Milliseconds();
+
+	t.found = 0;
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < order.Num(); i++ ) {
+		t.found += ( tree->Find( keys[order[i]] ) == &objects[order[i]] );
+	}
+	timer.Stop();
+	t.find = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < order.Num(); i++ ) {
+		t.found += ( tree->FindSmallestLargerEqual( keys[order[i]] - 1 ) == &objects[order[i]] );
+	}
+	timer.Stop();
+	t.nearest = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i + BENCH_RANGE_SIZE <= order.Num(); i += BENCH_RANGE_SIZE ) {
+		const int first = keys[order[i]];
+		list.SetNum( 0, false );
+		t.found += tree->GetRange( first, first + ( BENCH_RANGE_SIZE - 1 ) * 2, list );
+	}
+	timer.Stop();
+	t.range = timer.Milliseconds();
+
+	const size_t memory = tree->Allocated();
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < order.Num(); i += 2 ) {
+		tree->Remove( &objects[order[i]], keys[order[i]] );
+	}
+	timer.Stop();
+	t.remove = timer.Milliseconds();
+
+	for ( i = 1; i < order.Num(); i += 2 ) {
+		if ( tree->Find( keys[order[i]] ) != &objects[order[i]] ) {
+			idLib::common->Warning( "idPackedBTree lost key %d", keys[order[i]] );
+			break;
+		}
+	}
+	if ( tree->Num() != order.Num() / 2 ) {
+		idLib::common->Warning( "idPackedBTree has %d objects instead of %d", tree->Num(), order.Num() / 2 );
+	}
+
+	BTreeBench_Print( bulk ? "idPackedBTree build" : "idPackedBTree", t, keys.Num(), memory );
+
+	delete tree;
+}
+
+/*
+================
+PackedBTree_Bench_f
+
+  benchBTree [numKeys]
+================
+*/
+void PackedBTree_Bench_f( const idCmdArgs &args ) {
+	int i, j, n, first, last;
+	idList<int> keys, order;
+	idRandom random( 0x5EED );
+
+	first = 10000;
+	last = 1000000;
+	if ( args.Argc() > 1 ) {
+		first = last = idMath::ClampInt( BENCH_RANGE_SIZE * 2, BENCH_MAX_KEYS, atoi( args.Argv( 1 ) ) );
+	}
+
+	idLib::common->Printf( "%d keys per node, range queries of %d keys, times per operation\n", BENCH_KEYS_PER_NODE, BENCH_RANGE_SIZE );
+
+	for ( n = first; n <= last; n *= 10 ) {
+		// sorted even keys, inserted and searched in random order
+		keys.SetNum( n );
+		order.SetNum( n );
+		for ( i = 0; i < n; i++ ) {
+			keys[i] = i * 2;
+			order[i] = i;
+		}
+		// idRandom only returns 15 bits
+		for ( i = n - 1; i > 0; i-- ) {
+			j = ( ( random.RandomInt() << 15 ) | random.RandomInt() ) % ( i + 1 );
+			idSwap( order[i], order[j] );
+		}
+		int *objects = new int[n];
+
+		idLib::common->Printf( "%d keys\n", n );
+		BTreeBench_BTree( keys, order, objects );
+		BTreeBench_PackedBTree( keys, order, objects, false );
+		BTreeBench_PackedBTree( keys, order, objects, true );
+
+		delete[] objects;
+	}
+}
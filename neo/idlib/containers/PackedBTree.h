@@ -0,0 +1,898 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __PACKEDBTREE_H__
+#define __PACKEDBTREE_H__
+
+/*
+===============================================================================
+
+	Array backed B+ tree
+
+	Stores the same kind of sorted object pointers as idBTree but the nodes
+	live in two arrays and refer to each other by index. Every node stores
+	its keys packed together so searching a node reads a couple of cache lines
+	and compares all keys without branching. The objects are only stored in
+	the leaves which are linked in key order for range iteration.
+
+	Freed nodes are kept on free lists and reused. Build replaces the contents
+	with sorted input in linear time and lays the nodes out in key order.
+
+	Objects with the same key are allowed.
+
+===============================================================================
+*/
+
+/*
+================
+idPackedBTreeCountLess
+
+  Returns the number of keys smaller than the given key.
+================
+*/
+template< class keyType >
+ID_INLINE int idPackedBTreeCountLess( const keyType *keys, const int num, const keyType &key ) {
+	int count = 0;
+	for ( int i = 0; i < num; i++ ) {
+		count += ( keys[i] < key );
+	}
+	return count;
+}
+
+/*
+================
+idPackedBTreeCountLessEqual
+
+  Returns the number of keys smaller than or equal to the given key.
+================
+*/
+template< class keyType >
+ID_INLINE int idPackedBTreeCountLessEqual( const keyType *keys, const int num, const keyType &key ) {
+	int count = 0;
+	for ( int i = 0; i < num; i++ ) {
+		count += !( key < keys[i] );
+	}
+	return count;
+}
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+
+#include <emmintrin.h>
+
+// the compare results are all ones, subtracting them counts the keys
+template<>
+ID_INLINE int idPackedBTreeCountLess<int>( const int *keys, const int num, const int &key ) {
+	const __m128i k = _mm_set1_epi32( key );
+	__m128i c = _mm_setzero_si128();
+	int i;
+	for ( i = 0; i + 4 <= num; i += 4 ) {
+		c = _mm_sub_epi32( c, _mm_cmplt_epi32( _mm_loadu_si128( (const __m128i *)( keys + i ) ), k ) );
+	}
+	c = _mm_add_epi32( c, _mm_shuffle_epi32( c, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	c = _mm_add_epi32( c, _mm_shuffle_epi32( c, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	int count = _mm_cvtsi128_si32( c );
+	for ( ; i < num; i++ ) {
+		count += ( keys[i] < key );
+	}
+	return count;
+}
+
+template<>
+ID_INLINE int idPackedBTreeCountLessEqual<int>( const int *keys, const int num, const int &key ) {
+	const __m128i k = _mm_set1_epi32( key );
+	__m128i c = _mm_setzero_si128();
+	int i;
+	for ( i = 0; i + 4 <= num; i += 4 ) {
+		c = _mm_sub_epi32( c, _mm_cmpgt_epi32( _mm_loadu_si128( (const __m128i *)( keys + i ) ), k ) );
+	}
+	c = _mm_add_epi32( c, _mm_shuffle_epi32( c, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	c = _mm_add_epi32( c, _mm_shuffle_epi32( c, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	int count = i - _mm_cvtsi128_si32( c );
+	for ( ; i < num; i++ ) {
+		count += ( keys[i] <= key );
+	}
+	return count;
+}
+
+template<>
+ID_INLINE int idPackedBTreeCountLess<float>( const float *keys, const int num, const float &key ) {
+	const __m128 k = _mm_set1_ps( key );
+	__m128i c = _mm_setzero_si128();
+	int i;
+	for ( i = 0; i + 4 <= num; i += 4 ) {
+		c = _mm_sub_epi32( c, _mm_castps_si128( _mm_cmplt_ps( _mm_loadu_ps( keys + i ), k ) ) );
+	}
+	c = _mm_add_epi32( c, _mm_shuffle_epi32( c, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	c = _mm_add_epi32( c, _mm_shuffle_epi32( c, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	int count = _mm_cvtsi128_si32( c );
+	for ( ; i < num; i++ ) {
+		count += ( keys[i] < key );
+	}
+	return count;
+}
+
+template<>
+ID_INLINE int idPackedBTreeCountLessEqual<float>( const float *keys, const int num, const float &key ) {
+	const __m128 k = _mm_set1_ps( key );
+	__m128i c = _mm_setzero_si128();
+	int i;
+	for ( i = 0; i + 4 <= num; i += 4 ) {
+		c = _mm_sub_epi32( c, _mm_castps_si128( _mm_cmple_ps( _mm_loadu_ps( keys + i ), k ) ) );
+	}
+	c = _mm_add_epi32( c, _mm_shuffle_epi32( c, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	c = _mm_add_epi32( c, _mm_shuffle_epi32( c, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	int count = _mm_cvtsi128_si32( c );
+	for ( ; i < num; i++ ) {
+		count += ( keys[i] <= key );
+	}
+	return count;
+}
+
+#endif
+
+
+template< class objType, class keyType, int keysPerNode >
+class idPackedBTree {
+public:
+									idPackedBTree( void );
+									~idPackedBTree( void );
+
+	void							Clear( void );												// remove all objects but keep the node memory
+	void							Shutdown( void );											// remove all objects and free the node memory
+
+	void							Add( objType *object, keyType key );						// add an object to the tree
+	bool							Remove( objType *object, keyType key );						// remove an object that was added with the given key
+	void							Build( objType * const *objects, const keyType *keys, const int num );	// replace the contents with objects sorted on key
+
+	objType *						Find( keyType key ) const;									// find an object using the given key
+	objType *						FindSmallestLargerEqual( keyType key ) const;				// find an object with the smallest key larger equal the given key
+	objType *						FindLargestSmallerEqual( keyType key ) const;				// find an object with the largest key smaller equal the given key
+
+	int								Num( void ) const;											// returns the number of objects in the tree
+	int								GetHeight( void ) const;									// returns the number of internal node levels
+	size_t							Allocated( void ) const;									// returns total size of allocated memory
+
+									// walk the objects in key order, positions are invalid after the tree changes
+	int								GetFirst( void ) const;										// returns the position of the first object or -1
+	int								GetNext( int position ) const;								// returns the position of the next object or -1
+	int								LowerBound( keyType key ) const;							// returns the position of the first object with a key larger equal the given key or -1
+	objType *						GetObject( int position ) const;
+	keyType							GetKey( int position ) const;
+	int								GetRange( keyType minKey, keyType maxKey, idList<objType *> &list ) const;	// appends the objects with minKey <= key <= maxKey, returns the number appended
+
+private:
+	static const int				MIN_KEYS = keysPerNode / 2;
+	static const int				MAX_HEIGHT = 32;
+
+	typedef struct {
+		int							numKeys;
+		int							next;								// next leaf in key order or next free leaf
+		int							prev;								// previous leaf in key order
+		keyType						keys[keysPerNode];
+		objType *					objects[keysPerNode];
+	} leaf_t;
+
+	typedef struct {
+		int							numKeys;
+		int							next;								// next free node
+		keyType						keys[keysPerNode];					// largest key in every child
+		int							children[keysPerNode];				// leaf indexes at the lowest level, node indexes otherwise
+	} node_t;
+
+	typedef struct {
+		int							node[MAX_HEIGHT];
+		int							slot[MAX_HEIGHT];
+	} path_t;
+
+	idList<node_t>					nodes;
+	idList<leaf_t>					leaves;
+	int								root;								// leaf index if height is zero, node index otherwise, -1 if empty
+	int								height;
+	int								firstLeaf;
+	int								lastLeaf;
+	int								freeNodes;
+	int								freeLeaves;
+	int								numObjects;
+
+	int								AllocNode( void );
+	int								AllocLeaf( void );
+	void							FreeNode( int index );
+	void							FreeLeaf( int index );
+	int								FindLeaf( keyType key, path_t *path ) const;
+	int								NextLeaf( path_t &path ) const;
+	void							SplitChild( int parent, int slot, bool childIsLeaf );
+	void							RemoveFromLeaf( path_t &path, int leaf, int slot );
+	void							Rebalance( int parent, int slot, bool childIsLeaf );
+	keyType							LastKey( int child, bool childIsLeaf ) const;
+	void							CheckTree( void ) const;
+};
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE idPackedBTree<objType,keyType,keysPerNode>::idPackedBTree( void ) {
+	assert( keysPerNode >= 4 );
+	Clear();
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE idPackedBTree<objType,keyType,keysPerNode>::~idPackedBTree( void ) {
+	Shutdown();
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE void idPackedBTree<objType,keyType,keysPerNode>::Clear( void ) {
+	nodes.SetNum( 0, false );
+	leaves.SetNum( 0, false );
+	root = -1;
+	height = 0;
+	firstLeaf = -1;
+	lastLeaf = -1;
+	freeNodes = -1;
+	freeLeaves = -1;
+	numObjects = 0;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE void idPackedBTree<objType,keyType,keysPerNode>::Shutdown( void ) {
+	Clear();
+	nodes.Clear();
+	leaves.Clear();
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE void idPackedBTree<objType,keyType,keysPerNode>::Add( objType *object, keyType key ) {
+	int node, slot;
+
+	if ( root == -1 ) {
+		root = AllocLeaf();
+		firstLeaf = lastLeaf = root;
+	}
+
+	// split a full root first so there is always room for a split child
+	if ( ( height == 0 && leaves[root].numKeys >= keysPerNode ) || ( height > 0 && nodes[root].numKeys >= keysPerNode ) ) {
+		const int newRoot = AllocNode();
+		node_t &r = nodes[newRoot];
+		r.numKeys = 1;
+		r.keys[0] = LastKey( root, height == 0 );
+		r.children[0] = root;
+		root = newRoot;
+		height++;
+		SplitChild( root, 0, height == 1 );
+	}
+
+	// walk down and split full children on the way so the leaf has room
+	node = root;
+	for ( int level = 0; level < height; level++ ) {
+		const bool childIsLeaf = ( level == height - 1 );
+
+		slot = idPackedBTreeCountLessEqual( nodes[node].keys, nodes[node].numKeys, key );
+		if ( slot >= nodes[node].numKeys ) {
+			slot = nodes[node].numKeys - 1;
+		}
+
+		const int child = nodes[node].children[slot];
+		if ( childIsLeaf ? ( leaves[child].numKeys >= keysPerNode ) : ( nodes[child].numKeys >= keysPerNode ) ) {
+			SplitChild( node, slot, childIsLeaf );
+			if ( nodes[node].keys[slot] < key ) {
+				slot++;
+			}
+		}
+
+		node_t &n = nodes[node];
+		if ( n.keys[slot] < key ) {
+			n.keys[slot] = key;
+		}
+		node = n.children[slot];
+	}
+
+	// insert after any objects with the same key
+	leaf_t &leaf = leaves[node];
+	slot = idPackedBTreeCountLessEqual( leaf.keys, leaf.numKeys, key );
+	for ( int i = leaf.numKeys; i > slot; i-- ) {
+		leaf.keys[i] = leaf.keys[i - 1];
+		leaf.objects[i] = leaf.objects[i - 1];
+	}
+	leaf.keys[slot] = key;
+	leaf.objects[slot] = object;
+	leaf.numKeys++;
+	numObjects++;
+
+#ifdef BTREE_CHECK
+	CheckTree();
+#endif
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE bool idPackedBTree<objType,keyType,keysPerNode>::Remove( objType *object, keyType key ) {
+	path_t path;
+
+	// objects with the same key may continue in the next leaves
+	for ( int leaf = FindLeaf( key, &path ); leaf != -1; leaf = NextLeaf( path ) ) {
+		const leaf_t &l = leaves[leaf];
+		for ( int i = idPackedBTreeCountLess( l.keys, l.numKeys, key ); i < l.numKeys; i++ ) {
+			if ( key < l.keys[i] ) {
+				return false;
+			}
+			if ( l.objects[i] == object ) {
+				RemoveFromLeaf( path, leaf, i );
+#ifdef BTREE_CHECK
+				CheckTree();
+#endif
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE void idPackedBTree<objType,keyType,keysPerNode>::Build( objType * const *objects, const keyType *keys, const int num ) {
+	int i, j, count, first, numChildren;
+
+	Clear();
+
+	if ( num <= 0 ) {
+		return;
+	}
+
+	// spread the objects evenly over the smallest number of leaves
+	count = ( num + keysPerNode - 1 ) / keysPerNode;
+	leaves.SetNum( count, false );
+	for ( i = 0, j = 0; i < count; i++ ) {
+		leaf_t &leaf = leaves[i];
+		leaf.numKeys = num / count + ( i < num % count );
+		leaf.next = ( i < count - 1 ) ? i + 1 : -1;
+		leaf.prev = i - 1;
+		for ( int k = 0; k < leaf.numKeys; k++, j++ ) {
+			assert( j == 0 || !( keys[j] < keys[j - 1] ) );
+			leaf.keys[k] = keys[j];
+			leaf.objects[k] = objects[j];
+		}
+	}
+	firstLeaf = 0;
+	lastLeaf = count - 1;
+	numObjects = num;
+
+	// build the internal levels bottom up, every level is stored after the one below
+	first = 0;
+	numChildren = count;
+	while( numChildren > 1 ) {
+		count = ( numChildren + keysPerNode - 1 ) / keysPerNode;
+		const int base = nodes.Num();
+		nodes.SetNum( base + count, false );
+		for ( i = 0, j = first; i < count; i++ ) {
+			node_t &node = nodes[base + i];
+			node.numKeys = numChildren / count + ( i < numChildren % count );
+			node.next = -1;
+			for ( int k = 0; k < node.numKeys; k++, j++ ) {
+				node.keys[k] = LastKey( j, height == 0 );
+				node.children[k] = j;
+			}
+		}
+		first = base;
+		numChildren = count;
+		height++;
+	}
+	root = first;
+
+#ifdef BTREE_CHECK
+	CheckTree();
+#endif
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE objType *idPackedBTree<objType,keyType,keysPerNode>::Find( keyType key ) const {
+	const int position = LowerBound( key );
+	if ( position == -1 ) {
+		return NULL;
+	}
+	const leaf_t &leaf = leaves[position / keysPerNode];
+	const int slot = position % keysPerNode;
+	if ( key < leaf.keys[slot] ) {
+		return NULL;
+	}
+	return leaf.objects[slot];
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE objType *idPackedBTree<objType,keyType,keysPerNode>::FindSmallestLargerEqual( keyType key ) const {
+	const int position = LowerBound( key );
+	if ( position == -1 ) {
+		return NULL;
+	}
+	return leaves[position / keysPerNode].objects[position % keysPerNode];
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE objType *idPackedBTree<objType,keyType,keysPerNode>::FindLargestSmallerEqual( keyType key ) const {
+	if ( root == -1 ) {
+		return NULL;
+	}
+
+	// find the leaf with the first key larger than the given key, the object is in that leaf or the one before
+	int node = root;
+	for ( int level = 0; level < height; level++ ) {
+		const node_t &n = nodes[node];
+		int slot = idPackedBTreeCountLessEqual( n.keys, n.numKeys, key );
+		if ( slot >= n.numKeys ) {
+			slot = n.numKeys - 1;
+		}
+		node = n.children[slot];
+	}
+
+	const leaf_t &leaf = leaves[node];
+	const int slot = idPackedBTreeCountLessEqual( leaf.keys, leaf.numKeys, key );
+	if ( slot > 0 ) {
+		return leaf.objects[slot - 1];
+	}
+	if ( leaf.prev != -1 ) {
+		const leaf_t &prev = leaves[leaf.prev];
+		return prev.objects[prev.numKeys - 1];
+	}
+	return NULL;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE int idPackedBTree<objType,keyType,keysPerNode>::Num( void ) const {
+	return numObjects;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE int idPackedBTree<objType,keyType,keysPerNode>::GetHeight( void ) const {
+	return height;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE size_t idPackedBTree<objType,keyType,keysPerNode>::Allocated( void ) const {
+	return nodes.Allocated() + leaves.Allocated();
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE int idPackedBTree<objType,keyType,keysPerNode>::GetFirst( void ) const {
+	if ( numObjects == 0 ) {
+		return -1;
+	}
+	return firstLeaf * keysPerNode;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE int idPackedBTree<objType,keyType,keysPerNode>::GetNext( int position ) const {
+	const int leaf = position / keysPerNode;
+	const int slot = position % keysPerNode;
+	if ( slot + 1 < leaves[leaf].numKeys ) {
+		return position + 1;
+	}
+	if ( leaves[leaf].next == -1 ) {
+		return -1;
+	}
+	return leaves[leaf].next * keysPerNode;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE int idPackedBTree<objType,keyType,keysPerNode>::LowerBound( keyType key ) const {
+	const int leaf = FindLeaf( key, NULL );
+	if ( leaf == -1 ) {
+		return -1;
+	}
+	const leaf_t &l = leaves[leaf];
+	const int slot = idPackedBTreeCountLess( l.keys, l.numKeys, key );
+	if ( slot >= l.numKeys ) {
+		return -1;
+	}
+	return leaf * keysPerNode + slot;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE objType *idPackedBTree<objType,keyType,keysPerNode>::GetObject( int position ) const {
+	return leaves[position / keysPerNode].objects[position % keysPerNode];
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE keyType idPackedBTree<objType,keyType,keysPerNode>::GetKey( int position ) const {
+	return leaves[position / keysPerNode].keys[position % keysPerNode];
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE int idPackedBTree<objType,keyType,keysPerNode>::GetRange( keyType minKey, keyType maxKey, idList<objType *> &list ) const {
+	const int position = LowerBound( minKey );
+	if ( position == -1 ) {
+		return 0;
+	}
+	const int start = list.Num();
+	int slot = position % keysPerNode;
+	for ( int leaf = position / keysPerNode; leaf != -1; leaf = leaves[leaf].next, slot = 0 ) {
+		const leaf_t &l = leaves[leaf];
+		const int end = idPackedBTreeCountLessEqual( l.keys, l.numKeys, maxKey );
+		for ( ; slot < end; slot++ ) {
+			list.Append( l.objects[slot] );
+		}
+		if ( end < l.numKeys ) {
+			break;
+		}
+	}
+	return list.Num() - start;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE int idPackedBTree<objType,keyType,keysPerNode>::AllocNode( void ) {
+	int index;
+	if ( freeNodes != -1 ) {
+		index = freeNodes;
+		freeNodes = nodes[index].next;
+	} else {
+		// grow geometrically, the nodes are copied on every resize
+		if ( nodes.Num() >= nodes.NumAllocated() ) {
+			nodes.Resize( Max( 16, nodes.NumAllocated() * 2 ) );
+		}
+		index = nodes.Num();
+		nodes.Alloc();
+	}
+	nodes[index].numKeys = 0;
+	nodes[index].next = -1;
+	return index;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE int idPackedBTree<objType,keyType,keysPerNode>::AllocLeaf( void ) {
+	int index;
+	if ( freeLeaves != -1 ) {
+		index = freeLeaves;
+		freeLeaves = leaves[index].next;
+	} else {
+		if ( leaves.Num() >= leaves.NumAllocated() ) {
+			leaves.Resize( Max( 16, leaves.NumAllocated() * 2 ) );
+		}
+		index = leaves.Num();
+		leaves.Alloc();
+	}
+	leaves[index].numKeys = 0;
+	leaves[index].next = -1;
+	leaves[index].prev = -1;
+	return index;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE void idPackedBTree<objType,keyType,keysPerNode>::FreeNode( int index ) {
+	nodes[index].numKeys = 0;
+	nodes[index].next = freeNodes;
+	freeNodes = index;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE void idPackedBTree<objType,keyType,keysPerNode>::FreeLeaf( int index ) {
+	leaves[index].numKeys = 0;
+	leaves[index].prev = -1;
+	leaves[index].next = freeLeaves;
+	freeLeaves = index;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE int idPackedBTree<objType,keyType,keysPerNode>::FindLeaf( keyType key, path_t *path ) const {
+	if ( root == -1 ) {
+		return -1;
+	}
+
+	// the first child with a largest key larger equal the given key holds the first object with that key
+	int node = root;
+	for ( int level = 0; level < height; level++ ) {
+		const node_t &n = nodes[node];
+		int slot = idPackedBTreeCountLess( n.keys, n.numKeys, key );
+		if ( slot >= n.numKeys ) {
+			slot = n.numKeys - 1;
+		}
+		if ( path ) {
+			path->node[level] = node;
+			path->slot[level] = slot;
+		}
+		node = n.children[slot];
+	}
+	return node;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE int idPackedBTree<objType,keyType,keysPerNode>::NextLeaf( path_t &path ) const {
+	// move the path to the next leaf through the parents
+	for ( int level = height - 1; level >= 0; level-- ) {
+		if ( path.slot[level] + 1 < nodes[path.node[level]].numKeys ) {
+			path.slot[level]++;
+			for ( level++; level < height; level++ ) {
+				path.node[level] = nodes[path.node[level - 1]].children[path.slot[level - 1]];
+				path.slot[level] = 0;
+			}
+			return nodes[path.node[height - 1]].children[path.slot[height - 1]];
+		}
+	}
+	return -1;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE void idPackedBTree<objType,keyType,keysPerNode>::SplitChild( int parent, int slot, bool childIsLeaf ) {
+	int i, newChild;
+
+	assert( nodes[parent].numKeys < keysPerNode );
+
+	// move the upper half of the child to a new node after it
+	if ( childIsLeaf ) {
+		newChild = AllocLeaf();
+		leaf_t &child = leaves[nodes[parent].children[slot]];
+		leaf_t &newLeaf = leaves[newChild];
+		const int half = child.numKeys / 2;
+		for ( i = half; i < child.numKeys; i++ ) {
+			newLeaf.keys[i - half] = child.keys[i];
+			newLeaf.objects[i - half] = child.objects[i];
+		}
+		newLeaf.numKeys = child.numKeys - half;
+		child.numKeys = half;
+
+		const int childIndex = nodes[parent].children[slot];
+		newLeaf.prev = childIndex;
+		newLeaf.next = child.next;
+		if ( child.next != -1 ) {
+			leaves[child.next].prev = newChild;
+		} else {
+			lastLeaf = newChild;
+		}
+		child.next = newChild;
+	} else {
+		newChild = AllocNode();
+		node_t &child = nodes[nodes[parent].children[slot]];
+		node_t &newNode = nodes[newChild];
+		const int half = child.numKeys / 2;
+		for ( i = half; i < child.numKeys; i++ ) {
+			newNode.keys[i - half] = child.keys[i];
+			newNode.children[i - half] = child.children[i];
+		}
+		newNode.numKeys = child.numKeys - half;
+		child.numKeys = half;
+	}
+
+	node_t &p = nodes[parent];
+	for ( i = p.numKeys; i > slot + 1; i-- ) {
+		p.keys[i] = p.keys[i - 1];
+		p.children[i] = p.children[i - 1];
+	}
+	p.keys[slot + 1] = p.keys[slot];
+	p.children[slot + 1] = newChild;
+	p.keys[slot] = LastKey( p.children[slot], childIsLeaf );
+	p.numKeys++;
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE void idPackedBTree<objType,keyType,keysPerNode>::RemoveFromLeaf( path_t &path, int leaf, int slot ) {
+	int level, i;
+
+	leaf_t &l = leaves[leaf];
+	for ( i = slot; i < l.numKeys - 1; i++ ) {
+		l.keys[i] = l.keys[i + 1];
+		l.objects[i] = l.objects[i + 1];
+	}
+	l.numKeys--;
+	numObjects--;
+
+	if ( numObjects == 0 ) {
+		Clear();
+		return;
+	}
+
+	// merge or rebalance underfull children on the way up and fix the largest keys
+	bool underflow = ( l.numKeys < MIN_KEYS );
+	for ( level = height - 1; level >= 0; level-- ) {
+		const int parent = path.node[level];
+		const bool childIsLeaf = ( level == height - 1 );
+		if ( underflow ) {
+			Rebalance( parent, path.slot[level], childIsLeaf );
+			underflow = ( nodes[parent].numKeys < MIN_KEYS );
+		} else {
+			nodes[parent].keys[path.slot[level]] = LastKey( nodes[parent].children[path.slot[level]], childIsLeaf );
+		}
+	}
+
+	// remove root nodes with a single child
+	while( height > 0 && nodes[root].numKeys == 1 ) {
+		const int oldRoot = root;
+		root = nodes[root].children[0];
+		FreeNode( oldRoot );
+		height--;
+	}
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE void idPackedBTree<objType,keyType,keysPerNode>::Rebalance( int parent, int slot, bool childIsLeaf ) {
+	int i, n;
+	bool merged = false;
+
+	node_t &p = nodes[parent];
+	if ( p.numKeys < 2 ) {
+		// only the root can have a single child
+		p.keys[slot] = LastKey( p.children[slot], childIsLeaf );
+		return;
+	}
+
+	// always work on a child and the sibling to the right of it
+	const int left = ( slot > 0 ) ? slot - 1 : slot;
+	const int right = left + 1;
+	const int leftIndex = p.children[left];
+	const int rightIndex = p.children[right];
+
+	if ( childIsLeaf ) {
+		leaf_t &a = leaves[leftIndex];
+		leaf_t &b = leaves[rightIndex];
+		const int total = a.numKeys + b.numKeys;
+		if ( total <= keysPerNode ) {
+			// merge the right leaf into the left one
+			for ( i = 0; i < b.numKeys; i++ ) {
+				a.keys[a.numKeys + i] = b.keys[i];
+				a.objects[a.numKeys + i] = b.objects[i];
+			}
+			a.numKeys = total;
+			a.next = b.next;
+			if ( b.next != -1 ) {
+				leaves[b.next].prev = leftIndex;
+			} else {
+				lastLeaf = leftIndex;
+			}
+			FreeLeaf( rightIndex );
+			merged = true;
+		} else if ( a.numKeys > total / 2 ) {
+			// move keys from the end of the left leaf to the right leaf
+			n = a.numKeys - total / 2;
+			for ( i = b.numKeys - 1; i >= 0; i-- ) {
+				b.keys[i + n] = b.keys[i];
+				b.objects[i + n] = b.objects[i];
+			}
+			for ( i = 0; i < n; i++ ) {
+				b.keys[i] = a.keys[a.numKeys - n + i];
+				b.objects[i] = a.objects[a.numKeys - n + i];
+			}
+			a.numKeys -= n;
+			b.numKeys += n;
+		} else {
+			// move keys from the start of the right leaf to the left leaf
+			n = b.numKeys - ( total - total / 2 );
+			for ( i = 0; i < n; i++ ) {
+				a.keys[a.numKeys + i] = b.keys[i];
+				a.objects[a.numKeys + i] = b.objects[i];
+			}
+			for ( i = n; i < b.numKeys; i++ ) {
+				b.keys[i - n] = b.keys[i];
+				b.objects[i - n] = b.objects[i];
+			}
+			a.numKeys += n;
+			b.numKeys -= n;
+		}
+	} else {
+		node_t &a = nodes[leftIndex];
+		node_t &b = nodes[rightIndex];
+		const int total = a.numKeys + b.numKeys;
+		if ( total <= keysPerNode ) {
+			for ( i = 0; i < b.numKeys; i++ ) {
+				a.keys[a.numKeys + i] = b.keys[i];
+				a.children[a.numKeys + i] = b.children[i];
+			}
+			a.numKeys = total;
+			FreeNode( rightIndex );
+			merged = true;
+		} else if ( a.numKeys > total / 2 ) {
+			n = a.numKeys - total / 2;
+			for ( i = b.numKeys - 1; i >= 0; i-- ) {
+				b.keys[i + n] = b.keys[i];
+				b.children[i + n] = b.children[i];
+			}
+			for ( i = 0; i < n; i++ ) {
+				b.keys[i] = a.keys[a.numKeys - n + i];
+				b.children[i] = a.children[a.numKeys - n + i];
+			}
+			a.numKeys -= n;
+			b.numKeys += n;
+		} else {
+			n = b.numKeys - ( total - total / 2 );
+			for ( i = 0; i < n; i++ ) {
+				a.keys[a.numKeys + i] = b.keys[i];
+				a.children[a.numKeys + i] = b.children[i];
+			}
+			for ( i = n; i < b.numKeys; i++ ) {
+				b.keys[i - n] = b.keys[i];
+				b.children[i - n] = b.children[i];
+			}
+			a.numKeys += n;
+			b.numKeys -= n;
+		}
+	}
+
+	if ( merged ) {
+		// remove the merged right child from the parent
+		for ( i = right; i < p.numKeys - 1; i++ ) {
+			p.keys[i] = p.keys[i + 1];
+			p.children[i] = p.children[i + 1];
+		}
+		p.numKeys--;
+		p.keys[left] = LastKey( leftIndex, childIsLeaf );
+	} else {
+		p.keys[left] = LastKey( leftIndex, childIsLeaf );
+		p.keys[right] = LastKey( rightIndex, childIsLeaf );
+	}
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE keyType idPackedBTree<objType,keyType,keysPerNode>::LastKey( int child, bool childIsLeaf ) const {
+	if ( childIsLeaf ) {
+		assert( leaves[child].numKeys > 0 );
+		return leaves[child].keys[leaves[child].numKeys - 1];
+	}
+	assert( nodes[child].numKeys > 0 );
+	return nodes[child].keys[nodes[child].numKeys - 1];
+}
+
+template< class objType, class keyType, int keysPerNode >
+ID_INLINE void idPackedBTree<objType,keyType,keysPerNode>::CheckTree( void ) const {
+	int i, level, count, numLeaves;
+
+	if ( root == -1 ) {
+		assert( numObjects == 0 && height == 0 );
+		return;
+	}
+
+	// walk every level from left to right and check the node sizes and largest keys
+	idList<int> current, below;
+	current.Append( root );
+	for ( level = 0; level < height; level++ ) {
+		below.SetNum( 0, false );
+		for ( i = 0; i < current.Num(); i++ ) {
+			const node_t &n = nodes[current[i]];
+			assert( n.numKeys >= ( current[i] == root ? 2 : MIN_KEYS ) && n.numKeys <= keysPerNode );
+			for ( int k = 0; k < n.numKeys; k++ ) {
+				assert( k == 0 || !( n.keys[k] < n.keys[k - 1] ) );
+				assert( !( n.keys[k] < LastKey( n.children[k], level == height - 1 ) ) && !( LastKey( n.children[k], level == height - 1 ) < n.keys[k] ) );
+				below.Append( n.children[k] );
+			}
+		}
+		current = below;
+	}
+
+	// the leaves found through the nodes should equal the linked leaves
+	count = 0;
+	numLeaves = 0;
+	for ( i = firstLeaf; i != -1; i = leaves[i].next, numLeaves++ ) {
+		const leaf_t &l = leaves[i];
+		assert( i == current[numLeaves] );
+		assert( l.numKeys >= ( i == root ? 1 : MIN_KEYS ) && l.numKeys <= keysPerNode );
+		assert( l.next != -1 || i == lastLeaf );
+		assert( l.next == -1 || leaves[l.next].prev == i );
+		for ( int k = 0; k < l.numKeys; k++ ) {
+			assert( k == 0 || !( l.keys[k] < l.keys[k - 1] ) );
+		}
+		assert( l.next == -1 || !( leaves[l.next].keys[0] < l.keys[l.numKeys - 1] ) );
+		count += l.numKeys;
+	}
+	assert( numLeaves == current.Num() );
+	assert( count == numObjects );
+}
+
+// compares the speed of idPackedBTree and idBTree
+void PackedBTree_Bench_f( const class idCmdArgs &args );
+
+#endif /* !__PACKEDBTREE_H__ */
@@ -52,10 +52,13 @@ public:
 	size_t				Size( void ) const { return sizeof( *this ) + Allocated(); }
 						// returns a pointer to the pool this string was allocated from
 	const idStrPool *	GetPool( void ) const { return pool; }
+						// returns the hash of the string, case insensitive if the pool is case insensitive
+	int					GetHash( void ) const { return hash; }
 
 private:
 	idStrPool *			pool;
 	mutable int			numUsers;
+	int					hash;
 };
 
 class idStrPool {
@@ -99,7 +102,8 @@ ID_INLINE const idPoolStr *idStrPool::AllocString( const char *string ) {
 	int i, hash;
 	idPoolStr *poolStr;
 
-	hash = poolHash.GenerateKey( string, caseSensitive );
+	// the full hash is stored with the string, the hash index only uses the lower bits
+	hash = caseSensitive ? idStr::Hash( string ) : idStr::IHash( string );
 	if ( caseSensitive ) {
 		for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
 			if ( pool[i]->Cmp( string ) == 0 ) {
@@ -120,6 +124,7 @@ ID_INLINE const idPoolStr *idStrPool::AllocString( const char *string ) {
 	*static_cast<idStr *>(poolStr) = string;
 	poolStr->pool = this;
 	poolStr->numUsers = 1;
+	poolStr->hash = hash;
 	poolHash.Add( hash, pool.Append( poolStr ) );
 	return poolStr;
 }
@@ -137,18 +142,10 @@ ID_INLINE void idStrPool::FreeString( const idPoolStr *poolStr ) {
 
 	poolStr->numUsers--;
 	if ( poolStr->numUsers <= 0 ) {
-		hash = poolHash.GenerateKey( poolStr->c_str(), caseSensitive );
-		if ( caseSensitive ) { 
-			for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
-				if ( pool[i]->Cmp( poolStr->c_str() ) == 0 ) {
-					break;
-				}
-			}
-		} else {
-			for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
-				if ( pool[i]->Icmp( poolStr->c_str() ) == 0 ) {
-					break;
-				}
+		hash = poolStr->hash;
+		for ( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) ) {
+			if ( pool[i] == poolStr ) {
+				break;
 			}
 		}
 		assert( i != -1 );
@@ -45,6 +45,139 @@ public:
 };
 
 
+/*
+===============================================================================
+
+  Joint Quaternion streams
+
+  The components of an array of joint quaternions stored in separate streams
+  so four joints at a time fill the SIMD registers without any transposing.
+  The streams are 16 byte aligned and padded to a multiple of four joints,
+  the padding is kept at the identity so it can be processed with the joints.
+
+===============================================================================
+*/
+
+#define JOINTQUATSOA_PAD( n )			( ( ( n ) + 3 ) & ~3 )
+#define JOINTQUATSOA_ALLOCA( n )		( (float *) _alloca16( 7 * JOINTQUATSOA_PAD( n ) * sizeof( float ) ) )
+
+class idJointQuatSoA {
+public:
+					idJointQuatSoA( void );
+					explicit idJointQuatSoA( int numJoints );
+					~idJointQuatSoA( void );
+
+	void			SetNum( int numJoints );						// allocate the streams for numJoints joints
+	void			SetData( int numJoints, float *data );			// use memory from JOINTQUATSOA_ALLOCA
+	int				Num( void ) const;
+
+	idJointQuat		GetJoint( int index ) const;
+	void			SetJoint( int index, const idJointQuat &joint );
+
+	float *			x;
+	float *			y;
+	float *			z;
+	float *			w;
+	float *			tx;
+	float *			ty;
+	float *			tz;
+
+private:
+	int				numJoints;
+	int				alloced;		// joints allocated, if -1 then the streams point to data set with SetData
+	float *			data;
+
+	void			SetStreams( int numJoints );
+
+					idJointQuatSoA( const idJointQuatSoA &soa );
+	void			operator=( const idJointQuatSoA &soa );
+};
+
+ID_INLINE idJointQuatSoA::idJointQuatSoA( void ) {
+	numJoints = alloced = 0;
+	data = NULL;
+	x = y = z = w = tx = ty = tz = NULL;
+}
+
+ID_INLINE idJointQuatSoA::idJointQuatSoA( int numJoints ) {
+	this->numJoints = alloced = 0;
+	data = NULL;
+	x = y = z = w = tx = ty = tz = NULL;
+	SetNum( numJoints );
+}
+
+ID_INLINE idJointQuatSoA::~idJointQuatSoA( void ) {
+	if ( data != NULL && alloced != -1 ) {
+		Mem_Free16( data );
+	}
+}
+
+ID_INLINE void idJointQuatSoA::SetNum( int numJoints ) {
+	int alloc = JOINTQUATSOA_PAD( numJoints );
+	if ( alloc > alloced || alloced == -1 ) {
+		if ( data != NULL && alloced != -1 ) {
+			Mem_Free16( data );
+		}
+		data = (float *) Mem_Alloc16( 7 * alloc * sizeof( float ) );
+		alloced = alloc;
+	}
+	SetStreams( numJoints );
+}
+
+ID_INLINE void idJointQuatSoA::SetData( int numJoints, float *data ) {
+	if ( this->data != NULL && alloced != -1 ) {
+		Mem_Free16( this->data );
+	}
+	assert( ( ( (size_t) data ) & 15 ) == 0 ); // data must be 16 byte aligned
+	this->data = data;
+	alloced = -1;
+	SetStreams( numJoints );
+}
+
+ID_INLINE void idJointQuatSoA::SetStreams( int numJoints ) {
+	int i, stride;
+
+	stride = ( alloced == -1 ) ? JOINTQUATSOA_PAD( numJoints ) : alloced;
+	this->numJoints = numJoints;
+	x = data + 0 * stride;
+	y = data + 1 * stride;
+	z = data + 2 * stride;
+	w = data + 3 * stride;
+	tx = data + 4 * stride;
+	ty = data + 5 * stride;
+	tz = data + 6 * stride;
+	for ( i = numJoints; i < JOINTQUATSOA_PAD( numJoints ); i++ ) {
+		x[i] = y[i] = z[i] = 0.0f;
+		w[i] = 1.0f;
+		tx[i] = ty[i] = tz[i] = 0.0f;
+	}
+}
+
+ID_INLINE int idJointQuatSoA::Num( void ) const {
+	return numJoints;
+}
+
+ID_INLINE idJointQuat idJointQuatSoA::GetJoint( int index ) const {
+	idJointQuat joint;
+
+	assert( index >= 0 && index < numJoints );
+	joint.q.Set( x[index], y[index], z[index], w[index] );
+	joint.t.Set( tx[index], ty[index], tz[index] );
+	return joint;
+}
+
+ID_INLINE void idJointQuatSoA::SetJoint( int index, const idJointQuat &joint ) {
+	assert( index >= 0 && index < numJoints );
+	x[index] = joint.q.x;
+	y[index] = joint.q.y;
+	z[index] = joint.q.z;
+	w[index] = joint.q.w;
+	tx[index] = joint.t.x;
+	ty[index] = joint.t.y;
+	tz[index] = joint.t.z;
+}
+
+
 /*
 ===============================================================================
 
@@ -58,6 +58,15 @@ bool idWinding::ReAllocate( int n, bool keep ) {
 	return true;
 }
 
+/*
+=============
+idWinding::StackOverflowWarning
+=============
+*/
+void idWinding::StackOverflowWarning( int maxPoints ) {
+	idLib::common->Printf( "WARNING: idStackWinding -> %d points overflowed\n", maxPoints );
+}
+
 /*
 =============
 idWinding::BaseForPlane
@@ -456,6 +465,208 @@ bool idWinding::ClipInPlace( const idPlane &plane, const float epsilon, const bo
 	return true;
 }
 
+/*
+=============
+Winding_ClipPoints
+
+Clips the points against a single plane and writes the front part to 'out'.
+The 'dists' and 'sides' scratch buffers must have room for numIn + 1 entries.
+Returns the new number of points, zero if nothing is at the front of the plane,
+or -1 if nothing is at the back and the points stay the same.
+=============
+*/
+static int Winding_ClipPoints( const idVec5 *in, const int numIn, idVec5 *out, const int maxOut,
+								float *dists, byte *sides, const idPlane &plane, const float epsilon ) {
+	int			newNumPoints;
+	int			counts[3];
+	float		dot;
+	int			i, j;
+	const idVec5 *p1, *p2;
+	idVec5		mid;
+
+	counts[SIDE_FRONT] = counts[SIDE_BACK] = counts[SIDE_ON] = 0;
+
+	// determine sides for each point
+	for ( i = 0; i < numIn; i++ ) {
+		dists[i] = dot = plane.Distance( in[i].ToVec3() );
+		if ( dot > epsilon ) {
+			sides[i] = SIDE_FRONT;
+		} else if ( dot < -epsilon ) {
+			sides[i] = SIDE_BACK;
+		} else {
+			sides[i] = SIDE_ON;
+		}
+		counts[sides[i]]++;
+	}
+	sides[i] = sides[0];
+	dists[i] = dists[0];
+
+	// if nothing at the front of the clipping plane
+	if ( !counts[SIDE_FRONT] ) {
+		return 0;
+	}
+	// if nothing at the back of the clipping plane
+	if ( !counts[SIDE_BACK] ) {
+		return -1;
+	}
+
+	newNumPoints = 0;
+
+	for ( i = 0; i < numIn; i++ ) {
+		p1 = &in[i];
+
+		if ( newNumPoints+1 > maxOut ) {
+			return -1;		// can't split -- fall back to original
+		}
+
+		if ( sides[i] == SIDE_ON ) {
+			out[newNumPoints] = *p1;
+			newNumPoints++;
+			continue;
+		}
+
+		if ( sides[i] == SIDE_FRONT ) {
+			out[newNumPoints] = *p1;
+			newNumPoints++;
+		}
+
+		if ( sides[i+1] == SIDE_ON || sides[i+1] == sides[i] ) {
+			continue;
+		}
+
+		if ( newNumPoints+1 > maxOut ) {
+			return -1;		// can't split -- fall back to original
+		}
+
+		// generate a split point
+		p2 = ( i + 1 < numIn ) ? p1 + 1 : in;
+
+		dot = dists[i] / (dists[i] - dists[i+1]);
+		for ( j = 0; j < 3; j++ ) {
+			// avoid round off error when possible
+			if ( plane.Normal()[j] == 1.0f ) {
+				mid[j] = plane.Dist();
+			} else if ( plane.Normal()[j] == -1.0f ) {
+				mid[j] = -plane.Dist();
+			} else {
+				mid[j] = (*p1)[j] + dot * ( (*p2)[j] - (*p1)[j] );
+			}
+		}
+		mid.s = p1->s + dot * ( p2->s - p1->s );
+		mid.t = p1->t + dot * ( p2->t - p1->t );
+
+		out[newNumPoints] = mid;
+		newNumPoints++;
+	}
+
+	return newNumPoints;
+}
+
+#define MAX_WINDING_CLIP_PLANES		32		// one bit per plane in the cut mask
+
+/*
+=============
+idWinding::ClipInPlace
+
+  The distance range of the original points is determined for all planes up front.
+  The winding is convex so if none of the original points is at the back of a plane
+  no part clipped by the other planes can be either, and if none of the original
+  points is at the front of a plane the whole winding is clipped away. Only the
+  planes that actually cut the winding are clipped against, ping-ponging between
+  two stack buffers, and the winding itself is only written once at the end.
+=============
+*/
+bool idWinding::ClipInPlace( const idPlane *planes, const int numPlanes, const float epsilon ) {
+	float *		dists;
+	byte *		sides;
+	idVec5 *	points[2];
+	const idVec5 *in;
+	int			numIn, newNumPoints, maxpts, cur;
+	int			cutBits;
+	int			i, j;
+
+	assert( this );
+
+	if ( numPlanes > MAX_WINDING_CLIP_PLANES ) {
+		if ( !ClipInPlace( planes, MAX_WINDING_CLIP_PLANES, epsilon ) ) {
+			return false;
+		}
+		return ClipInPlace( planes + MAX_WINDING_CLIP_PLANES, numPlanes - MAX_WINDING_CLIP_PLANES, epsilon );
+	}
+
+	if ( numPlanes <= 0 || numPoints <= 0 ) {
+		return ( numPoints > 0 );
+	}
+
+	// determine the distance range of the points for all planes
+	cutBits = 0;
+	for ( j = 0; j < numPlanes; j++ ) {
+		const float nx = planes[j][0], ny = planes[j][1], nz = planes[j][2], nd = planes[j][3];
+		float minDist = idMath::INFINITY;
+		float maxDist = -idMath::INFINITY;
+
+		for ( i = 0; i < numPoints; i++ ) {
+			const float d = nx * p[i].x + ny * p[i].y + nz * p[i].z + nd;
+			minDist = ( d < minDist ) ? d : minDist;
+			maxDist = ( d > maxDist ) ? d : maxDist;
+		}
+		// if nothing at the front of the clipping plane
+		if ( maxDist <= epsilon ) {
+			numPoints = 0;
+			return false;
+		}
+		// if something at the back of the clipping plane
+		if ( minDist < -epsilon ) {
+			cutBits |= 1 << j;
+		}
+	}
+
+	// if nothing at the back of any of the clipping planes
+	if ( !cutBits ) {
+		return true;
+	}
+
+	maxpts = numPoints + numPlanes + 4;		// cant use counts[0]+2 because of fp grouping errors
+
+	points[0] = (idVec5 *) _alloca16( 2 * maxpts * sizeof( idVec5 ) );
+	points[1] = points[0] + maxpts;
+	dists = (float *) _alloca( ( maxpts + 1 ) * sizeof( float ) );
+	sides = (byte *) _alloca( ( maxpts + 1 ) * sizeof( byte ) );
+	cur = 0;
+
+	in = p;
+	numIn = numPoints;
+	for ( j = 0; j < numPlanes; j++ ) {
+		if ( !( cutBits & ( 1 << j ) ) ) {
+			continue;
+		}
+		newNumPoints = Winding_ClipPoints( in, numIn, points[cur], maxpts, dists, sides, planes[j], epsilon );
+		if ( newNumPoints == 0 ) {
+			numPoints = 0;
+			return false;
+		}
+		if ( newNumPoints < 0 ) {
+			continue;
+		}
+		in = points[cur];
+		numIn = newNumPoints;
+		cur ^= 1;
+	}
+
+	if ( in == p ) {
+		return true;
+	}
+
+	if ( !EnsureAlloced( numIn, false ) ) {
+		return true;
+	}
+
+	numPoints = numIn;
+	memcpy( p, in, numIn * sizeof(idVec5) );
+
+	return true;
+}
+
 /*
 =============
 idWinding::Copy
@@ -1599,3 +1810,99 @@ int idFixedWinding::Split( idFixedWinding *back, const idPlane &plane, const flo
 
 	return SIDE_CROSS;
 }
+
+/*
+=============
+Winding_Bench_f
+
+Clips random triangles against the planes of a box one plane at a time and with the multi-plane clip.
+=============
+*/
+void Winding_Bench_f( const idCmdArgs &args ) {
+	const int numTriangles = 4096;
+	const int numPasses = 16;
+	idPlane planes[6];
+	idVec3 *verts;
+	idRandom random( 0x5eed );
+	idTimer timer;
+	double single, multi;
+	int i, j, k, pass, numSingle, numMulti, mismatches;
+
+	// small triangles scattered around the box like the surface triangles touched by a decal or light
+	verts = new idVec3[numTriangles * 3];
+	for ( i = 0; i < numTriangles; i++ ) {
+		idVec3 center( random.CRandomFloat() * 10.0f, random.CRandomFloat() * 10.0f, random.CRandomFloat() * 10.0f );
+		for ( j = 0; j < 3; j++ ) {
+			verts[i * 3 + j] = center + idVec3( random.CRandomFloat() * 3.0f, random.CRandomFloat() * 3.0f, random.CRandomFloat() * 3.0f );
+		}
+	}
+	// the inside of the box is at the front of the planes, one plane is not axial
+	planes[0].SetNormal( idVec3( 1, 0, 0 ) ); planes[0].SetDist( -8.0f );
+	planes[1].SetNormal( idVec3( -1, 0, 0 ) ); planes[1].SetDist( -8.0f );
+	planes[2].SetNormal( idVec3( 0, 1, 0 ) ); planes[2].SetDist( -8.0f );
+	planes[3].SetNormal( idVec3( 0, -1, 0 ) ); planes[3].SetDist( -8.0f );
+	planes[4].SetNormal( idVec3( 0, 0, 1 ) ); planes[4].SetDist( -8.0f );
+	planes[5].SetNormal( idVec3( -0.6f, 0, -0.8f ) ); planes[5].SetDist( -8.0f );
+
+	// one plane at a time
+	numSingle = 0;
+	timer.Clear();
+	timer.Start();
+	for ( pass = 0; pass < numPasses; pass++ ) {
+		for ( i = 0; i < numTriangles; i++ ) {
+			idFixedWinding w( verts + i * 3, 3 );
+			for ( j = 0; j < 6; j++ ) {
+				if ( !w.ClipInPlace( planes[j] ) ) {
+					break;
+				}
+			}
+			numSingle += w.GetNumPoints();
+		}
+	}
+	timer.Stop();
+	single = timer.Milliseconds();
+
+	// all planes in one pass
+	numMulti = 0;
+	timer.Clear();
+	timer.Start();
+	for ( pass = 0; pass < numPasses; pass++ ) {
+		for ( i = 0; i < numTriangles; i++ ) {
+			idStackWinding<16> w( verts + i * 3, 3 );
+			w.ClipInPlace( planes, 6 );
+			numMulti += w.GetNumPoints();
+		}
+	}
+	timer.Stop();
+	multi = timer.Milliseconds();
+
+	// compare the results
+	mismatches = 0;
+	for ( i = 0; i < numTriangles; i++ ) {
+		idFixedWinding w1( verts + i * 3, 3 );
+		idStackWinding<16> w2( verts + i * 3, 3 );
+		for ( j = 0; j < 6; j++ ) {
+			if ( !w1.ClipInPlace( planes[j] ) ) {
+				break;
+			}
+		}
+		w2.ClipInPlace( planes, 6 );
+		if ( w1.GetNumPoints() != w2.GetNumPoints() ) {
+			mismatches++;
+			continue;
+		}
+		for ( k = 0; k < w1.GetNumPoints(); k++ ) {
+			if ( !w1[k].ToVec3().Compare( w2[k].ToVec3(), 1e-4f ) ) {
+				mismatches++;
+				break;
+			}
+		}
+	}
+
+	delete[] verts;
+
+	idLib::common->Printf( "%d triangles x %d passes clipped against 6 planes\n", numTriangles, numPasses );
+	idLib::common->Printf( "ClipInPlace per plane  %8.2f ms (%d points)\n", single, numSingle );
+	idLib::common->Printf( "ClipInPlace all planes %8.2f ms (%d points)\n", multi, numMulti );
+	idLib::common->Printf( "%d mismatches\n", mismatches );
+}
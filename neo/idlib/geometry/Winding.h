@@ -76,6 +76,10 @@ public:
 					// cuts off the part at the back side of the plane, returns true if some part was at the front
 					// if there is nothing at the front the number of points is set to zero
 	bool			ClipInPlace( const idPlane &plane, const float epsilon = ON_EPSILON, const bool keepOn = false );
+					// cuts off the part at the back side of each of the planes, returns true if some part was at the front
+					// the winding is classified against all planes up front and planes that do not cut it are skipped
+					// if there is nothing at the front the number of points is set to zero
+	bool			ClipInPlace( const idPlane *planes, const int numPlanes, const float epsilon = ON_EPSILON );
 
 					// returns a copy of the winding
 	idWinding *		Copy( void ) const;
@@ -127,6 +131,9 @@ protected:
 
 	bool			EnsureAlloced( int n, bool keep = false );
 	virtual bool	ReAllocate( int n, bool keep = false );
+
+	// prints the idStackWinding overflow warning out of line so the template does not need idCommon
+	static void		StackOverflowWarning( int maxPoints );
 };
 
 ID_INLINE idWinding::idWinding( void ) {
@@ -398,4 +405,114 @@ ID_INLINE idFixedWinding &idFixedWinding::operator=( const idWinding &winding )
 ID_INLINE void idFixedWinding::Clear( void ) {
 	numPoints = 0;
 }
+
+/*
+===============================================================================
+
+	idStackWinding is a fixed capacity winding that lives on the stack.
+	The capacity is a template parameter so small windings like clipped
+	triangles don't touch the full MAX_POINTS_ON_WINDING point buffer.
+
+===============================================================================
+*/
+
+template< int maxPoints >
+class idStackWinding : public idWinding {
+
+public:
+					idStackWinding( void );
+					explicit idStackWinding( const idVec3 *verts, const int n );
+					explicit idStackWinding( const idWinding &winding );
+					explicit idStackWinding( const idStackWinding &winding );
+	virtual			~idStackWinding( void );
+
+	idStackWinding &operator=( const idWinding &winding );
+
+	virtual void	Clear( void );
+
+protected:
+	idVec5			data[maxPoints];	// point data
+
+	virtual bool	ReAllocate( int n, bool keep = false );
+};
+
+template< int maxPoints >
+ID_INLINE idStackWinding<maxPoints>::idStackWinding( void ) {
+	numPoints = 0;
+	p = data;
+	allocedSize = maxPoints;
+}
+
+template< int maxPoints >
+ID_INLINE idStackWinding<maxPoints>::idStackWinding( const idVec3 *verts, const int n ) {
+	int i;
+
+	numPoints = 0;
+	p = data;
+	allocedSize = maxPoints;
+	if ( !EnsureAlloced( n ) ) {
+		return;
+	}
+	for ( i = 0; i < n; i++ ) {
+		p[i].ToVec3() = verts[i];
+		p[i].s = p[i].t = 0;
+	}
+	numPoints = n;
+}
+
+template< int maxPoints >
+ID_INLINE idStackWinding<maxPoints>::idStackWinding( const idWinding &winding ) {
+	numPoints = 0;
+	p = data;
+	allocedSize = maxPoints;
+	*this = winding;
+}
+
+template< int maxPoints >
+ID_INLINE idStackWinding<maxPoints>::idStackWinding( const idStackWinding &winding ) {
+	numPoints = 0;
+	p = data;
+	allocedSize = maxPoints;
+	*this = winding;
+}
+
+template< int maxPoints >
+ID_INLINE idStackWinding<maxPoints>::~idStackWinding( void ) {
+	p = NULL;	// otherwise it tries to free the fixed buffer
+}
+
+template< int maxPoints >
+ID_INLINE idStackWinding<maxPoints> &idStackWinding<maxPoints>::operator=( const idWinding &winding ) {
+	int i;
+
+	if ( !EnsureAlloced( winding.GetNumPoints() ) ) {
+		numPoints = 0;
+		return *this;
+	}
+	for ( i = 0; i < winding.GetNumPoints(); i++ ) {
+		p[i] = winding[i];
+	}
+	numPoints = winding.GetNumPoints();
+	return *this;
+}
+
+template< int maxPoints >
+ID_INLINE void idStackWinding<maxPoints>::Clear( void ) {
+	numPoints = 0;
+}
+
+template< int maxPoints >
+ID_INLINE bool idStackWinding<maxPoints>::ReAllocate( int n, bool keep ) {
+	assert( n <= maxPoints );
+
+	if ( n > maxPoints ) {
+		StackOverflowWarning( maxPoints );
+		return false;
+	}
+	return true;
+}
+
+// benchmarks the multi-plane clip against clipping one plane at a time
+void Winding_Bench_f( const class idCmdArgs &args );
+
 #endif	/* !__WINDING_H__ */
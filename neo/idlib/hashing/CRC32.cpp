@@ -134,6 +134,187 @@ static unsigned long crctable[256] = {
 
 #endif
 
+/*
+   Slicing-by-8 tables, crcslice[k][i] is the CRC of byte i followed by k zero bytes.
+   This processes eight bytes with eight independent table lookups.
+*/
+static dword crcslice[8][256];
+
+/*
+   PCLMULQDQ folding of the reflected polynomial, see Intel's "Fast CRC Computation
+   for Generic Polynomials Using PCLMULQDQ Instruction". The SSE4.2 crc32 instruction
+   can not be used because it computes the CRC-32C (Castagnoli) polynomial.
+*/
+#if defined( _MSC_VER ) || ( defined( __GNUC__ ) && ( defined( __i386__ ) || defined( __x86_64__ ) ) )
+	#define ID_CRC32_CLMUL
+#endif
+
+#ifdef ID_CRC32_CLMUL
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#ifdef __GNUC__
+	#define ID_CLMUL_TARGET		__attribute__((target("sse2,pclmul")))
+#else
+	#define ID_CLMUL_TARGET
+#endif
+
+#define CRC32_CLMUL_MIN_LENGTH	64
+
+/*
+================
+CRC32_UpdateCLMUL
+
+  Length must be a multiple of 16 and at least CRC32_CLMUL_MIN_LENGTH.
+================
+*/
+ID_CLMUL_TARGET static dword CRC32_UpdateCLMUL( dword crc, const byte *buf, int length ) {
+	const __m128i k1k2 = _mm_set_epi32( 0x00000001, (int)0xc6e41596, 0x00000001, 0x54442bd4 );
+	const __m128i k3k4 = _mm_set_epi32( 0x00000000, (int)0xccaa009e, 0x00000001, 0x751997d0 );
+	const __m128i k5k0 = _mm_set_epi32( 0x00000000, 0x00000000, 0x00000001, 0x63cd6124 );
+	const __m128i poly = _mm_set_epi32( 0x00000001, (int)0xf7011641, 0x00000001, (int)0xdb710641 );
+	const __m128i mask32 = _mm_set_epi32( 0, ~0, 0, ~0 );
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+	x1 = _mm_loadu_si128( (const __m128i *)( buf + 0x00 ) );
+	x2 = _mm_loadu_si128( (const __m128i *)( buf + 0x10 ) );
+	x3 = _mm_loadu_si128( (const __m128i *)( buf + 0x20 ) );
+	x4 = _mm_loadu_si128( (const __m128i *)( buf + 0x30 ) );
+	x1 = _mm_xor_si128( x1, _mm_cvtsi32_si128( (int)crc ) );
+	buf += 64;
+	length -= 64;
+
+	// fold four 128 bit lanes in parallel
+	while ( length >= 64 ) {
+		x5 = _mm_clmulepi64_si128( x1, k1k2, 0x00 );
+		x6 = _mm_clmulepi64_si128( x2, k1k2, 0x00 );
+		x7 = _mm_clmulepi64_si128( x3, k1k2, 0x00 );
+		x8 = _mm_clmulepi64_si128( x4, k1k2, 0x00 );
+		x1 = _mm_clmulepi64_si128( x1, k1k2, 0x11 );
+		x2 = _mm_clmulepi64_si128( x2, k1k2, 0x11 );
+		x3 = _mm_clmulepi64_si128( x3, k1k2, 0x11 );
+		x4 = _mm_clmulepi64_si128( x4, k1k2, 0x11 );
+		x1 = _mm_xor_si128( _mm_xor_si128( x1, x5 ), _mm_loadu_si128( (const __m128i *)( buf + 0x00 ) ) );
+		x2 = _mm_xor_si128( _mm_xor_si128( x2, x6 ), _mm_loadu_si128( (const __m128i *)( buf + 0x10 ) ) );
+		x3 = _mm_xor_si128( _mm_xor_si128( x3, x7 ), _mm_loadu_si128( (const __m128i *)( buf + 0x20 ) ) );
+		x4 = _mm_xor_si128( _mm_xor_si128( x4, x8 ), _mm_loadu_si128( (const __m128i *)( buf + 0x30 ) ) );
+		buf += 64;
+		length -= 64;
+	}
+
+	// fold the four lanes into one
+	x5 = _mm_clmulepi64_si128( x1, k3k4, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k3k4, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x2 ), x5 );
+	x5 = _mm_clmulepi64_si128( x1, k3k4, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k3k4, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x3 ), x5 );
+	x5 = _mm_clmulepi64_si128( x1, k3k4, 0x00 );
+	x1 = _mm_clmulepi64_si128( x1, k3k4, 0x11 );
+	x1 = _mm_xor_si128( _mm_xor_si128( x1, x4 ), x5 );
+
+	// fold the remaining 16 byte blocks
+	while ( length >= 16 ) {
+		x5 = _mm_clmulepi64_si128( x1, k3k4, 0x00 );
+		x1 = _mm_clmulepi64_si128( x1, k3k4, 0x11 );
+		x1 = _mm_xor_si128( _mm_xor_si128( x1, _mm_loadu_si128( (const __m128i *)buf ) ), x5 );
+		buf += 16;
+		length -= 16;
+	}
+
+	// fold 128 bits to 64 bits
+	x2 = _mm_clmulepi64_si128( x1, k3k4, 0x10 );
+	x1 = _mm_xor_si128( _mm_srli_si128( x1, 8 ), x2 );
+	x2 = _mm_srli_si128( x1, 4 );
+	x1 = _mm_and_si128( x1, mask32 );
+	x1 = _mm_clmulepi64_si128( x1, k5k0, 0x00 );
+	x1 = _mm_xor_si128( x1, x2 );
+
+	// Barrett reduction to 32 bits
+	x2 = _mm_and_si128( x1, mask32 );
+	x2 = _mm_clmulepi64_si128( x2, poly, 0x10 );
+	x2 = _mm_and_si128( x2, mask32 );
+	x2 = _mm_clmulepi64_si128( x2, poly, 0x00 );
+	x1 = _mm_xor_si128( x1, x2 );
+
+	x0 = _mm_srli_si128( x1, 4 );
+	return (dword)_mm_cvtsi128_si32( x0 );
+}
+
+#endif
+
+static crc32Method_t crcmethod = CRC32_METHOD_BYTE;
+
+/*
+================
+CRC32_UpdateSlice8
+================
+*/
+static dword CRC32_UpdateSlice8( dword crc, const byte *buf, int length ) {
+	while ( length >= 8 ) {
+		crc ^= (dword)buf[0] | ( (dword)buf[1] << 8 ) | ( (dword)buf[2] << 16 ) | ( (dword)buf[3] << 24 );
+		crc = crcslice[7][crc & 0xff] ^ crcslice[6][( crc >> 8 ) & 0xff] ^
+				crcslice[5][( crc >> 16 ) & 0xff] ^ crcslice[4][crc >> 24] ^
+				crcslice[3][buf[4]] ^ crcslice[2][buf[5]] ^
+				crcslice[1][buf[6]] ^ crcslice[0][buf[7]];
+		buf += 8;
+		length -= 8;
+	}
+	while ( length-- ) {
+		crc = crcslice[0][( crc ^ ( *buf++ ) ) & 0xff] ^ ( crc >> 8 );
+	}
+	return crc;
+}
+
+/*
+================
+CRC32_Init
+================
+*/
+void CRC32_Init( void ) {
+	int i, k;
+
+#ifdef CREATE_CRC_TABLE
+	make_crc_table();
+#endif
+
+	for ( i = 0; i < 256; i++ ) {
+		crcslice[0][i] = (dword)crctable[i];
+	}
+	for ( k = 1; k < 8; k++ ) {
+		for ( i = 0; i < 256; i++ ) {
+			crcslice[k][i] = ( crcslice[k-1][i] >> 8 ) ^ crcslice[0][crcslice[k-1][i] & 0xff];
+		}
+	}
+	if ( crcmethod == CRC32_METHOD_BYTE ) {
+		crcmethod = CRC32_METHOD_SLICE8;
+	}
+}
+
+/*
+================
+CRC32_SetMethod
+================
+*/
+void CRC32_SetMethod( crc32Method_t method ) {
+#ifndef ID_CRC32_CLMUL
+	if ( method == CRC32_METHOD_CLMUL ) {
+		method = CRC32_METHOD_SLICE8;
+	}
+#endif
+	crcmethod = method;
+}
+
+/*
+================
+CRC32_GetMethod
+================
+*/
+crc32Method_t CRC32_GetMethod( void ) {
+	return crcmethod;
+}
+
 void CRC32_InitChecksum( unsigned long &crcvalue ) {
 	crcvalue = CRC32_INIT_VALUE;
 }
@@ -146,6 +327,29 @@ void CRC32_UpdateChecksum( unsigned long &crcvalue, const void *data, int length
 	unsigned long crc;
 	const unsigned char *buf = (const unsigned char *) data;
 
+	switch( crcmethod ) {
+#ifdef ID_CRC32_CLMUL
+		case CRC32_METHOD_CLMUL: {
+			dword c = (dword)crcvalue;
+			if ( length >= CRC32_CLMUL_MIN_LENGTH ) {
+				int blocks = length & ~15;
+				c = CRC32_UpdateCLMUL( c, buf, blocks );
+				buf += blocks;
+				length -= blocks;
+			}
+			crcvalue = CRC32_UpdateSlice8( c, buf, length );
+			return;
+		}
+#endif
+		case CRC32_METHOD_SLICE8: {
+			crcvalue = CRC32_UpdateSlice8( (dword)crcvalue, buf, length );
+			return;
+		}
+		default: {
+			break;
+		}
+	}
+
 	crc = crcvalue;
 	while( length-- ) {
 		crc = crctable[ ( crc ^ ( *buf++ ) ) & 0xff ] ^ ( crc >> 8 );
@@ -10,6 +10,18 @@
 ===============================================================================
 */
 
+typedef enum {
+	CRC32_METHOD_BYTE,		// one table lookup per byte
+	CRC32_METHOD_SLICE8,	// eight table lookups per eight bytes
+	CRC32_METHOD_CLMUL		// carry-less multiply folding, requires CPUID_PCLMUL
+} crc32Method_t;
+
+// builds the slicing tables, called from idLib::Init
+void CRC32_Init( void );
+// selects the implementation, results are identical for all methods
+void CRC32_SetMethod( crc32Method_t method );
+crc32Method_t CRC32_GetMethod( void );
+
 void CRC32_InitChecksum( unsigned long &crcvalue );
 void CRC32_UpdateChecksum( unsigned long &crcvalue, const void *data, int length );
 void CRC32_FinishChecksum( unsigned long &crcvalue );
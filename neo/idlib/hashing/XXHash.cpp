@@ -0,0 +1,259 @@
+
+#include "../precompiled.h"
+#pragma hdrstop
+
+/*
+   xxHash64
+   Copyright (C) 2012-2016 Yann Collet
+   BSD 2-Clause License
+*/
+
+#define XXH_PRIME64_1		0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2		0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3		0x165667B19E3779F9ULL
+#define XXH_PRIME64_4		0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5		0x27D4EB2F165667C5ULL
+
+static ID_INLINE qword XXH_RotL64( qword x, int r ) {
+	return ( x << r ) | ( x >> ( 64 - r ) );
+}
+
+static ID_INLINE qword XXH_Read64( const byte *p ) {
+	qword v;
+	memcpy( &v, p, sizeof( v ) );
+#ifdef __ppc__
+	v = ( v >> 56 ) | ( ( v >> 40 ) & 0xff00ULL ) | ( ( v >> 24 ) & 0xff0000ULL ) | ( ( v >> 8 ) & 0xff000000ULL ) |
+		( ( v << 8 ) & 0xff00000000ULL ) | ( ( v << 24 ) & 0xff0000000000ULL ) | ( ( v << 40 ) & 0xff000000000000ULL ) | ( v << 56 );
+#endif
+	return v;
+}
+
+static ID_INLINE dword XXH_Read32( const byte *p ) {
+	return (dword)p[0] | ( (dword)p[1] << 8 ) | ( (dword)p[2] << 16 ) | ( (dword)p[3] << 24 );
+}
+
+static ID_INLINE qword XXH_Round( qword acc, qword input ) {
+	acc += input * XXH_PRIME64_2;
+	acc = XXH_RotL64( acc, 31 );
+	acc *= XXH_PRIME64_1;
+	return acc;
+}
+
+static ID_INLINE qword XXH_MergeRound( qword acc, qword val ) {
+	acc ^= XXH_Round( 0, val );
+	acc = acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+	return acc;
+}
+
+/*
+================
+XXH64_BlockChecksum
+================
+*/
+qword XXH64_BlockChecksum( const void *data, int length, qword seed ) {
+	const byte *p = (const byte *) data;
+	const byte *end = p + length;
+	qword h;
+
+	if ( length >= 32 ) {
+		const byte *limit = end - 32;
+		qword v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+		qword v2 = seed + XXH_PRIME64_2;
+		qword v3 = seed;
+		qword v4 = seed - XXH_PRIME64_1;
+
+		do {
+			v1 = XXH_Round( v1, XXH_Read64( p + 0 ) );
+			v2 = XXH_Round( v2, XXH_Read64( p + 8 ) );
+			v3 = XXH_Round( v3, XXH_Read64( p + 16 ) );
+			v4 = XXH_Round( v4, XXH_Read64( p + 24 ) );
+			p += 32;
+		} while ( p <= limit );
+
+		h = XXH_RotL64( v1, 1 ) + XXH_RotL64( v2, 7 ) + XXH_RotL64( v3, 12 ) + XXH_RotL64( v4, 18 );
+		h = XXH_MergeRound( h, v1 );
+		h = XXH_MergeRound( h, v2 );
+		h = XXH_MergeRound( h, v3 );
+		h = XXH_MergeRound( h, v4 );
+	} else {
+		h = seed + XXH_PRIME64_5;
+	}
+
+	h += (qword) length;
+
+	while ( p + 8 <= end ) {
+		h ^= XXH_Round( 0, XXH_Read64( p ) );
+		h = XXH_RotL64( h, 27 ) * XXH_PRIME64_1 + XXH_PRIME64_4;
+		p += 8;
+	}
+
+	if ( p + 4 <= end ) {
+		h ^= (qword) XXH_Read32( p ) * XXH_PRIME64_1;
+		h = XXH_RotL64( h, 23 ) * XXH_PRIME64_2 + XXH_PRIME64_3;
+		p += 4;
+	}
+
+	while ( p < end ) {
+		h ^= (qword) (*p) * XXH_PRIME64_5;
+		h = XXH_RotL64( h, 11 ) * XXH_PRIME64_1;
+		p++;
+	}
+
+	h ^= h >> 33;
+	h *= XXH_PRIME64_2;
+	h ^= h >> 29;
+	h *= XXH_PRIME64_3;
+	h ^= h >> 32;
+
+	return h;
+}
+
+//===============================================================
+//
+//	Hash_Bench_f
+//
+//===============================================================
+
+#define HASH_BENCH_TOTAL_BYTES		( 64 << 20 )
+
+typedef enum {
+	HASH_BENCH_CRC32_BYTE,
+	HASH_BENCH_CRC32_SLICE8,
+	HASH_BENCH_CRC32_CLMUL,
+	HASH_BENCH_MD4,
+	HASH_BENCH_MD5,
+	HASH_BENCH_XXH64,
+	HASH_BENCH_NUM
+} hashBenchMethod_t;
+
+static const char *hashBenchNames[HASH_BENCH_NUM] = {
+	"CRC32 (byte)",
+	"CRC32 (slice8)",
+	"CRC32 (clmul)",
+	"MD4",
+	"MD5",
+	"XXH64"
+};
+
+static const crc32Method_t hashBenchCRC32Methods[] = {
+	CRC32_METHOD_BYTE,
+	CRC32_METHOD_SLICE8,
+	CRC32_METHOD_CLMUL
+};
+
+/*
+================
+HashBench_CRC32
+================
+*/
+static unsigned long HashBench_CRC32( crc32Method_t method, const byte *data, int length ) {
+	const crc32Method_t crcMethod = CRC32_GetMethod();
+	CRC32_SetMethod( method );
+	unsigned long crc = CRC32_BlockChecksum( data, length );
+	CRC32_SetMethod( crcMethod );
+	return crc;
+}
+
+/*
+================
+HashBench_Run
+
+  Returns the throughput in MB/s.
+================
+*/
+static double HashBench_Run( hashBenchMethod_t method, const byte *data, int length, volatile qword &result ) {
+	idTimer timer;
+	int i, count;
+
+	count = Max( HASH_BENCH_TOTAL_BYTES / length, 1 );
+	result = 0;
+
+	const crc32Method_t crcMethod = CRC32_GetMethod();
+	if ( method <= HASH_BENCH_CRC32_CLMUL ) {
+		CRC32_SetMethod( hashBenchCRC32Methods[method] );
+	}
+
+	timer.Start();
+	for ( i = 0; i < count; i++ ) {
+		switch( method ) {
+			case HASH_BENCH_CRC32_BYTE:
+			case HASH_BENCH_CRC32_SLICE8:
+			case HASH_BENCH_CRC32_CLMUL:
+				result += CRC32_BlockChecksum( data, length );
+				break;
+			case HASH_BENCH_MD4:
+				result += MD4_BlockChecksum( data, length );
+				break;
+			case HASH_BENCH_MD5:
+				result += MD5_BlockChecksum( data, length );
+				break;
+			default:
+				result += XXH64_BlockChecksum( data, length );
+				break;
+		}
+	}
+	timer.Stop();
+
+	CRC32_SetMethod( crcMethod );
+
+	return (double)count * length / ( 1024.0 * 1024.0 ) / ( Max( timer.Milliseconds(), 0.001 ) * 0.001 );
+}
+
+/*
+================
+Hash_Bench_f
+
+  benchHash [blockSize]
+================
+*/
+void Hash_Bench_f( const idCmdArgs &args ) {
+	static const int defaultSizes[] = { 16, 64, 1024, 64 * 1024, 4 * 1024 * 1024 };
+	int i, j, numSizes, sizes[5];
+	idRandom random( 0x5EED );
+	// volatile so the inlined hash can't be moved out of the timed loop
+	volatile qword result;
+
+	if ( args.Argc() > 1 ) {
+		sizes[0] = idMath::ClampInt( 1, 64 << 20, atoi( args.Argv( 1 ) ) );
+		numSizes = 1;
+	} else {
+		memcpy( sizes, defaultSizes, sizeof( sizes ) );
+		numSizes = sizeof( defaultSizes ) / sizeof( defaultSizes[0] );
+	}
+
+	int maxSize = 0;
+	for ( i = 0; i < numSizes; i++ ) {
+		maxSize = Max( maxSize, sizes[i] );
+	}
+	byte *data = (byte *) Mem_Alloc16( maxSize );
+	for ( i = 0; i < maxSize; i++ ) {
+		data[i] = (byte) random.RandomInt( 256 );
+	}
+
+	const bool clmul = ( idLib::sys->GetProcessorId() & CPUID_PCLMUL ) != 0;
+
+	idLib::common->Printf( "%-16s", "block size" );
+	for ( i = 0; i < numSizes; i++ ) {
+		idLib::common->Printf( " %10d", sizes[i] );
+	}
+	idLib::common->Printf( "  MB/s\n" );
+
+	for ( j = 0; j < HASH_BENCH_NUM; j++ ) {
+		if ( j == HASH_BENCH_CRC32_CLMUL && !clmul ) {
+			continue;
+		}
+		bool mismatch = false;
+		idLib::common->Printf( "%-16s", hashBenchNames[j] );
+		for ( i = 0; i < numSizes; i++ ) {
+			const double speed = HashBench_Run( (hashBenchMethod_t)j, data, sizes[i], result );
+			idLib::common->Printf( " %10.0f", speed );
+			if ( j <= HASH_BENCH_CRC32_CLMUL ) {
+				// all CRC-32 implementations have to produce the same checksum
+				mismatch |= HashBench_CRC32( hashBenchCRC32Methods[j], data, sizes[i] ) != HashBench_CRC32( CRC32_METHOD_BYTE, data, sizes[i] );
+			}
+		}
+		idLib::common->Printf( mismatch ? "  CHECKSUM MISMATCH\n" : "\n" );
+	}
+
+	Mem_Free16( data );
+}
@@ -0,0 +1,28 @@
+#ifndef __XXHASH_H__
+#define __XXHASH_H__
+
+/*
+===============================================================================
+
+	Calculates a fast non-cryptographic 64 bit hash for a block of data
+	using the xxHash64 algorithm.
+
+	The hash is meant for hash tables and change detection, it is not
+	a replacement for CRC32 or MD4 checksums that are stored in files or
+	exchanged over the network.
+
+===============================================================================
+*/
+
+qword XXH64_BlockChecksum( const void *data, int length, qword seed = 0 );
+
+// folds the 64 bit hash into an int for use with idHashIndex
+ID_INLINE int XXH64_BlockHash( const void *data, int length ) {
+	qword h = XXH64_BlockChecksum( data, length );
+	return (int)( h ^ ( h >> 32 ) );
+}
+
+// compares the throughput of the CRC-32, MD4, MD5 and xxHash64 implementations
+void Hash_Bench_f( const class idCmdArgs &args );
+
+#endif /* !__XXHASH_H__ */
@@ -849,6 +849,10 @@ bool idLCP_Symmetric::FactorClamped( void ) {
 	for ( int i = 0; i < numClamped; i++ ) {
 		memcpy( clamped[i], rowPtrs[i], numClamped * sizeof( float ) );
 	}
+	// large systems are factored in blocks spread over the job threads
+	if ( idMatX::UseParallelFactor( numClamped ) ) {
+		return clamped.LDLT_FactorBlocked( true, numClamped, diagonal.ToFloatPtr() );
+	}
 	return SIMDProcessor->MatX_LDLTFactor( clamped, diagonal, numClamped );
 }
 
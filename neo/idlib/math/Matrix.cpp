@@ -3440,6 +3440,101 @@ const char *idMatX::ToString( int precision ) const {
 	return idStr::FloatArrayToString( ToFloatPtr(), GetDimension(), precision );
 }
 
+/*
+============
+idMatX::ParallelMultiply
+
+  dst = this * vec spread over the job threads in bands of rows
+============
+*/
+typedef struct {
+	const idMatX *			mat;
+	const float *			vec;
+	float *					dst;
+	int						rowsPerJob;
+} matXMultiplyVecXJob_t;
+
+static void MatX_MultiplyVecXJob( void *data, int index ) {
+	const matXMultiplyVecXJob_t *job = (const matXMultiplyVecXJob_t *) data;
+	const idMatX &mat = *job->mat;
+	int i, first, last;
+
+	first = index * job->rowsPerJob;
+	last = Min( first + job->rowsPerJob, mat.GetNumRows() );
+	for ( i = first; i < last; i++ ) {
+		SIMDProcessor->Dot( job->dst[i], mat[i], job->vec, mat.GetNumColumns() );
+	}
+}
+
+void idMatX::ParallelMultiply( idVecX &dst, const idVecX &vec ) const {
+	matXMultiplyVecXJob_t job;
+
+	assert( numColumns == vec.GetSize() );
+	assert( dst.GetSize() >= numRows );
+	assert( dst.ToFloatPtr() != vec.ToFloatPtr() );
+
+	job.mat = this;
+	job.vec = vec.ToFloatPtr();
+	job.dst = dst.ToFloatPtr();
+	job.rowsPerJob = 32;
+	idLib::ParallelFor( MatX_MultiplyVecXJob, &job, ( numRows + job.rowsPerJob - 1 ) / job.rowsPerJob );
+}
+
+/*
+============
+idMatX::ParallelMultiply
+
+  dst = this * a spread over the job threads in bands of rows.
+  Each band runs over the rows of a in tiles so a tile of a stays in the cache
+  while it is added into all rows of the band.
+============
+*/
+typedef struct {
+	const idMatX *			m1;
+	const idMatX *			m2;
+	idMatX *				dst;
+	int						rowsPerJob;
+	int						tileSize;
+} matXMultiplyMatXJob_t;
+
+static void MatX_MultiplyMatXJob( void *data, int index ) {
+	const matXMultiplyMatXJob_t *job = (const matXMultiplyMatXJob_t *) data;
+	const idMatX &m1 = *job->m1;
+	const idMatX &m2 = *job->m2;
+	idMatX &dst = *job->dst;
+	int i, k, k0, k1, first, last;
+
+	first = index * job->rowsPerJob;
+	last = Min( first + job->rowsPerJob, m1.GetNumRows() );
+
+	for ( i = first; i < last; i++ ) {
+		memset( dst[i], 0, m2.GetNumColumns() * sizeof( float ) );
+	}
+	for ( k0 = 0; k0 < m1.GetNumColumns(); k0 += job->tileSize ) {
+		k1 = Min( k0 + job->tileSize, m1.GetNumColumns() );
+		for ( i = first; i < last; i++ ) {
+			for ( k = k0; k < k1; k++ ) {
+				SIMDProcessor->MulAdd( dst[i], m1[i][k], m2[k], m2.GetNumColumns() );
+			}
+		}
+	}
+}
+
+void idMatX::ParallelMultiply( idMatX &dst, const idMatX &a ) const {
+	matXMultiplyMatXJob_t job;
+
+	assert( numColumns == a.numRows );
+	assert( dst.numRows == numRows && dst.numColumns == a.numColumns );
+	assert( &dst != this && &dst != &a );
+
+	job.m1 = this;
+	job.m2 = &a;
+	job.dst = &dst;
+	job.rowsPerJob = 8;
+	job.tileSize = 64;
+	idLib::ParallelFor( MatX_MultiplyMatXJob, &job, ( numRows + job.rowsPerJob - 1 ) / job.rowsPerJob );
+}
+
 /*
 ============
 idMatX::Update_RankOne
@@ -5281,6 +5376,17 @@ void idMatX::SVD_MultiplyFactors( idMatX &m, const idVecX &w, const idMatX &V )
 	}
 }
 
+/*
+============
+idMatX::UseParallelFactor
+
+  Without job threads the blocked factorizations are slower than the unblocked SIMD ones at any size.
+============
+*/
+bool idMatX::UseParallelFactor( int n ) {
+	return ( n >= MATX_PARALLEL_MIN_SIZE && idLib::parallelJobManager != NULL && idLib::parallelJobManager->GetNumThreads() > 0 );
+}
+
 /*
 ============
 idMatX::Cholesky_Factor
@@ -5298,6 +5404,10 @@ bool idMatX::Cholesky_Factor( void ) {
 
 	assert( numRows == numColumns );
 
+	if ( UseParallelFactor( numRows ) ) {
+		return FactorBlocked( numRows, true, true, NULL );
+	}
+
 	invSqrt = (float *) _alloca16( numRows * sizeof( float ) );
 
 	for ( i = 0; i < numRows; i++ ) {
@@ -5326,6 +5436,18 @@ bool idMatX::Cholesky_Factor( void ) {
 	return true;
 }
 
+/*
+============
+idMatX::Cholesky_FactorBlocked
+
+  Same factorization as Cholesky_Factor but for large matrices.
+  See idMatX::FactorBlocked.
+============
+*/
+bool idMatX::Cholesky_FactorBlocked( bool parallel ) {
+	return FactorBlocked( numRows, true, parallel, NULL );
+}
+
 /*
 ============
 idMatX::Cholesky_UpdateRankOne
@@ -5754,6 +5876,10 @@ bool idMatX::LDLT_Factor( void ) {
 
 	assert( numRows == numColumns );
 
+	if ( UseParallelFactor( numRows ) ) {
+		return FactorBlocked( numRows, false, true, NULL );
+	}
+
 	v = (float *) _alloca16( numRows * sizeof( float ) );
 
 	for ( i = 0; i < numRows; i++ ) {
@@ -5784,6 +5910,144 @@ bool idMatX::LDLT_Factor( void ) {
 	return true;
 }
 
+/*
+============
+idMatX::LDLT_FactorBlocked
+
+  Same factorization as LDLT_Factor but for large matrices.
+  Only the upper left n * n sub-matrix is factored, the whole matrix when n is negative.
+  If invDiag is not NULL the reciprocals of the diagonal elements are stored in it.
+  See idMatX::FactorBlocked.
+============
+*/
+bool idMatX::LDLT_FactorBlocked( bool parallel, int n, float *invDiag ) {
+	return FactorBlocked( n < 0 ? numRows : n, false, parallel, invDiag );
+}
+
+typedef struct {
+	float *					mat;					// matrix being factored
+	int						nc;						// row stride
+	int						n;						// size of the sub-matrix being factored
+	int						k0, k1;					// columns of the current block
+	const float *			invDiag;				// reciprocal diagonal
+	const float *			left[MATX_BLOCK_SIZE];	// left[c][k] = L[k0+c][k] * D[k] for k < k0+c
+	int						rowsPerJob;
+} matXFactorJob_t;
+
+/*
+============
+MatX_FactorPanelJob
+
+  Computes the columns [k0, k1) for a band of rows below the diagonal block.
+============
+*/
+static void MatX_FactorPanelJob( void *data, int index ) {
+	const matXFactorJob_t *job = (const matXFactorJob_t *) data;
+	int r, c, first, last;
+	float *row, dot;
+
+	first = job->k1 + index * job->rowsPerJob;
+	last = Min( first + job->rowsPerJob, job->n );
+
+	for ( r = first; r < last; r++ ) {
+		row = job->mat + r * job->nc;
+		for ( c = job->k0; c < job->k1; c++ ) {
+			SIMDProcessor->Dot( dot, row, job->left[c - job->k0], c );
+			row[c] = ( row[c] - dot ) * job->invDiag[c];
+		}
+	}
+}
+
+/*
+============
+idMatX::FactorBlocked
+
+  Blocked left-looking in-place LL' or LDL' factorization of the upper left n * n sub-matrix.
+  The factors are stored exactly like Cholesky_Factor and LDLT_Factor store them.
+
+  The columns are processed in blocks of MATX_BLOCK_SIZE. The rows of the diagonal block
+  are factored first and kept scaled by D. All rows below the block then compute their
+  elements in the block columns with SIMD dot products against those rows, which stay in
+  the cache while the rest of the matrix streams past them. The rows below the block are
+  independent and are spread over the job threads when parallel is set.
+============
+*/
+bool idMatX::FactorBlocked( int n, bool cholesky, bool parallel, float *invDiag ) {
+	int k0, k1, r, c, k, numJobs;
+	float *diag, *inv, *left, *row, dot;
+	double sum;
+	matXFactorJob_t job;
+
+	assert( numRows == numColumns );
+	assert( n >= 0 && n <= numRows );
+
+	diag = (float *) _alloca16( n * sizeof( float ) );
+	inv = (float *) _alloca16( n * sizeof( float ) );
+	left = cholesky ? NULL : (float *) Mem_Alloc16( MATX_BLOCK_SIZE * n * sizeof( float ) );
+
+	job.mat = mat;
+	job.nc = numColumns;
+	job.n = n;
+	job.invDiag = inv;
+	job.rowsPerJob = 8;
+
+	for ( k0 = 0; k0 < n; k0 += MATX_BLOCK_SIZE ) {
+		k1 = Min( k0 + MATX_BLOCK_SIZE, n );
+
+		job.k0 = k0;
+		job.k1 = k1;
+
+		// factor the rows of the diagonal block
+		for ( r = k0; r < k1; r++ ) {
+			row = mat + r * numColumns;
+
+			for ( c = k0; c < r; c++ ) {
+				SIMDProcessor->Dot( dot, row, job.left[c - k0], c );
+				row[c] = ( row[c] - dot ) * inv[c];
+			}
+
+			if ( cholesky ) {
+				SIMDProcessor->Dot( dot, row, row, r );
+				sum = row[r] - dot;
+				if ( sum <= 0.0f ) {
+					Mem_Free16( left );
+					return false;
+				}
+				inv[r] = idMath::InvSqrt( sum );
+				diag[r] = row[r] = inv[r] * sum;
+				job.left[r - k0] = row;
+			} else {
+				SIMDProcessor->Mul( left + ( r - k0 ) * n, row, diag, r );
+				SIMDProcessor->Dot( dot, row, left + ( r - k0 ) * n, r );
+				sum = row[r] - dot;
+				if ( sum == 0.0f ) {
+					Mem_Free16( left );
+					return false;
+				}
+				diag[r] = row[r] = sum;
+				inv[r] = 1.0f / sum;
+				job.left[r - k0] = left + ( r - k0 ) * n;
+			}
+		}
+
+		numJobs = ( n - k1 + job.rowsPerJob - 1 ) / job.rowsPerJob;
+		if ( parallel ) {
+			idLib::ParallelFor( MatX_FactorPanelJob, &job, numJobs );
+		} else {
+			for ( k = 0; k < numJobs; k++ ) {
+				MatX_FactorPanelJob( &job, k );
+			}
+		}
+	}
+
+	if ( invDiag ) {
+		memcpy( invDiag, inv, n * sizeof( float ) );
+	}
+
+	Mem_Free16( left );
+	return true;
+}
+
 /*
 ============
 idMatX::LDLT_UpdateRankOne
@@ -8100,3 +8364,168 @@ void idMatX::Test( void ) {
 		idLib::common->Warning( "idMatX::Eigen_Solve failed" );
 	}
 }
+
+/*
+============
+MatX_BenchSymmetric
+
+  fills m with a random symmetric positive definite matrix
+============
+*/
+static void MatX_BenchSymmetric( idMatX &m, int n, int seed ) {
+	idMatX r;
+
+	r.Random( n, n, seed, -1.0f, 1.0f );
+	m.SetSize( n, n );
+	r.TransposeMultiply( m, r );
+	for ( int i = 0; i < n; i++ ) {
+		m[i][i] += n;
+	}
+}
+
+/*
+============
+MatX_BenchMaxError
+
+  largest relative difference between the lower triangles of two matrices
+============
+*/
+static float MatX_BenchMaxError( const idMatX &a, const idMatX &b ) {
+	float maxError = 0.0f;
+
+	for ( int i = 0; i < a.GetNumRows(); i++ ) {
+		for ( int j = 0; j <= i; j++ ) {
+			maxError = Max( maxError, idMath::Fabs( a[i][j] - b[i][j] ) / Max( 1.0f, idMath::Fabs( a[i][j] ) ) );
+		}
+	}
+	return maxError;
+}
+
+/*
+============
+MatX_Bench_f
+
+  compares the unblocked SIMD factorization with the blocked and parallel blocked
+  factorizations, and the SIMD products with the parallel products
+============
+*/
+void MatX_Bench_f( const idCmdArgs &args ) {
+	static const int sizes[] = { 16, 32, 64, 128, 192, 256, 384, 512 };
+	idMatX original, ref, m, dst;
+	idVecX vec, res, invDiag;
+	idTimer timer;
+	double unblocked, blocked, parallel, product, parallelProduct;
+	float error;
+	int i, n, r, reps;
+
+	idLib::common->Printf( "%d job threads, times in microseconds per call\n", idLib::parallelJobManager ? idLib::parallelJobManager->GetNumThreads() : 0 );
+
+	for ( i = 0; i < (int)( sizeof( sizes ) / sizeof( sizes[0] ) ); i++ ) {
+		n = sizes[i];
+		reps = 1 + ( 256 * 256 * 256 ) / ( n * n * n );
+
+		MatX_BenchSymmetric( original, n, n );
+		m.SetSize( n, n );
+		invDiag.SetSize( n );
+
+		// LDL'
+		timer.Clear();
+		for ( r = 0; r < reps; r++ ) {
+			ref = original;
+			timer.Start();
+			SIMDProcessor->MatX_LDLTFactor( ref, invDiag, n );
+			timer.Stop();
+		}
+		unblocked = timer.Milliseconds() * 1000.0 / reps;
+
+		timer.Clear();
+		for ( r = 0; r < reps; r++ ) {
+			m = original;
+			timer.Start();
+			m.LDLT_FactorBlocked( false );
+			timer.Stop();
+		}
+		blocked = timer.Milliseconds() * 1000.0 / reps;
+		error = MatX_BenchMaxError( ref, m );
+
+		timer.Clear();
+		for ( r = 0; r < reps; r++ ) {
+			m = original;
+			timer.Start();
+			m.LDLT_FactorBlocked( true );
+			timer.Stop();
+		}
+		parallel = timer.Milliseconds() * 1000.0 / reps;
+		error = Max( error, MatX_BenchMaxError( ref, m ) );
+
+		idLib::common->Printf( "n = %3d LDLT      simd %9.1f  blocked %9.1f  parallel %9.1f  (max error %.2e)\n", n, unblocked, blocked, parallel, error );
+
+		// LL'
+		timer.Clear();
+		for ( r = 0; r < reps; r++ ) {
+			m = original;
+			timer.Start();
+			m.Cholesky_FactorBlocked( false );
+			timer.Stop();
+		}
+		blocked = timer.Milliseconds() * 1000.0 / reps;
+
+		timer.Clear();
+		for ( r = 0; r < reps; r++ ) {
+			m = original;
+			timer.Start();
+			m.Cholesky_FactorBlocked( true );
+			timer.Stop();
+		}
+		parallel = timer.Milliseconds() * 1000.0 / reps;
+
+		// the factors multiplied back together must give the original matrix
+		ref.SetSize( n, n );
+		m.Cholesky_MultiplyFactors( ref );
+		error = MatX_BenchMaxError( original, ref ) / n;
+
+		idLib::common->Printf( "n = %3d Cholesky                 blocked %9.1f  parallel %9.1f  (max error %.2e)\n", n, blocked, parallel, error );
+
+		// matrix times vector
+		vec.Random( n, n );
+		res.SetSize( n );
+		timer.Clear();
+		timer.Start();
+		for ( r = 0; r < reps * 16; r++ ) {
+			SIMDProcessor->MatX_MultiplyVecX( res, original, vec );
+		}
+		timer.Stop();
+		product = timer.Milliseconds() * 1000.0 / ( reps * 16 );
+
+		timer.Clear();
+		timer.Start();
+		for ( r = 0; r < reps * 16; r++ ) {
+			original.ParallelMultiply( res, vec );
+		}
+		timer.Stop();
+		parallelProduct = timer.Milliseconds() * 1000.0 / ( reps * 16 );
+
+		idLib::common->Printf( "n = %3d MatX*VecX simd %9.1f  parallel %9.1f\n", n, product, parallelProduct );
+
+		// matrix times matrix
+		dst.SetSize( n, n );
+		timer.Clear();
+		timer.Start();
+		for ( r = 0; r < reps; r++ ) {
+			SIMDProcessor->MatX_MultiplyMatX( dst, original, original );
+		}
+		timer.Stop();
+		product = timer.Milliseconds() * 1000.0 / reps;
+		ref = dst;
+
+		timer.Clear();
+		timer.Start();
+		for ( r = 0; r < reps; r++ ) {
+			original.ParallelMultiply( dst, original );
+		}
+		timer.Stop();
+		parallelProduct = timer.Milliseconds() * 1000.0 / reps;
+
+		idLib::common->Printf( "n = %3d MatX*MatX simd %9.1f  parallel %9.1f  (%s)\n", n, product, parallelProduct, dst.Compare( ref, n * 1e-4f ) ? "ok" : "MISMATCH" );
+	}
+}
@@ -1783,6 +1783,10 @@ ID_INLINE float *idMat6::ToFloatPtr( void ) {
 #define MATX_ALLOCA( n )	( (float *) _alloca16( MATX_QUAD( n ) ) )
 #define MATX_SIMD
 
+#define MATX_BLOCK_SIZE				32		// number of columns factored at once by the blocked factorizations
+#define MATX_PARALLEL_MIN_SIZE		192		// factorizations and products at least this large are spread over the job threads if there are any
+#define MATX_PARALLEL_MIN_ELEMENTS	65536	// matrix times vector products with at least this many elements are spread over the job threads
+
 class idMatX {
 public:
 					idMatX( void );
@@ -1882,6 +1886,8 @@ public:
 	void			TransposeMultiplySub( idVecX &dst, const idVecX &vec ) const;	// dst -= this->Transpose() * vec
 
 	void			Multiply( idMatX &dst, const idMatX &a ) const;					// dst = (*this) * a
+	void			ParallelMultiply( idVecX &dst, const idVecX &vec ) const;		// dst = (*this) * vec spread over the job threads
+	void			ParallelMultiply( idMatX &dst, const idMatX &a ) const;			// dst = (*this) * a spread over the job threads
 	void			TransposeMultiply( idMatX &dst, const idMatX &a ) const;		// dst = this->Transpose() * a
 
 	int				GetDimension( void ) const;										// returns total number of values in matrix
@@ -1936,6 +1942,7 @@ public:
 	void			SVD_MultiplyFactors( idMatX &m, const idVecX &w, const idMatX &V ) const;
 
 	bool			Cholesky_Factor( void );						// factor in-place: L * L.Transpose()
+	bool			Cholesky_FactorBlocked( bool parallel );		// factor in-place with a blocked left-looking algorithm
 	bool			Cholesky_UpdateRankOne( const idVecX &v, float alpha, int offset = 0 );
 	bool			Cholesky_UpdateRowColumn( const idVecX &v, int r );
 	bool			Cholesky_UpdateIncrement( const idVecX &v );
@@ -1945,6 +1952,8 @@ public:
 	void			Cholesky_MultiplyFactors( idMatX &m ) const;
 
 	bool			LDLT_Factor( void );							// factor in-place: L * D * L.Transpose()
+	bool			LDLT_FactorBlocked( bool parallel, int n = -1, float *invDiag = NULL );	// factor the n * n sub-matrix in-place with a blocked left-looking algorithm
+	static bool		UseParallelFactor( int n );					// true if an n * n blocked factorization is faster than the SIMD one
 	bool			LDLT_UpdateRankOne( const idVecX &v, float alpha, int offset = 0 );
 	bool			LDLT_UpdateRowColumn( const idVecX &v, int r );
 	bool			LDLT_UpdateIncrement( const idVecX &v );
@@ -1978,6 +1987,7 @@ private:
 
 private:
 	void			SetTempSize( int rows, int columns );
+	bool			FactorBlocked( int n, bool cholesky, bool parallel, float *invDiag );
 	float			DeterminantGeneric( void ) const;
 	bool			InverseSelfGeneric( void );
 	void			QR_Rotate( idMatX &R, int i, float a, float b );
@@ -2710,7 +2720,11 @@ ID_INLINE idMatX idMatX::TransposeMultiply( const idMatX &a ) const {
 
 ID_INLINE void idMatX::Multiply( idVecX &dst, const idVecX &vec ) const {
 #ifdef MATX_SIMD
-	SIMDProcessor->MatX_MultiplyVecX( dst, *this, vec );
+	if ( numRows * numColumns >= MATX_PARALLEL_MIN_ELEMENTS ) {
+		ParallelMultiply( dst, vec );
+	} else {
+		SIMDProcessor->MatX_MultiplyVecX( dst, *this, vec );
+	}
 #else
 	int i, j;
 	const float *mPtr, *vPtr;
@@ -2842,7 +2856,11 @@ ID_INLINE void idMatX::TransposeMultiplySub( idVecX &dst, const idVecX &vec ) co
 
 ID_INLINE void idMatX::Multiply( idMatX &dst, const idMatX &a ) const {
 #ifdef MATX_SIMD
-	SIMDProcessor->MatX_MultiplyMatX( dst, *this, a );
+	if ( numRows >= MATX_PARALLEL_MIN_SIZE ) {
+		ParallelMultiply( dst, a );
+	} else {
+		SIMDProcessor->MatX_MultiplyMatX( dst, *this, a );
+	}
 #else
 	int i, j, k, l, n;
 	float *dstPtr;
@@ -2940,4 +2958,7 @@ ID_INLINE float *idMatX::ToFloatPtr( void ) {
 	return mat;
 }
 
+// compares the speed of the unblocked, blocked and parallel idMatX factorizations and products
+void MatX_Bench_f( const class idCmdArgs &args );
+
 #endif /* !__MATH_MATRIX_H__ */
@@ -35,6 +35,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "Simd_SSE.h"
 #include "Simd_SSE2.h"
 #include "Simd_SSE3.h"
+#include "Simd_AVX2.h"
 #include "Simd_AltiVec.h"
 
 
@@ -75,6 +76,8 @@ void idSIMD::InitProcessor( const char *module, bool forceGeneric ) {
 		if ( !processor ) {
 			if ( ( cpuid & CPUID_ALTIVEC ) ) {
 				processor = new idSIMD_AltiVec;
+			} else if ( ( cpuid & CPUID_AVX2 ) && ( cpuid & CPUID_FMA3 ) ) {
+				processor = new idSIMD_AVX2;
 			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) && ( cpuid & CPUID_SSE3 ) ) {
 				processor = new idSIMD_SSE3;
 			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) ) {
@@ -99,6 +102,14 @@ void idSIMD::InitProcessor( const char *module, bool forceGeneric ) {
 		idLib::common->Printf( "%s using %s for SIMD processing\n", module, SIMDProcessor->GetName() );
 	}
 
+	crc32Method_t crcMethod = ( !forceGeneric && ( cpuid & CPUID_PCLMUL ) ) ? CRC32_METHOD_CLMUL : CRC32_METHOD_SLICE8;
+	if ( crcMethod != CRC32_GetMethod() ) {
+		CRC32_SetMethod( crcMethod );
+		if ( CRC32_GetMethod() == CRC32_METHOD_CLMUL ) {
+			idLib::common->Printf( "%s using carry-less multiply for CRC-32\n", module );
+		}
+	}
+
 	if ( cpuid & CPUID_FTZ ) {
 		idLib::sys->FPU_SetFTZ( true );
 		idLib::common->Printf( "enabled Flush-To-Zero mode\n" );
@@ -2406,6 +2417,191 @@ void TestConvertJointQuatsToJointMats( void ) {
 	PrintClocks( va( "   simd->ConvertJointQuatsToJointMats() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
+/*
+============
+TestBlendJointsSoA
+============
+*/
+void TestBlendJointsSoA( void ) {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( idJointQuat baseJoints[COUNT] );
+	ALIGN16( idJointQuat blendJoints[COUNT] );
+	ALIGN16( idJointQuat joints1[COUNT] );
+	ALIGN16( idJointQuat joints2[COUNT] );
+	ALIGN16( int index[COUNT] );
+	idJointQuatSoA base( COUNT ), blend( COUNT ), soa1( COUNT ), soa2( COUNT );
+	float lerp = 0.3f;
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < COUNT; i++ ) {
+		idAngles angles;
+		angles[0] = srnd.CRandomFloat() * 180.0f;
+		angles[1] = srnd.CRandomFloat() * 180.0f;
+		angles[2] = srnd.CRandomFloat() * 180.0f;
+		baseJoints[i].q = angles.ToQuat();
+		baseJoints[i].t[0] = srnd.CRandomFloat() * 10.0f;
+		baseJoints[i].t[1] = srnd.CRandomFloat() * 10.0f;
+		baseJoints[i].t[2] = srnd.CRandomFloat() * 10.0f;
+		angles[0] = srnd.CRandomFloat() * 180.0f;
+		angles[1] = srnd.CRandomFloat() * 180.0f;
+		angles[2] = srnd.CRandomFloat() * 180.0f;
+		blendJoints[i].q = angles.ToQuat();
+		blendJoints[i].t[0] = srnd.CRandomFloat() * 10.0f;
+		blendJoints[i].t[1] = srnd.CRandomFloat() * 10.0f;
+		blendJoints[i].t[2] = srnd.CRandomFloat() * 10.0f;
+	}
+
+	p_generic->ConvertJointQuatsToSoA( base, baseJoints, COUNT );
+	p_generic->ConvertJointQuatsToSoA( blend, blendJoints, COUNT );
+
+	// conversion in both directions
+	p_simd->ConvertJointQuatsToSoA( soa2, baseJoints, COUNT );
+	p_simd->ConvertSoAToJointQuats( joints2, soa2, COUNT );
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( !soa2.GetJoint( i ).q.Compare( base.GetJoint( i ).q ) || !soa2.GetJoint( i ).t.Compare( base.GetJoint( i ).t ) ) {
+			break;
+		}
+		if ( !joints2[i].q.Compare( baseJoints[i].q ) || !joints2[i].t.Compare( baseJoints[i].t ) ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	idLib::common->Printf( "   simd->ConvertJointQuatsToSoA/ConvertSoAToJointQuats() %s\n", result );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		p_generic->ConvertJointQuatsToSoA( soa1, baseJoints, COUNT );
+		StartRecordTime( start );
+		p_generic->BlendJointsSoA( soa1, blend, lerp, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->BlendJointsSoA()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		p_generic->ConvertJointQuatsToSoA( soa2, baseJoints, COUNT );
+		StartRecordTime( start );
+		p_simd->BlendJointsSoA( soa2, blend, lerp, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( !soa1.GetJoint( i ).t.Compare( soa2.GetJoint( i ).t, 1e-3f ) ) {
+			break;
+		}
+		if ( !soa1.GetJoint( i ).q.Compare( soa2.GetJoint( i ).q, 1e-2f ) ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->BlendJointsSoA() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		p_generic->ConvertJointQuatsToSoA( soa1, baseJoints, COUNT );
+		StartRecordTime( start );
+		p_generic->BlendJointsSoAFast( soa1, blend, lerp, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->BlendJointsSoAFast()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		p_generic->ConvertJointQuatsToSoA( soa2, baseJoints, COUNT );
+		StartRecordTime( start );
+		p_simd->BlendJointsSoAFast( soa2, blend, lerp, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( !soa1.GetJoint( i ).t.Compare( soa2.GetJoint( i ).t, 1e-3f ) ) {
+			break;
+		}
+		if ( !soa1.GetJoint( i ).q.Compare( soa2.GetJoint( i ).q, 1e-3f ) ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->BlendJointsSoAFast() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+
+	// the AoS blend for comparison
+	bestClocksSIMD = 0;
+	for ( i = 0; i < COUNT; i++ ) {
+		index[i] = i;
+	}
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		for ( j = 0; j < COUNT; j++ ) {
+			joints1[j] = baseJoints[j];
+		}
+		StartRecordTime( start );
+		p_simd->BlendJoints( joints1, blendJoints, lerp, index, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+	PrintClocks( "   simd->BlendJoints() for comparison", COUNT, bestClocksSIMD );
+}
+
+/*
+============
+TestConvertSoAToJointMats
+============
+*/
+void TestConvertSoAToJointMats( void ) {
+	int i;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( idJointQuat baseJoints[COUNT] );
+	ALIGN16( idJointMat joints1[COUNT] );
+	ALIGN16( idJointMat joints2[COUNT] );
+	idJointQuatSoA soa( COUNT );
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < COUNT; i++ ) {
+		idAngles angles;
+		angles[0] = srnd.CRandomFloat() * 180.0f;
+		angles[1] = srnd.CRandomFloat() * 180.0f;
+		angles[2] = srnd.CRandomFloat() * 180.0f;
+		baseJoints[i].q = angles.ToQuat();
+		baseJoints[i].t[0] = srnd.CRandomFloat() * 10.0f;
+		baseJoints[i].t[1] = srnd.CRandomFloat() * 10.0f;
+		baseJoints[i].t[2] = srnd.CRandomFloat() * 10.0f;
+	}
+	p_generic->ConvertJointQuatsToSoA( soa, baseJoints, COUNT );
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->ConvertSoAToJointMats( joints1, soa, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->ConvertSoAToJointMats()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->ConvertSoAToJointMats( joints2, soa, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( !joints1[i].Compare( joints2[i], 1e-4f ) ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->ConvertSoAToJointMats() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
 /*
 ============
 TestConvertJointMatsToJointQuats
@@ -2833,6 +3029,68 @@ void TestOverlayPointCull( void ) {
 	PrintClocks( va( "   simd->OverlayPointCull() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
+/*
+============
+TestCullBounds
+============
+*/
+void TestCullBounds( void ) {
+	int i, j, numCulled1, numCulled2;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( idPlane planes[6] );
+	ALIGN16( idBounds bounds[COUNT] );
+	ALIGN16( dword cullBits1[COUNT/32] );
+	ALIGN16( dword cullBits2[COUNT/32] );
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	planes[0].SetNormal( idVec3(  1,  0, 0 ) );
+	planes[1].SetNormal( idVec3( -1,  0, 0 ) );
+	planes[2].SetNormal( idVec3(  0,  1, 0 ) );
+	planes[3].SetNormal( idVec3(  0, -1, 0 ) );
+	planes[4].SetNormal( idVec3(  0.6f, 0, 0.8f ) );
+	planes[5].SetNormal( idVec3( -0.6f, 0, -0.8f ) );
+	planes[0][3] = -5.3f;
+	planes[1][3] = -5.3f;
+	planes[2][3] = -3.4f;
+	planes[3][3] = -3.4f;
+	planes[4][3] = -4.0f;
+	planes[5][3] = -4.0f;
+
+	for ( i = 0; i < COUNT; i++ ) {
+		for ( j = 0; j < 3; j++ ) {
+			bounds[i][0][j] = srnd.CRandomFloat() * 10.0f;
+			bounds[i][1][j] = bounds[i][0][j] + srnd.RandomFloat() * 2.0f;
+		}
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		numCulled1 = p_generic->CullBounds( cullBits1, planes, 6, bounds, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->CullBounds()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		numCulled2 = p_simd->CullBounds( cullBits2, planes, 6, bounds, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT/32; i++ ) {
+		if ( cullBits1[i] != cullBits2[i] ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT/32 && numCulled1 == numCulled2 ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->CullBounds() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
 /*
 ============
 TestDeriveTriPlanes
@@ -4094,6 +4352,64 @@ void TestNegate( void ) {
 }
 
 
+/*
+============
+SIMD_CreateProcessor
+
+  Creates the SIMD processor with the given name.
+  Returns NULL if the name is unknown or the CPU does not support the processor.
+============
+*/
+static idSIMDProcessor *SIMD_CreateProcessor( const char *name ) {
+	cpuid_t cpuid = idLib::sys->GetProcessorId();
+
+	if ( idStr::Icmp( name, "MMX" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) ) {
+			common->Printf( "CPU does not support MMX\n" );
+			return NULL;
+		}
+		return new idSIMD_MMX;
+	} else if ( idStr::Icmp( name, "3DNow" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_3DNOW ) ) {
+			common->Printf( "CPU does not support MMX & 3DNow\n" );
+			return NULL;
+		}
+		return new idSIMD_3DNow;
+	} else if ( idStr::Icmp( name, "SSE" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) ) {
+			common->Printf( "CPU does not support MMX & SSE\n" );
+			return NULL;
+		}
+		return new idSIMD_SSE;
+	} else if ( idStr::Icmp( name, "SSE2" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) ) {
+			common->Printf( "CPU does not support MMX & SSE & SSE2\n" );
+			return NULL;
+		}
+		return new idSIMD_SSE2;
+	} else if ( idStr::Icmp( name, "SSE3" ) == 0 ) {
+		if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) || !( cpuid & CPUID_SSE3 ) ) {
+			common->Printf( "CPU does not support MMX & SSE & SSE2 & SSE3\n" );
+			return NULL;
+		}
+		return new idSIMD_SSE3();
+	} else if ( idStr::Icmp( name, "AVX2" ) == 0 ) {
+		if ( !( cpuid & CPUID_AVX2 ) || !( cpuid & CPUID_FMA3 ) ) {
+			common->Printf( "CPU does not support AVX2 & FMA3\n" );
+			return NULL;
+		}
+		return new idSIMD_AVX2();
+	} else if ( idStr::Icmp( name, "AltiVec" ) == 0 ) {
+		if ( !( cpuid & CPUID_ALTIVEC ) ) {
+			common->Printf( "CPU does not support AltiVec\n" );
+			return NULL;
+		}
+		return new idSIMD_AltiVec();
+	}
+	common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AVX2, AltiVec\n" );
+	return NULL;
+}
+
 /*
 ============
 idSIMD::Test_f
@@ -4109,49 +4425,12 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	p_generic = generic;
 
 	if ( idStr::Length( args.Argv( 1 ) ) != 0 ) {
-		cpuid_t cpuid = idLib::sys->GetProcessorId();
 		idStr argString = args.Args();
 
 		argString.Replace( " ", "" );
 
-		if ( idStr::Icmp( argString, "MMX" ) == 0 ) {
-			if ( !( cpuid & CPUID_MMX ) ) {
-				common->Printf( "CPU does not support MMX\n" );
-				return;
-			}
-			p_simd = new idSIMD_MMX;
-		} else if ( idStr::Icmp( argString, "3DNow" ) == 0 ) {
-			if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_3DNOW ) ) {
-				common->Printf( "CPU does not support MMX & 3DNow\n" );
-				return;
-			}
-			p_simd = new idSIMD_3DNow;
-		} else if ( idStr::Icmp( argString, "SSE" ) == 0 ) {
-			if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) ) {
-				common->Printf( "CPU does not support MMX & SSE\n" );
-				return;
-			}
-			p_simd = new idSIMD_SSE;
-		} else if ( idStr::Icmp( argString, "SSE2" ) == 0 ) {
-			if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) ) {
-				common->Printf( "CPU does not support MMX & SSE & SSE2\n" );
-				return;
-			}
-			p_simd = new idSIMD_SSE2;
-		} else if ( idStr::Icmp( argString, "SSE3" ) == 0 ) {
-			if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) || !( cpuid & CPUID_SSE3 ) ) {
-				common->Printf( "CPU does not support MMX & SSE & SSE2 & SSE3\n" );
-				return;
-			}
-			p_simd = new idSIMD_SSE3();
-		} else if ( idStr::Icmp( argString, "AltiVec" ) == 0 ) {
-			if ( !( cpuid & CPUID_ALTIVEC ) ) {
-				common->Printf( "CPU does not support AltiVec\n" );
-				return;
-			}
-			p_simd = new idSIMD_AltiVec();
-		} else {
-			common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AltiVec\n" );
+		p_simd = SIMD_CreateProcessor( argString );
+		if ( !p_simd ) {
 			return;
 		}
 	}
@@ -4191,6 +4470,8 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 
 	TestBlendJoints();
 	TestConvertJointQuatsToJointMats();
+	TestBlendJointsSoA();
+	TestConvertSoAToJointMats();
 	TestConvertJointMatsToJointQuats();
 	TestTransformJoints();
 	TestUntransformJoints();
@@ -4198,6 +4479,7 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	TestTracePointCull();
 	TestDecalPointCull();
 	TestOverlayPointCull();
+	TestCullBounds();
 	TestDeriveTriPlanes();
 	TestDeriveTangents();
 	TestDeriveUnsmoothedTangents();
@@ -4223,3 +4505,1218 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_NORMAL );
 #endif /* _WIN32 */
 }
+
+
+//===============================================================
+//
+// Regression and micro-benchmark
+//
+//===============================================================
+
+/*
+	Every idSIMDProcessor entry point is run by the generic and the tested
+	processor on the same pseudo random input for several data counts and
+	source alignments. The outputs are compared and the best time out of a
+	number of runs is reported for both. The results can be written to a
+	comma separated file to track them between builds.
+*/
+
+#define BENCH_MAX_COUNT				65536
+#define BENCH_MAX_ALIGN				60
+#define BENCH_PADDING				64						// bytes allocated beyond the end of every array
+#define BENCH_DEFAULT_RUNS			16
+#define BENCH_MATX_MAX_SIZE			128
+#define BENCH_NUM_SKIN_JOINTS		64
+#define BENCH_OUTPUT_FLOATS( c )	( Max( (c) * 64, BENCH_MATX_MAX_SIZE * BENCH_MATX_MAX_SIZE * 2 + MIXBUFFER_SAMPLES * 6 ) )
+#define BENCH_OUTPUT_BYTES( c )		( (c) * 16 + 64 )
+
+#define BENCH_ALIGNED				BIT(0)					// requires 16 byte aligned data, skipped for other alignments
+#define BENCH_FIXED_COUNT			BIT(1)					// always processes the same number of elements
+
+typedef struct simdBenchData_s {
+	int					count;
+	int					align;
+
+	float *				fsrc0;
+	float *				fsrc1;
+	float *				mixed;
+	byte *				bsrc;
+	idVec2 *			vec2;
+	idVec3 *			vec3;
+	idPlane *			planes;
+	idBounds *			bounds;
+	idDrawVert *		verts;
+	int *				indexes;
+	int					numIndexes;
+	int *				remap;
+	dominantTri_s *		dominantTris;
+
+	idJointQuat *		jointQuats;
+	idJointQuat *		blendQuats;
+	idJointMat *		jointMats;
+	int *				jointIndex;
+	int *				jointParents;
+	idJointMat *		skinJoints;
+	idVec4 *			weights;
+	int *				weightIndex;
+	int					numWeights;
+
+	short *				pcm;
+	float *				ogg[2];
+	float *				samples;
+	float *				mixBuffer;
+
+	int					matSize;
+	idMatX				mat;
+	idMatX				spd;					// symmetric positive definite
+	idMatX				ldlt;					// LDL' factorization of spd
+	idVecX				vec;
+
+	idVec3				constVec3;
+	idPlane				constPlane;
+	idPlane				cullPlanes[6];
+	idPlane				overlayPlanes[2];
+	idVec3				lightOrigin;
+	idVec3				viewOrigin;
+
+	idList<void *>		allocations;
+} simdBenchData_t;
+
+typedef struct simdBenchOutput_s {
+	float *				f;						// 16 byte aligned
+	int					numFloats;
+	byte *				b;						// 16 byte aligned
+	int					numBytes;
+	int					elements;
+	idVecX				vecX;
+	idMatX				matX;
+} simdBenchOutput_t;
+
+typedef void (*simdBenchFunc_t)( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o );
+
+typedef struct simdBenchCase_s {
+	const char *		name;
+	simdBenchFunc_t		prepare;				// untimed setup of the output before every run, may be NULL
+	simdBenchFunc_t		run;
+	float				tolerance;				// maximum error relative to the largest generic output value
+	int					flags;
+} simdBenchCase_t;
+
+/*
+============
+Bench_Alloc
+
+  Allocates an array with the start offset in bytes from a 16 byte boundary.
+============
+*/
+static void *Bench_Alloc( simdBenchData_t &d, int bytes, int align ) {
+	byte *ptr = (byte *) Mem_Alloc16( bytes + align + BENCH_PADDING );
+	memset( ptr, 0, bytes + align + BENCH_PADDING );
+	d.allocations.Append( ptr );
+	return ptr + align;
+}
+
+/*
+============
+Bench_FreeData
+============
+*/
+static void Bench_FreeData( simdBenchData_t &d ) {
+	for ( int i = 0; i < d.allocations.Num(); i++ ) {
+		Mem_Free16( d.allocations[i] );
+	}
+	d.allocations.Clear();
+	d.mat.SetSize( 0, 0 );
+	d.spd.SetSize( 0, 0 );
+	d.ldlt.SetSize( 0, 0 );
+	d.vec.SetSize( 0 );
+}
+
+/*
+============
+Bench_RandomRotation
+============
+*/
+static idQuat Bench_RandomRotation( idRandom &rnd ) {
+	idQuat q( rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat() );
+	if ( q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w < 1e-4f ) {
+		q.w = 1.0f;
+	}
+	q.Normalize();
+	return q;
+}
+
+/*
+============
+Bench_RandomPlane
+============
+*/
+static idPlane Bench_RandomPlane( idRandom &rnd, float range ) {
+	idVec3 normal( rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat() + 2.0f );
+	normal.Normalize();
+	idPlane plane;
+	plane.SetNormal( normal );
+	plane.SetDist( rnd.CRandomFloat() * range );
+	return plane;
+}
+
+/*
+============
+Bench_SetupData
+
+  The data only depends on the count so every alignment gets the same input.
+============
+*/
+static void Bench_SetupData( simdBenchData_t &d, idSIMDProcessor *generic, const int count, const int align ) {
+	int i, j, k;
+	idRandom rnd( RANDOM_SEED );
+
+	d.count = count;
+	d.align = align;
+
+	const int numSamples = Max( count, MIXBUFFER_SAMPLES * 6 );
+
+	d.fsrc0 = (float *) Bench_Alloc( d, numSamples * sizeof( float ), align );
+	d.fsrc1 = (float *) Bench_Alloc( d, numSamples * sizeof( float ), align );
+	d.mixed = (float *) Bench_Alloc( d, count * sizeof( float ), align );
+	d.bsrc = (byte *) Bench_Alloc( d, count * sizeof( float ), align );
+	for ( i = 0; i < numSamples; i++ ) {
+		d.fsrc0[i] = rnd.CRandomFloat() * 10.0f;
+		d.fsrc1[i] = rnd.CRandomFloat() * 10.0f;
+		if ( idMath::Fabs( d.fsrc1[i] ) < 0.1f ) {
+			d.fsrc1[i] = 0.1f;
+		}
+	}
+	for ( i = 0; i < count; i++ ) {
+		d.mixed[i] = rnd.CRandomFloat() * 40000.0f;
+	}
+	for ( i = 0; i < count * (int)sizeof( float ); i++ ) {
+		d.bsrc[i] = rnd.RandomInt( 256 );
+	}
+
+	d.vec2 = (idVec2 *) Bench_Alloc( d, count * sizeof( idVec2 ), align );
+	d.vec3 = (idVec3 *) Bench_Alloc( d, count * sizeof( idVec3 ), align );
+	d.planes = (idPlane *) Bench_Alloc( d, count * sizeof( idPlane ), align );
+	for ( i = 0; i < count; i++ ) {
+		d.vec2[i].Set( rnd.CRandomFloat() * 10.0f, rnd.CRandomFloat() * 10.0f );
+		d.vec3[i].Set( rnd.CRandomFloat() * 10.0f, rnd.CRandomFloat() * 10.0f, rnd.CRandomFloat() * 10.0f );
+		d.planes[i] = idPlane( rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat() * 10.0f );
+	}
+
+	// boxes of varying size in the same range as the cull planes
+	d.bounds = (idBounds *) Bench_Alloc( d, count * sizeof( idBounds ), align );
+	for ( i = 0; i < count; i++ ) {
+		idVec3 center( rnd.CRandomFloat() * 10.0f, rnd.CRandomFloat() * 10.0f, rnd.CRandomFloat() * 10.0f );
+		idVec3 extents( rnd.RandomFloat() * 2.0f, rnd.RandomFloat() * 2.0f, rnd.RandomFloat() * 2.0f );
+		d.bounds[i][0] = center - extents;
+		d.bounds[i][1] = center + extents;
+	}
+
+	d.verts = (idDrawVert *) Bench_Alloc( d, count * sizeof( idDrawVert ), align );
+	for ( i = 0; i < count; i++ ) {
+		idDrawVert &v = d.verts[i];
+		v.xyz.Set( rnd.CRandomFloat() * 10.0f, rnd.CRandomFloat() * 10.0f, rnd.CRandomFloat() * 10.0f );
+		v.st.Set( rnd.CRandomFloat(), rnd.CRandomFloat() );
+		v.normal.Set( rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat() + 2.0f );
+		v.tangents[0].Set( rnd.CRandomFloat() + 2.0f, rnd.CRandomFloat(), rnd.CRandomFloat() );
+		v.tangents[1].Set( rnd.CRandomFloat(), rnd.CRandomFloat() + 2.0f, rnd.CRandomFloat() );
+		v.color[0] = v.color[1] = v.color[2] = v.color[3] = 255;
+	}
+
+	// triangles with three different vertices
+	d.numIndexes = ( count / 3 ) * 3;
+	d.indexes = (int *) Bench_Alloc( d, Max( count, 1 ) * sizeof( int ), align );
+	for ( i = 0; i < d.numIndexes; i += 3 ) {
+		d.indexes[i+0] = rnd.RandomInt( count );
+		d.indexes[i+1] = ( d.indexes[i+0] + 1 + rnd.RandomInt( count - 2 ) ) % count;
+		do {
+			d.indexes[i+2] = rnd.RandomInt( count );
+		} while( d.indexes[i+2] == d.indexes[i+0] || d.indexes[i+2] == d.indexes[i+1] );
+	}
+
+	d.remap = (int *) Bench_Alloc( d, count * sizeof( int ), align );
+	for ( i = 0; i < count; i++ ) {
+		d.remap[i] = ( rnd.RandomInt( 4 ) == 0 ) ? 1 : 0;
+	}
+
+	d.dominantTris = (dominantTri_s *) Bench_Alloc( d, count * sizeof( dominantTri_s ), align );
+	for ( i = 0; i < count; i++ ) {
+		d.dominantTris[i].v2 = ( i + 1 + rnd.RandomInt( count - 2 ) ) % count;
+		do {
+			d.dominantTris[i].v3 = rnd.RandomInt( count );
+		} while( d.dominantTris[i].v3 == i || d.dominantTris[i].v3 == d.dominantTris[i].v2 );
+		d.dominantTris[i].normalizationScale[0] = rnd.CRandomFloat();
+		d.dominantTris[i].normalizationScale[1] = rnd.CRandomFloat();
+		d.dominantTris[i].normalizationScale[2] = rnd.CRandomFloat();
+	}
+
+	// joints with a parent earlier in the list
+	d.jointQuats = (idJointQuat *) Bench_Alloc( d, count * sizeof( idJointQuat ), align );
+	d.blendQuats = (idJointQuat *) Bench_Alloc( d, count * sizeof( idJointQuat ), align );
+	d.jointMats = (idJointMat *) Bench_Alloc( d, count * sizeof( idJointMat ), align );
+	d.jointIndex = (int *) Bench_Alloc( d, count * sizeof( int ), align );
+	d.jointParents = (int *) Bench_Alloc( d, count * sizeof( int ), align );
+	for ( i = 0; i < count; i++ ) {
+		d.jointQuats[i].q = Bench_RandomRotation( rnd );
+		d.jointQuats[i].t.Set( rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat() );
+		d.blendQuats[i].q = Bench_RandomRotation( rnd );
+		d.blendQuats[i].t.Set( rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat() );
+		d.jointMats[i].SetRotation( d.jointQuats[i].q.ToMat3() );
+		d.jointMats[i].SetTranslation( d.jointQuats[i].t );
+		d.jointIndex[i] = i;
+		d.jointParents[i] = ( i > 0 ) ? rnd.RandomInt( i ) : -1;
+	}
+	for ( i = count - 1; i > 0; i-- ) {
+		j = rnd.RandomInt( i + 1 );
+		k = d.jointIndex[i];
+		d.jointIndex[i] = d.jointIndex[j];
+		d.jointIndex[j] = k;
+	}
+
+	// one to three weights per vertex
+	d.skinJoints = (idJointMat *) Bench_Alloc( d, BENCH_NUM_SKIN_JOINTS * sizeof( idJointMat ), align );
+	for ( i = 0; i < BENCH_NUM_SKIN_JOINTS; i++ ) {
+		d.skinJoints[i].SetRotation( Bench_RandomRotation( rnd ).ToMat3() );
+		d.skinJoints[i].SetTranslation( idVec3( rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat() ) );
+	}
+	d.weights = (idVec4 *) Bench_Alloc( d, count * 3 * sizeof( idVec4 ), align );
+	d.weightIndex = (int *) Bench_Alloc( d, count * 3 * 2 * sizeof( int ), align );
+	d.numWeights = 0;
+	for ( i = 0; i < count; i++ ) {
+		const int numVertWeights = 1 + rnd.RandomInt( 3 );
+		for ( j = 0; j < numVertWeights; j++ ) {
+			const float w = 1.0f / numVertWeights;
+			d.weights[d.numWeights] = idVec4( d.verts[i].xyz.x * w, d.verts[i].xyz.y * w, d.verts[i].xyz.z * w, w );
+			d.weightIndex[d.numWeights*2+0] = rnd.RandomInt( BENCH_NUM_SKIN_JOINTS ) * sizeof( idJointMat );
+			d.weightIndex[d.numWeights*2+1] = ( j == numVertWeights - 1 );
+			d.numWeights++;
+		}
+	}
+
+	// sound
+	d.pcm = (short *) Bench_Alloc( d, count * sizeof( short ), align );
+	d.ogg[0] = (float *) Bench_Alloc( d, count * sizeof( float ), align );
+	d.ogg[1] = (float *) Bench_Alloc( d, count * sizeof( float ), align );
+	for ( i = 0; i < count; i++ ) {
+		d.pcm[i] = (short) ( rnd.CRandomFloat() * 32767.0f );
+		d.ogg[0][i] = rnd.CRandomFloat();
+		d.ogg[1][i] = rnd.CRandomFloat();
+	}
+	d.samples = (float *) Bench_Alloc( d, MIXBUFFER_SAMPLES * 2 * sizeof( float ), align );
+	d.mixBuffer = (float *) Bench_Alloc( d, MIXBUFFER_SAMPLES * 6 * sizeof( float ), align );
+	for ( i = 0; i < MIXBUFFER_SAMPLES * 2; i++ ) {
+		d.samples[i] = rnd.CRandomFloat() * 32767.0f;
+	}
+	for ( i = 0; i < MIXBUFFER_SAMPLES * 6; i++ ) {
+		d.mixBuffer[i] = rnd.CRandomFloat() * 32767.0f;
+	}
+
+	// matrices are not offset, idMatX always uses 16 byte aligned memory
+	d.matSize = Min( count, BENCH_MATX_MAX_SIZE );
+	d.mat.SetSize( d.matSize, d.matSize );
+	d.spd.SetSize( d.matSize, d.matSize );
+	d.ldlt.SetSize( d.matSize, d.matSize );
+	d.vec.SetSize( d.matSize );
+	for ( i = 0; i < d.matSize; i++ ) {
+		for ( j = 0; j < d.matSize; j++ ) {
+			d.mat[i][j] = rnd.CRandomFloat();
+		}
+		d.vec[i] = rnd.CRandomFloat();
+	}
+	for ( i = 0; i < d.matSize; i++ ) {
+		for ( j = 0; j <= i; j++ ) {
+			float sum = 0.0f;
+			for ( k = 0; k < d.matSize; k++ ) {
+				sum += d.mat[k][i] * d.mat[k][j];
+			}
+			d.spd[i][j] = d.spd[j][i] = sum;
+		}
+		d.spd[i][i] += 1.0f;
+	}
+	d.ldlt = d.spd;
+	idVecX invDiag;
+	invDiag.SetSize( d.matSize );
+	generic->MatX_LDLTFactor( d.ldlt, invDiag, d.matSize );
+
+	d.constVec3.Set( rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat() );
+	d.constPlane = idPlane( rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat(), rnd.CRandomFloat() );
+	for ( i = 0; i < 6; i++ ) {
+		d.cullPlanes[i] = Bench_RandomPlane( rnd, 5.0f );
+	}
+	d.overlayPlanes[0] = idPlane( 0.05f, 0.01f, 0.0f, 0.5f );
+	d.overlayPlanes[1] = idPlane( 0.0f, 0.05f, 0.01f, 0.5f );
+	d.lightOrigin.Set( 20.0f, -15.0f, 30.0f );
+	d.viewOrigin.Set( -40.0f, 25.0f, 10.0f );
+}
+
+/*
+============
+Bench_ComputeError
+
+  Returns the largest difference relative to the largest generic output value.
+============
+*/
+static float Bench_ComputeError( const simdBenchOutput_t &ref, const simdBenchOutput_t &test ) {
+	int i;
+	float maxValue, maxError;
+
+	if ( ref.numFloats != test.numFloats || ref.numBytes != test.numBytes ) {
+		return idMath::INFINITY;
+	}
+	if ( memcmp( ref.b, test.b, ref.numBytes ) != 0 ) {
+		return idMath::INFINITY;
+	}
+
+	maxValue = 1.0f;
+	maxError = 0.0f;
+	for ( i = 0; i < ref.numFloats; i++ ) {
+		const float a = ref.f[i];
+		const float b = test.f[i];
+		// outputs may contain non-float data like vertex colors
+		if ( a == b || *(const int *)&ref.f[i] == *(const int *)&test.f[i] ) {
+			continue;
+		}
+		// NaN compares unequal with everything, including itself
+		if ( !( idMath::Fabs( a - b ) < idMath::INFINITY ) ) {
+			return idMath::INFINITY;
+		}
+		maxValue = Max( maxValue, idMath::Fabs( a ) );
+		maxError = Max( maxError, idMath::Fabs( a - b ) );
+	}
+	return maxError / maxValue;
+}
+
+//===============================================================
+//
+// benchmark cases
+//
+//===============================================================
+
+static void Bench_CopySrc0( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	memcpy( o.f, d.fsrc0, d.count * sizeof( float ) );
+}
+
+static void Bench_CopyBytes( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	memcpy( o.b, d.bsrc, d.count );
+}
+
+static void Bench_CopyVerts( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	memcpy( o.f, d.verts, d.count * sizeof( idDrawVert ) );
+}
+
+static void Bench_CopyVecX( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	memcpy( o.f, d.fsrc0, d.matSize * sizeof( float ) );
+}
+
+static void Bench_AddConstant( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Add( o.f, 4.0f, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_Add( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Add( o.f, d.fsrc0, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_SubConstant( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Sub( o.f, 4.0f, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_Sub( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Sub( o.f, d.fsrc0, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_MulConstant( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Mul( o.f, 4.0f, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_Mul( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Mul( o.f, d.fsrc0, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_DivConstant( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Div( o.f, 4.0f, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_Div( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Div( o.f, d.fsrc0, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_MulAddConstant( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MulAdd( o.f, 4.0f, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_MulAdd( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MulAdd( o.f, d.fsrc0, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_MulSubConstant( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MulSub( o.f, 4.0f, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_MulSub( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MulSub( o.f, d.fsrc0, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_DotVec3Vec3( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Dot( o.f, d.constVec3, d.vec3, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_DotVec3Plane( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Dot( o.f, d.constVec3, d.planes, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_DotVec3DrawVert( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Dot( o.f, d.constVec3, d.verts, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_DotPlaneVec3( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Dot( o.f, d.constPlane, d.vec3, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_DotPlanePlane( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Dot( o.f, d.constPlane, d.planes, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_DotPlaneDrawVert( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Dot( o.f, d.constPlane, d.verts, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_DotVec3Array( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Dot( o.f, d.vec3, (const idVec3 *) d.planes, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_DotFloat( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Dot( o.f[0], d.fsrc0, d.fsrc1, d.count );
+	o.numFloats = 1;
+}
+
+static void Bench_CmpGT( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->CmpGT( o.b, d.fsrc0, 0.5f, d.count );
+	o.numBytes = d.count;
+}
+
+static void Bench_CmpGTBit( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->CmpGT( o.b, 3, d.fsrc0, 0.5f, d.count );
+	o.numBytes = d.count;
+}
+
+static void Bench_CmpGE( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->CmpGE( o.b, d.fsrc0, 0.5f, d.count );
+	o.numBytes = d.count;
+}
+
+static void Bench_CmpGEBit( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->CmpGE( o.b, 5, d.fsrc0, 0.5f, d.count );
+	o.numBytes = d.count;
+}
+
+static void Bench_CmpLT( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->CmpLT( o.b, d.fsrc0, 0.5f, d.count );
+	o.numBytes = d.count;
+}
+
+static void Bench_CmpLTBit( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->CmpLT( o.b, 0, d.fsrc0, 0.5f, d.count );
+	o.numBytes = d.count;
+}
+
+static void Bench_CmpLE( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->CmpLE( o.b, d.fsrc0, 0.5f, d.count );
+	o.numBytes = d.count;
+}
+
+static void Bench_CmpLEBit( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->CmpLE( o.b, 7, d.fsrc0, 0.5f, d.count );
+	o.numBytes = d.count;
+}
+
+static void Bench_MinMaxFloat( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MinMax( o.f[0], o.f[1], d.fsrc0, d.count );
+	o.numFloats = 2;
+}
+
+static void Bench_MinMaxVec2( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MinMax( *(idVec2 *)( o.f + 0 ), *(idVec2 *)( o.f + 2 ), d.vec2, d.count );
+	o.numFloats = 4;
+}
+
+static void Bench_MinMaxVec3( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MinMax( *(idVec3 *)( o.f + 0 ), *(idVec3 *)( o.f + 3 ), d.vec3, d.count );
+	o.numFloats = 6;
+}
+
+static void Bench_MinMaxDrawVert( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MinMax( *(idVec3 *)( o.f + 0 ), *(idVec3 *)( o.f + 3 ), d.verts, d.count );
+	o.numFloats = 6;
+}
+
+static void Bench_MinMaxDrawVertIndexed( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MinMax( *(idVec3 *)( o.f + 0 ), *(idVec3 *)( o.f + 3 ), d.verts, d.indexes, d.numIndexes );
+	o.numFloats = 6;
+	o.elements = d.numIndexes;
+}
+
+static void Bench_Clamp( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Clamp( o.f, d.fsrc0, -1.0f, 1.0f, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_ClampMin( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->ClampMin( o.f, d.fsrc0, -1.0f, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_ClampMax( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->ClampMax( o.f, d.fsrc0, 1.0f, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_Memcpy( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Memcpy( o.b, d.bsrc, d.count * sizeof( float ) );
+	o.numBytes = d.count * sizeof( float );
+}
+
+static void Bench_Memset( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Memset( o.b, 0x5A, d.count * sizeof( float ) );
+	o.numBytes = d.count * sizeof( float );
+}
+
+static void Bench_Zero16( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Zero16( o.f, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_Negate16( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Negate16( o.f, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_Copy16( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Copy16( o.f, d.fsrc0, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_Add16( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Add16( o.f, d.fsrc0, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_Sub16( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Sub16( o.f, d.fsrc0, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_Mul16( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->Mul16( o.f, d.fsrc0, 4.0f, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_AddAssign16( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->AddAssign16( o.f, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_SubAssign16( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->SubAssign16( o.f, d.fsrc1, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_MulAssign16( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MulAssign16( o.f, 4.0f, d.count );
+	o.numFloats = d.count;
+}
+
+static void Bench_MatXMultiplyVecX( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	o.vecX.SetData( d.matSize, o.f );
+	p->MatX_MultiplyVecX( o.vecX, d.mat, d.vec );
+	o.numFloats = d.matSize;
+	o.elements = d.matSize;
+}
+
+static void Bench_MatXMultiplyAddVecX( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	o.vecX.SetData( d.matSize, o.f );
+	p->MatX_MultiplyAddVecX( o.vecX, d.mat, d.vec );
+	o.numFloats = d.matSize;
+	o.elements = d.matSize;
+}
+
+static void Bench_MatXMultiplySubVecX( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	o.vecX.SetData( d.matSize, o.f );
+	p->MatX_MultiplySubVecX( o.vecX, d.mat, d.vec );
+	o.numFloats = d.matSize;
+	o.elements = d.matSize;
+}
+
+static void Bench_MatXTransposeMultiplyVecX( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	o.vecX.SetData( d.matSize, o.f );
+	p->MatX_TransposeMultiplyVecX( o.vecX, d.mat, d.vec );
+	o.numFloats = d.matSize;
+	o.elements = d.matSize;
+}
+
+static void Bench_MatXTransposeMultiplyAddVecX( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	o.vecX.SetData( d.matSize, o.f );
+	p->MatX_TransposeMultiplyAddVecX( o.vecX, d.mat, d.vec );
+	o.numFloats = d.matSize;
+	o.elements = d.matSize;
+}
+
+static void Bench_MatXTransposeMultiplySubVecX( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	o.vecX.SetData( d.matSize, o.f );
+	p->MatX_TransposeMultiplySubVecX( o.vecX, d.mat, d.vec );
+	o.numFloats = d.matSize;
+	o.elements = d.matSize;
+}
+
+static void Bench_MatXMultiplyMatX( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	o.matX.SetData( d.matSize, d.matSize, o.f );
+	p->MatX_MultiplyMatX( o.matX, d.mat, d.spd );
+	o.numFloats = d.matSize * d.matSize;
+	o.elements = d.matSize;
+}
+
+static void Bench_MatXTransposeMultiplyMatX( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	o.matX.SetData( d.matSize, d.matSize, o.f );
+	p->MatX_TransposeMultiplyMatX( o.matX, d.mat, d.spd );
+	o.numFloats = d.matSize * d.matSize;
+	o.elements = d.matSize;
+}
+
+static void Bench_MatXLowerTriangularSolve( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MatX_LowerTriangularSolve( d.ldlt, o.f, d.vec.ToFloatPtr(), d.matSize );
+	o.numFloats = d.matSize;
+	o.elements = d.matSize;
+}
+
+static void Bench_MatXLowerTriangularSolveTranspose( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MatX_LowerTriangularSolveTranspose( d.ldlt, o.f, d.vec.ToFloatPtr(), d.matSize );
+	o.numFloats = d.matSize;
+	o.elements = d.matSize;
+}
+
+static void Bench_CopySPD( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	memcpy( o.f, d.spd.ToFloatPtr(), d.matSize * d.matSize * sizeof( float ) );
+}
+
+static void Bench_MatXLDLTFactor( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	const int diagOffset = ( d.matSize * d.matSize + 3 ) & ~3;
+	o.matX.SetData( d.matSize, d.matSize, o.f );
+	o.vecX.SetData( d.matSize, o.f + diagOffset );
+	o.b[0] = p->MatX_LDLTFactor( o.matX, o.vecX, d.matSize );
+	o.numFloats = diagOffset + d.matSize;
+	o.numBytes = 1;
+	o.elements = d.matSize;
+}
+
+static void Bench_CopyJointQuats( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	memcpy( o.f, d.jointQuats, d.count * sizeof( idJointQuat ) );
+}
+
+static void Bench_CopyJointMats( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	memcpy( o.f, d.jointMats, d.count * sizeof( idJointMat ) );
+}
+
+static void Bench_BlendJoints( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->BlendJoints( (idJointQuat *) o.f, d.blendQuats, 0.35f, d.jointIndex, d.count );
+	o.numFloats = d.count * sizeof( idJointQuat ) / sizeof( float );
+}
+
+static void Bench_ConvertJointQuatsToJointMats( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->ConvertJointQuatsToJointMats( (idJointMat *) o.f, d.jointQuats, d.count );
+	o.numFloats = d.count * sizeof( idJointMat ) / sizeof( float );
+}
+
+static void Bench_ConvertJointMatsToJointQuats( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->ConvertJointMatsToJointQuats( (idJointQuat *) o.f, d.jointMats, d.count );
+	o.numFloats = d.count * sizeof( idJointQuat ) / sizeof( float );
+}
+
+static void Bench_TransformJoints( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->TransformJoints( (idJointMat *) o.f, d.jointParents, 1, d.count - 1 );
+	o.numFloats = d.count * sizeof( idJointMat ) / sizeof( float );
+}
+
+static void Bench_UntransformJoints( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->UntransformJoints( (idJointMat *) o.f, d.jointParents, 1, d.count - 1 );
+	o.numFloats = d.count * sizeof( idJointMat ) / sizeof( float );
+}
+
+static void Bench_TransformVerts( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->TransformVerts( (idDrawVert *) o.f, d.count, d.skinJoints, d.weights, d.weightIndex, d.numWeights );
+	o.numFloats = d.count * sizeof( idDrawVert ) / sizeof( float );
+}
+
+static void Bench_TracePointCull( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->TracePointCull( o.b, o.b[d.count], 2.0f, d.cullPlanes, d.verts, d.count );
+	o.numBytes = d.count + 1;
+}
+
+static void Bench_DecalPointCull( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->DecalPointCull( o.b, d.cullPlanes, d.verts, d.count );
+	o.numBytes = d.count;
+}
+
+static void Bench_OverlayPointCull( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->OverlayPointCull( o.b, (idVec2 *) o.f, d.overlayPlanes, d.verts, d.count );
+	o.numFloats = d.count * 2;
+	o.numBytes = d.count;
+}
+
+static void Bench_CullBounds( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	o.f[0] = (float) p->CullBounds( (dword *) o.b, d.cullPlanes, 6, d.bounds, d.count );
+	o.numFloats = 1;
+	o.numBytes = ( ( d.count + 31 ) >> 5 ) * sizeof( dword );
+}
+
+static void Bench_DeriveTriPlanes( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->DeriveTriPlanes( (idPlane *) o.f, d.verts, d.count, d.indexes, d.numIndexes );
+	o.numFloats = d.numIndexes / 3 * 4;
+	o.elements = d.numIndexes / 3;
+}
+
+static void Bench_DeriveTangents( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	const int numVertFloats = d.count * sizeof( idDrawVert ) / sizeof( float );
+	p->DeriveTangents( (idPlane *)( o.f + numVertFloats ), (idDrawVert *) o.f, d.count, d.indexes, d.numIndexes );
+	o.numFloats = numVertFloats + d.numIndexes / 3 * 4;
+}
+
+static void Bench_DeriveUnsmoothedTangents( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->DeriveUnsmoothedTangents( (idDrawVert *) o.f, d.dominantTris, d.count );
+	o.numFloats = d.count * sizeof( idDrawVert ) / sizeof( float );
+}
+
+static void Bench_NormalizeTangents( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->NormalizeTangents( (idDrawVert *) o.f, d.count );
+	o.numFloats = d.count * sizeof( idDrawVert ) / sizeof( float );
+}
+
+static void Bench_CreateTextureSpaceLightVectors( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->CreateTextureSpaceLightVectors( (idVec3 *) o.f, d.lightOrigin, d.verts, d.count, d.indexes, d.numIndexes );
+	o.numFloats = d.count * 3;
+}
+
+static void Bench_CreateSpecularTextureCoords( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->CreateSpecularTextureCoords( (idVec4 *) o.f, d.lightOrigin, d.viewOrigin, d.verts, d.count, d.indexes, d.numIndexes );
+	o.numFloats = d.count * 4;
+}
+
+static void Bench_CopyRemap( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	memcpy( o.b, d.remap, d.count * sizeof( int ) );
+}
+
+static void Bench_CreateShadowCache( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	const int numVerts = p->CreateShadowCache( (idVec4 *) o.f, (int *) o.b, d.lightOrigin, d.verts, d.count );
+	o.numFloats = numVerts * 4;
+	o.numBytes = d.count * sizeof( int );
+}
+
+static void Bench_CreateVertexProgramShadowCache( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	const int numVerts = p->CreateVertexProgramShadowCache( (idVec4 *) o.f, d.verts, d.count );
+	o.numFloats = numVerts * 4;
+}
+
+static void Bench_UpSamplePCM11kHzMono( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->UpSamplePCMTo44kHz( o.f, d.pcm, d.count, 11025, 1 );
+	o.numFloats = d.count * 4;
+}
+
+static void Bench_UpSamplePCM22kHzStereo( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->UpSamplePCMTo44kHz( o.f, d.pcm, d.count & ~1, 22050, 2 );
+	o.numFloats = ( d.count & ~1 ) * 2;
+}
+
+static void Bench_UpSamplePCM44kHzStereo( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->UpSamplePCMTo44kHz( o.f, d.pcm, d.count & ~1, 44100, 2 );
+	o.numFloats = d.count & ~1;
+}
+
+static void Bench_UpSampleOGG11kHzMono( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->UpSampleOGGTo44kHz( o.f, d.ogg, d.count, 11025, 1 );
+	o.numFloats = d.count * 4;
+}
+
+static void Bench_UpSampleOGG22kHzStereo( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->UpSampleOGGTo44kHz( o.f, d.ogg, d.count & ~1, 22050, 2 );
+	o.numFloats = ( d.count & ~1 ) * 2;
+}
+
+static void Bench_UpSampleOGG44kHzStereo( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->UpSampleOGGTo44kHz( o.f, d.ogg, d.count & ~1, 44100, 2 );
+	o.numFloats = d.count & ~1;
+}
+
+static void Bench_CopyMixBuffer( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	memcpy( o.f, d.mixBuffer, MIXBUFFER_SAMPLES * 6 * sizeof( float ) );
+}
+
+static const float benchLastV[6] = { 0.1f, 0.5f, 1.0f, 0.3f, 0.2f, 0.9f };
+static const float benchCurrentV[6] = { 0.9f, 0.1f, 0.5f, 0.2f, 0.8f, 0.0f };
+
+static void Bench_MixSoundTwoSpeakerMono( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MixSoundTwoSpeakerMono( o.f, d.samples, MIXBUFFER_SAMPLES, benchLastV, benchCurrentV );
+	o.numFloats = MIXBUFFER_SAMPLES * 2;
+	o.elements = MIXBUFFER_SAMPLES;
+}
+
+static void Bench_MixSoundTwoSpeakerStereo( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MixSoundTwoSpeakerStereo( o.f, d.samples, MIXBUFFER_SAMPLES, benchLastV, benchCurrentV );
+	o.numFloats = MIXBUFFER_SAMPLES * 2;
+	o.elements = MIXBUFFER_SAMPLES;
+}
+
+static void Bench_MixSoundSixSpeakerMono( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MixSoundSixSpeakerMono( o.f, d.samples, MIXBUFFER_SAMPLES, benchLastV, benchCurrentV );
+	o.numFloats = MIXBUFFER_SAMPLES * 6;
+	o.elements = MIXBUFFER_SAMPLES;
+}
+
+static void Bench_MixSoundSixSpeakerStereo( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MixSoundSixSpeakerStereo( o.f, d.samples, MIXBUFFER_SAMPLES, benchLastV, benchCurrentV );
+	o.numFloats = MIXBUFFER_SAMPLES * 6;
+	o.elements = MIXBUFFER_SAMPLES;
+}
+
+static void Bench_MixedSoundToSamples( idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o ) {
+	p->MixedSoundToSamples( (short *) o.b, d.mixed, d.count );
+	o.numBytes = d.count * sizeof( short );
+}
+
+static const simdBenchCase_t benchCases[] = {
+	{ "Add( float[] = float + float[] )",				NULL,					Bench_AddConstant,							1e-6f,	0 },
+	{ "Add( float[] = float[] + float[] )",				NULL,					Bench_Add,									1e-6f,	0 },
+	{ "Sub( float[] = float - float[] )",				NULL,					Bench_SubConstant,							1e-6f,	0 },
+	{ "Sub( float[] = float[] - float[] )",				NULL,					Bench_Sub,									1e-6f,	0 },
+	{ "Mul( float[] = float * float[] )",				NULL,					Bench_MulConstant,							1e-6f,	0 },
+	{ "Mul( float[] = float[] * float[] )",				NULL,					Bench_Mul,									1e-6f,	0 },
+	{ "Div( float[] = float / float[] )",				NULL,					Bench_DivConstant,							1e-5f,	0 },
+	{ "Div( float[] = float[] / float[] )",				NULL,					Bench_Div,									1e-5f,	0 },
+	{ "MulAdd( float[] += float * float[] )",			Bench_CopySrc0,			Bench_MulAddConstant,						1e-6f,	0 },
+	{ "MulAdd( float[] += float[] * float[] )",			Bench_CopySrc0,			Bench_MulAdd,								1e-6f,	0 },
+	{ "MulSub( float[] -= float * float[] )",			Bench_CopySrc0,			Bench_MulSubConstant,						1e-6f,	0 },
+	{ "MulSub( float[] -= float[] * float[] )",			Bench_CopySrc0,			Bench_MulSub,								1e-6f,	0 },
+	{ "Dot( float[] = idVec3 * idVec3[] )",				NULL,					Bench_DotVec3Vec3,							1e-6f,	0 },
+	{ "Dot( float[] = idVec3 * idPlane[] )",			NULL,					Bench_DotVec3Plane,							1e-6f,	0 },
+	{ "Dot( float[] = idVec3 * idDrawVert[] )",			NULL,					Bench_DotVec3DrawVert,						1e-6f,	0 },
+	{ "Dot( float[] = idPlane * idVec3[] )",			NULL,					Bench_DotPlaneVec3,							1e-6f,	0 },
+	{ "Dot( float[] = idPlane * idPlane[] )",			NULL,					Bench_DotPlanePlane,						1e-6f,	0 },
+	{ "Dot( float[] = idPlane * idDrawVert[] )",		NULL,					Bench_DotPlaneDrawVert,						1e-6f,	0 },
+	{ "Dot( float[] = idVec3[] * idVec3[] )",			NULL,					Bench_DotVec3Array,							1e-6f,	0 },
+	{ "Dot( float = float[] * float[] )",				NULL,					Bench_DotFloat,								1e-4f,	0 },
+	{ "CmpGT( byte[] = float[] > float )",				NULL,					Bench_CmpGT,								0.0f,	0 },
+	{ "CmpGT( byte[] |= ( float[] > float ) << bit )",	Bench_CopyBytes,		Bench_CmpGTBit,								0.0f,	0 },
+	{ "CmpGE( byte[] = float[] >= float )",				NULL,					Bench_CmpGE,								0.0f,	0 },
+	{ "CmpGE( byte[] |= ( float[] >= float ) << bit )",	Bench_CopyBytes,		Bench_CmpGEBit,								0.0f,	0 },
+	{ "CmpLT( byte[] = float[] < float )",				NULL,					Bench_CmpLT,								0.0f,	0 },
+	{ "CmpLT( byte[] |= ( float[] < float ) << bit )",	Bench_CopyBytes,		Bench_CmpLTBit,								0.0f,	0 },
+	{ "CmpLE( byte[] = float[] <= float )",				NULL,					Bench_CmpLE,								0.0f,	0 },
+	{ "CmpLE( byte[] |= ( float[] <= float ) << bit )",	Bench_CopyBytes,		Bench_CmpLEBit,								0.0f,	0 },
+	{ "MinMax( float[] )",								NULL,					Bench_MinMaxFloat,							0.0f,	0 },
+	{ "MinMax( idVec2[] )",								NULL,					Bench_MinMaxVec2,							0.0f,	0 },
+	{ "MinMax( idVec3[] )",								NULL,					Bench_MinMaxVec3,							0.0f,	0 },
+	{ "MinMax( idDrawVert[] )",							NULL,					Bench_MinMaxDrawVert,						0.0f,	0 },
+	{ "MinMax( idDrawVert[] with indexes )",			NULL,					Bench_MinMaxDrawVertIndexed,				0.0f,	0 },
+	{ "Clamp( float[] )",								NULL,					Bench_Clamp,								0.0f,	0 },
+	{ "ClampMin( float[] )",							NULL,					Bench_ClampMin,								0.0f,	0 },
+	{ "ClampMax( float[] )",							NULL,					Bench_ClampMax,								0.0f,	0 },
+	{ "Memcpy()",										NULL,					Bench_Memcpy,								0.0f,	0 },
+	{ "Memset()",										NULL,					Bench_Memset,								0.0f,	0 },
+	{ "Zero16( float[] )",								NULL,					Bench_Zero16,								0.0f,	BENCH_ALIGNED },
+	{ "Negate16( float[] )",							Bench_CopySrc0,			Bench_Negate16,								0.0f,	BENCH_ALIGNED },
+	{ "Copy16( float[] )",								NULL,					Bench_Copy16,								0.0f,	BENCH_ALIGNED },
+	{ "Add16( float[] = float[] + float[] )",			NULL,					Bench_Add16,								1e-6f,	BENCH_ALIGNED },
+	{ "Sub16( float[] = float[] - float[] )",			NULL,					Bench_Sub16,								1e-6f,	BENCH_ALIGNED },
+	{ "Mul16( float[] = float[] * float )",				NULL,					Bench_Mul16,								1e-6f,	BENCH_ALIGNED },
+	{ "AddAssign16( float[] += float[] )",				Bench_CopySrc0,			Bench_AddAssign16,							1e-6f,	BENCH_ALIGNED },
+	{ "SubAssign16( float[] -= float[] )",				Bench_CopySrc0,			Bench_SubAssign16,							1e-6f,	BENCH_ALIGNED },
+	{ "MulAssign16( float[] *= float )",				Bench_CopySrc0,			Bench_MulAssign16,							1e-6f,	BENCH_ALIGNED },
+	{ "MatX_MultiplyVecX()",							NULL,					Bench_MatXMultiplyVecX,						1e-5f,	BENCH_ALIGNED },
+	{ "MatX_MultiplyAddVecX()",							Bench_CopyVecX,			Bench_MatXMultiplyAddVecX,					1e-5f,	BENCH_ALIGNED },
+	{ "MatX_MultiplySubVecX()",							Bench_CopyVecX,			Bench_MatXMultiplySubVecX,					1e-5f,	BENCH_ALIGNED },
+	{ "MatX_TransposeMultiplyVecX()",					NULL,					Bench_MatXTransposeMultiplyVecX,			1e-5f,	BENCH_ALIGNED },
+	{ "MatX_TransposeMultiplyAddVecX()",				Bench_CopyVecX,			Bench_MatXTransposeMultiplyAddVecX,			1e-5f,	BENCH_ALIGNED },
+	{ "MatX_TransposeMultiplySubVecX()",				Bench_CopyVecX,			Bench_MatXTransposeMultiplySubVecX,			1e-5f,	BENCH_ALIGNED },
+	{ "MatX_MultiplyMatX()",							NULL,					Bench_MatXMultiplyMatX,						1e-5f,	BENCH_ALIGNED },
+	{ "MatX_TransposeMultiplyMatX()",					NULL,					Bench_MatXTransposeMultiplyMatX,			1e-5f,	BENCH_ALIGNED },
+	{ "MatX_LowerTriangularSolve()",					NULL,					Bench_MatXLowerTriangularSolve,				1e-4f,	BENCH_ALIGNED },
+	{ "MatX_LowerTriangularSolveTranspose()",			NULL,					Bench_MatXLowerTriangularSolveTranspose,	1e-4f,	BENCH_ALIGNED },
+	{ "MatX_LDLTFactor()",								Bench_CopySPD,			Bench_MatXLDLTFactor,						1e-4f,	BENCH_ALIGNED },
+	{ "BlendJoints()",									Bench_CopyJointQuats,	Bench_BlendJoints,							1e-3f,	0 },
+	{ "ConvertJointQuatsToJointMats()",					NULL,					Bench_ConvertJointQuatsToJointMats,			1e-5f,	0 },
+	{ "ConvertJointMatsToJointQuats()",					NULL,					Bench_ConvertJointMatsToJointQuats,			1e-4f,	0 },
+	{ "TransformJoints()",								Bench_CopyJointMats,	Bench_TransformJoints,						1e-4f,	0 },
+	{ "UntransformJoints()",							Bench_CopyJointMats,	Bench_UntransformJoints,					1e-4f,	0 },
+	{ "TransformVerts()",								Bench_CopyVerts,		Bench_TransformVerts,						1e-5f,	0 },
+	{ "TracePointCull()",								NULL,					Bench_TracePointCull,						0.0f,	0 },
+	{ "DecalPointCull()",								NULL,					Bench_DecalPointCull,						0.0f,	0 },
+	{ "OverlayPointCull()",								NULL,					Bench_OverlayPointCull,						1e-6f,	0 },
+	{ "CullBounds()",									NULL,					Bench_CullBounds,							0.0f,	0 },
+	{ "DeriveTriPlanes()",								NULL,					Bench_DeriveTriPlanes,						1e-2f,	0 },
+	{ "DeriveTangents()",								Bench_CopyVerts,		Bench_DeriveTangents,						1e-2f,	0 },
+	{ "DeriveUnsmoothedTangents()",						Bench_CopyVerts,		Bench_DeriveUnsmoothedTangents,				1e-4f,	0 },
+	{ "NormalizeTangents()",							Bench_CopyVerts,		Bench_NormalizeTangents,					2.5e-2f,	0 },
+	{ "CreateTextureSpaceLightVectors()",				NULL,					Bench_CreateTextureSpaceLightVectors,		1e-5f,	0 },
+	{ "CreateSpecularTextureCoords()",					NULL,					Bench_CreateSpecularTextureCoords,			1e-2f,	0 },
+	{ "CreateShadowCache()",							Bench_CopyRemap,		Bench_CreateShadowCache,					0.0f,	0 },
+	{ "CreateVertexProgramShadowCache()",				NULL,					Bench_CreateVertexProgramShadowCache,		0.0f,	0 },
+	{ "UpSamplePCMTo44kHz( 11kHz mono )",				NULL,					Bench_UpSamplePCM11kHzMono,					0.0f,	0 },
+	{ "UpSamplePCMTo44kHz( 22kHz stereo )",				NULL,					Bench_UpSamplePCM22kHzStereo,				0.0f,	0 },
+	{ "UpSamplePCMTo44kHz( 44kHz stereo )",				NULL,					Bench_UpSamplePCM44kHzStereo,				0.0f,	0 },
+	{ "UpSampleOGGTo44kHz( 11kHz mono )",				NULL,					Bench_UpSampleOGG11kHzMono,					1e-6f,	0 },
+	{ "UpSampleOGGTo44kHz( 22kHz stereo )",				NULL,					Bench_UpSampleOGG22kHzStereo,				1e-6f,	0 },
+	{ "UpSampleOGGTo44kHz( 44kHz stereo )",				NULL,					Bench_UpSampleOGG44kHzStereo,				1e-6f,	0 },
+	{ "MixSoundTwoSpeakerMono()",						Bench_CopyMixBuffer,	Bench_MixSoundTwoSpeakerMono,				1e-4f,	BENCH_FIXED_COUNT },
+	{ "MixSoundTwoSpeakerStereo()",						Bench_CopyMixBuffer,	Bench_MixSoundTwoSpeakerStereo,				1e-4f,	BENCH_FIXED_COUNT },
+	{ "MixSoundSixSpeakerMono()",						Bench_CopyMixBuffer,	Bench_MixSoundSixSpeakerMono,				1e-4f,	BENCH_FIXED_COUNT },
+	{ "MixSoundSixSpeakerStereo()",						Bench_CopyMixBuffer,	Bench_MixSoundSixSpeakerStereo,				1e-4f,	BENCH_FIXED_COUNT },
+	{ "MixedSoundToSamples()",							NULL,					Bench_MixedSoundToSamples,					0.0f,	0 },
+	{ NULL,												NULL,					NULL,										0.0f,	0 }
+};
+
+/*
+============
+Bench_ParseIntList
+
+  Parses the space separated integers following argument 'first'.
+  The command tokenizer splits up commas so the values are separate arguments.
+  Returns the index of the last argument used.
+============
+*/
+static int Bench_ParseIntList( const idCmdArgs &args, int first, idList<int> &list, int min, int max ) {
+	int i;
+
+	list.Clear();
+	for ( i = first + 1; i < args.Argc() && idStr::IsNumeric( args.Argv( i ) ); i++ ) {
+		int value = atoi( args.Argv( i ) );
+		if ( value >= min && value <= max ) {
+			list.AddUnique( value );
+		}
+	}
+	return i - 1;
+}
+
+/*
+============
+Bench_Time
+
+  Returns the best time in clock ticks out of the given number of runs.
+============
+*/
+static double Bench_Time( const simdBenchCase_t &bench, idSIMDProcessor *p, simdBenchData_t &d, simdBenchOutput_t &o, int numRuns, double overhead ) {
+	double start, end, best = 0.0;
+
+	for ( int i = 0; i < numRuns; i++ ) {
+		o.numFloats = o.numBytes = 0;
+		o.elements = d.count;
+		if ( bench.prepare ) {
+			bench.prepare( p, d, o );
+		}
+		start = idLib::sys->GetClockTicks();
+		bench.run( p, d, o );
+		end = idLib::sys->GetClockTicks();
+		if ( i == 0 || end - start < best ) {
+			best = end - start;
+		}
+	}
+	return Max( best - overhead, 0.0 );
+}
+
+/*
+============
+idSIMD::Bench_f
+
+  benchSIMD [processor] [counts 16 256 4096] [align 0 4 8 12] [runs 16] [filter name] [csv file]
+============
+*/
+void idSIMD::Bench_f( const idCmdArgs &args ) {
+	int i, j, k;
+	idSIMDProcessor *p_bench = processor;
+	idList<int> counts, aligns;
+	idStr filter, csvName;
+	int numRuns = BENCH_DEFAULT_RUNS;
+
+	counts.Append( 16 );
+	counts.Append( 256 );
+	counts.Append( 4096 );
+	aligns.Append( 0 );
+	aligns.Append( 4 );
+	aligns.Append( 8 );
+	aligns.Append( 12 );
+
+	for ( i = 1; i < args.Argc(); i++ ) {
+		const char *arg = args.Argv( i );
+		if ( idStr::Icmp( arg, "counts" ) == 0 ) {
+			i = Bench_ParseIntList( args, i, counts, 4, BENCH_MAX_COUNT );
+		} else if ( idStr::Icmp( arg, "align" ) == 0 ) {
+			i = Bench_ParseIntList( args, i, aligns, 0, BENCH_MAX_ALIGN );
+		} else if ( idStr::Icmp( arg, "runs" ) == 0 && i + 1 < args.Argc() ) {
+			numRuns = Max( atoi( args.Argv( ++i ) ), 1 );
+		} else if ( idStr::Icmp( arg, "filter" ) == 0 && i + 1 < args.Argc() ) {
+			filter = args.Argv( ++i );
+		} else if ( idStr::Icmp( arg, "csv" ) == 0 && i + 1 < args.Argc() ) {
+			csvName = args.Argv( ++i );
+		} else if ( p_bench == processor ) {
+			p_bench = SIMD_CreateProcessor( arg );
+			if ( !p_bench ) {
+				return;
+			}
+		} else {
+			idLib::common->Printf( "usage: benchSIMD [processor] [counts 16 256 4096] [align 0 4 8 12] [runs 16] [filter name] [csv file]\n" );
+			if ( p_bench != processor ) {
+				delete p_bench;
+			}
+			return;
+		}
+	}
+
+	if ( counts.Num() == 0 || aligns.Num() == 0 ) {
+		idLib::common->Printf( "no valid counts or alignments\n" );
+		if ( p_bench != processor ) {
+			delete p_bench;
+		}
+		return;
+	}
+
+	idFile *csv = NULL;
+	if ( csvName.Length() && !idLib::fileSystem ) {
+		idLib::common->Warning( "no file system, not writing %s", csvName.c_str() );
+	} else if ( csvName.Length() ) {
+		csvName.DefaultFileExtension( ".csv" );
+		csv = idLib::fileSystem->OpenFileWrite( csvName );
+		if ( !csv ) {
+			idLib::common->Warning( "couldn't open %s", csvName.c_str() );
+		} else {
+			csv->Printf( "processor,function,count,align,elements,generic_ticks,simd_ticks,speedup,error,tolerance,result\n" );
+		}
+	}
+
+#ifdef _WIN32
+	SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL );
+#endif /* _WIN32 */
+
+	idLib::common->SetRefreshOnPrint( true );
+	idLib::common->Printf( "benchmarking %s against %s, best of %d runs\n", p_bench->GetName(), generic->GetName(), numRuns );
+
+	// timer overhead
+	double overhead = 0.0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		double start = idLib::sys->GetClockTicks();
+		double end = idLib::sys->GetClockTicks();
+		if ( i == 0 || end - start < overhead ) {
+			overhead = end - start;
+		}
+	}
+
+	simdBenchData_t data;
+	simdBenchOutput_t outGeneric, outSIMD;
+	int numPassed = 0, numFailed = 0;
+
+	for ( i = 0; i < counts.Num(); i++ ) {
+		const int count = counts[i];
+		const int outputFloats = BENCH_OUTPUT_FLOATS( count );
+		const int outputBytes = BENCH_OUTPUT_BYTES( count );
+
+		outGeneric.f = (float *) Mem_Alloc16( outputFloats * sizeof( float ) );
+		outSIMD.f = (float *) Mem_Alloc16( outputFloats * sizeof( float ) );
+		outGeneric.b = (byte *) Mem_Alloc16( outputBytes );
+		outSIMD.b = (byte *) Mem_Alloc16( outputBytes );
+
+		idLib::common->Printf( "====================================\n" );
+
+		for ( j = 0; j < aligns.Num(); j++ ) {
+			const int align = aligns[j];
+
+			Bench_SetupData( data, generic, count, align );
+
+			for ( k = 0; benchCases[k].name; k++ ) {
+				const simdBenchCase_t &bench = benchCases[k];
+
+				if ( filter.Length() && idStr::FindText( bench.name, filter, false ) == -1 ) {
+					continue;
+				}
+				if ( ( bench.flags & BENCH_ALIGNED ) && ( align & 15 ) != 0 ) {
+					continue;
+				}
+				if ( ( bench.flags & BENCH_FIXED_COUNT ) && i != 0 ) {
+					continue;
+				}
+
+				memset( outGeneric.f, 0, outputFloats * sizeof( float ) );
+				memset( outSIMD.f, 0, outputFloats * sizeof( float ) );
+				memset( outGeneric.b, 0, outputBytes );
+				memset( outSIMD.b, 0, outputBytes );
+
+				const double genericTicks = Bench_Time( bench, generic, data, outGeneric, numRuns, overhead );
+				const double simdTicks = Bench_Time( bench, p_bench, data, outSIMD, numRuns, overhead );
+				const float error = Bench_ComputeError( outGeneric, outSIMD );
+				const bool passed = ( error <= bench.tolerance );
+				const float speedup = ( simdTicks > 0.0 ) ? (float)( genericTicks / simdTicks ) : 0.0f;
+
+				if ( passed ) {
+					numPassed++;
+				} else {
+					numFailed++;
+				}
+
+				idStr line = va( "%s%s c=%d a=%d", passed ? "" : S_COLOR_RED, bench.name, outSIMD.elements, align );
+				idLib::common->Printf( "%s", line.c_str() );
+				for ( int l = idStr::LengthWithoutColors( line ); l < 64; l++ ) {
+					idLib::common->Printf( " " );
+				}
+				idLib::common->Printf( "generic %8.0f simd %8.0f %5.2fx err %.1e %s\n", genericTicks, simdTicks, speedup, error, passed ? "ok" : S_COLOR_RED"X" );
+
+				if ( csv ) {
+					csv->Printf( "\"%s\",\"%s\",%d,%d,%d,%.0f,%.0f,%.3f,%e,%e,%s\n", p_bench->GetName(), bench.name, count, align, outSIMD.elements,
+									genericTicks, simdTicks, speedup, error, bench.tolerance, passed ? "pass" : "fail" );
+				}
+			}
+
+			Bench_FreeData( data );
+		}
+
+		Mem_Free16( outGeneric.f );
+		Mem_Free16( outSIMD.f );
+		Mem_Free16( outGeneric.b );
+		Mem_Free16( outSIMD.b );
+	}
+
+	outGeneric.vecX.SetData( 0, NULL );
+	outGeneric.matX.SetData( 0, 0, NULL );
+	outSIMD.vecX.SetData( 0, NULL );
+	outSIMD.matX.SetData( 0, 0, NULL );
+
+	idLib::common->Printf( "====================================\n" );
+	idLib::common->Printf( "%d passed, %d failed\n", numPassed, numFailed );
+
+	idLib::common->SetRefreshOnPrint( false );
+
+#ifdef _WIN32
+	SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_NORMAL );
+#endif /* _WIN32 */
+
+	if ( csv ) {
+		idLib::common->Printf( "wrote %s\n", csv->GetFullPath() );
+		idLib::fileSystem->CloseFile( csv );
+	}
+
+	if ( p_bench != processor ) {
+		delete p_bench;
+	}
+}
@@ -46,6 +46,7 @@ public:
 	static void			InitProcessor( const char *module, bool forceGeneric );
 	static void			Shutdown( void );
 	static void			Test_f( const class idCmdArgs &args );
+	static void			Bench_f( const class idCmdArgs &args );
 };
 
 
@@ -76,8 +77,10 @@ class idMat5;
 class idMat6;
 class idMatX;
 class idPlane;
+class idBounds;
 class idDrawVert;
 class idJointQuat;
+class idJointQuatSoA;
 class idJointMat;
 struct dominantTri_s;
 
@@ -173,12 +176,18 @@ public:
 	virtual void VPCALL BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints ) = 0;
 	virtual void VPCALL ConvertJointQuatsToJointMats( idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints ) = 0;
 	virtual void VPCALL ConvertJointMatsToJointQuats( idJointQuat *jointQuats, const idJointMat *jointMats, const int numJoints ) = 0;
+	virtual void VPCALL ConvertJointQuatsToSoA( idJointQuatSoA &soa, const idJointQuat *jointQuats, const int numJoints ) = 0;
+	virtual void VPCALL ConvertSoAToJointQuats( idJointQuat *jointQuats, const idJointQuatSoA &soa, const int numJoints ) = 0;
+	virtual void VPCALL BlendJointsSoA( idJointQuatSoA &joints, const idJointQuatSoA &blendJoints, const float lerp, const int numJoints ) = 0;
+	virtual void VPCALL BlendJointsSoAFast( idJointQuatSoA &joints, const idJointQuatSoA &blendJoints, const float lerp, const int numJoints ) = 0;
+	virtual void VPCALL ConvertSoAToJointMats( idJointMat *jointMats, const idJointQuatSoA &soa, const int numJoints ) = 0;
 	virtual void VPCALL TransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) = 0;
 	virtual void VPCALL UntransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) = 0;
 	virtual void VPCALL TransformVerts( idDrawVert *verts, const int numVerts, const idJointMat *joints, const idVec4 *weights, const int *index, const int numWeights ) = 0;
 	virtual void VPCALL TracePointCull( byte *cullBits, byte &totalOr, const float radius, const idPlane *planes, const idDrawVert *verts, const int numVerts ) = 0;
 	virtual void VPCALL DecalPointCull( byte *cullBits, const idPlane *planes, const idDrawVert *verts, const int numVerts ) = 0;
 	virtual void VPCALL OverlayPointCull( byte *cullBits, idVec2 *texCoords, const idPlane *planes, const idDrawVert *verts, const int numVerts ) = 0;
+	virtual int  VPCALL CullBounds( dword *cullBits, const idPlane *planes, const int numPlanes, const idBounds *bounds, const int numBounds ) = 0;
 	virtual void VPCALL DeriveTriPlanes( idPlane *planes, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) = 0;
 	virtual void VPCALL DeriveTangents( idPlane *planes, idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) = 0;
 	virtual void VPCALL DeriveUnsmoothedTangents( idDrawVert *verts, const dominantTri_s *dominantTris, const int numVerts ) = 0;
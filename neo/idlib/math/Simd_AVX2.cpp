@@ -0,0 +1,860 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../precompiled.h"
+#pragma hdrstop
+
+#include "Simd_Generic.h"
+#include "Simd_MMX.h"
+#include "Simd_SSE.h"
+#include "Simd_SSE2.h"
+#include "Simd_SSE3.h"
+#include "Simd_AVX2.h"
+
+
+//===============================================================
+//
+//	AVX2 & FMA3 implementation of idSIMDProcessor
+//
+//===============================================================
+
+#if defined(ID_SIMD_AVX2)
+
+#include <immintrin.h>
+
+// GCC and clang only allow the AVX2 and FMA intrinsics in functions compiled for that target
+#if defined(__GNUC__) || defined(__clang__)
+#define ID_AVX2_TARGET				__attribute__((target("avx2,fma")))
+#define ID_AVX2_NO_FMA_TARGET		__attribute__((target("avx2")))		// keeps a * b + c from being contracted to FMA
+#else
+#define ID_AVX2_TARGET
+#define ID_AVX2_NO_FMA_TARGET
+#endif
+
+#define DRAWVERT_STRIDE				( sizeof( idDrawVert ) / sizeof( float ) )
+
+/*
+============
+idSIMD_AVX2::GetName
+============
+*/
+const char * idSIMD_AVX2::GetName( void ) const {
+	return "MMX & SSE & SSE2 & SSE3 & AVX2 & FMA3";
+}
+
+/*
+============
+StoreVec3_AVX2
+
+  Stores the first three components without touching the float that follows the vector.
+============
+*/
+ID_AVX2_TARGET static inline void StoreVec3_AVX2( float *dst, const __m128 v ) {
+	_mm_storel_pi( (__m64 *) dst, v );
+	_mm_store_ss( dst + 2, _mm_movehl_ps( v, v ) );
+}
+
+/*
+============
+DrawVertOffsets_AVX2
+
+  Returns the float offsets of eight consecutive idDrawVerts for use with the gather instructions.
+============
+*/
+ID_AVX2_TARGET static inline __m256i DrawVertOffsets_AVX2( void ) {
+	return _mm256_mullo_epi32( _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ), _mm256_set1_epi32( DRAWVERT_STRIDE ) );
+}
+
+/*
+============
+RSqrt_AVX2
+
+  Reciprocal square root estimate refined with one Newton-Raphson iteration.
+  Like idMath::RSqrt this returns a huge number instead of infinity when x == 0.0
+============
+*/
+ID_AVX2_TARGET static inline __m256 RSqrt_AVX2( __m256 x ) {
+	x = _mm256_max_ps( x, _mm256_set1_ps( 1e-30f ) );
+	__m256 r = _mm256_rsqrt_ps( x );
+	__m256 y = _mm256_mul_ps( _mm256_mul_ps( x, r ), r );
+	return _mm256_mul_ps( _mm256_mul_ps( _mm256_set1_ps( 0.5f ), r ), _mm256_sub_ps( _mm256_set1_ps( 3.0f ), y ) );
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int count ) {
+	__m256 min0 = _mm256_set1_ps( idMath::INFINITY );
+	__m256 max0 = _mm256_set1_ps( -idMath::INFINITY );
+	__m256 min1 = min0;
+	__m256 max1 = max0;
+	int i;
+
+	// the fourth float loaded with each position is st[0] and is ignored
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m256 v0 = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( src[i+0].xyz.ToFloatPtr() ) ), _mm_loadu_ps( src[i+1].xyz.ToFloatPtr() ), 1 );
+		__m256 v1 = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( src[i+2].xyz.ToFloatPtr() ) ), _mm_loadu_ps( src[i+3].xyz.ToFloatPtr() ), 1 );
+		min0 = _mm256_min_ps( min0, v0 );
+		max0 = _mm256_max_ps( max0, v0 );
+		min1 = _mm256_min_ps( min1, v1 );
+		max1 = _mm256_max_ps( max1, v1 );
+	}
+	min0 = _mm256_min_ps( min0, min1 );
+	max0 = _mm256_max_ps( max0, max1 );
+
+	__m128 min4 = _mm_min_ps( _mm256_castps256_ps128( min0 ), _mm256_extractf128_ps( min0, 1 ) );
+	__m128 max4 = _mm_max_ps( _mm256_castps256_ps128( max0 ), _mm256_extractf128_ps( max0, 1 ) );
+	for ( ; i < count; i++ ) {
+		__m128 v = _mm_loadu_ps( src[i].xyz.ToFloatPtr() );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+
+	StoreVec3_AVX2( min.ToFloatPtr(), min4 );
+	StoreVec3_AVX2( max.ToFloatPtr(), max4 );
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int *indexes, const int count ) {
+	__m256 min0 = _mm256_set1_ps( idMath::INFINITY );
+	__m256 max0 = _mm256_set1_ps( -idMath::INFINITY );
+	__m256 min1 = min0;
+	__m256 max1 = max0;
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m256 v0 = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( src[indexes[i+0]].xyz.ToFloatPtr() ) ), _mm_loadu_ps( src[indexes[i+1]].xyz.ToFloatPtr() ), 1 );
+		__m256 v1 = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( src[indexes[i+2]].xyz.ToFloatPtr() ) ), _mm_loadu_ps( src[indexes[i+3]].xyz.ToFloatPtr() ), 1 );
+		min0 = _mm256_min_ps( min0, v0 );
+		max0 = _mm256_max_ps( max0, v0 );
+		min1 = _mm256_min_ps( min1, v1 );
+		max1 = _mm256_max_ps( max1, v1 );
+	}
+	min0 = _mm256_min_ps( min0, min1 );
+	max0 = _mm256_max_ps( max0, max1 );
+
+	__m128 min4 = _mm_min_ps( _mm256_castps256_ps128( min0 ), _mm256_extractf128_ps( min0, 1 ) );
+	__m128 max4 = _mm_max_ps( _mm256_castps256_ps128( max0 ), _mm256_extractf128_ps( max0, 1 ) );
+	for ( ; i < count; i++ ) {
+		__m128 v = _mm_loadu_ps( src[indexes[i]].xyz.ToFloatPtr() );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+
+	StoreVec3_AVX2( min.ToFloatPtr(), min4 );
+	StoreVec3_AVX2( max.ToFloatPtr(), max4 );
+}
+
+/*
+============
+idSIMD_AVX2::TransformVerts
+
+  The first two rows of the joint matrix are multiplied with the weight in one
+  256 bit register, the third row in a 128 bit register.
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::TransformVerts( idDrawVert *verts, const int numVerts, const idJointMat *joints, const idVec4 *weights, const int *index, const int numWeights ) {
+	int i, j;
+	const byte *jointsPtr = (const byte *)joints;
+
+	assert( sizeof( idJointMat ) == 12 * sizeof( float ) );
+	assert( sizeof( idVec4 ) == 4 * sizeof( float ) );
+
+	for( j = i = 0; i < numVerts; i++ ) {
+		const float *m = (const float *)( jointsPtr + index[j*2+0] );
+		__m256 w = _mm256_broadcast_ps( (const __m128 *) weights[j].ToFloatPtr() );
+		__m256 r01 = _mm256_mul_ps( _mm256_loadu_ps( m + 0 ), w );
+		__m128 r2 = _mm_mul_ps( _mm_loadu_ps( m + 8 ), _mm256_castps256_ps128( w ) );
+
+		while( index[j*2+1] == 0 ) {
+			j++;
+			m = (const float *)( jointsPtr + index[j*2+0] );
+			w = _mm256_broadcast_ps( (const __m128 *) weights[j].ToFloatPtr() );
+			r01 = _mm256_fmadd_ps( _mm256_loadu_ps( m + 0 ), w, r01 );
+			r2 = _mm_fmadd_ps( _mm_loadu_ps( m + 8 ), _mm256_castps256_ps128( w ), r2 );
+		}
+		j++;
+
+		__m128 r0 = _mm256_castps256_ps128( r01 );
+		__m128 r1 = _mm256_extractf128_ps( r01, 1 );
+		__m128 v = _mm_hadd_ps( _mm_hadd_ps( r0, r1 ), _mm_hadd_ps( r2, r2 ) );
+
+		StoreVec3_AVX2( verts[i].xyz.ToFloatPtr(), v );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::TracePointCull
+
+  Eight vertices are culled at once with the positions fetched through gathers.
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::TracePointCull( byte *cullBits, byte &totalOr, const float radius, const idPlane *planes, const idDrawVert *verts, const int numVerts ) {
+	int i, k;
+	byte tOr;
+	__m256 pa[4], pb[4], pc[4], pd[4];
+
+	for ( k = 0; k < 4; k++ ) {
+		pa[k] = _mm256_set1_ps( planes[k][0] );
+		pb[k] = _mm256_set1_ps( planes[k][1] );
+		pc[k] = _mm256_set1_ps( planes[k][2] );
+		pd[k] = _mm256_set1_ps( planes[k][3] );
+	}
+
+	const __m256i offsets = DrawVertOffsets_AVX2();
+	const __m256 r = _mm256_set1_ps( radius );
+	__m256i orBits = _mm256_setzero_si256();
+
+	for ( i = 0; i + 8 <= numVerts; i += 8 ) {
+		const float *v = verts[i].xyz.ToFloatPtr();
+		__m256 x = _mm256_i32gather_ps( v + 0, offsets, 4 );
+		__m256 y = _mm256_i32gather_ps( v + 1, offsets, 4 );
+		__m256 z = _mm256_i32gather_ps( v + 2, offsets, 4 );
+		__m256i bits = _mm256_setzero_si256();
+
+		for ( k = 0; k < 4; k++ ) {
+			__m256 d = _mm256_fmadd_ps( pa[k], x, _mm256_fmadd_ps( pb[k], y, _mm256_fmadd_ps( pc[k], z, pd[k] ) ) );
+			__m256i s0 = _mm256_srli_epi32( _mm256_castps_si256( _mm256_add_ps( d, r ) ), 31 );
+			__m256i s1 = _mm256_srli_epi32( _mm256_castps_si256( _mm256_sub_ps( d, r ) ), 31 );
+			bits = _mm256_or_si256( bits, _mm256_sll_epi32( s0, _mm_cvtsi32_si128( k ) ) );
+			bits = _mm256_or_si256( bits, _mm256_sll_epi32( s1, _mm_cvtsi32_si128( k + 4 ) ) );
+		}
+
+		bits = _mm256_xor_si256( bits, _mm256_set1_epi32( 0x0F ) );		// flip lower four bits
+		orBits = _mm256_or_si256( orBits, bits );
+
+		__m128i b = _mm_packus_epi32( _mm256_castsi256_si128( bits ), _mm256_extracti128_si256( bits, 1 ) );
+		_mm_storel_epi64( (__m128i *)( cullBits + i ), _mm_packus_epi16( b, b ) );
+	}
+
+	__m128i o = _mm_or_si128( _mm256_castsi256_si128( orBits ), _mm256_extracti128_si256( orBits, 1 ) );
+	o = _mm_or_si128( o, _mm_srli_si128( o, 8 ) );
+	o = _mm_or_si128( o, _mm_srli_si128( o, 4 ) );
+	tOr = (byte) _mm_cvtsi128_si32( o );
+
+	for ( ; i < numVerts; i++ ) {
+		byte bits;
+		float d0, d1, d2, d3, t;
+		const idVec3 &v = verts[i].xyz;
+
+		d0 = planes[0].Distance( v );
+		d1 = planes[1].Distance( v );
+		d2 = planes[2].Distance( v );
+		d3 = planes[3].Distance( v );
+
+		t = d0 + radius;
+		bits  = FLOATSIGNBITSET( t ) << 0;
+		t = d1 + radius;
+		bits |= FLOATSIGNBITSET( t ) << 1;
+		t = d2 + radius;
+		bits |= FLOATSIGNBITSET( t ) << 2;
+		t = d3 + radius;
+		bits |= FLOATSIGNBITSET( t ) << 3;
+
+		t = d0 - radius;
+		bits |= FLOATSIGNBITSET( t ) << 4;
+		t = d1 - radius;
+		bits |= FLOATSIGNBITSET( t ) << 5;
+		t = d2 - radius;
+		bits |= FLOATSIGNBITSET( t ) << 6;
+		t = d3 - radius;
+		bits |= FLOATSIGNBITSET( t ) << 7;
+
+		bits ^= 0x0F;		// flip lower four bits
+
+		tOr |= bits;
+		cullBits[i] = bits;
+	}
+
+	totalOr = tOr;
+}
+
+/*
+============
+idSIMD_AVX2::CullBounds
+
+  Eight bounds are gathered to SoA and tested against a plane at once. The
+  distances are calculated without FMA such that the result is exactly the
+  same as with the other processors.
+============
+*/
+ID_AVX2_NO_FMA_TARGET int VPCALL idSIMD_AVX2::CullBounds( dword *cullBits, const idPlane *planes, const int numPlanes, const idBounds *bounds, const int numBounds ) {
+	int i, j, numCulled, mask;
+	int *select;
+	dword bits;
+
+	// index of the min or max component to use for each plane
+	select = (int *) _alloca16( numPlanes * 3 * sizeof( int ) );
+	for ( j = 0; j < numPlanes; j++ ) {
+		select[j*3+0] = ( planes[j][0] >= 0.0f ) ? 0 : 3;
+		select[j*3+1] = ( planes[j][1] >= 0.0f ) ? 1 : 4;
+		select[j*3+2] = ( planes[j][2] >= 0.0f ) ? 2 : 5;
+	}
+
+	const __m256i offsets = _mm256_setr_epi32( 0, 6, 12, 18, 24, 30, 36, 42 );
+	const __m256 zero = _mm256_setzero_ps();
+
+	numCulled = 0;
+	bits = 0;
+
+	for ( i = 0; i + 8 <= numBounds; i += 8 ) {
+		const float *f = bounds[i][0].ToFloatPtr();
+		__m256 v[6];
+
+		v[0] = _mm256_i32gather_ps( f + 0, offsets, 4 );
+		v[1] = _mm256_i32gather_ps( f + 1, offsets, 4 );
+		v[2] = _mm256_i32gather_ps( f + 2, offsets, 4 );
+		v[3] = _mm256_i32gather_ps( f + 3, offsets, 4 );
+		v[4] = _mm256_i32gather_ps( f + 4, offsets, 4 );
+		v[5] = _mm256_i32gather_ps( f + 5, offsets, 4 );
+
+		__m256 culled = zero;
+		for ( j = 0; j < numPlanes; j++ ) {
+			const float *p = planes[j].ToFloatPtr();
+			const int *s = select + j * 3;
+			__m256 d = _mm256_mul_ps( _mm256_broadcast_ss( p + 0 ), v[s[0]] );
+			d = _mm256_add_ps( d, _mm256_mul_ps( _mm256_broadcast_ss( p + 1 ), v[s[1]] ) );
+			d = _mm256_add_ps( d, _mm256_mul_ps( _mm256_broadcast_ss( p + 2 ), v[s[2]] ) );
+			d = _mm256_add_ps( d, _mm256_broadcast_ss( p + 3 ) );
+			culled = _mm256_or_ps( culled, _mm256_cmp_ps( d, zero, _CMP_GT_OQ ) );
+			if ( _mm256_movemask_ps( culled ) == 255 ) {
+				break;
+			}
+		}
+
+		mask = _mm256_movemask_ps( culled );
+		numCulled += idMath::BitCount( mask );
+		bits |= (dword)mask << ( i & 31 );
+
+		if ( ( i & 31 ) == 24 ) {
+			cullBits[i >> 5] = bits;
+			bits = 0;
+		}
+	}
+
+	for ( ; i < numBounds; i++ ) {
+		const idBounds &b = bounds[i];
+
+		for ( j = 0; j < numPlanes; j++ ) {
+			const idPlane &p = planes[j];
+			float x = ( p[0] >= 0.0f ) ? b[0][0] : b[1][0];
+			float y = ( p[1] >= 0.0f ) ? b[0][1] : b[1][1];
+			float z = ( p[2] >= 0.0f ) ? b[0][2] : b[1][2];
+			if ( p[0] * x + p[1] * y + p[2] * z + p[3] > 0.0f ) {
+				bits |= (dword)1 << ( i & 31 );
+				numCulled++;
+				break;
+			}
+		}
+
+		if ( ( i & 31 ) == 31 ) {
+			cullBits[i >> 5] = bits;
+			bits = 0;
+		}
+	}
+	if ( i & 31 ) {
+		cullBits[i >> 5] = bits;
+	}
+
+	return numCulled;
+}
+
+/*
+============
+idSIMD_AVX2::DeriveTangents
+
+	Derives the normal and orthogonal tangent vectors for the triangle vertices.
+	For each vertex the normal and tangent vectors are derived from all triangles
+	using the vertex which results in smooth tangents across the mesh.
+	In the process the triangle planes are calculated as well.
+
+	The per triangle math is done for eight triangles at once with the vertex
+	data fetched through gathers. The results are accumulated into the vertices
+	sequentially because triangles in the same batch may share vertices.
+	The cross products are not fused such that degenerate triangles still
+	produce exact zero vectors instead of normalized rounding errors.
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::DeriveTangents( idPlane *planes, idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	int i, k;
+	int v0[8], v1[8], v2[8];
+	float nx[8], ny[8], nz[8];
+	float t0x[8], t0y[8], t0z[8];
+	float t1x[8], t1y[8], t1z[8];
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	const float *base = verts->xyz.ToFloatPtr();
+	const __m256i stride = _mm256_set1_epi32( DRAWVERT_STRIDE );
+	const __m256 signMask = _mm256_set1_ps( -0.0f );
+	const int numTris = numIndexes / 3;
+
+	idPlane *planesPtr = planes;
+	for ( i = 0; i < numTris; i += 8 ) {
+		int count = numTris - i;
+		if ( count > 8 ) {
+			count = 8;
+		}
+
+		// pad the last batch with copies of the first triangle
+		for ( k = 0; k < 8; k++ ) {
+			const int *tri = indexes + ( i + ( k < count ? k : 0 ) ) * 3;
+			v0[k] = tri[0];
+			v1[k] = tri[1];
+			v2[k] = tri[2];
+		}
+
+		__m256i oa = _mm256_mullo_epi32( _mm256_loadu_si256( (const __m256i *) v0 ), stride );
+		__m256i ob = _mm256_mullo_epi32( _mm256_loadu_si256( (const __m256i *) v1 ), stride );
+		__m256i oc = _mm256_mullo_epi32( _mm256_loadu_si256( (const __m256i *) v2 ), stride );
+
+		__m256 ax = _mm256_i32gather_ps( base + 0, oa, 4 );
+		__m256 ay = _mm256_i32gather_ps( base + 1, oa, 4 );
+		__m256 az = _mm256_i32gather_ps( base + 2, oa, 4 );
+		__m256 as = _mm256_i32gather_ps( base + 3, oa, 4 );
+		__m256 at = _mm256_i32gather_ps( base + 4, oa, 4 );
+
+		__m256 d0x = _mm256_sub_ps( _mm256_i32gather_ps( base + 0, ob, 4 ), ax );
+		__m256 d0y = _mm256_sub_ps( _mm256_i32gather_ps( base + 1, ob, 4 ), ay );
+		__m256 d0z = _mm256_sub_ps( _mm256_i32gather_ps( base + 2, ob, 4 ), az );
+		__m256 d0s = _mm256_sub_ps( _mm256_i32gather_ps( base + 3, ob, 4 ), as );
+		__m256 d0t = _mm256_sub_ps( _mm256_i32gather_ps( base + 4, ob, 4 ), at );
+
+		__m256 d1x = _mm256_sub_ps( _mm256_i32gather_ps( base + 0, oc, 4 ), ax );
+		__m256 d1y = _mm256_sub_ps( _mm256_i32gather_ps( base + 1, oc, 4 ), ay );
+		__m256 d1z = _mm256_sub_ps( _mm256_i32gather_ps( base + 2, oc, 4 ), az );
+		__m256 d1s = _mm256_sub_ps( _mm256_i32gather_ps( base + 3, oc, 4 ), as );
+		__m256 d1t = _mm256_sub_ps( _mm256_i32gather_ps( base + 4, oc, 4 ), at );
+
+		// normal
+		__m256 n0 = _mm256_sub_ps( _mm256_mul_ps( d1y, d0z ), _mm256_mul_ps( d1z, d0y ) );
+		__m256 n1 = _mm256_sub_ps( _mm256_mul_ps( d1z, d0x ), _mm256_mul_ps( d1x, d0z ) );
+		__m256 n2 = _mm256_sub_ps( _mm256_mul_ps( d1x, d0y ), _mm256_mul_ps( d1y, d0x ) );
+		__m256 f = RSqrt_AVX2( _mm256_fmadd_ps( n0, n0, _mm256_fmadd_ps( n1, n1, _mm256_mul_ps( n2, n2 ) ) ) );
+		_mm256_storeu_ps( nx, _mm256_mul_ps( n0, f ) );
+		_mm256_storeu_ps( ny, _mm256_mul_ps( n1, f ) );
+		_mm256_storeu_ps( nz, _mm256_mul_ps( n2, f ) );
+
+		// area sign bit
+		__m256 signBit = _mm256_and_ps( _mm256_sub_ps( _mm256_mul_ps( d0s, d1t ), _mm256_mul_ps( d0t, d1s ) ), signMask );
+
+		// first tangent
+		__m256 t0 = _mm256_sub_ps( _mm256_mul_ps( d0x, d1t ), _mm256_mul_ps( d0t, d1x ) );
+		__m256 t1 = _mm256_sub_ps( _mm256_mul_ps( d0y, d1t ), _mm256_mul_ps( d0t, d1y ) );
+		__m256 t2 = _mm256_sub_ps( _mm256_mul_ps( d0z, d1t ), _mm256_mul_ps( d0t, d1z ) );
+		f = _mm256_xor_ps( RSqrt_AVX2( _mm256_fmadd_ps( t0, t0, _mm256_fmadd_ps( t1, t1, _mm256_mul_ps( t2, t2 ) ) ) ), signBit );
+		_mm256_storeu_ps( t0x, _mm256_mul_ps( t0, f ) );
+		_mm256_storeu_ps( t0y, _mm256_mul_ps( t1, f ) );
+		_mm256_storeu_ps( t0z, _mm256_mul_ps( t2, f ) );
+
+		// second tangent
+		t0 = _mm256_sub_ps( _mm256_mul_ps( d0s, d1x ), _mm256_mul_ps( d0x, d1s ) );
+		t1 = _mm256_sub_ps( _mm256_mul_ps( d0s, d1y ), _mm256_mul_ps( d0y, d1s ) );
+		t2 = _mm256_sub_ps( _mm256_mul_ps( d0s, d1z ), _mm256_mul_ps( d0z, d1s ) );
+		f = _mm256_xor_ps( RSqrt_AVX2( _mm256_fmadd_ps( t0, t0, _mm256_fmadd_ps( t1, t1, _mm256_mul_ps( t2, t2 ) ) ) ), signBit );
+		_mm256_storeu_ps( t1x, _mm256_mul_ps( t0, f ) );
+		_mm256_storeu_ps( t1y, _mm256_mul_ps( t1, f ) );
+		_mm256_storeu_ps( t1z, _mm256_mul_ps( t2, f ) );
+
+		for ( k = 0; k < count; k++ ) {
+			idDrawVert *a = verts + v0[k];
+			idDrawVert *b = verts + v1[k];
+			idDrawVert *c = verts + v2[k];
+			const idVec3 n( nx[k], ny[k], nz[k] );
+			const idVec3 tangent0( t0x[k], t0y[k], t0z[k] );
+			const idVec3 tangent1( t1x[k], t1y[k], t1z[k] );
+
+			planesPtr->SetNormal( n );
+			planesPtr->FitThroughPoint( a->xyz );
+			planesPtr++;
+
+			if ( used[v0[k]] ) {
+				a->normal += n;
+				a->tangents[0] += tangent0;
+				a->tangents[1] += tangent1;
+			} else {
+				a->normal = n;
+				a->tangents[0] = tangent0;
+				a->tangents[1] = tangent1;
+				used[v0[k]] = true;
+			}
+
+			if ( used[v1[k]] ) {
+				b->normal += n;
+				b->tangents[0] += tangent0;
+				b->tangents[1] += tangent1;
+			} else {
+				b->normal = n;
+				b->tangents[0] = tangent0;
+				b->tangents[1] = tangent1;
+				used[v1[k]] = true;
+			}
+
+			if ( used[v2[k]] ) {
+				c->normal += n;
+				c->tangents[0] += tangent0;
+				c->tangents[1] += tangent1;
+			} else {
+				c->normal = n;
+				c->tangents[0] = tangent0;
+				c->tangents[1] = tangent1;
+				used[v2[k]] = true;
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_AVX2::CreateShadowCache
+
+  The vertex remap table is tested eight entries at a time such that already
+  referenced stretches of vertices are skipped quickly.
+============
+*/
+ID_AVX2_TARGET int VPCALL idSIMD_AVX2::CreateShadowCache( idVec4 *vertexCache, int *vertRemap, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts ) {
+	int i, k, mask, outVerts = 0;
+	const __m128 light = _mm_setr_ps( lightOrigin[0], lightOrigin[1], lightOrigin[2], 0.0f );
+	const __m128 one = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+	const __m128 zero = _mm_setzero_ps();
+
+	for ( i = 0; i < numVerts; i += 8 ) {
+		if ( i + 8 <= numVerts ) {
+			__m256i remap = _mm256_loadu_si256( (const __m256i *)( vertRemap + i ) );
+			mask = _mm256_movemask_ps( _mm256_castsi256_ps( _mm256_cmpeq_epi32( remap, _mm256_setzero_si256() ) ) );
+		} else {
+			mask = 0;
+			for ( k = 0; i + k < numVerts; k++ ) {
+				mask |= ( vertRemap[i+k] == 0 ) << k;
+			}
+		}
+
+		for ( k = 0; mask != 0; k++, mask >>= 1 ) {
+			if ( !( mask & 1 ) ) {
+				continue;
+			}
+			// the fourth float loaded with the position is st[0] and is replaced
+			__m128 v = _mm_loadu_ps( verts[i+k].xyz.ToFloatPtr() );
+			__m128 v0 = _mm_blend_ps( v, one, 8 );
+			// R_SetupProjection() builds the projection matrix with a slight crunch
+			// for depth, which keeps this w=0 division from rasterizing right at the
+			// wrap around point and causing depth fighting with the rear caps
+			__m128 v1 = _mm_blend_ps( _mm_sub_ps( v, light ), zero, 8 );
+			_mm256_storeu_ps( vertexCache[outVerts].ToFloatPtr(), _mm256_insertf128_ps( _mm256_castps128_ps256( v0 ), v1, 1 ) );
+			vertRemap[i+k] = outVerts;
+			outVerts += 2;
+		}
+	}
+	return outVerts;
+}
+
+/*
+============
+UpSampleStore_AVX2
+
+  Stores eight source floats duplicated for 44kHz output.
+  For stereo the source floats are four interleaved left/right pairs.
+============
+*/
+ID_AVX2_TARGET static inline void UpSampleStore_AVX2( float *dest, const __m256 f, const int factor, const int numChannels ) {
+	if ( factor == 1 ) {
+		_mm256_storeu_ps( dest, f );
+	} else if ( factor == 2 ) {
+		__m256 lo, hi;
+		if ( numChannels == 1 ) {
+			lo = _mm256_unpacklo_ps( f, f );
+			hi = _mm256_unpackhi_ps( f, f );
+		} else {
+			lo = _mm256_castpd_ps( _mm256_unpacklo_pd( _mm256_castps_pd( f ), _mm256_castps_pd( f ) ) );
+			hi = _mm256_castpd_ps( _mm256_unpackhi_pd( _mm256_castps_pd( f ), _mm256_castps_pd( f ) ) );
+		}
+		_mm256_storeu_ps( dest + 0, _mm256_permute2f128_ps( lo, hi, 0x20 ) );
+		_mm256_storeu_ps( dest + 8, _mm256_permute2f128_ps( lo, hi, 0x31 ) );
+	} else {
+		if ( numChannels == 1 ) {
+			_mm256_storeu_ps( dest +  0, _mm256_permutevar8x32_ps( f, _mm256_setr_epi32( 0, 0, 0, 0, 1, 1, 1, 1 ) ) );
+			_mm256_storeu_ps( dest +  8, _mm256_permutevar8x32_ps( f, _mm256_setr_epi32( 2, 2, 2, 2, 3, 3, 3, 3 ) ) );
+			_mm256_storeu_ps( dest + 16, _mm256_permutevar8x32_ps( f, _mm256_setr_epi32( 4, 4, 4, 4, 5, 5, 5, 5 ) ) );
+			_mm256_storeu_ps( dest + 24, _mm256_permutevar8x32_ps( f, _mm256_setr_epi32( 6, 6, 6, 6, 7, 7, 7, 7 ) ) );
+		} else {
+			_mm256_storeu_ps( dest +  0, _mm256_permutevar8x32_ps( f, _mm256_setr_epi32( 0, 1, 0, 1, 0, 1, 0, 1 ) ) );
+			_mm256_storeu_ps( dest +  8, _mm256_permutevar8x32_ps( f, _mm256_setr_epi32( 2, 3, 2, 3, 2, 3, 2, 3 ) ) );
+			_mm256_storeu_ps( dest + 16, _mm256_permutevar8x32_ps( f, _mm256_setr_epi32( 4, 5, 4, 5, 4, 5, 4, 5 ) ) );
+			_mm256_storeu_ps( dest + 24, _mm256_permutevar8x32_ps( f, _mm256_setr_epi32( 6, 7, 6, 7, 6, 7, 6, 7 ) ) );
+		}
+	}
+}
+
+/*
+============
+UpSampleFactor_AVX2
+============
+*/
+static int UpSampleFactor_AVX2( const int kHz ) {
+	switch( kHz ) {
+		case 11025: return 4;
+		case 22050: return 2;
+		case 44100: return 1;
+	}
+	return 0;
+}
+
+/*
+============
+idSIMD_AVX2::UpSamplePCMTo44kHz
+
+  Duplicate samples for 44kHz output.
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::UpSamplePCMTo44kHz( float *dest, const short *src, const int numSamples, const int kHz, const int numChannels ) {
+	int i;
+	const int factor = UpSampleFactor_AVX2( kHz );
+
+	if ( factor == 0 ) {
+		idSIMD_Generic::UpSamplePCMTo44kHz( dest, src, numSamples, kHz, numChannels );
+		return;
+	}
+
+	for ( i = 0; i + 8 <= numSamples; i += 8 ) {
+		__m256 f = _mm256_cvtepi32_ps( _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i *)( src + i ) ) ) );
+		UpSampleStore_AVX2( dest + i * factor, f, factor, numChannels );
+	}
+
+	if ( i < numSamples ) {
+		idSIMD_Generic::UpSamplePCMTo44kHz( dest + i * factor, src + i, numSamples - i, kHz, numChannels );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::UpSampleOGGTo44kHz
+
+  Duplicate samples for 44kHz output.
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::UpSampleOGGTo44kHz( float *dest, const float * const *ogg, const int numSamples, const int kHz, const int numChannels ) {
+	int i;
+	const int factor = UpSampleFactor_AVX2( kHz );
+	const __m256 scale = _mm256_set1_ps( 32768.0f );
+
+	if ( factor == 0 ) {
+		idSIMD_Generic::UpSampleOGGTo44kHz( dest, ogg, numSamples, kHz, numChannels );
+		return;
+	}
+
+	if ( numChannels == 1 ) {
+		for ( i = 0; i + 8 <= numSamples; i += 8 ) {
+			UpSampleStore_AVX2( dest + i * factor, _mm256_mul_ps( _mm256_loadu_ps( ogg[0] + i ), scale ), factor, 1 );
+		}
+		if ( i < numSamples ) {
+			const float *tail[2] = { ogg[0] + i, NULL };
+			idSIMD_Generic::UpSampleOGGTo44kHz( dest + i * factor, tail, numSamples - i, kHz, 1 );
+		}
+	} else {
+		const int numPairs = numSamples >> 1;
+		for ( i = 0; i + 8 <= numPairs; i += 8 ) {
+			__m256 l = _mm256_mul_ps( _mm256_loadu_ps( ogg[0] + i ), scale );
+			__m256 r = _mm256_mul_ps( _mm256_loadu_ps( ogg[1] + i ), scale );
+			__m256 lo = _mm256_unpacklo_ps( l, r );
+			__m256 hi = _mm256_unpackhi_ps( l, r );
+			UpSampleStore_AVX2( dest + ( i + 0 ) * 2 * factor, _mm256_permute2f128_ps( lo, hi, 0x20 ), factor, 2 );
+			UpSampleStore_AVX2( dest + ( i + 4 ) * 2 * factor, _mm256_permute2f128_ps( lo, hi, 0x31 ), factor, 2 );
+		}
+		if ( i < numPairs ) {
+			const float *tail[2] = { ogg[0] + i, ogg[1] + i };
+			idSIMD_Generic::UpSampleOGGTo44kHz( dest + i * 2 * factor, tail, numSamples - i * 2, kHz, numChannels );
+		}
+	}
+}
+
+/*
+============
+idSIMD_AVX2::MixSoundTwoSpeakerMono
+
+  Four samples are mixed per iteration with the speaker volumes interleaved
+  the same way as the mix buffer. The volume ramp is evaluated directly from
+  the sample index instead of being accumulated to avoid drift.
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::MixSoundTwoSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	float sL = lastV[0];
+	float sR = lastV[1];
+	float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	const __m256 volBase = _mm256_setr_ps( sL, sR, sL + incL, sR + incR, sL + 2.0f * incL, sR + 2.0f * incR, sL + 3.0f * incL, sR + 3.0f * incR );
+	const __m256 volInc = _mm256_setr_ps( incL, incR, incL, incR, incL, incR, incL, incR );
+
+	for( int j = 0; j < MIXBUFFER_SAMPLES; j += 4 ) {
+		__m256 vol = _mm256_fmadd_ps( _mm256_set1_ps( (float) j ), volInc, volBase );
+		__m128 s = _mm_loadu_ps( samples + j );
+		__m256 s2 = _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_unpacklo_ps( s, s ) ), _mm_unpackhi_ps( s, s ), 1 );
+		_mm256_storeu_ps( mixBuffer + j * 2, _mm256_fmadd_ps( s2, vol, _mm256_loadu_ps( mixBuffer + j * 2 ) ) );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::MixSoundTwoSpeakerStereo
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::MixSoundTwoSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	float sL = lastV[0];
+	float sR = lastV[1];
+	float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	const __m256 volBase = _mm256_setr_ps( sL, sR, sL + incL, sR + incR, sL + 2.0f * incL, sR + 2.0f * incR, sL + 3.0f * incL, sR + 3.0f * incR );
+	const __m256 volInc = _mm256_setr_ps( incL, incR, incL, incR, incL, incR, incL, incR );
+
+	for( int j = 0; j < MIXBUFFER_SAMPLES; j += 4 ) {
+		__m256 vol = _mm256_fmadd_ps( _mm256_set1_ps( (float) j ), volInc, volBase );
+		__m256 s = _mm256_loadu_ps( samples + j * 2 );
+		_mm256_storeu_ps( mixBuffer + j * 2, _mm256_fmadd_ps( s, vol, _mm256_loadu_ps( mixBuffer + j * 2 ) ) );
+	}
+}
+
+/*
+============
+SetupSixSpeakerVolumes_AVX2
+
+  Sets up the volumes and per sample volume increments for four consecutive samples of six speakers.
+============
+*/
+ID_AVX2_TARGET static inline void SetupSixSpeakerVolumes_AVX2( __m256 volBase[3], __m256 volInc[3], const float lastV[6], const float currentV[6] ) {
+	float v[24], inc[24];
+
+	for ( int i = 0; i < 6; i++ ) {
+		float incV = ( currentV[i] - lastV[i] ) / MIXBUFFER_SAMPLES;
+		for ( int j = 0; j < 4; j++ ) {
+			v[j*6+i] = lastV[i] + j * incV;
+			inc[j*6+i] = incV;
+		}
+	}
+	for ( int i = 0; i < 3; i++ ) {
+		volBase[i] = _mm256_loadu_ps( v + i * 8 );
+		volInc[i] = _mm256_loadu_ps( inc + i * 8 );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::MixSoundSixSpeakerMono
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::MixSoundSixSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	__m256 volBase[3], volInc[3];
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	SetupSixSpeakerVolumes_AVX2( volBase, volInc, lastV, currentV );
+
+	const __m256i p0 = _mm256_setr_epi32( 0, 0, 0, 0, 0, 0, 1, 1 );
+	const __m256i p1 = _mm256_setr_epi32( 1, 1, 1, 1, 2, 2, 2, 2 );
+	const __m256i p2 = _mm256_setr_epi32( 2, 2, 3, 3, 3, 3, 3, 3 );
+
+	for( int i = 0; i < MIXBUFFER_SAMPLES; i += 4 ) {
+		const __m256 index = _mm256_set1_ps( (float) i );
+		__m256 s = _mm256_castps128_ps256( _mm_loadu_ps( samples + i ) );
+		float *m = mixBuffer + i * 6;
+		_mm256_storeu_ps( m +  0, _mm256_fmadd_ps( _mm256_permutevar8x32_ps( s, p0 ), _mm256_fmadd_ps( index, volInc[0], volBase[0] ), _mm256_loadu_ps( m +  0 ) ) );
+		_mm256_storeu_ps( m +  8, _mm256_fmadd_ps( _mm256_permutevar8x32_ps( s, p1 ), _mm256_fmadd_ps( index, volInc[1], volBase[1] ), _mm256_loadu_ps( m +  8 ) ) );
+		_mm256_storeu_ps( m + 16, _mm256_fmadd_ps( _mm256_permutevar8x32_ps( s, p2 ), _mm256_fmadd_ps( index, volInc[2], volBase[2] ), _mm256_loadu_ps( m + 16 ) ) );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::MixSoundSixSpeakerStereo
+
+  The left channel feeds speakers 0, 2, 3 and 4, the right channel feeds speakers 1 and 5.
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::MixSoundSixSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	__m256 volBase[3], volInc[3];
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	SetupSixSpeakerVolumes_AVX2( volBase, volInc, lastV, currentV );
+
+	const __m256i p0 = _mm256_setr_epi32( 0, 1, 0, 0, 0, 1, 2, 3 );
+	const __m256i p1 = _mm256_setr_epi32( 2, 2, 2, 3, 4, 5, 4, 4 );
+	const __m256i p2 = _mm256_setr_epi32( 4, 5, 6, 7, 6, 6, 6, 7 );
+
+	for( int i = 0; i < MIXBUFFER_SAMPLES; i += 4 ) {
+		const __m256 index = _mm256_set1_ps( (float) i );
+		__m256 s = _mm256_loadu_ps( samples + i * 2 );
+		float *m = mixBuffer + i * 6;
+		_mm256_storeu_ps( m +  0, _mm256_fmadd_ps( _mm256_permutevar8x32_ps( s, p0 ), _mm256_fmadd_ps( index, volInc[0], volBase[0] ), _mm256_loadu_ps( m +  0 ) ) );
+		_mm256_storeu_ps( m +  8, _mm256_fmadd_ps( _mm256_permutevar8x32_ps( s, p1 ), _mm256_fmadd_ps( index, volInc[1], volBase[1] ), _mm256_loadu_ps( m +  8 ) ) );
+		_mm256_storeu_ps( m + 16, _mm256_fmadd_ps( _mm256_permutevar8x32_ps( s, p2 ), _mm256_fmadd_ps( index, volInc[2], volBase[2] ), _mm256_loadu_ps( m + 16 ) ) );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::MixedSoundToSamples
+============
+*/
+ID_AVX2_TARGET void VPCALL idSIMD_AVX2::MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples ) {
+	int i;
+	const __m256 minSample = _mm256_set1_ps( -32768.0f );
+	const __m256 maxSample = _mm256_set1_ps( 32767.0f );
+
+	for ( i = 0; i + 16 <= numSamples; i += 16 ) {
+		__m256 a = _mm256_min_ps( _mm256_max_ps( _mm256_loadu_ps( mixBuffer + i + 0 ), minSample ), maxSample );
+		__m256 b = _mm256_min_ps( _mm256_max_ps( _mm256_loadu_ps( mixBuffer + i + 8 ), minSample ), maxSample );
+		// the pack works per 128 bit lane so the 64 bit quarters are put back in order afterwards
+		__m256i s = _mm256_packs_epi32( _mm256_cvttps_epi32( a ), _mm256_cvttps_epi32( b ) );
+		_mm256_storeu_si256( (__m256i *)( samples + i ), _mm256_permute4x64_epi64( s, 0xD8 ) );
+	}
+
+	for ( ; i < numSamples; i++ ) {
+		if ( mixBuffer[i] <= -32768.0f ) {
+			samples[i] = -32768;
+		} else if ( mixBuffer[i] >= 32767.0f ) {
+			samples[i] = 32767;
+		} else {
+			samples[i] = (short) mixBuffer[i];
+		}
+	}
+}
+
+#endif /* ID_SIMD_AVX2 */
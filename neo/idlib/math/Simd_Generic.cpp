@@ -2280,6 +2280,126 @@ void VPCALL idSIMD_Generic::ConvertJointMatsToJointQuats( idJointQuat *jointQuat
 	}
 }
 
+/*
+============
+idSIMD_Generic::ConvertJointQuatsToSoA
+============
+*/
+void VPCALL idSIMD_Generic::ConvertJointQuatsToSoA( idJointQuatSoA &soa, const idJointQuat *jointQuats, const int numJoints ) {
+	int i;
+
+	assert( numJoints <= soa.Num() );
+
+	for ( i = 0; i < numJoints; i++ ) {
+		soa.SetJoint( i, jointQuats[i] );
+	}
+}
+
+/*
+============
+idSIMD_Generic::ConvertSoAToJointQuats
+============
+*/
+void VPCALL idSIMD_Generic::ConvertSoAToJointQuats( idJointQuat *jointQuats, const idJointQuatSoA &soa, const int numJoints ) {
+	int i;
+
+	assert( numJoints <= soa.Num() );
+
+	for ( i = 0; i < numJoints; i++ ) {
+		jointQuats[i] = soa.GetJoint( i );
+	}
+}
+
+/*
+============
+idSIMD_Generic::BlendJointsSoA
+============
+*/
+void VPCALL idSIMD_Generic::BlendJointsSoA( idJointQuatSoA &joints, const idJointQuatSoA &blendJoints, const float lerp, const int numJoints ) {
+	int i;
+	idQuat q;
+
+	assert( numJoints <= joints.Num() && numJoints <= blendJoints.Num() );
+
+	if ( lerp <= 0.0f ) {
+		return;
+	} else if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			joints.SetJoint( i, blendJoints.GetJoint( i ) );
+		}
+		return;
+	}
+
+	for ( i = 0; i < numJoints; i++ ) {
+		q.Slerp( idQuat( joints.x[i], joints.y[i], joints.z[i], joints.w[i] ),
+					idQuat( blendJoints.x[i], blendJoints.y[i], blendJoints.z[i], blendJoints.w[i] ), lerp );
+		joints.x[i] = q.x;
+		joints.y[i] = q.y;
+		joints.z[i] = q.z;
+		joints.w[i] = q.w;
+		joints.tx[i] += lerp * ( blendJoints.tx[i] - joints.tx[i] );
+		joints.ty[i] += lerp * ( blendJoints.ty[i] - joints.ty[i] );
+		joints.tz[i] += lerp * ( blendJoints.tz[i] - joints.tz[i] );
+	}
+}
+
+/*
+============
+idSIMD_Generic::BlendJointsSoAFast
+
+  Normalized linear interpolation of the rotations, only accurate for small angles.
+============
+*/
+void VPCALL idSIMD_Generic::BlendJointsSoAFast( idJointQuatSoA &joints, const idJointQuatSoA &blendJoints, const float lerp, const int numJoints ) {
+	int i;
+	float cosom, scale0, scale1, s;
+
+	assert( numJoints <= joints.Num() && numJoints <= blendJoints.Num() );
+
+	if ( lerp <= 0.0f ) {
+		return;
+	} else if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			joints.SetJoint( i, blendJoints.GetJoint( i ) );
+		}
+		return;
+	}
+
+	for ( i = 0; i < numJoints; i++ ) {
+		cosom = joints.x[i] * blendJoints.x[i] + joints.y[i] * blendJoints.y[i] + joints.z[i] * blendJoints.z[i] + joints.w[i] * blendJoints.w[i];
+		scale0 = 1.0f - lerp;
+		scale1 = ( cosom < 0.0f ) ? -lerp : lerp;
+		joints.x[i] = scale0 * joints.x[i] + scale1 * blendJoints.x[i];
+		joints.y[i] = scale0 * joints.y[i] + scale1 * blendJoints.y[i];
+		joints.z[i] = scale0 * joints.z[i] + scale1 * blendJoints.z[i];
+		joints.w[i] = scale0 * joints.w[i] + scale1 * blendJoints.w[i];
+		s = idMath::InvSqrt( joints.x[i] * joints.x[i] + joints.y[i] * joints.y[i] + joints.z[i] * joints.z[i] + joints.w[i] * joints.w[i] );
+		joints.x[i] *= s;
+		joints.y[i] *= s;
+		joints.z[i] *= s;
+		joints.w[i] *= s;
+		joints.tx[i] += lerp * ( blendJoints.tx[i] - joints.tx[i] );
+		joints.ty[i] += lerp * ( blendJoints.ty[i] - joints.ty[i] );
+		joints.tz[i] += lerp * ( blendJoints.tz[i] - joints.tz[i] );
+	}
+}
+
+/*
+============
+idSIMD_Generic::ConvertSoAToJointMats
+============
+*/
+void VPCALL idSIMD_Generic::ConvertSoAToJointMats( idJointMat *jointMats, const idJointQuatSoA &soa, const int numJoints ) {
+	int i;
+
+	assert( numJoints <= soa.Num() );
+
+	for ( i = 0; i < numJoints; i++ ) {
+		jointMats[i].SetRotation( idQuat( soa.x[i], soa.y[i], soa.z[i], soa.w[i] ).ToMat3() );
+		jointMats[i].SetTranslation( idVec3( soa.tx[i], soa.ty[i], soa.tz[i] ) );
+	}
+}
+
 /*
 ============
 idSIMD_Generic::TransformJoints
@@ -2437,6 +2557,51 @@ void VPCALL idSIMD_Generic::OverlayPointCull( byte *cullBits, idVec2 *texCoords,
 	}
 }
 
+/*
+============
+idSIMD_Generic::CullBounds
+
+  Sets bit i in cullBits when bounds[i] is completely at the front of at least
+  one of the planes. The bits are packed in 32 bit words, ( numBounds + 31 ) >> 5
+  words are written with the unused bits of the last word cleared.
+  Returns the number of culled bounds.
+============
+*/
+int VPCALL idSIMD_Generic::CullBounds( dword *cullBits, const idPlane *planes, const int numPlanes, const idBounds *bounds, const int numBounds ) {
+	int i, j, numCulled;
+	dword bits;
+
+	numCulled = 0;
+	bits = 0;
+
+	for ( i = 0; i < numBounds; i++ ) {
+		const idBounds &b = bounds[i];
+
+		for ( j = 0; j < numPlanes; j++ ) {
+			const idPlane &p = planes[j];
+			// test the corner furthest towards the back of the plane
+			float x = ( p[0] >= 0.0f ) ? b[0][0] : b[1][0];
+			float y = ( p[1] >= 0.0f ) ? b[0][1] : b[1][1];
+			float z = ( p[2] >= 0.0f ) ? b[0][2] : b[1][2];
+			if ( p[0] * x + p[1] * y + p[2] * z + p[3] > 0.0f ) {
+				bits |= (dword)1 << ( i & 31 );
+				numCulled++;
+				break;
+			}
+		}
+
+		if ( ( i & 31 ) == 31 ) {
+			cullBits[i >> 5] = bits;
+			bits = 0;
+		}
+	}
+	if ( i & 31 ) {
+		cullBits[i >> 5] = bits;
+	}
+
+	return numCulled;
+}
+
 /*
 ============
 idSIMD_Generic::DeriveTriPlanes
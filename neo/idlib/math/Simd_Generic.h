@@ -110,12 +110,18 @@ public:
 	virtual void VPCALL BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints );
 	virtual void VPCALL ConvertJointQuatsToJointMats( idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints );
 	virtual void VPCALL ConvertJointMatsToJointQuats( idJointQuat *jointQuats, const idJointMat *jointMats, const int numJoints );
+	virtual void VPCALL ConvertJointQuatsToSoA( idJointQuatSoA &soa, const idJointQuat *jointQuats, const int numJoints );
+	virtual void VPCALL ConvertSoAToJointQuats( idJointQuat *jointQuats, const idJointQuatSoA &soa, const int numJoints );
+	virtual void VPCALL BlendJointsSoA( idJointQuatSoA &joints, const idJointQuatSoA &blendJoints, const float lerp, const int numJoints );
+	virtual void VPCALL BlendJointsSoAFast( idJointQuatSoA &joints, const idJointQuatSoA &blendJoints, const float lerp, const int numJoints );
+	virtual void VPCALL ConvertSoAToJointMats( idJointMat *jointMats, const idJointQuatSoA &soa, const int numJoints );
 	virtual void VPCALL TransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint );
 	virtual void VPCALL UntransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint );
 	virtual void VPCALL TransformVerts( idDrawVert *verts, const int numVerts, const idJointMat *joints, const idVec4 *weights, const int *index, const int numWeights );
 	virtual void VPCALL TracePointCull( byte *cullBits, byte &totalOr, const float radius, const idPlane *planes, const idDrawVert *verts, const int numVerts );
 	virtual void VPCALL DecalPointCull( byte *cullBits, const idPlane *planes, const idDrawVert *verts, const int numVerts );
 	virtual void VPCALL OverlayPointCull( byte *cullBits, idVec2 *texCoords, const idPlane *planes, const idDrawVert *verts, const int numVerts );
+	virtual int  VPCALL CullBounds( dword *cullBits, const idPlane *planes, const int numPlanes, const idBounds *bounds, const int numBounds );
 	virtual void VPCALL DeriveTriPlanes( idPlane *planes, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes );
 	virtual void VPCALL DeriveTangents( idPlane *planes, idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes );
 	virtual void VPCALL DeriveUnsmoothedTangents( idDrawVert *verts, const dominantTri_s *dominantTris, const int numVerts );
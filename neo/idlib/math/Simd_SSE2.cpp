@@ -874,4 +874,3139 @@ void VPCALL idSIMD_SSE2::MixedSoundToSamples( short *samples, const float *mixBu
 	}
 }
 
-#endif /* _WIN32 */
+#elif defined(ID_SIMD_SSE2_INTRINSICS)
+
+#include <emmintrin.h>
+
+/*
+============
+idSIMD_SSE2::GetName
+============
+*/
+const char * idSIMD_SSE2::GetName( void ) const {
+	return "MMX & SSE & SSE2";
+}
+
+/*
+============
+LoadVec3_SSE2
+
+  Loads three floats without reading beyond the end of the vector, the fourth component is zero.
+============
+*/
+static ID_INLINE __m128 LoadVec3_SSE2( const float *src ) {
+	return _mm_movelh_ps( _mm_loadl_pi( _mm_setzero_ps(), (const __m64 *) src ), _mm_load_ss( src + 2 ) );
+}
+
+/*
+============
+StoreVec3_SSE2
+
+  Stores the first three components without touching the float that follows the vector.
+============
+*/
+static ID_INLINE void StoreVec3_SSE2( float *dst, const __m128 v ) {
+	_mm_storel_pi( (__m64 *) dst, v );
+	_mm_store_ss( dst + 2, _mm_movehl_ps( v, v ) );
+}
+
+/*
+============
+Deinterleave3_SSE2
+
+  Converts four consecutive idVec3 loaded into three registers into separate x, y and z registers.
+============
+*/
+static ID_INLINE void Deinterleave3_SSE2( const __m128 a, const __m128 b, const __m128 c, __m128 &x, __m128 &y, __m128 &z ) {
+	x = _mm_shuffle_ps( a, _mm_shuffle_ps( b, c, _MM_SHUFFLE( 1, 1, 2, 2 ) ), _MM_SHUFFLE( 2, 0, 3, 0 ) );
+	y = _mm_shuffle_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 0, 0, 1, 1 ) ), _mm_shuffle_ps( b, c, _MM_SHUFFLE( 2, 2, 3, 3 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) );
+	z = _mm_shuffle_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 1, 1, 2, 2 ) ), c, _MM_SHUFFLE( 3, 0, 2, 0 ) );
+}
+
+/*
+============
+HorizontalSum_SSE2
+============
+*/
+static ID_INLINE float HorizontalSum_SSE2( const __m128 v ) {
+	__m128 t = _mm_add_ps( v, _mm_movehl_ps( v, v ) );
+	t = _mm_add_ss( t, _mm_shuffle_ps( t, t, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	return _mm_cvtss_f32( t );
+}
+
+/*
+============
+RSqrt_SSE2
+
+  Reciprocal square root estimate refined with one Newton-Raphson iteration.
+  Like idMath::RSqrt this returns a huge number instead of infinity when x == 0.0
+============
+*/
+static ID_INLINE __m128 RSqrt_SSE2( __m128 x ) {
+	x = _mm_max_ps( x, _mm_set1_ps( 1e-30f ) );
+	__m128 r = _mm_rsqrt_ps( x );
+	__m128 y = _mm_mul_ps( _mm_mul_ps( x, r ), r );
+	return _mm_mul_ps( _mm_mul_ps( _mm_set1_ps( 0.5f ), r ), _mm_sub_ps( _mm_set1_ps( 3.0f ), y ) );
+}
+
+/*
+============
+SignBits_SSE2
+
+  Returns the sign bit of each float as an integer 0 or 1 shifted left by the given number of bits.
+============
+*/
+static ID_INLINE __m128i SignBits_SSE2( const __m128 v, const int shift ) {
+	return _mm_sll_epi32( _mm_srli_epi32( _mm_castps_si128( v ), 31 ), _mm_cvtsi32_si128( shift ) );
+}
+
+/*
+============
+StoreBytes_SSE2
+
+  Stores the low byte of four integers.
+============
+*/
+static ID_INLINE void StoreBytes_SSE2( byte *dst, const __m128i v ) {
+	__m128i b = _mm_packs_epi32( v, v );
+	b = _mm_packus_epi16( b, b );
+	*(int *) dst = _mm_cvtsi128_si32( b );
+}
+
+/*
+============
+Dot_SSE2
+============
+*/
+static ID_INLINE float Dot_SSE2( const float *src1, const float *src2, const int count ) {
+	__m128 s0 = _mm_setzero_ps();
+	__m128 s1 = _mm_setzero_ps();
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		s0 = _mm_add_ps( s0, _mm_mul_ps( _mm_loadu_ps( src1 + i + 0 ), _mm_loadu_ps( src2 + i + 0 ) ) );
+		s1 = _mm_add_ps( s1, _mm_mul_ps( _mm_loadu_ps( src1 + i + 4 ), _mm_loadu_ps( src2 + i + 4 ) ) );
+	}
+	if ( i + 4 <= count ) {
+		s0 = _mm_add_ps( s0, _mm_mul_ps( _mm_loadu_ps( src1 + i ), _mm_loadu_ps( src2 + i ) ) );
+		i += 4;
+	}
+	float sum = HorizontalSum_SSE2( _mm_add_ps( s0, s1 ) );
+	for ( ; i < count; i++ ) {
+		sum += src1[i] * src2[i];
+	}
+	return sum;
+}
+
+/*
+============
+MulAddRow_SSE2
+
+  dst[i] += constant * src[i];
+============
+*/
+static ID_INLINE void MulAddRow_SSE2( float *dst, const float constant, const float *src, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_loadu_ps( dst + i ), _mm_mul_ps( c, _mm_loadu_ps( src + i ) ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] += constant * src[i];
+	}
+}
+
+/*
+============
+MulRow_SSE2
+
+  dst[i] = constant * src[i];
+============
+*/
+static ID_INLINE void MulRow_SSE2( float *dst, const float constant, const float *src, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_mul_ps( c, _mm_loadu_ps( src + i ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i];
+	}
+}
+
+// applies VECOP to four floats at a time and SCALAROP to the remaining floats
+#define LOOP4_SSE2( VECOP, SCALAROP )		{ int _IX; for ( _IX = 0; _IX + 4 <= count; _IX += 4 ) { VECOP( _IX ); } for ( ; _IX < count; _IX++ ) { SCALAROP( _IX ); } }
+
+/*
+============
+idSIMD_SSE2::Add
+
+  dst[i] = constant + src[i];
+============
+*/
+void VPCALL idSIMD_SSE2::Add( float *dst, const float constant, const float *src, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_add_ps( _mm_loadu_ps( src + (X) ), c ) );
+#define OPER(X) dst[(X)] = src[(X)] + constant;
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Add
+
+  dst[i] = src0[i] + src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2::Add( float *dst, const float *src0, const float *src1, const int count ) {
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_add_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) );
+#define OPER(X) dst[(X)] = src0[(X)] + src1[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Sub
+
+  dst[i] = constant - src[i];
+============
+*/
+void VPCALL idSIMD_SSE2::Sub( float *dst, const float constant, const float *src, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_sub_ps( c, _mm_loadu_ps( src + (X) ) ) );
+#define OPER(X) dst[(X)] = constant - src[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Sub
+
+  dst[i] = src0[i] - src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2::Sub( float *dst, const float *src0, const float *src1, const int count ) {
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_sub_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) );
+#define OPER(X) dst[(X)] = src0[(X)] - src1[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Mul
+
+  dst[i] = constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE2::Mul( float *dst, const float constant, const float *src, const int count ) {
+	MulRow_SSE2( dst, constant, src, count );
+}
+
+/*
+============
+idSIMD_SSE2::Mul
+
+  dst[i] = src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2::Mul( float *dst, const float *src0, const float *src1, const int count ) {
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_mul_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) );
+#define OPER(X) dst[(X)] = src0[(X)] * src1[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Div
+
+  dst[i] = constant / divisor[i];
+============
+*/
+void VPCALL idSIMD_SSE2::Div( float *dst, const float constant, const float *divisor, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_div_ps( c, _mm_loadu_ps( divisor + (X) ) ) );
+#define OPER(X) dst[(X)] = constant / divisor[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Div
+
+  dst[i] = src0[i] / src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2::Div( float *dst, const float *src0, const float *src1, const int count ) {
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_div_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) );
+#define OPER(X) dst[(X)] = src0[(X)] / src1[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::MulAdd
+
+  dst[i] += constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE2::MulAdd( float *dst, const float constant, const float *src, const int count ) {
+	MulAddRow_SSE2( dst, constant, src, count );
+}
+
+/*
+============
+idSIMD_SSE2::MulAdd
+
+  dst[i] += src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2::MulAdd( float *dst, const float *src0, const float *src1, const int count ) {
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_add_ps( _mm_loadu_ps( dst + (X) ), _mm_mul_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) ) );
+#define OPER(X) dst[(X)] += src0[(X)] * src1[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::MulSub
+
+  dst[i] -= constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE2::MulSub( float *dst, const float constant, const float *src, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_sub_ps( _mm_loadu_ps( dst + (X) ), _mm_mul_ps( c, _mm_loadu_ps( src + (X) ) ) ) );
+#define OPER(X) dst[(X)] -= constant * src[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::MulSub
+
+  dst[i] -= src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2::MulSub( float *dst, const float *src0, const float *src1, const int count ) {
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_sub_ps( _mm_loadu_ps( dst + (X) ), _mm_mul_ps( _mm_loadu_ps( src0 + (X) ), _mm_loadu_ps( src1 + (X) ) ) ) );
+#define OPER(X) dst[(X)] -= src0[(X)] * src1[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Dot
+
+  dst[i] = constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE2::Dot( float *dst, const idVec3 &constant, const idVec3 *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		const float *s = src[i].ToFloatPtr();
+		__m128 x, y, z;
+		Deinterleave3_SSE2( _mm_loadu_ps( s + 0 ), _mm_loadu_ps( s + 4 ), _mm_loadu_ps( s + 8 ), x, y, z );
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE2::Dot
+
+  dst[i] = constant * src[i].Normal() + src[i][3];
+============
+*/
+void VPCALL idSIMD_SSE2::Dot( float *dst, const idVec3 &constant, const idPlane *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x = _mm_loadu_ps( src[i+0].ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( src[i+1].ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( src[i+2].ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( src[i+3].ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) ), w ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i].Normal() + src[i][3];
+	}
+}
+
+/*
+============
+idSIMD_SSE2::Dot
+
+  dst[i] = constant * src[i].xyz;
+============
+*/
+void VPCALL idSIMD_SSE2::Dot( float *dst, const idVec3 &constant, const idDrawVert *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	int i;
+
+	// the fourth float loaded with each position is st[0] and is ignored
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x = _mm_loadu_ps( src[i+0].xyz.ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( src[i+1].xyz.ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( src[i+2].xyz.ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( src[i+3].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i].xyz;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::Dot
+
+  dst[i] = constant.Normal() * src[i] + constant[3];
+============
+*/
+void VPCALL idSIMD_SSE2::Dot( float *dst, const idPlane &constant, const idVec3 *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	const __m128 cw = _mm_set1_ps( constant[3] );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		const float *s = src[i].ToFloatPtr();
+		__m128 x, y, z;
+		Deinterleave3_SSE2( _mm_loadu_ps( s + 0 ), _mm_loadu_ps( s + 4 ), _mm_loadu_ps( s + 8 ), x, y, z );
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) ), cw ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant.Normal() * src[i] + constant[3];
+	}
+}
+
+/*
+============
+idSIMD_SSE2::Dot
+
+  dst[i] = constant.Normal() * src[i].Normal() + constant[3] * src[i][3];
+============
+*/
+void VPCALL idSIMD_SSE2::Dot( float *dst, const idPlane &constant, const idPlane *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	const __m128 cw = _mm_set1_ps( constant[3] );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x = _mm_loadu_ps( src[i+0].ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( src[i+1].ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( src[i+2].ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( src[i+3].ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) ), _mm_mul_ps( cw, w ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant.Normal() * src[i].Normal() + constant[3] * src[i][3];
+	}
+}
+
+/*
+============
+idSIMD_SSE2::Dot
+
+  dst[i] = constant.Normal() * src[i].xyz + constant[3];
+============
+*/
+void VPCALL idSIMD_SSE2::Dot( float *dst, const idPlane &constant, const idDrawVert *src, const int count ) {
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	const __m128 cw = _mm_set1_ps( constant[3] );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x = _mm_loadu_ps( src[i+0].xyz.ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( src[i+1].xyz.ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( src[i+2].xyz.ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( src[i+3].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) ), _mm_mul_ps( cz, z ) ), cw ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant.Normal() * src[i].xyz + constant[3];
+	}
+}
+
+/*
+============
+idSIMD_SSE2::Dot
+
+  dst[i] = src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE2::Dot( float *dst, const idVec3 *src0, const idVec3 *src1, const int count ) {
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		const float *s0 = src0[i].ToFloatPtr();
+		const float *s1 = src1[i].ToFloatPtr();
+		__m128 x0, y0, z0, x1, y1, z1;
+		Deinterleave3_SSE2( _mm_loadu_ps( s0 + 0 ), _mm_loadu_ps( s0 + 4 ), _mm_loadu_ps( s0 + 8 ), x0, y0, z0 );
+		Deinterleave3_SSE2( _mm_loadu_ps( s1 + 0 ), _mm_loadu_ps( s1 + 4 ), _mm_loadu_ps( s1 + 8 ), x1, y1, z1 );
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( x0, x1 ), _mm_mul_ps( y0, y1 ) ), _mm_mul_ps( z0, z1 ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src0[i] * src1[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE2::Dot
+
+  dot = src1[0] * src2[0] + src1[1] * src2[1] + src1[2] * src2[2] + ...
+============
+*/
+void VPCALL idSIMD_SSE2::Dot( float &dot, const float *src1, const float *src2, const int count ) {
+	dot = Dot_SSE2( src1, src2, count );
+}
+
+// compares sixteen floats at a time and converts the compare masks to bytes with the value 0 or 1
+#define COMPARE16_SSE2( SRC, CMP )		_mm_and_si128( _mm_packs_epi16( \
+			_mm_packs_epi32( _mm_castps_si128( CMP( _mm_loadu_ps( (SRC) + 0 ), c ) ), _mm_castps_si128( CMP( _mm_loadu_ps( (SRC) + 4 ), c ) ) ), \
+			_mm_packs_epi32( _mm_castps_si128( CMP( _mm_loadu_ps( (SRC) + 8 ), c ) ), _mm_castps_si128( CMP( _mm_loadu_ps( (SRC) + 12 ), c ) ) ) ), \
+			_mm_set1_epi8( 1 ) )
+
+#define COMPARECONSTANT_SSE2( DST, SRC0, CONSTANT, COUNT, CMP, OPER ) {										\
+	const __m128 c = _mm_set1_ps( CONSTANT );																\
+	int i;																									\
+	for ( i = 0; i + 16 <= COUNT; i += 16 ) {																\
+		_mm_storeu_si128( (__m128i *)( DST + i ), COMPARE16_SSE2( SRC0 + i, CMP ) );						\
+	}																										\
+	for ( ; i < COUNT; i++ ) {																				\
+		DST[i] = SRC0[i] OPER CONSTANT;																		\
+	}																										\
+}
+
+#define COMPAREBITCONSTANT_SSE2( DST, BITNUM, SRC0, CONSTANT, COUNT, CMP, OPER ) {							\
+	const __m128 c = _mm_set1_ps( CONSTANT );																\
+	const __m128i shift = _mm_cvtsi32_si128( BITNUM );														\
+	int i;																									\
+	for ( i = 0; i + 16 <= COUNT; i += 16 ) {																\
+		__m128i b = COMPARE16_SSE2( SRC0 + i, CMP );														\
+		b = _mm_sll_epi16( b, shift );																		\
+		_mm_storeu_si128( (__m128i *)( DST + i ), _mm_or_si128( _mm_loadu_si128( (__m128i *)( DST + i ) ), b ) );	\
+	}																										\
+	for ( ; i < COUNT; i++ ) {																				\
+		DST[i] |= ( SRC0[i] OPER CONSTANT ) << BITNUM;														\
+	}																										\
+}
+
+/*
+============
+idSIMD_SSE2::CmpGT
+
+  dst[i] = src0[i] > constant;
+============
+*/
+void VPCALL idSIMD_SSE2::CmpGT( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARECONSTANT_SSE2( dst, src0, constant, count, _mm_cmpgt_ps, > )
+}
+
+/*
+============
+idSIMD_SSE2::CmpGT
+
+  dst[i] |= ( src0[i] > constant ) << bitNum;
+============
+*/
+void VPCALL idSIMD_SSE2::CmpGT( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPAREBITCONSTANT_SSE2( dst, bitNum, src0, constant, count, _mm_cmpgt_ps, > )
+}
+
+/*
+============
+idSIMD_SSE2::CmpGE
+
+  dst[i] = src0[i] >= constant;
+============
+*/
+void VPCALL idSIMD_SSE2::CmpGE( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARECONSTANT_SSE2( dst, src0, constant, count, _mm_cmpge_ps, >= )
+}
+
+/*
+============
+idSIMD_SSE2::CmpGE
+
+  dst[i] |= ( src0[i] >= constant ) << bitNum;
+============
+*/
+void VPCALL idSIMD_SSE2::CmpGE( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPAREBITCONSTANT_SSE2( dst, bitNum, src0, constant, count, _mm_cmpge_ps, >= )
+}
+
+/*
+============
+idSIMD_SSE2::CmpLT
+
+  dst[i] = src0[i] < constant;
+============
+*/
+void VPCALL idSIMD_SSE2::CmpLT( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARECONSTANT_SSE2( dst, src0, constant, count, _mm_cmplt_ps, < )
+}
+
+/*
+============
+idSIMD_SSE2::CmpLT
+
+  dst[i] |= ( src0[i] < constant ) << bitNum;
+============
+*/
+void VPCALL idSIMD_SSE2::CmpLT( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPAREBITCONSTANT_SSE2( dst, bitNum, src0, constant, count, _mm_cmplt_ps, < )
+}
+
+/*
+============
+idSIMD_SSE2::CmpLE
+
+  dst[i] = src0[i] <= constant;
+============
+*/
+void VPCALL idSIMD_SSE2::CmpLE( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARECONSTANT_SSE2( dst, src0, constant, count, _mm_cmple_ps, <= )
+}
+
+/*
+============
+idSIMD_SSE2::CmpLE
+
+  dst[i] |= ( src0[i] <= constant ) << bitNum;
+============
+*/
+void VPCALL idSIMD_SSE2::CmpLE( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPAREBITCONSTANT_SSE2( dst, bitNum, src0, constant, count, _mm_cmple_ps, <= )
+}
+
+/*
+============
+idSIMD_SSE2::MinMax
+============
+*/
+void VPCALL idSIMD_SSE2::MinMax( float &min, float &max, const float *src, const int count ) {
+	__m128 min4 = _mm_set1_ps( idMath::INFINITY );
+	__m128 max4 = _mm_set1_ps( -idMath::INFINITY );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 v = _mm_loadu_ps( src + i );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+	min4 = _mm_min_ps( min4, _mm_movehl_ps( min4, min4 ) );
+	max4 = _mm_max_ps( max4, _mm_movehl_ps( max4, max4 ) );
+	min4 = _mm_min_ss( min4, _mm_shuffle_ps( min4, min4, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	max4 = _mm_max_ss( max4, _mm_shuffle_ps( max4, max4, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	for ( ; i < count; i++ ) {
+		__m128 v = _mm_load_ss( src + i );
+		min4 = _mm_min_ss( min4, v );
+		max4 = _mm_max_ss( max4, v );
+	}
+	min = _mm_cvtss_f32( min4 );
+	max = _mm_cvtss_f32( max4 );
+}
+
+/*
+============
+idSIMD_SSE2::MinMax
+============
+*/
+void VPCALL idSIMD_SSE2::MinMax( idVec2 &min, idVec2 &max, const idVec2 *src, const int count ) {
+	__m128 min4 = _mm_set1_ps( idMath::INFINITY );
+	__m128 max4 = _mm_set1_ps( -idMath::INFINITY );
+	int i;
+
+	for ( i = 0; i + 2 <= count; i += 2 ) {
+		__m128 v = _mm_loadu_ps( src[i].ToFloatPtr() );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+	if ( i < count ) {
+		__m128 v = _mm_loadl_pi( _mm_set1_ps( idMath::INFINITY ), (const __m64 *) src[i].ToFloatPtr() );
+		min4 = _mm_min_ps( min4, v );
+		v = _mm_loadl_pi( _mm_set1_ps( -idMath::INFINITY ), (const __m64 *) src[i].ToFloatPtr() );
+		max4 = _mm_max_ps( max4, v );
+	}
+	min4 = _mm_min_ps( min4, _mm_movehl_ps( min4, min4 ) );
+	max4 = _mm_max_ps( max4, _mm_movehl_ps( max4, max4 ) );
+	_mm_storel_pi( (__m64 *) min.ToFloatPtr(), min4 );
+	_mm_storel_pi( (__m64 *) max.ToFloatPtr(), max4 );
+}
+
+/*
+============
+idSIMD_SSE2::MinMax
+============
+*/
+void VPCALL idSIMD_SSE2::MinMax( idVec3 &min, idVec3 &max, const idVec3 *src, const int count ) {
+	__m128 min4 = _mm_set1_ps( idMath::INFINITY );
+	__m128 max4 = _mm_set1_ps( -idMath::INFINITY );
+	int i;
+
+	// the fourth float loaded with each vector is the first component of the next vector
+	for ( i = 0; i + 2 <= count; i++ ) {
+		__m128 v = _mm_loadu_ps( src[i].ToFloatPtr() );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+	for ( ; i < count; i++ ) {
+		__m128 v = LoadVec3_SSE2( src[i].ToFloatPtr() );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+	StoreVec3_SSE2( min.ToFloatPtr(), min4 );
+	StoreVec3_SSE2( max.ToFloatPtr(), max4 );
+}
+
+/*
+============
+idSIMD_SSE2::MinMax
+============
+*/
+void VPCALL idSIMD_SSE2::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int count ) {
+	__m128 min0 = _mm_set1_ps( idMath::INFINITY );
+	__m128 max0 = _mm_set1_ps( -idMath::INFINITY );
+	__m128 min1 = min0;
+	__m128 max1 = max0;
+	int i;
+
+	// the fourth float loaded with each position is st[0] and is ignored
+	for ( i = 0; i + 2 <= count; i += 2 ) {
+		__m128 v0 = _mm_loadu_ps( src[i+0].xyz.ToFloatPtr() );
+		__m128 v1 = _mm_loadu_ps( src[i+1].xyz.ToFloatPtr() );
+		min0 = _mm_min_ps( min0, v0 );
+		max0 = _mm_max_ps( max0, v0 );
+		min1 = _mm_min_ps( min1, v1 );
+		max1 = _mm_max_ps( max1, v1 );
+	}
+	if ( i < count ) {
+		__m128 v0 = _mm_loadu_ps( src[i].xyz.ToFloatPtr() );
+		min0 = _mm_min_ps( min0, v0 );
+		max0 = _mm_max_ps( max0, v0 );
+	}
+	StoreVec3_SSE2( min.ToFloatPtr(), _mm_min_ps( min0, min1 ) );
+	StoreVec3_SSE2( max.ToFloatPtr(), _mm_max_ps( max0, max1 ) );
+}
+
+/*
+============
+idSIMD_SSE2::MinMax
+============
+*/
+void VPCALL idSIMD_SSE2::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int *indexes, const int count ) {
+	__m128 min0 = _mm_set1_ps( idMath::INFINITY );
+	__m128 max0 = _mm_set1_ps( -idMath::INFINITY );
+	__m128 min1 = min0;
+	__m128 max1 = max0;
+	int i;
+
+	for ( i = 0; i + 2 <= count; i += 2 ) {
+		__m128 v0 = _mm_loadu_ps( src[indexes[i+0]].xyz.ToFloatPtr() );
+		__m128 v1 = _mm_loadu_ps( src[indexes[i+1]].xyz.ToFloatPtr() );
+		min0 = _mm_min_ps( min0, v0 );
+		max0 = _mm_max_ps( max0, v0 );
+		min1 = _mm_min_ps( min1, v1 );
+		max1 = _mm_max_ps( max1, v1 );
+	}
+	if ( i < count ) {
+		__m128 v0 = _mm_loadu_ps( src[indexes[i]].xyz.ToFloatPtr() );
+		min0 = _mm_min_ps( min0, v0 );
+		max0 = _mm_max_ps( max0, v0 );
+	}
+	StoreVec3_SSE2( min.ToFloatPtr(), _mm_min_ps( min0, min1 ) );
+	StoreVec3_SSE2( max.ToFloatPtr(), _mm_max_ps( max0, max1 ) );
+}
+
+/*
+============
+idSIMD_SSE2::Clamp
+============
+*/
+void VPCALL idSIMD_SSE2::Clamp( float *dst, const float *src, const float min, const float max, const int count ) {
+	const __m128 mn = _mm_set1_ps( min );
+	const __m128 mx = _mm_set1_ps( max );
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_min_ps( _mm_max_ps( _mm_loadu_ps( src + (X) ), mn ), mx ) );
+#define OPER(X) dst[(X)] = src[(X)] < min ? min : src[(X)] > max ? max : src[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::ClampMin
+============
+*/
+void VPCALL idSIMD_SSE2::ClampMin( float *dst, const float *src, const float min, const int count ) {
+	const __m128 mn = _mm_set1_ps( min );
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_max_ps( _mm_loadu_ps( src + (X) ), mn ) );
+#define OPER(X) dst[(X)] = src[(X)] < min ? min : src[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::ClampMax
+============
+*/
+void VPCALL idSIMD_SSE2::ClampMax( float *dst, const float *src, const float max, const int count ) {
+	const __m128 mx = _mm_set1_ps( max );
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_min_ps( _mm_loadu_ps( src + (X) ), mx ) );
+#define OPER(X) dst[(X)] = src[(X)] > max ? max : src[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Zero16
+============
+*/
+void VPCALL idSIMD_SSE2::Zero16( float *dst, const int count ) {
+	const __m128 zero = _mm_setzero_ps();
+#define VECOP(X) _mm_storeu_ps( dst + (X), zero );
+#define OPER(X) dst[(X)] = 0.0f;
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Negate16
+============
+*/
+void VPCALL idSIMD_SSE2::Negate16( float *dst, const int count ) {
+	const __m128 signBit = _mm_set1_ps( -0.0f );
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_xor_ps( _mm_loadu_ps( dst + (X) ), signBit ) );
+#define OPER(X) dst[(X)] = -dst[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Copy16
+============
+*/
+void VPCALL idSIMD_SSE2::Copy16( float *dst, const float *src, const int count ) {
+#define VECOP(X) _mm_storeu_ps( dst + (X), _mm_loadu_ps( src + (X) ) );
+#define OPER(X) dst[(X)] = src[(X)];
+	LOOP4_SSE2( VECOP, OPER )
+#undef VECOP
+#undef OPER
+}
+
+/*
+============
+idSIMD_SSE2::Add16
+============
+*/
+void VPCALL idSIMD_SSE2::Add16( float *dst, const float *src1, const float *src2, const int count ) {
+	idSIMD_SSE2::Add( dst, src1, src2, count );
+}
+
+/*
+============
+idSIMD_SSE2::Sub16
+============
+*/
+void VPCALL idSIMD_SSE2::Sub16( float *dst, const float *src1, const float *src2, const int count ) {
+	idSIMD_SSE2::Sub( dst, src1, src2, count );
+}
+
+/*
+============
+idSIMD_SSE2::Mul16
+============
+*/
+void VPCALL idSIMD_SSE2::Mul16( float *dst, const float *src1, const float constant, const int count ) {
+	MulRow_SSE2( dst, constant, src1, count );
+}
+
+/*
+============
+idSIMD_SSE2::AddAssign16
+============
+*/
+void VPCALL idSIMD_SSE2::AddAssign16( float *dst, const float *src, const int count ) {
+	idSIMD_SSE2::Add( dst, dst, src, count );
+}
+
+/*
+============
+idSIMD_SSE2::SubAssign16
+============
+*/
+void VPCALL idSIMD_SSE2::SubAssign16( float *dst, const float *src, const int count ) {
+	idSIMD_SSE2::Sub( dst, dst, src, count );
+}
+
+/*
+============
+idSIMD_SSE2::MulAssign16
+============
+*/
+void VPCALL idSIMD_SSE2::MulAssign16( float *dst, const float constant, const int count ) {
+	MulRow_SSE2( dst, constant, dst, count );
+}
+
+
+/*
+============
+idSIMD_SSE2::MatX_MultiplyVecX
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_MultiplyVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	int i, numRows, numColumns;
+	const float *mPtr, *vPtr;
+	float *dstPtr;
+
+	assert( vec.GetSize() >= mat.GetNumColumns() );
+	assert( dst.GetSize() >= mat.GetNumRows() );
+
+	mPtr = mat.ToFloatPtr();
+	vPtr = vec.ToFloatPtr();
+	dstPtr = dst.ToFloatPtr();
+	numRows = mat.GetNumRows();
+	numColumns = mat.GetNumColumns();
+	for ( i = 0; i < numRows; i++ ) {
+		dstPtr[i] = Dot_SSE2( mPtr, vPtr, numColumns );
+		mPtr += numColumns;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_MultiplyAddVecX
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_MultiplyAddVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	int i, numRows, numColumns;
+	const float *mPtr, *vPtr;
+	float *dstPtr;
+
+	assert( vec.GetSize() >= mat.GetNumColumns() );
+	assert( dst.GetSize() >= mat.GetNumRows() );
+
+	mPtr = mat.ToFloatPtr();
+	vPtr = vec.ToFloatPtr();
+	dstPtr = dst.ToFloatPtr();
+	numRows = mat.GetNumRows();
+	numColumns = mat.GetNumColumns();
+	for ( i = 0; i < numRows; i++ ) {
+		dstPtr[i] += Dot_SSE2( mPtr, vPtr, numColumns );
+		mPtr += numColumns;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_MultiplySubVecX
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_MultiplySubVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	int i, numRows, numColumns;
+	const float *mPtr, *vPtr;
+	float *dstPtr;
+
+	assert( vec.GetSize() >= mat.GetNumColumns() );
+	assert( dst.GetSize() >= mat.GetNumRows() );
+
+	mPtr = mat.ToFloatPtr();
+	vPtr = vec.ToFloatPtr();
+	dstPtr = dst.ToFloatPtr();
+	numRows = mat.GetNumRows();
+	numColumns = mat.GetNumColumns();
+	for ( i = 0; i < numRows; i++ ) {
+		dstPtr[i] -= Dot_SSE2( mPtr, vPtr, numColumns );
+		mPtr += numColumns;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_TransposeMultiplyVecX
+
+  The rows of the matrix are scaled by the vector elements and summed.
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_TransposeMultiplyVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	int i, numRows, numColumns;
+	const float *mPtr, *vPtr;
+	float *dstPtr;
+
+	assert( vec.GetSize() >= mat.GetNumRows() );
+	assert( dst.GetSize() >= mat.GetNumColumns() );
+
+	mPtr = mat.ToFloatPtr();
+	vPtr = vec.ToFloatPtr();
+	dstPtr = dst.ToFloatPtr();
+	numRows = mat.GetNumRows();
+	numColumns = mat.GetNumColumns();
+	if ( numRows <= 0 ) {
+		memset( dstPtr, 0, numColumns * sizeof( float ) );
+		return;
+	}
+	MulRow_SSE2( dstPtr, vPtr[0], mPtr, numColumns );
+	for ( i = 1; i < numRows; i++ ) {
+		mPtr += numColumns;
+		MulAddRow_SSE2( dstPtr, vPtr[i], mPtr, numColumns );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_TransposeMultiplyAddVecX
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_TransposeMultiplyAddVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	int i, numRows, numColumns;
+	const float *mPtr, *vPtr;
+	float *dstPtr;
+
+	assert( vec.GetSize() >= mat.GetNumRows() );
+	assert( dst.GetSize() >= mat.GetNumColumns() );
+
+	mPtr = mat.ToFloatPtr();
+	vPtr = vec.ToFloatPtr();
+	dstPtr = dst.ToFloatPtr();
+	numRows = mat.GetNumRows();
+	numColumns = mat.GetNumColumns();
+	for ( i = 0; i < numRows; i++ ) {
+		MulAddRow_SSE2( dstPtr, vPtr[i], mPtr, numColumns );
+		mPtr += numColumns;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_TransposeMultiplySubVecX
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_TransposeMultiplySubVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	int i, numRows, numColumns;
+	const float *mPtr, *vPtr;
+	float *dstPtr;
+
+	assert( vec.GetSize() >= mat.GetNumRows() );
+	assert( dst.GetSize() >= mat.GetNumColumns() );
+
+	mPtr = mat.ToFloatPtr();
+	vPtr = vec.ToFloatPtr();
+	dstPtr = dst.ToFloatPtr();
+	numRows = mat.GetNumRows();
+	numColumns = mat.GetNumColumns();
+	for ( i = 0; i < numRows; i++ ) {
+		MulAddRow_SSE2( dstPtr, -vPtr[i], mPtr, numColumns );
+		mPtr += numColumns;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_MultiplyMatX
+
+  Each row of the result is the sum of the rows of m2 scaled by the elements of the same row of m1.
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_MultiplyMatX( idMatX &dst, const idMatX &m1, const idMatX &m2 ) {
+	int i, j, k, l, n;
+	float *dstPtr;
+	const float *m1Ptr, *m2Ptr;
+
+	assert( m1.GetNumColumns() == m2.GetNumRows() );
+
+	dstPtr = dst.ToFloatPtr();
+	m1Ptr = m1.ToFloatPtr();
+	k = m1.GetNumRows();
+	l = m2.GetNumColumns();
+	n = m1.GetNumColumns();
+
+	for ( i = 0; i < k; i++ ) {
+		m2Ptr = m2.ToFloatPtr();
+		if ( n > 0 ) {
+			MulRow_SSE2( dstPtr, m1Ptr[0], m2Ptr, l );
+		} else {
+			memset( dstPtr, 0, l * sizeof( float ) );
+		}
+		for ( j = 1; j < n; j++ ) {
+			m2Ptr += l;
+			MulAddRow_SSE2( dstPtr, m1Ptr[j], m2Ptr, l );
+		}
+		m1Ptr += n;
+		dstPtr += l;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_TransposeMultiplyMatX
+
+  Each row of the result is the sum of the rows of m2 scaled by the elements of the same column of m1.
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_TransposeMultiplyMatX( idMatX &dst, const idMatX &m1, const idMatX &m2 ) {
+	int i, j, k, l, n;
+	float *dstPtr;
+	const float *m1Ptr, *m2Ptr;
+
+	assert( m1.GetNumRows() == m2.GetNumRows() );
+
+	dstPtr = dst.ToFloatPtr();
+	k = m1.GetNumColumns();
+	l = m2.GetNumColumns();
+	n = m1.GetNumRows();
+
+	for ( i = 0; i < k; i++ ) {
+		m1Ptr = m1.ToFloatPtr() + i;
+		m2Ptr = m2.ToFloatPtr();
+		if ( n > 0 ) {
+			MulRow_SSE2( dstPtr, m1Ptr[0], m2Ptr, l );
+		} else {
+			memset( dstPtr, 0, l * sizeof( float ) );
+		}
+		for ( j = 1; j < n; j++ ) {
+			m1Ptr += k;
+			m2Ptr += l;
+			MulAddRow_SSE2( dstPtr, m1Ptr[0], m2Ptr, l );
+		}
+		dstPtr += l;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_LowerTriangularSolve
+
+  solves x in Lx = b for the n * n sub-matrix of L
+  if skip > 0 the first skip elements of x are assumed to be valid already
+  L has to be a lower triangular matrix with (implicit) ones on the diagonal
+  x == b is allowed
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_LowerTriangularSolve( const idMatX &L, float *x, const float *b, const int n, int skip ) {
+	int i, nc;
+	const float *lptr;
+
+	if ( skip >= n ) {
+		return;
+	}
+
+	lptr = L.ToFloatPtr();
+	nc = L.GetNumColumns();
+
+	for ( i = skip; i < n; i++ ) {
+		x[i] = b[i] - Dot_SSE2( lptr + i * nc, x, i );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_LowerTriangularSolveTranspose
+
+  solves x in L'x = b for the n * n sub-matrix of L
+  L has to be a lower triangular matrix with (implicit) ones on the diagonal
+  x == b is allowed
+
+  Instead of walking down the columns of L each solved element is
+  substituted into the remaining equations along a row of L.
+============
+*/
+void VPCALL idSIMD_SSE2::MatX_LowerTriangularSolveTranspose( const idMatX &L, float *x, const float *b, const int n ) {
+	int i, nc;
+	const float *lptr;
+
+	if ( n <= 0 ) {
+		return;
+	}
+
+	lptr = L.ToFloatPtr();
+	nc = L.GetNumColumns();
+
+	if ( x != b ) {
+		memcpy( x, b, n * sizeof( float ) );
+	}
+	for ( i = n - 1; i > 0; i-- ) {
+		MulAddRow_SSE2( x, -x[i], lptr + i * nc, i );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MatX_LDLTFactor
+
+  in-place factorization LDL' of the n * n sub-matrix of mat
+  the reciprocal of the diagonal elements are stored in invDiag
+============
+*/
+bool VPCALL idSIMD_SSE2::MatX_LDLTFactor( idMatX &mat, idVecX &invDiag, const int n ) {
+	int i, j;
+	float *v, *diag, *mptr;
+	float sum, d;
+
+	if ( n <= 0 ) {
+		return true;
+	}
+
+	v = (float *) _alloca16( n * sizeof( float ) );
+	diag = (float *) _alloca16( n * sizeof( float ) );
+
+	for ( i = 0; i < n; i++ ) {
+
+		mptr = mat[i];
+
+		// v = diag * row, four elements at a time
+		for ( j = 0; j + 4 <= i; j += 4 ) {
+			_mm_storeu_ps( v + j, _mm_mul_ps( _mm_loadu_ps( diag + j ), _mm_loadu_ps( mptr + j ) ) );
+		}
+		for ( ; j < i; j++ ) {
+			v[j] = diag[j] * mptr[j];
+		}
+
+		sum = mptr[i] - Dot_SSE2( v, mptr, i );
+
+		if ( sum == 0.0f ) {
+			return false;
+		}
+
+		mptr[i] = sum;
+		diag[i] = sum;
+		invDiag[i] = d = 1.0f / sum;
+
+		for ( j = i + 1; j < n; j++ ) {
+			mptr = mat[j];
+			mptr[i] = ( mptr[i] - Dot_SSE2( mptr, v, i ) ) * d;
+		}
+	}
+
+	return true;
+}
+
+/*
+============
+Sin16_SSE2
+
+  Same polynomial as idMath::Sin16 for angles in the range [-PI/2, PI/2].
+============
+*/
+static ID_INLINE __m128 Sin16_SSE2( const __m128 a ) {
+	__m128 s = _mm_mul_ps( a, a );
+	__m128 r = _mm_set1_ps( -2.39e-08f );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 2.7526e-06f ) );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 1.98409e-04f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 8.3333315e-03f ) );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 1.666666664e-01f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 1.0f ) );
+	return _mm_mul_ps( a, r );
+}
+
+/*
+============
+ATan16_SSE2
+
+  Same polynomial as idMath::ATan16 for y >= 0 and x >= 0.
+============
+*/
+static ID_INLINE __m128 ATan16_SSE2( const __m128 y, const __m128 x ) {
+	__m128 swap = _mm_cmpgt_ps( y, x );
+	__m128 a = _mm_div_ps( _mm_min_ps( x, y ), _mm_max_ps( x, y ) );
+	__m128 s = _mm_mul_ps( a, a );
+	__m128 r = _mm_set1_ps( 0.0028662257f );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.0161657367f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.0429096138f ) );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.0752896400f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.1065626393f ) );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.1420889944f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.1999355085f ) );
+	r = _mm_sub_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.3333314528f ) );
+	r = _mm_mul_ps( _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 1.0f ) ), a );
+	return _mm_or_ps( _mm_and_ps( swap, _mm_sub_ps( _mm_set1_ps( idMath::HALF_PI ), r ) ), _mm_andnot_ps( swap, r ) );
+}
+
+/*
+============
+idSIMD_SSE2::BlendJoints
+
+  Four joints are blended at once with the same approximations as idQuat::Slerp.
+============
+*/
+void VPCALL idSIMD_SSE2::BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints ) {
+	int i, k;
+
+	if ( lerp <= 0.0f ) {
+		return;
+	} else if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			int j = index[i];
+			joints[j] = blendJoints[j];
+		}
+		return;
+	}
+
+	const __m128 signBit = _mm_set1_ps( -0.0f );
+	const __m128 one = _mm_set1_ps( 1.0f );
+	const __m128 t = _mm_set1_ps( lerp );
+	const __m128 invT = _mm_set1_ps( 1.0f - lerp );
+
+	for ( i = 0; i + 4 <= numJoints; i += 4 ) {
+		const int j0 = index[i+0];
+		const int j1 = index[i+1];
+		const int j2 = index[i+2];
+		const int j3 = index[i+3];
+
+		__m128 jx = _mm_loadu_ps( joints[j0].q.ToFloatPtr() );
+		__m128 jy = _mm_loadu_ps( joints[j1].q.ToFloatPtr() );
+		__m128 jz = _mm_loadu_ps( joints[j2].q.ToFloatPtr() );
+		__m128 jw = _mm_loadu_ps( joints[j3].q.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( jx, jy, jz, jw );
+
+		__m128 bx = _mm_loadu_ps( blendJoints[j0].q.ToFloatPtr() );
+		__m128 by = _mm_loadu_ps( blendJoints[j1].q.ToFloatPtr() );
+		__m128 bz = _mm_loadu_ps( blendJoints[j2].q.ToFloatPtr() );
+		__m128 bw = _mm_loadu_ps( blendJoints[j3].q.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( bx, by, bz, bw );
+
+		__m128 cosom = _mm_add_ps( _mm_add_ps( _mm_mul_ps( jx, bx ), _mm_mul_ps( jy, by ) ), _mm_add_ps( _mm_mul_ps( jz, bz ), _mm_mul_ps( jw, bw ) ) );
+
+		// take the shortest path
+		__m128 sign = _mm_and_ps( cosom, signBit );
+		cosom = _mm_xor_ps( cosom, sign );
+
+		__m128 scale0 = _mm_sub_ps( one, _mm_mul_ps( cosom, cosom ) );
+		__m128 sinom = RSqrt_SSE2( scale0 );
+		__m128 omega = ATan16_SSE2( _mm_mul_ps( scale0, sinom ), cosom );
+		scale0 = _mm_mul_ps( Sin16_SSE2( _mm_mul_ps( invT, omega ) ), sinom );
+		__m128 scale1 = _mm_mul_ps( Sin16_SSE2( _mm_mul_ps( t, omega ) ), sinom );
+
+		// linear interpolation for nearly identical rotations
+		__m128 linear = _mm_cmple_ps( _mm_sub_ps( one, cosom ), _mm_set1_ps( 1e-6f ) );
+		scale0 = _mm_or_ps( _mm_and_ps( linear, invT ), _mm_andnot_ps( linear, scale0 ) );
+		scale1 = _mm_or_ps( _mm_and_ps( linear, t ), _mm_andnot_ps( linear, scale1 ) );
+		scale1 = _mm_xor_ps( scale1, sign );
+
+		jx = _mm_add_ps( _mm_mul_ps( scale0, jx ), _mm_mul_ps( scale1, bx ) );
+		jy = _mm_add_ps( _mm_mul_ps( scale0, jy ), _mm_mul_ps( scale1, by ) );
+		jz = _mm_add_ps( _mm_mul_ps( scale0, jz ), _mm_mul_ps( scale1, bz ) );
+		jw = _mm_add_ps( _mm_mul_ps( scale0, jw ), _mm_mul_ps( scale1, bw ) );
+		_MM_TRANSPOSE4_PS( jx, jy, jz, jw );
+
+		_mm_storeu_ps( joints[j0].q.ToFloatPtr(), jx );
+		_mm_storeu_ps( joints[j1].q.ToFloatPtr(), jy );
+		_mm_storeu_ps( joints[j2].q.ToFloatPtr(), jz );
+		_mm_storeu_ps( joints[j3].q.ToFloatPtr(), jw );
+
+		for ( k = 0; k < 4; k++ ) {
+			idJointQuat &jq = joints[index[i+k]];
+			__m128 from = LoadVec3_SSE2( jq.t.ToFloatPtr() );
+			__m128 to = LoadVec3_SSE2( blendJoints[index[i+k]].t.ToFloatPtr() );
+			StoreVec3_SSE2( jq.t.ToFloatPtr(), _mm_add_ps( from, _mm_mul_ps( t, _mm_sub_ps( to, from ) ) ) );
+		}
+	}
+
+	for ( ; i < numJoints; i++ ) {
+		int j = index[i];
+		joints[j].q.Slerp( joints[j].q, blendJoints[j].q, lerp );
+		joints[j].t.Lerp( joints[j].t, blendJoints[j].t, lerp );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::ConvertJointQuatsToJointMats
+
+  Converts four joints at once with the quaternion components in separate registers.
+============
+*/
+void VPCALL idSIMD_SSE2::ConvertJointQuatsToJointMats( idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints ) {
+	int i, k;
+
+	assert( sizeof( idJointQuat ) == 7 * sizeof( float ) );
+	assert( sizeof( idJointMat ) == 12 * sizeof( float ) );
+
+	const __m128 one = _mm_set1_ps( 1.0f );
+
+	for ( i = 0; i + 4 <= numJoints; i += 4 ) {
+		const idJointQuat *jq = jointQuats + i;
+
+		__m128 x = _mm_loadu_ps( jq[0].q.ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( jq[1].q.ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( jq[2].q.ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( jq[3].q.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+
+		__m128 tx = LoadVec3_SSE2( jq[0].t.ToFloatPtr() );
+		__m128 ty = LoadVec3_SSE2( jq[1].t.ToFloatPtr() );
+		__m128 tz = LoadVec3_SSE2( jq[2].t.ToFloatPtr() );
+		__m128 tw = LoadVec3_SSE2( jq[3].t.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( tx, ty, tz, tw );
+
+		__m128 x2 = _mm_add_ps( x, x );
+		__m128 y2 = _mm_add_ps( y, y );
+		__m128 z2 = _mm_add_ps( z, z );
+
+		__m128 xx = _mm_mul_ps( x, x2 );
+		__m128 xy = _mm_mul_ps( x, y2 );
+		__m128 xz = _mm_mul_ps( x, z2 );
+
+		__m128 yy = _mm_mul_ps( y, y2 );
+		__m128 yz = _mm_mul_ps( y, z2 );
+		__m128 zz = _mm_mul_ps( z, z2 );
+
+		__m128 wx = _mm_mul_ps( w, x2 );
+		__m128 wy = _mm_mul_ps( w, y2 );
+		__m128 wz = _mm_mul_ps( w, z2 );
+
+		// rows of the joint matrices with one joint per register lane
+		__m128 r0 = _mm_sub_ps( one, _mm_add_ps( yy, zz ) );
+		__m128 r1 = _mm_add_ps( xy, wz );
+		__m128 r2 = _mm_sub_ps( xz, wy );
+		__m128 r3 = tx;
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+		_mm_storeu_ps( jointMats[i+0].ToFloatPtr() + 0, r0 );
+		_mm_storeu_ps( jointMats[i+1].ToFloatPtr() + 0, r1 );
+		_mm_storeu_ps( jointMats[i+2].ToFloatPtr() + 0, r2 );
+		_mm_storeu_ps( jointMats[i+3].ToFloatPtr() + 0, r3 );
+
+		r0 = _mm_sub_ps( xy, wz );
+		r1 = _mm_sub_ps( one, _mm_add_ps( xx, zz ) );
+		r2 = _mm_add_ps( yz, wx );
+		r3 = ty;
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+		_mm_storeu_ps( jointMats[i+0].ToFloatPtr() + 4, r0 );
+		_mm_storeu_ps( jointMats[i+1].ToFloatPtr() + 4, r1 );
+		_mm_storeu_ps( jointMats[i+2].ToFloatPtr() + 4, r2 );
+		_mm_storeu_ps( jointMats[i+3].ToFloatPtr() + 4, r3 );
+
+		r0 = _mm_add_ps( xz, wy );
+		r1 = _mm_sub_ps( yz, wx );
+		r2 = _mm_sub_ps( one, _mm_add_ps( xx, yy ) );
+		r3 = tz;
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+		_mm_storeu_ps( jointMats[i+0].ToFloatPtr() + 8, r0 );
+		_mm_storeu_ps( jointMats[i+1].ToFloatPtr() + 8, r1 );
+		_mm_storeu_ps( jointMats[i+2].ToFloatPtr() + 8, r2 );
+		_mm_storeu_ps( jointMats[i+3].ToFloatPtr() + 8, r3 );
+	}
+
+	for ( k = i; k < numJoints; k++ ) {
+		jointMats[k].SetRotation( jointQuats[k].q.ToMat3() );
+		jointMats[k].SetTranslation( jointQuats[k].t );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::ConvertJointMatsToJointQuats
+
+  Converts four joints at once. All four cases of idJointMat::ToJointQuat
+  are evaluated and the one the scalar code would pick is selected per joint.
+============
+*/
+void VPCALL idSIMD_SSE2::ConvertJointMatsToJointQuats( idJointQuat *jointQuats, const idJointMat *jointMats, const int numJoints ) {
+	int i, k;
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps( 1.0f );
+	const __m128 half = _mm_set1_ps( 0.5f );
+
+#define SELECT_SSE2( mask, a, b )	_mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) )
+
+	for ( i = 0; i + 4 <= numJoints; i += 4 ) {
+		const float *m0 = jointMats[i+0].ToFloatPtr();
+		const float *m1 = jointMats[i+1].ToFloatPtr();
+		const float *m2 = jointMats[i+2].ToFloatPtr();
+		const float *m3 = jointMats[i+3].ToFloatPtr();
+
+		__m128 m00 = _mm_loadu_ps( m0 + 0 );
+		__m128 m01 = _mm_loadu_ps( m1 + 0 );
+		__m128 m02 = _mm_loadu_ps( m2 + 0 );
+		__m128 t0 = _mm_loadu_ps( m3 + 0 );
+		_MM_TRANSPOSE4_PS( m00, m01, m02, t0 );
+
+		__m128 m10 = _mm_loadu_ps( m0 + 4 );
+		__m128 m11 = _mm_loadu_ps( m1 + 4 );
+		__m128 m12 = _mm_loadu_ps( m2 + 4 );
+		__m128 t1 = _mm_loadu_ps( m3 + 4 );
+		_MM_TRANSPOSE4_PS( m10, m11, m12, t1 );
+
+		__m128 m20 = _mm_loadu_ps( m0 + 8 );
+		__m128 m21 = _mm_loadu_ps( m1 + 8 );
+		__m128 m22 = _mm_loadu_ps( m2 + 8 );
+		__m128 t2 = _mm_loadu_ps( m3 + 8 );
+		_MM_TRANSPOSE4_PS( m20, m21, m22, t2 );
+
+		// pick the same case as the scalar code
+		__m128 trace = _mm_add_ps( _mm_add_ps( m00, m11 ), m22 );
+		__m128 caseW = _mm_cmpgt_ps( trace, zero );
+		__m128 caseY = _mm_cmpgt_ps( m11, m00 );
+		__m128 caseZ = _mm_andnot_ps( caseW, _mm_cmpgt_ps( m22, SELECT_SSE2( caseY, m11, m00 ) ) );
+		caseY = _mm_andnot_ps( caseW, _mm_andnot_ps( caseZ, caseY ) );
+		__m128 caseX = _mm_andnot_ps( caseW, _mm_andnot_ps( caseY, _mm_andnot_ps( caseZ, _mm_cmpeq_ps( zero, zero ) ) ) );
+
+		__m128 tW = _mm_add_ps( trace, one );
+		__m128 tX = _mm_add_ps( _mm_sub_ps( m00, _mm_add_ps( m11, m22 ) ), one );
+		__m128 tY = _mm_add_ps( _mm_sub_ps( m11, _mm_add_ps( m22, m00 ) ), one );
+		__m128 tZ = _mm_add_ps( _mm_sub_ps( m22, _mm_add_ps( m00, m11 ) ), one );
+		__m128 t = SELECT_SSE2( caseW, tW, SELECT_SSE2( caseX, tX, SELECT_SSE2( caseY, tY, tZ ) ) );
+		__m128 s = _mm_mul_ps( RSqrt_SSE2( t ), half );
+
+		__m128 a = _mm_sub_ps( m12, m21 );
+		__m128 b = _mm_sub_ps( m20, m02 );
+		__m128 c = _mm_sub_ps( m01, m10 );
+		__m128 d = _mm_add_ps( m01, m10 );
+		__m128 e = _mm_add_ps( m02, m20 );
+		__m128 f = _mm_add_ps( m12, m21 );
+
+		__m128 qx = _mm_mul_ps( SELECT_SSE2( caseW, a, SELECT_SSE2( caseX, t, SELECT_SSE2( caseY, d, e ) ) ), s );
+		__m128 qy = _mm_mul_ps( SELECT_SSE2( caseW, b, SELECT_SSE2( caseX, d, SELECT_SSE2( caseY, t, f ) ) ), s );
+		__m128 qz = _mm_mul_ps( SELECT_SSE2( caseW, c, SELECT_SSE2( caseX, e, SELECT_SSE2( caseY, f, t ) ) ), s );
+		__m128 qw = _mm_mul_ps( SELECT_SSE2( caseW, t, SELECT_SSE2( caseX, a, SELECT_SSE2( caseY, b, c ) ) ), s );
+		_MM_TRANSPOSE4_PS( qx, qy, qz, qw );
+
+		__m128 tw = zero;
+		_MM_TRANSPOSE4_PS( t0, t1, t2, tw );
+
+		_mm_storeu_ps( jointQuats[i+0].q.ToFloatPtr(), qx );
+		_mm_storeu_ps( jointQuats[i+1].q.ToFloatPtr(), qy );
+		_mm_storeu_ps( jointQuats[i+2].q.ToFloatPtr(), qz );
+		_mm_storeu_ps( jointQuats[i+3].q.ToFloatPtr(), qw );
+
+		StoreVec3_SSE2( jointQuats[i+0].t.ToFloatPtr(), t0 );
+		StoreVec3_SSE2( jointQuats[i+1].t.ToFloatPtr(), t1 );
+		StoreVec3_SSE2( jointQuats[i+2].t.ToFloatPtr(), t2 );
+		StoreVec3_SSE2( jointQuats[i+3].t.ToFloatPtr(), tw );
+	}
+
+#undef SELECT_SSE2
+
+	for ( k = i; k < numJoints; k++ ) {
+		jointQuats[k] = jointMats[k].ToJointQuat();
+	}
+}
+
+/*
+============
+idSIMD_SSE2::ConvertJointQuatsToSoA
+============
+*/
+void VPCALL idSIMD_SSE2::ConvertJointQuatsToSoA( idJointQuatSoA &soa, const idJointQuat *jointQuats, const int numJoints ) {
+	int i;
+
+	assert( numJoints <= soa.Num() );
+
+	for ( i = 0; i + 4 <= numJoints; i += 4 ) {
+		const idJointQuat *jq = jointQuats + i;
+
+		__m128 x = _mm_loadu_ps( jq[0].q.ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( jq[1].q.ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( jq[2].q.ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( jq[3].q.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+
+		__m128 tx = LoadVec3_SSE2( jq[0].t.ToFloatPtr() );
+		__m128 ty = LoadVec3_SSE2( jq[1].t.ToFloatPtr() );
+		__m128 tz = LoadVec3_SSE2( jq[2].t.ToFloatPtr() );
+		__m128 tw = LoadVec3_SSE2( jq[3].t.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( tx, ty, tz, tw );
+
+		_mm_store_ps( soa.x + i, x );
+		_mm_store_ps( soa.y + i, y );
+		_mm_store_ps( soa.z + i, z );
+		_mm_store_ps( soa.w + i, w );
+		_mm_store_ps( soa.tx + i, tx );
+		_mm_store_ps( soa.ty + i, ty );
+		_mm_store_ps( soa.tz + i, tz );
+	}
+
+	for ( ; i < numJoints; i++ ) {
+		soa.SetJoint( i, jointQuats[i] );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::ConvertSoAToJointQuats
+============
+*/
+void VPCALL idSIMD_SSE2::ConvertSoAToJointQuats( idJointQuat *jointQuats, const idJointQuatSoA &soa, const int numJoints ) {
+	int i;
+
+	assert( numJoints <= soa.Num() );
+
+	for ( i = 0; i + 4 <= numJoints; i += 4 ) {
+		idJointQuat *jq = jointQuats + i;
+
+		__m128 x = _mm_load_ps( soa.x + i );
+		__m128 y = _mm_load_ps( soa.y + i );
+		__m128 z = _mm_load_ps( soa.z + i );
+		__m128 w = _mm_load_ps( soa.w + i );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+
+		__m128 tx = _mm_load_ps( soa.tx + i );
+		__m128 ty = _mm_load_ps( soa.ty + i );
+		__m128 tz = _mm_load_ps( soa.tz + i );
+		__m128 tw = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( tx, ty, tz, tw );
+
+		_mm_storeu_ps( jq[0].q.ToFloatPtr(), x );
+		_mm_storeu_ps( jq[1].q.ToFloatPtr(), y );
+		_mm_storeu_ps( jq[2].q.ToFloatPtr(), z );
+		_mm_storeu_ps( jq[3].q.ToFloatPtr(), w );
+
+		StoreVec3_SSE2( jq[0].t.ToFloatPtr(), tx );
+		StoreVec3_SSE2( jq[1].t.ToFloatPtr(), ty );
+		StoreVec3_SSE2( jq[2].t.ToFloatPtr(), tz );
+		StoreVec3_SSE2( jq[3].t.ToFloatPtr(), tw );
+	}
+
+	for ( ; i < numJoints; i++ ) {
+		jointQuats[i] = soa.GetJoint( i );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::BlendJointsSoA
+
+  Same approximations as idSIMD_SSE2::BlendJoints but the joints are loaded straight from the streams.
+  When all joints are blended the padding is blended along with them so there is no scalar tail.
+============
+*/
+void VPCALL idSIMD_SSE2::BlendJointsSoA( idJointQuatSoA &joints, const idJointQuatSoA &blendJoints, const float lerp, const int numJoints ) {
+	int i, count;
+
+	assert( numJoints <= joints.Num() && numJoints <= blendJoints.Num() );
+
+	if ( lerp <= 0.0f ) {
+		return;
+	} else if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			joints.SetJoint( i, blendJoints.GetJoint( i ) );
+		}
+		return;
+	}
+
+	const __m128 signBit = _mm_set1_ps( -0.0f );
+	const __m128 one = _mm_set1_ps( 1.0f );
+	const __m128 t = _mm_set1_ps( lerp );
+	const __m128 invT = _mm_set1_ps( 1.0f - lerp );
+
+	count = ( numJoints == joints.Num() ) ? JOINTQUATSOA_PAD( numJoints ) : ( numJoints & ~3 );
+
+	for ( i = 0; i < count; i += 4 ) {
+		__m128 jx = _mm_load_ps( joints.x + i );
+		__m128 jy = _mm_load_ps( joints.y + i );
+		__m128 jz = _mm_load_ps( joints.z + i );
+		__m128 jw = _mm_load_ps( joints.w + i );
+
+		__m128 bx = _mm_load_ps( blendJoints.x + i );
+		__m128 by = _mm_load_ps( blendJoints.y + i );
+		__m128 bz = _mm_load_ps( blendJoints.z + i );
+		__m128 bw = _mm_load_ps( blendJoints.w + i );
+
+		__m128 cosom = _mm_add_ps( _mm_add_ps( _mm_mul_ps( jx, bx ), _mm_mul_ps( jy, by ) ), _mm_add_ps( _mm_mul_ps( jz, bz ), _mm_mul_ps( jw, bw ) ) );
+
+		// take the shortest path
+		__m128 sign = _mm_and_ps( cosom, signBit );
+		cosom = _mm_xor_ps( cosom, sign );
+
+		__m128 scale0 = _mm_sub_ps( one, _mm_mul_ps( cosom, cosom ) );
+		__m128 sinom = RSqrt_SSE2( scale0 );
+		__m128 omega = ATan16_SSE2( _mm_mul_ps( scale0, sinom ), cosom );
+		scale0 = _mm_mul_ps( Sin16_SSE2( _mm_mul_ps( invT, omega ) ), sinom );
+		__m128 scale1 = _mm_mul_ps( Sin16_SSE2( _mm_mul_ps( t, omega ) ), sinom );
+
+		// linear interpolation for nearly identical rotations
+		__m128 linear = _mm_cmple_ps( _mm_sub_ps( one, cosom ), _mm_set1_ps( 1e-6f ) );
+		scale0 = _mm_or_ps( _mm_and_ps( linear, invT ), _mm_andnot_ps( linear, scale0 ) );
+		scale1 = _mm_or_ps( _mm_and_ps( linear, t ), _mm_andnot_ps( linear, scale1 ) );
+		scale1 = _mm_xor_ps( scale1, sign );
+
+		_mm_store_ps( joints.x + i, _mm_add_ps( _mm_mul_ps( scale0, jx ), _mm_mul_ps( scale1, bx ) ) );
+		_mm_store_ps( joints.y + i, _mm_add_ps( _mm_mul_ps( scale0, jy ), _mm_mul_ps( scale1, by ) ) );
+		_mm_store_ps( joints.z + i, _mm_add_ps( _mm_mul_ps( scale0, jz ), _mm_mul_ps( scale1, bz ) ) );
+		_mm_store_ps( joints.w + i, _mm_add_ps( _mm_mul_ps( scale0, jw ), _mm_mul_ps( scale1, bw ) ) );
+
+		__m128 tx = _mm_load_ps( joints.tx + i );
+		__m128 ty = _mm_load_ps( joints.ty + i );
+		__m128 tz = _mm_load_ps( joints.tz + i );
+		_mm_store_ps( joints.tx + i, _mm_add_ps( tx, _mm_mul_ps( t, _mm_sub_ps( _mm_load_ps( blendJoints.tx + i ), tx ) ) ) );
+		_mm_store_ps( joints.ty + i, _mm_add_ps( ty, _mm_mul_ps( t, _mm_sub_ps( _mm_load_ps( blendJoints.ty + i ), ty ) ) ) );
+		_mm_store_ps( joints.tz + i, _mm_add_ps( tz, _mm_mul_ps( t, _mm_sub_ps( _mm_load_ps( blendJoints.tz + i ), tz ) ) ) );
+	}
+
+	for ( ; i < numJoints; i++ ) {
+		idJointQuat joint = joints.GetJoint( i );
+		idJointQuat blendJoint = blendJoints.GetJoint( i );
+		joint.q.Slerp( joint.q, blendJoint.q, lerp );
+		joint.t.Lerp( joint.t, blendJoint.t, lerp );
+		joints.SetJoint( i, joint );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::BlendJointsSoAFast
+
+  Normalized linear interpolation of the rotations, only accurate for small angles.
+============
+*/
+void VPCALL idSIMD_SSE2::BlendJointsSoAFast( idJointQuatSoA &joints, const idJointQuatSoA &blendJoints, const float lerp, const int numJoints ) {
+	int i, count;
+
+	assert( numJoints <= joints.Num() && numJoints <= blendJoints.Num() );
+
+	if ( lerp <= 0.0f ) {
+		return;
+	} else if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			joints.SetJoint( i, blendJoints.GetJoint( i ) );
+		}
+		return;
+	}
+
+	const __m128 signBit = _mm_set1_ps( -0.0f );
+	const __m128 t = _mm_set1_ps( lerp );
+	const __m128 invT = _mm_set1_ps( 1.0f - lerp );
+
+	count = ( numJoints == joints.Num() ) ? JOINTQUATSOA_PAD( numJoints ) : ( numJoints & ~3 );
+
+	for ( i = 0; i < count; i += 4 ) {
+		__m128 jx = _mm_load_ps( joints.x + i );
+		__m128 jy = _mm_load_ps( joints.y + i );
+		__m128 jz = _mm_load_ps( joints.z + i );
+		__m128 jw = _mm_load_ps( joints.w + i );
+
+		__m128 bx = _mm_load_ps( blendJoints.x + i );
+		__m128 by = _mm_load_ps( blendJoints.y + i );
+		__m128 bz = _mm_load_ps( blendJoints.z + i );
+		__m128 bw = _mm_load_ps( blendJoints.w + i );
+
+		__m128 cosom = _mm_add_ps( _mm_add_ps( _mm_mul_ps( jx, bx ), _mm_mul_ps( jy, by ) ), _mm_add_ps( _mm_mul_ps( jz, bz ), _mm_mul_ps( jw, bw ) ) );
+
+		// take the shortest path
+		__m128 scale1 = _mm_xor_ps( t, _mm_and_ps( cosom, signBit ) );
+
+		jx = _mm_add_ps( _mm_mul_ps( invT, jx ), _mm_mul_ps( scale1, bx ) );
+		jy = _mm_add_ps( _mm_mul_ps( invT, jy ), _mm_mul_ps( scale1, by ) );
+		jz = _mm_add_ps( _mm_mul_ps( invT, jz ), _mm_mul_ps( scale1, bz ) );
+		jw = _mm_add_ps( _mm_mul_ps( invT, jw ), _mm_mul_ps( scale1, bw ) );
+
+		__m128 s = RSqrt_SSE2( _mm_add_ps( _mm_add_ps( _mm_mul_ps( jx, jx ), _mm_mul_ps( jy, jy ) ), _mm_add_ps( _mm_mul_ps( jz, jz ), _mm_mul_ps( jw, jw ) ) ) );
+
+		_mm_store_ps( joints.x + i, _mm_mul_ps( jx, s ) );
+		_mm_store_ps( joints.y + i, _mm_mul_ps( jy, s ) );
+		_mm_store_ps( joints.z + i, _mm_mul_ps( jz, s ) );
+		_mm_store_ps( joints.w + i, _mm_mul_ps( jw, s ) );
+
+		__m128 tx = _mm_load_ps( joints.tx + i );
+		__m128 ty = _mm_load_ps( joints.ty + i );
+		__m128 tz = _mm_load_ps( joints.tz + i );
+		_mm_store_ps( joints.tx + i, _mm_add_ps( tx, _mm_mul_ps( t, _mm_sub_ps( _mm_load_ps( blendJoints.tx + i ), tx ) ) ) );
+		_mm_store_ps( joints.ty + i, _mm_add_ps( ty, _mm_mul_ps( t, _mm_sub_ps( _mm_load_ps( blendJoints.ty + i ), ty ) ) ) );
+		_mm_store_ps( joints.tz + i, _mm_add_ps( tz, _mm_mul_ps( t, _mm_sub_ps( _mm_load_ps( blendJoints.tz + i ), tz ) ) ) );
+	}
+
+	for ( ; i < numJoints; i++ ) {
+		float cosom = joints.x[i] * blendJoints.x[i] + joints.y[i] * blendJoints.y[i] + joints.z[i] * blendJoints.z[i] + joints.w[i] * blendJoints.w[i];
+		float scale0 = 1.0f - lerp;
+		float scale1 = ( cosom < 0.0f ) ? -lerp : lerp;
+		idQuat q( scale0 * joints.x[i] + scale1 * blendJoints.x[i], scale0 * joints.y[i] + scale1 * blendJoints.y[i],
+					scale0 * joints.z[i] + scale1 * blendJoints.z[i], scale0 * joints.w[i] + scale1 * blendJoints.w[i] );
+		q.Normalize();
+		joints.x[i] = q.x;
+		joints.y[i] = q.y;
+		joints.z[i] = q.z;
+		joints.w[i] = q.w;
+		joints.tx[i] += lerp * ( blendJoints.tx[i] - joints.tx[i] );
+		joints.ty[i] += lerp * ( blendJoints.ty[i] - joints.ty[i] );
+		joints.tz[i] += lerp * ( blendJoints.tz[i] - joints.tz[i] );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::ConvertSoAToJointMats
+
+  Same as ConvertJointQuatsToJointMats without transposing the quaternions first.
+============
+*/
+void VPCALL idSIMD_SSE2::ConvertSoAToJointMats( idJointMat *jointMats, const idJointQuatSoA &soa, const int numJoints ) {
+	int i;
+
+	assert( numJoints <= soa.Num() );
+
+	const __m128 one = _mm_set1_ps( 1.0f );
+
+	for ( i = 0; i + 4 <= numJoints; i += 4 ) {
+		__m128 x = _mm_load_ps( soa.x + i );
+		__m128 y = _mm_load_ps( soa.y + i );
+		__m128 z = _mm_load_ps( soa.z + i );
+		__m128 w = _mm_load_ps( soa.w + i );
+
+		__m128 x2 = _mm_add_ps( x, x );
+		__m128 y2 = _mm_add_ps( y, y );
+		__m128 z2 = _mm_add_ps( z, z );
+
+		__m128 xx = _mm_mul_ps( x, x2 );
+		__m128 xy = _mm_mul_ps( x, y2 );
+		__m128 xz = _mm_mul_ps( x, z2 );
+
+		__m128 yy = _mm_mul_ps( y, y2 );
+		__m128 yz = _mm_mul_ps( y, z2 );
+		__m128 zz = _mm_mul_ps( z, z2 );
+
+		__m128 wx = _mm_mul_ps( w, x2 );
+		__m128 wy = _mm_mul_ps( w, y2 );
+		__m128 wz = _mm_mul_ps( w, z2 );
+
+		// rows of the joint matrices with one joint per register lane
+		__m128 r0 = _mm_sub_ps( one, _mm_add_ps( yy, zz ) );
+		__m128 r1 = _mm_add_ps( xy, wz );
+		__m128 r2 = _mm_sub_ps( xz, wy );
+		__m128 r3 = _mm_load_ps( soa.tx + i );
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+		_mm_storeu_ps( jointMats[i+0].ToFloatPtr() + 0, r0 );
+		_mm_storeu_ps( jointMats[i+1].ToFloatPtr() + 0, r1 );
+		_mm_storeu_ps( jointMats[i+2].ToFloatPtr() + 0, r2 );
+		_mm_storeu_ps( jointMats[i+3].ToFloatPtr() + 0, r3 );
+
+		r0 = _mm_sub_ps( xy, wz );
+		r1 = _mm_sub_ps( one, _mm_add_ps( xx, zz ) );
+		r2 = _mm_add_ps( yz, wx );
+		r3 = _mm_load_ps( soa.ty + i );
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+		_mm_storeu_ps( jointMats[i+0].ToFloatPtr() + 4, r0 );
+		_mm_storeu_ps( jointMats[i+1].ToFloatPtr() + 4, r1 );
+		_mm_storeu_ps( jointMats[i+2].ToFloatPtr() + 4, r2 );
+		_mm_storeu_ps( jointMats[i+3].ToFloatPtr() + 4, r3 );
+
+		r0 = _mm_add_ps( xz, wy );
+		r1 = _mm_sub_ps( yz, wx );
+		r2 = _mm_sub_ps( one, _mm_add_ps( xx, yy ) );
+		r3 = _mm_load_ps( soa.tz + i );
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+		_mm_storeu_ps( jointMats[i+0].ToFloatPtr() + 8, r0 );
+		_mm_storeu_ps( jointMats[i+1].ToFloatPtr() + 8, r1 );
+		_mm_storeu_ps( jointMats[i+2].ToFloatPtr() + 8, r2 );
+		_mm_storeu_ps( jointMats[i+3].ToFloatPtr() + 8, r3 );
+	}
+
+	for ( ; i < numJoints; i++ ) {
+		jointMats[i].SetRotation( idQuat( soa.x[i], soa.y[i], soa.z[i], soa.w[i] ).ToMat3() );
+		jointMats[i].SetTranslation( idVec3( soa.tx[i], soa.ty[i], soa.tz[i] ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::TransformJoints
+
+  Each row of the child matrix is a combination of the rows of the parent matrix.
+============
+*/
+void VPCALL idSIMD_SSE2::TransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) {
+	int i;
+	const __m128 lastMask = _mm_castsi128_ps( _mm_setr_epi32( 0, 0, 0, -1 ) );
+
+	for( i = firstJoint; i <= lastJoint; i++ ) {
+		assert( parents[i] < i );
+		float *m = jointMats[i].ToFloatPtr();
+		const float *a = jointMats[parents[i]].ToFloatPtr();
+
+		__m128 c0 = _mm_loadu_ps( m + 0 );
+		__m128 c1 = _mm_loadu_ps( m + 4 );
+		__m128 c2 = _mm_loadu_ps( m + 8 );
+
+		__m128 a0 = _mm_loadu_ps( a + 0 );
+		__m128 a1 = _mm_loadu_ps( a + 4 );
+		__m128 a2 = _mm_loadu_ps( a + 8 );
+
+		__m128 r0 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( c0, _mm_shuffle_ps( a0, a0, _MM_SHUFFLE( 0, 0, 0, 0 ) ) ),
+											_mm_mul_ps( c1, _mm_shuffle_ps( a0, a0, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) ),
+											_mm_mul_ps( c2, _mm_shuffle_ps( a0, a0, _MM_SHUFFLE( 2, 2, 2, 2 ) ) ) );
+		__m128 r1 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( c0, _mm_shuffle_ps( a1, a1, _MM_SHUFFLE( 0, 0, 0, 0 ) ) ),
+											_mm_mul_ps( c1, _mm_shuffle_ps( a1, a1, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) ),
+											_mm_mul_ps( c2, _mm_shuffle_ps( a1, a1, _MM_SHUFFLE( 2, 2, 2, 2 ) ) ) );
+		__m128 r2 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( c0, _mm_shuffle_ps( a2, a2, _MM_SHUFFLE( 0, 0, 0, 0 ) ) ),
+											_mm_mul_ps( c1, _mm_shuffle_ps( a2, a2, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) ),
+											_mm_mul_ps( c2, _mm_shuffle_ps( a2, a2, _MM_SHUFFLE( 2, 2, 2, 2 ) ) ) );
+
+		_mm_storeu_ps( m + 0, _mm_add_ps( r0, _mm_and_ps( a0, lastMask ) ) );
+		_mm_storeu_ps( m + 4, _mm_add_ps( r1, _mm_and_ps( a1, lastMask ) ) );
+		_mm_storeu_ps( m + 8, _mm_add_ps( r2, _mm_and_ps( a2, lastMask ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::UntransformJoints
+
+  Each row of the child matrix is a combination of the rows of the child
+  matrix weighted by the columns of the parent matrix.
+============
+*/
+void VPCALL idSIMD_SSE2::UntransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) {
+	int i;
+	const __m128 lastMask = _mm_castsi128_ps( _mm_setr_epi32( 0, 0, 0, -1 ) );
+
+	for( i = lastJoint; i >= firstJoint; i-- ) {
+		assert( parents[i] < i );
+		float *m = jointMats[i].ToFloatPtr();
+		const float *a = jointMats[parents[i]].ToFloatPtr();
+
+		__m128 a0 = _mm_loadu_ps( a + 0 );
+		__m128 a1 = _mm_loadu_ps( a + 4 );
+		__m128 a2 = _mm_loadu_ps( a + 8 );
+
+		__m128 c0 = _mm_sub_ps( _mm_loadu_ps( m + 0 ), _mm_and_ps( a0, lastMask ) );
+		__m128 c1 = _mm_sub_ps( _mm_loadu_ps( m + 4 ), _mm_and_ps( a1, lastMask ) );
+		__m128 c2 = _mm_sub_ps( _mm_loadu_ps( m + 8 ), _mm_and_ps( a2, lastMask ) );
+
+		__m128 r0 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( c0, _mm_shuffle_ps( a0, a0, _MM_SHUFFLE( 0, 0, 0, 0 ) ) ),
+											_mm_mul_ps( c1, _mm_shuffle_ps( a1, a1, _MM_SHUFFLE( 0, 0, 0, 0 ) ) ) ),
+											_mm_mul_ps( c2, _mm_shuffle_ps( a2, a2, _MM_SHUFFLE( 0, 0, 0, 0 ) ) ) );
+		__m128 r1 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( c0, _mm_shuffle_ps( a0, a0, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ),
+											_mm_mul_ps( c1, _mm_shuffle_ps( a1, a1, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) ),
+											_mm_mul_ps( c2, _mm_shuffle_ps( a2, a2, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) );
+		__m128 r2 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( c0, _mm_shuffle_ps( a0, a0, _MM_SHUFFLE( 2, 2, 2, 2 ) ) ),
+											_mm_mul_ps( c1, _mm_shuffle_ps( a1, a1, _MM_SHUFFLE( 2, 2, 2, 2 ) ) ) ),
+											_mm_mul_ps( c2, _mm_shuffle_ps( a2, a2, _MM_SHUFFLE( 2, 2, 2, 2 ) ) ) );
+
+		_mm_storeu_ps( m + 0, r0 );
+		_mm_storeu_ps( m + 4, r1 );
+		_mm_storeu_ps( m + 8, r2 );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::TransformVerts
+============
+*/
+void VPCALL idSIMD_SSE2::TransformVerts( idDrawVert *verts, const int numVerts, const idJointMat *joints, const idVec4 *weights, const int *index, const int numWeights ) {
+	int i, j;
+	const byte *jointsPtr = (const byte *)joints;
+
+	assert( sizeof( idJointMat ) == 12 * sizeof( float ) );
+	assert( sizeof( idVec4 ) == 4 * sizeof( float ) );
+
+	for( j = i = 0; i < numVerts; i++ ) {
+		const float *m = (const float *)( jointsPtr + index[j*2+0] );
+		__m128 w = _mm_loadu_ps( weights[j].ToFloatPtr() );
+		__m128 r0 = _mm_mul_ps( _mm_loadu_ps( m + 0 ), w );
+		__m128 r1 = _mm_mul_ps( _mm_loadu_ps( m + 4 ), w );
+		__m128 r2 = _mm_mul_ps( _mm_loadu_ps( m + 8 ), w );
+
+		while( index[j*2+1] == 0 ) {
+			j++;
+			m = (const float *)( jointsPtr + index[j*2+0] );
+			w = _mm_loadu_ps( weights[j].ToFloatPtr() );
+			r0 = _mm_add_ps( r0, _mm_mul_ps( _mm_loadu_ps( m + 0 ), w ) );
+			r1 = _mm_add_ps( r1, _mm_mul_ps( _mm_loadu_ps( m + 4 ), w ) );
+			r2 = _mm_add_ps( r2, _mm_mul_ps( _mm_loadu_ps( m + 8 ), w ) );
+		}
+		j++;
+
+		__m128 r3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+		StoreVec3_SSE2( verts[i].xyz.ToFloatPtr(), _mm_add_ps( _mm_add_ps( r0, r1 ), _mm_add_ps( r2, r3 ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::TracePointCull
+============
+*/
+void VPCALL idSIMD_SSE2::TracePointCull( byte *cullBits, byte &totalOr, const float radius, const idPlane *planes, const idDrawVert *verts, const int numVerts ) {
+	int i, k;
+	byte tOr;
+	__m128 pa[4], pb[4], pc[4], pd[4];
+
+	for ( k = 0; k < 4; k++ ) {
+		pa[k] = _mm_set1_ps( planes[k][0] );
+		pb[k] = _mm_set1_ps( planes[k][1] );
+		pc[k] = _mm_set1_ps( planes[k][2] );
+		pd[k] = _mm_set1_ps( planes[k][3] );
+	}
+
+	const __m128 r = _mm_set1_ps( radius );
+	__m128i orBits = _mm_setzero_si128();
+
+	for ( i = 0; i + 4 <= numVerts; i += 4 ) {
+		__m128 x = _mm_loadu_ps( verts[i+0].xyz.ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( verts[i+1].xyz.ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( verts[i+2].xyz.ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( verts[i+3].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+
+		__m128i bits = _mm_setzero_si128();
+		for ( k = 0; k < 4; k++ ) {
+			__m128 d = _mm_add_ps( _mm_add_ps( _mm_mul_ps( pa[k], x ), _mm_mul_ps( pb[k], y ) ), _mm_add_ps( _mm_mul_ps( pc[k], z ), pd[k] ) );
+			bits = _mm_or_si128( bits, SignBits_SSE2( _mm_add_ps( d, r ), k ) );
+			bits = _mm_or_si128( bits, SignBits_SSE2( _mm_sub_ps( d, r ), k + 4 ) );
+		}
+
+		bits = _mm_xor_si128( bits, _mm_set1_epi32( 0x0F ) );		// flip lower four bits
+		orBits = _mm_or_si128( orBits, bits );
+
+		StoreBytes_SSE2( cullBits + i, bits );
+	}
+
+	orBits = _mm_or_si128( orBits, _mm_srli_si128( orBits, 8 ) );
+	orBits = _mm_or_si128( orBits, _mm_srli_si128( orBits, 4 ) );
+	tOr = (byte) _mm_cvtsi128_si32( orBits );
+
+	for ( ; i < numVerts; i++ ) {
+		byte bits;
+		float d0, d1, d2, d3, t;
+		const idVec3 &v = verts[i].xyz;
+
+		d0 = planes[0].Distance( v );
+		d1 = planes[1].Distance( v );
+		d2 = planes[2].Distance( v );
+		d3 = planes[3].Distance( v );
+
+		t = d0 + radius;
+		bits  = FLOATSIGNBITSET( t ) << 0;
+		t = d1 + radius;
+		bits |= FLOATSIGNBITSET( t ) << 1;
+		t = d2 + radius;
+		bits |= FLOATSIGNBITSET( t ) << 2;
+		t = d3 + radius;
+		bits |= FLOATSIGNBITSET( t ) << 3;
+
+		t = d0 - radius;
+		bits |= FLOATSIGNBITSET( t ) << 4;
+		t = d1 - radius;
+		bits |= FLOATSIGNBITSET( t ) << 5;
+		t = d2 - radius;
+		bits |= FLOATSIGNBITSET( t ) << 6;
+		t = d3 - radius;
+		bits |= FLOATSIGNBITSET( t ) << 7;
+
+		bits ^= 0x0F;		// flip lower four bits
+
+		tOr |= bits;
+		cullBits[i] = bits;
+	}
+
+	totalOr = tOr;
+}
+
+/*
+============
+idSIMD_SSE2::DecalPointCull
+============
+*/
+void VPCALL idSIMD_SSE2::DecalPointCull( byte *cullBits, const idPlane *planes, const idDrawVert *verts, const int numVerts ) {
+	int i, k;
+	__m128 pa[6], pb[6], pc[6], pd[6];
+
+	for ( k = 0; k < 6; k++ ) {
+		pa[k] = _mm_set1_ps( planes[k][0] );
+		pb[k] = _mm_set1_ps( planes[k][1] );
+		pc[k] = _mm_set1_ps( planes[k][2] );
+		pd[k] = _mm_set1_ps( planes[k][3] );
+	}
+
+	for ( i = 0; i + 4 <= numVerts; i += 4 ) {
+		__m128 x = _mm_loadu_ps( verts[i+0].xyz.ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( verts[i+1].xyz.ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( verts[i+2].xyz.ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( verts[i+3].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+
+		__m128i bits = _mm_setzero_si128();
+		for ( k = 0; k < 6; k++ ) {
+			__m128 d = _mm_add_ps( _mm_add_ps( _mm_mul_ps( pa[k], x ), _mm_mul_ps( pb[k], y ) ), _mm_add_ps( _mm_mul_ps( pc[k], z ), pd[k] ) );
+			bits = _mm_or_si128( bits, SignBits_SSE2( d, k ) );
+		}
+
+		StoreBytes_SSE2( cullBits + i, _mm_xor_si128( bits, _mm_set1_epi32( 0x3F ) ) );		// flip lower 6 bits
+	}
+
+	for ( ; i < numVerts; i++ ) {
+		byte bits;
+		float d0, d1, d2, d3, d4, d5;
+		const idVec3 &v = verts[i].xyz;
+
+		d0 = planes[0].Distance( v );
+		d1 = planes[1].Distance( v );
+		d2 = planes[2].Distance( v );
+		d3 = planes[3].Distance( v );
+		d4 = planes[4].Distance( v );
+		d5 = planes[5].Distance( v );
+
+		bits  = FLOATSIGNBITSET( d0 ) << 0;
+		bits |= FLOATSIGNBITSET( d1 ) << 1;
+		bits |= FLOATSIGNBITSET( d2 ) << 2;
+		bits |= FLOATSIGNBITSET( d3 ) << 3;
+		bits |= FLOATSIGNBITSET( d4 ) << 4;
+		bits |= FLOATSIGNBITSET( d5 ) << 5;
+
+		cullBits[i] = bits ^ 0x3F;		// flip lower 6 bits
+	}
+}
+
+/*
+============
+idSIMD_SSE2::OverlayPointCull
+============
+*/
+void VPCALL idSIMD_SSE2::OverlayPointCull( byte *cullBits, idVec2 *texCoords, const idPlane *planes, const idDrawVert *verts, const int numVerts ) {
+	int i;
+
+	const __m128 p0a = _mm_set1_ps( planes[0][0] );
+	const __m128 p0b = _mm_set1_ps( planes[0][1] );
+	const __m128 p0c = _mm_set1_ps( planes[0][2] );
+	const __m128 p0d = _mm_set1_ps( planes[0][3] );
+	const __m128 p1a = _mm_set1_ps( planes[1][0] );
+	const __m128 p1b = _mm_set1_ps( planes[1][1] );
+	const __m128 p1c = _mm_set1_ps( planes[1][2] );
+	const __m128 p1d = _mm_set1_ps( planes[1][3] );
+	const __m128 one = _mm_set1_ps( 1.0f );
+
+	for ( i = 0; i + 4 <= numVerts; i += 4 ) {
+		__m128 x = _mm_loadu_ps( verts[i+0].xyz.ToFloatPtr() );
+		__m128 y = _mm_loadu_ps( verts[i+1].xyz.ToFloatPtr() );
+		__m128 z = _mm_loadu_ps( verts[i+2].xyz.ToFloatPtr() );
+		__m128 w = _mm_loadu_ps( verts[i+3].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+
+		__m128 d0 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( p0a, x ), _mm_mul_ps( p0b, y ) ), _mm_add_ps( _mm_mul_ps( p0c, z ), p0d ) );
+		__m128 d1 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( p1a, x ), _mm_mul_ps( p1b, y ) ), _mm_add_ps( _mm_mul_ps( p1c, z ), p1d ) );
+
+		_mm_storeu_ps( texCoords[i+0].ToFloatPtr(), _mm_unpacklo_ps( d0, d1 ) );
+		_mm_storeu_ps( texCoords[i+2].ToFloatPtr(), _mm_unpackhi_ps( d0, d1 ) );
+
+		__m128i bits = SignBits_SSE2( d0, 0 );
+		bits = _mm_or_si128( bits, SignBits_SSE2( d1, 1 ) );
+		bits = _mm_or_si128( bits, SignBits_SSE2( _mm_sub_ps( one, d0 ), 2 ) );
+		bits = _mm_or_si128( bits, SignBits_SSE2( _mm_sub_ps( one, d1 ), 3 ) );
+
+		StoreBytes_SSE2( cullBits + i, bits );
+	}
+
+	for ( ; i < numVerts; i++ ) {
+		byte bits;
+		float d0, d1;
+		const idVec3 &v = verts[i].xyz;
+
+		texCoords[i][0] = d0 = planes[0].Distance( v );
+		texCoords[i][1] = d1 = planes[1].Distance( v );
+
+		bits  = FLOATSIGNBITSET( d0 ) << 0;
+		d0 = 1.0f - d0;
+		bits |= FLOATSIGNBITSET( d1 ) << 1;
+		d1 = 1.0f - d1;
+		bits |= FLOATSIGNBITSET( d0 ) << 2;
+		bits |= FLOATSIGNBITSET( d1 ) << 3;
+
+		cullBits[i] = bits;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::CullBounds
+
+  Four bounds are transposed to SoA and tested against a plane at once. The
+  corner to test only depends on the plane so it is selected per plane.
+============
+*/
+int VPCALL idSIMD_SSE2::CullBounds( dword *cullBits, const idPlane *planes, const int numPlanes, const idBounds *bounds, const int numBounds ) {
+	int i, j, numCulled, mask;
+	int *select;
+	dword bits;
+
+	// index of the min or max component to use for each plane
+	select = (int *) _alloca16( numPlanes * 3 * sizeof( int ) );
+	for ( j = 0; j < numPlanes; j++ ) {
+		select[j*3+0] = ( planes[j][0] >= 0.0f ) ? 0 : 3;
+		select[j*3+1] = ( planes[j][1] >= 0.0f ) ? 1 : 4;
+		select[j*3+2] = ( planes[j][2] >= 0.0f ) ? 2 : 5;
+	}
+
+	const __m128 zero = _mm_setzero_ps();
+
+	numCulled = 0;
+	bits = 0;
+
+	for ( i = 0; i + 4 <= numBounds; i += 4 ) {
+		const float *f = bounds[i][0].ToFloatPtr();
+		__m128 v[6];
+
+		__m128 a0 = _mm_loadu_ps( f + 0 );
+		__m128 a1 = _mm_loadu_ps( f + 6 );
+		__m128 a2 = _mm_loadu_ps( f + 12 );
+		__m128 a3 = _mm_loadu_ps( f + 18 );
+		__m128 b0 = _mm_loadu_ps( f + 2 );
+		__m128 b1 = _mm_loadu_ps( f + 8 );
+		__m128 b2 = _mm_loadu_ps( f + 14 );
+		__m128 b3 = _mm_loadu_ps( f + 20 );
+		_MM_TRANSPOSE4_PS( a0, a1, a2, a3 );		// min x, min y, min z, max x
+		_MM_TRANSPOSE4_PS( b0, b1, b2, b3 );		// min z, max x, max y, max z
+
+		v[0] = a0;
+		v[1] = a1;
+		v[2] = a2;
+		v[3] = a3;
+		v[4] = b2;
+		v[5] = b3;
+
+		__m128 culled = zero;
+		for ( j = 0; j < numPlanes; j++ ) {
+			const float *p = planes[j].ToFloatPtr();
+			const int *s = select + j * 3;
+			__m128 d = _mm_mul_ps( _mm_load1_ps( p + 0 ), v[s[0]] );
+			d = _mm_add_ps( d, _mm_mul_ps( _mm_load1_ps( p + 1 ), v[s[1]] ) );
+			d = _mm_add_ps( d, _mm_mul_ps( _mm_load1_ps( p + 2 ), v[s[2]] ) );
+			d = _mm_add_ps( d, _mm_load1_ps( p + 3 ) );
+			culled = _mm_or_ps( culled, _mm_cmpgt_ps( d, zero ) );
+			if ( _mm_movemask_ps( culled ) == 15 ) {
+				break;
+			}
+		}
+
+		mask = _mm_movemask_ps( culled );
+		numCulled += idMath::BitCount( mask );
+		bits |= (dword)mask << ( i & 31 );
+
+		if ( ( i & 31 ) == 28 ) {
+			cullBits[i >> 5] = bits;
+			bits = 0;
+		}
+	}
+
+	for ( ; i < numBounds; i++ ) {
+		const idBounds &b = bounds[i];
+
+		for ( j = 0; j < numPlanes; j++ ) {
+			const idPlane &p = planes[j];
+			float x = ( p[0] >= 0.0f ) ? b[0][0] : b[1][0];
+			float y = ( p[1] >= 0.0f ) ? b[0][1] : b[1][1];
+			float z = ( p[2] >= 0.0f ) ? b[0][2] : b[1][2];
+			if ( p[0] * x + p[1] * y + p[2] * z + p[3] > 0.0f ) {
+				bits |= (dword)1 << ( i & 31 );
+				numCulled++;
+				break;
+			}
+		}
+
+		if ( ( i & 31 ) == 31 ) {
+			cullBits[i >> 5] = bits;
+			bits = 0;
+		}
+	}
+	if ( i & 31 ) {
+		cullBits[i >> 5] = bits;
+	}
+
+	return numCulled;
+}
+
+/*
+============
+idSIMD_SSE2::DeriveTriPlanes
+
+	Derives a plane equation for each triangle.
+	Four triangles are processed at once.
+============
+*/
+void VPCALL idSIMD_SSE2::DeriveTriPlanes( idPlane *planes, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	int i;
+	const int numTris = numIndexes / 3;
+
+	for ( i = 0; i + 4 <= numTris; i += 4 ) {
+		const int *tri = indexes + i * 3;
+
+		__m128 ax = _mm_loadu_ps( verts[tri[0]].xyz.ToFloatPtr() );
+		__m128 ay = _mm_loadu_ps( verts[tri[3]].xyz.ToFloatPtr() );
+		__m128 az = _mm_loadu_ps( verts[tri[6]].xyz.ToFloatPtr() );
+		__m128 aw = _mm_loadu_ps( verts[tri[9]].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( ax, ay, az, aw );
+
+		__m128 bx = _mm_loadu_ps( verts[tri[1]].xyz.ToFloatPtr() );
+		__m128 by = _mm_loadu_ps( verts[tri[4]].xyz.ToFloatPtr() );
+		__m128 bz = _mm_loadu_ps( verts[tri[7]].xyz.ToFloatPtr() );
+		__m128 bw = _mm_loadu_ps( verts[tri[10]].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( bx, by, bz, bw );
+
+		__m128 cx = _mm_loadu_ps( verts[tri[2]].xyz.ToFloatPtr() );
+		__m128 cy = _mm_loadu_ps( verts[tri[5]].xyz.ToFloatPtr() );
+		__m128 cz = _mm_loadu_ps( verts[tri[8]].xyz.ToFloatPtr() );
+		__m128 cw = _mm_loadu_ps( verts[tri[11]].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( cx, cy, cz, cw );
+
+		__m128 d0x = _mm_sub_ps( bx, ax );
+		__m128 d0y = _mm_sub_ps( by, ay );
+		__m128 d0z = _mm_sub_ps( bz, az );
+		__m128 d1x = _mm_sub_ps( cx, ax );
+		__m128 d1y = _mm_sub_ps( cy, ay );
+		__m128 d1z = _mm_sub_ps( cz, az );
+
+		__m128 nx = _mm_sub_ps( _mm_mul_ps( d1y, d0z ), _mm_mul_ps( d1z, d0y ) );
+		__m128 ny = _mm_sub_ps( _mm_mul_ps( d1z, d0x ), _mm_mul_ps( d1x, d0z ) );
+		__m128 nz = _mm_sub_ps( _mm_mul_ps( d1x, d0y ), _mm_mul_ps( d1y, d0x ) );
+
+		__m128 f = RSqrt_SSE2( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, nx ), _mm_mul_ps( ny, ny ) ), _mm_mul_ps( nz, nz ) ) );
+		nx = _mm_mul_ps( nx, f );
+		ny = _mm_mul_ps( ny, f );
+		nz = _mm_mul_ps( nz, f );
+
+		__m128 nd = _mm_xor_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, ax ), _mm_mul_ps( ny, ay ) ), _mm_mul_ps( nz, az ) ), _mm_set1_ps( -0.0f ) );
+		_MM_TRANSPOSE4_PS( nx, ny, nz, nd );
+
+		_mm_storeu_ps( planes[i+0].ToFloatPtr(), nx );
+		_mm_storeu_ps( planes[i+1].ToFloatPtr(), ny );
+		_mm_storeu_ps( planes[i+2].ToFloatPtr(), nz );
+		_mm_storeu_ps( planes[i+3].ToFloatPtr(), nd );
+	}
+
+	if ( i < numTris ) {
+		idSIMD_Generic::DeriveTriPlanes( planes + i, verts, numVerts, indexes + i * 3, ( numTris - i ) * 3 );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::DeriveTangents
+
+	Derives the normal and orthogonal tangent vectors for the triangle vertices.
+	For each vertex the normal and tangent vectors are derived from all triangles
+	using the vertex which results in smooth tangents across the mesh.
+	In the process the triangle planes are calculated as well.
+
+	The per triangle math is done for four triangles at once. The results are
+	accumulated into the vertices sequentially because triangles in the same
+	batch may share vertices.
+============
+*/
+void VPCALL idSIMD_SSE2::DeriveTangents( idPlane *planes, idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	int i, k;
+	idVec3 n[4], t0[4], t1[4];
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	const __m128 signMask = _mm_set1_ps( -0.0f );
+	const int numTris = numIndexes / 3;
+
+	idPlane *planesPtr = planes;
+	for ( i = 0; i < numTris; i += 4 ) {
+		int count = numTris - i;
+		if ( count > 4 ) {
+			count = 4;
+		}
+
+		// pad the last batch with copies of the first triangle
+		const int *tri[4];
+		for ( k = 0; k < 4; k++ ) {
+			tri[k] = indexes + ( i + ( k < count ? k : 0 ) ) * 3;
+		}
+
+		const idDrawVert *a0 = verts + tri[0][0];
+		const idDrawVert *a1 = verts + tri[1][0];
+		const idDrawVert *a2 = verts + tri[2][0];
+		const idDrawVert *a3 = verts + tri[3][0];
+
+		// x, y, z and st[0] are transposed, st[1] is loaded separately
+		__m128 ax = _mm_loadu_ps( a0->xyz.ToFloatPtr() );
+		__m128 ay = _mm_loadu_ps( a1->xyz.ToFloatPtr() );
+		__m128 az = _mm_loadu_ps( a2->xyz.ToFloatPtr() );
+		__m128 as = _mm_loadu_ps( a3->xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( ax, ay, az, as );
+		__m128 at = _mm_setr_ps( a0->st[1], a1->st[1], a2->st[1], a3->st[1] );
+
+		const idDrawVert *b0 = verts + tri[0][1];
+		const idDrawVert *b1 = verts + tri[1][1];
+		const idDrawVert *b2 = verts + tri[2][1];
+		const idDrawVert *b3 = verts + tri[3][1];
+
+		__m128 d0x = _mm_loadu_ps( b0->xyz.ToFloatPtr() );
+		__m128 d0y = _mm_loadu_ps( b1->xyz.ToFloatPtr() );
+		__m128 d0z = _mm_loadu_ps( b2->xyz.ToFloatPtr() );
+		__m128 d0s = _mm_loadu_ps( b3->xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( d0x, d0y, d0z, d0s );
+		__m128 d0t = _mm_setr_ps( b0->st[1], b1->st[1], b2->st[1], b3->st[1] );
+
+		const idDrawVert *c0 = verts + tri[0][2];
+		const idDrawVert *c1 = verts + tri[1][2];
+		const idDrawVert *c2 = verts + tri[2][2];
+		const idDrawVert *c3 = verts + tri[3][2];
+
+		__m128 d1x = _mm_loadu_ps( c0->xyz.ToFloatPtr() );
+		__m128 d1y = _mm_loadu_ps( c1->xyz.ToFloatPtr() );
+		__m128 d1z = _mm_loadu_ps( c2->xyz.ToFloatPtr() );
+		__m128 d1s = _mm_loadu_ps( c3->xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( d1x, d1y, d1z, d1s );
+		__m128 d1t = _mm_setr_ps( c0->st[1], c1->st[1], c2->st[1], c3->st[1] );
+
+		d0x = _mm_sub_ps( d0x, ax );
+		d0y = _mm_sub_ps( d0y, ay );
+		d0z = _mm_sub_ps( d0z, az );
+		d0s = _mm_sub_ps( d0s, as );
+		d0t = _mm_sub_ps( d0t, at );
+
+		d1x = _mm_sub_ps( d1x, ax );
+		d1y = _mm_sub_ps( d1y, ay );
+		d1z = _mm_sub_ps( d1z, az );
+		d1s = _mm_sub_ps( d1s, as );
+		d1t = _mm_sub_ps( d1t, at );
+
+		// normal
+		__m128 n0 = _mm_sub_ps( _mm_mul_ps( d1y, d0z ), _mm_mul_ps( d1z, d0y ) );
+		__m128 n1 = _mm_sub_ps( _mm_mul_ps( d1z, d0x ), _mm_mul_ps( d1x, d0z ) );
+		__m128 n2 = _mm_sub_ps( _mm_mul_ps( d1x, d0y ), _mm_mul_ps( d1y, d0x ) );
+		__m128 f = RSqrt_SSE2( _mm_add_ps( _mm_add_ps( _mm_mul_ps( n0, n0 ), _mm_mul_ps( n1, n1 ) ), _mm_mul_ps( n2, n2 ) ) );
+		n0 = _mm_mul_ps( n0, f );
+		n1 = _mm_mul_ps( n1, f );
+		n2 = _mm_mul_ps( n2, f );
+		__m128 n3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( n0, n1, n2, n3 );
+		StoreVec3_SSE2( n[0].ToFloatPtr(), n0 );
+		StoreVec3_SSE2( n[1].ToFloatPtr(), n1 );
+		StoreVec3_SSE2( n[2].ToFloatPtr(), n2 );
+		StoreVec3_SSE2( n[3].ToFloatPtr(), n3 );
+
+		// area sign bit
+		__m128 signBit = _mm_and_ps( _mm_sub_ps( _mm_mul_ps( d0s, d1t ), _mm_mul_ps( d0t, d1s ) ), signMask );
+
+		// first tangent
+		__m128 tx = _mm_sub_ps( _mm_mul_ps( d0x, d1t ), _mm_mul_ps( d0t, d1x ) );
+		__m128 ty = _mm_sub_ps( _mm_mul_ps( d0y, d1t ), _mm_mul_ps( d0t, d1y ) );
+		__m128 tz = _mm_sub_ps( _mm_mul_ps( d0z, d1t ), _mm_mul_ps( d0t, d1z ) );
+		f = _mm_xor_ps( RSqrt_SSE2( _mm_add_ps( _mm_add_ps( _mm_mul_ps( tx, tx ), _mm_mul_ps( ty, ty ) ), _mm_mul_ps( tz, tz ) ) ), signBit );
+		tx = _mm_mul_ps( tx, f );
+		ty = _mm_mul_ps( ty, f );
+		tz = _mm_mul_ps( tz, f );
+		__m128 tw = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( tx, ty, tz, tw );
+		StoreVec3_SSE2( t0[0].ToFloatPtr(), tx );
+		StoreVec3_SSE2( t0[1].ToFloatPtr(), ty );
+		StoreVec3_SSE2( t0[2].ToFloatPtr(), tz );
+		StoreVec3_SSE2( t0[3].ToFloatPtr(), tw );
+
+		// second tangent
+		tx = _mm_sub_ps( _mm_mul_ps( d0s, d1x ), _mm_mul_ps( d0x, d1s ) );
+		ty = _mm_sub_ps( _mm_mul_ps( d0s, d1y ), _mm_mul_ps( d0y, d1s ) );
+		tz = _mm_sub_ps( _mm_mul_ps( d0s, d1z ), _mm_mul_ps( d0z, d1s ) );
+		f = _mm_xor_ps( RSqrt_SSE2( _mm_add_ps( _mm_add_ps( _mm_mul_ps( tx, tx ), _mm_mul_ps( ty, ty ) ), _mm_mul_ps( tz, tz ) ) ), signBit );
+		tx = _mm_mul_ps( tx, f );
+		ty = _mm_mul_ps( ty, f );
+		tz = _mm_mul_ps( tz, f );
+		tw = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( tx, ty, tz, tw );
+		StoreVec3_SSE2( t1[0].ToFloatPtr(), tx );
+		StoreVec3_SSE2( t1[1].ToFloatPtr(), ty );
+		StoreVec3_SSE2( t1[2].ToFloatPtr(), tz );
+		StoreVec3_SSE2( t1[3].ToFloatPtr(), tw );
+
+		for ( k = 0; k < count; k++ ) {
+			planesPtr->SetNormal( n[k] );
+			planesPtr->FitThroughPoint( verts[tri[k][0]].xyz );
+			planesPtr++;
+
+			for ( int j = 0; j < 3; j++ ) {
+				const int v = tri[k][j];
+				idDrawVert *a = verts + v;
+				if ( used[v] ) {
+					a->normal += n[k];
+					a->tangents[0] += t0[k];
+					a->tangents[1] += t1[k];
+				} else {
+					a->normal = n[k];
+					a->tangents[0] = t0[k];
+					a->tangents[1] = t1[k];
+					used[v] = true;
+				}
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE2::DeriveUnsmoothedTangents
+
+	Derives the normal and orthogonal tangent vectors for the triangle vertices.
+	For each vertex the normal and tangent vectors are derived from a single dominant triangle.
+	Four vertices are processed at once.
+============
+*/
+void VPCALL idSIMD_SSE2::DeriveUnsmoothedTangents( idDrawVert *verts, const dominantTri_s *dominantTris, const int numVerts ) {
+	int i, k;
+	ALIGN16( float n[3][4] );
+	ALIGN16( float t0[3][4] );
+	ALIGN16( float t1[3][4] );
+
+	for ( i = 0; i + 4 <= numVerts; i += 4 ) {
+		const dominantTri_s *dt = dominantTris + i;
+
+		__m128 ax = _mm_loadu_ps( verts[i+0].xyz.ToFloatPtr() );
+		__m128 ay = _mm_loadu_ps( verts[i+1].xyz.ToFloatPtr() );
+		__m128 az = _mm_loadu_ps( verts[i+2].xyz.ToFloatPtr() );
+		__m128 as = _mm_loadu_ps( verts[i+3].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( ax, ay, az, as );
+		__m128 at = _mm_setr_ps( verts[i+0].st[1], verts[i+1].st[1], verts[i+2].st[1], verts[i+3].st[1] );
+
+		__m128 d0 = _mm_loadu_ps( verts[dt[0].v2].xyz.ToFloatPtr() );
+		__m128 d1 = _mm_loadu_ps( verts[dt[1].v2].xyz.ToFloatPtr() );
+		__m128 d2 = _mm_loadu_ps( verts[dt[2].v2].xyz.ToFloatPtr() );
+		__m128 d3 = _mm_loadu_ps( verts[dt[3].v2].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( d0, d1, d2, d3 );
+		__m128 d4 = _mm_setr_ps( verts[dt[0].v2].st[1], verts[dt[1].v2].st[1], verts[dt[2].v2].st[1], verts[dt[3].v2].st[1] );
+
+		__m128 d5 = _mm_loadu_ps( verts[dt[0].v3].xyz.ToFloatPtr() );
+		__m128 d6 = _mm_loadu_ps( verts[dt[1].v3].xyz.ToFloatPtr() );
+		__m128 d7 = _mm_loadu_ps( verts[dt[2].v3].xyz.ToFloatPtr() );
+		__m128 d8 = _mm_loadu_ps( verts[dt[3].v3].xyz.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( d5, d6, d7, d8 );
+		__m128 d9 = _mm_setr_ps( verts[dt[0].v3].st[1], verts[dt[1].v3].st[1], verts[dt[2].v3].st[1], verts[dt[3].v3].st[1] );
+
+		__m128 s0 = _mm_setr_ps( dt[0].normalizationScale[0], dt[1].normalizationScale[0], dt[2].normalizationScale[0], dt[3].normalizationScale[0] );
+		__m128 s1 = _mm_setr_ps( dt[0].normalizationScale[1], dt[1].normalizationScale[1], dt[2].normalizationScale[1], dt[3].normalizationScale[1] );
+		__m128 s2 = _mm_setr_ps( dt[0].normalizationScale[2], dt[1].normalizationScale[2], dt[2].normalizationScale[2], dt[3].normalizationScale[2] );
+
+		d0 = _mm_sub_ps( d0, ax );
+		d1 = _mm_sub_ps( d1, ay );
+		d2 = _mm_sub_ps( d2, az );
+		d3 = _mm_sub_ps( d3, as );
+		d4 = _mm_sub_ps( d4, at );
+
+		d5 = _mm_sub_ps( d5, ax );
+		d6 = _mm_sub_ps( d6, ay );
+		d7 = _mm_sub_ps( d7, az );
+		d8 = _mm_sub_ps( d8, as );
+		d9 = _mm_sub_ps( d9, at );
+
+		__m128 n0 = _mm_mul_ps( s2, _mm_sub_ps( _mm_mul_ps( d6, d2 ), _mm_mul_ps( d7, d1 ) ) );
+		__m128 n1 = _mm_mul_ps( s2, _mm_sub_ps( _mm_mul_ps( d7, d0 ), _mm_mul_ps( d5, d2 ) ) );
+		__m128 n2 = _mm_mul_ps( s2, _mm_sub_ps( _mm_mul_ps( d5, d1 ), _mm_mul_ps( d6, d0 ) ) );
+
+		__m128 tx = _mm_mul_ps( s0, _mm_sub_ps( _mm_mul_ps( d0, d9 ), _mm_mul_ps( d4, d5 ) ) );
+		__m128 ty = _mm_mul_ps( s0, _mm_sub_ps( _mm_mul_ps( d1, d9 ), _mm_mul_ps( d4, d6 ) ) );
+		__m128 tz = _mm_mul_ps( s0, _mm_sub_ps( _mm_mul_ps( d2, d9 ), _mm_mul_ps( d4, d7 ) ) );
+
+		// the bitangent is derived from the normal and tangent like DERIVE_UNSMOOTHED_BITANGENT in the generic code
+		_mm_store_ps( t1[0], _mm_mul_ps( s1, _mm_sub_ps( _mm_mul_ps( n2, ty ), _mm_mul_ps( n1, tz ) ) ) );
+		_mm_store_ps( t1[1], _mm_mul_ps( s1, _mm_sub_ps( _mm_mul_ps( n0, tz ), _mm_mul_ps( n2, tx ) ) ) );
+		_mm_store_ps( t1[2], _mm_mul_ps( s1, _mm_sub_ps( _mm_mul_ps( n1, tx ), _mm_mul_ps( n0, ty ) ) ) );
+
+		_mm_store_ps( n[0], n0 );
+		_mm_store_ps( n[1], n1 );
+		_mm_store_ps( n[2], n2 );
+		_mm_store_ps( t0[0], tx );
+		_mm_store_ps( t0[1], ty );
+		_mm_store_ps( t0[2], tz );
+
+		for ( k = 0; k < 4; k++ ) {
+			idDrawVert *a = verts + i + k;
+
+			a->normal[0] = n[0][k];
+			a->normal[1] = n[1][k];
+			a->normal[2] = n[2][k];
+
+			a->tangents[0][0] = t0[0][k];
+			a->tangents[0][1] = t0[1][k];
+			a->tangents[0][2] = t0[2][k];
+
+			a->tangents[1][0] = t1[0][k];
+			a->tangents[1][1] = t1[1][k];
+			a->tangents[1][2] = t1[2][k];
+		}
+	}
+
+	if ( i < numVerts ) {
+		// the dominant triangles index the whole vertex array so the remainder is done here
+		for ( ; i < numVerts; i++ ) {
+			idDrawVert *a, *b, *c;
+			float d0, d1, d2, d4;
+			float d5, d6, d7, d9;
+			float s0, s1, s2;
+			float n0, n1, n2;
+			float t0, t1, t2;
+
+			const dominantTri_s &dt = dominantTris[i];
+
+			a = verts + i;
+			b = verts + dt.v2;
+			c = verts + dt.v3;
+
+			d0 = b->xyz[0] - a->xyz[0];
+			d1 = b->xyz[1] - a->xyz[1];
+			d2 = b->xyz[2] - a->xyz[2];
+			d4 = b->st[1] - a->st[1];
+
+			d5 = c->xyz[0] - a->xyz[0];
+			d6 = c->xyz[1] - a->xyz[1];
+			d7 = c->xyz[2] - a->xyz[2];
+			d9 = c->st[1] - a->st[1];
+
+			s0 = dt.normalizationScale[0];
+			s1 = dt.normalizationScale[1];
+			s2 = dt.normalizationScale[2];
+
+			n0 = s2 * ( d6 * d2 - d7 * d1 );
+			n1 = s2 * ( d7 * d0 - d5 * d2 );
+			n2 = s2 * ( d5 * d1 - d6 * d0 );
+
+			t0 = s0 * ( d0 * d9 - d4 * d5 );
+			t1 = s0 * ( d1 * d9 - d4 * d6 );
+			t2 = s0 * ( d2 * d9 - d4 * d7 );
+
+			a->normal[0] = n0;
+			a->normal[1] = n1;
+			a->normal[2] = n2;
+
+			a->tangents[0][0] = t0;
+			a->tangents[0][1] = t1;
+			a->tangents[0][2] = t2;
+
+			a->tangents[1][0] = s1 * ( n2 * t1 - n1 * t2 );
+			a->tangents[1][1] = s1 * ( n0 * t2 - n2 * t0 );
+			a->tangents[1][2] = s1 * ( n1 * t0 - n0 * t1 );
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE2::NormalizeTangents
+
+	Normalizes each vertex normal and projects and normalizes the
+	tangent vectors onto the plane orthogonal to the vertex normal.
+	Four vertices are processed at once.
+============
+*/
+void VPCALL idSIMD_SSE2::NormalizeTangents( idDrawVert *verts, const int numVerts ) {
+	int i, j, k;
+	ALIGN16( float v[9][4] );
+
+	for ( i = 0; i + 4 <= numVerts; i += 4 ) {
+		idDrawVert *dv = verts + i;
+
+		// the normal and both tangents are nine consecutive floats
+		for ( j = 0; j < 9; j++ ) {
+			_mm_store_ps( v[j], _mm_setr_ps( dv[0].normal.ToFloatPtr()[j], dv[1].normal.ToFloatPtr()[j], dv[2].normal.ToFloatPtr()[j], dv[3].normal.ToFloatPtr()[j] ) );
+		}
+
+		__m128 nx = _mm_load_ps( v[0] );
+		__m128 ny = _mm_load_ps( v[1] );
+		__m128 nz = _mm_load_ps( v[2] );
+		__m128 f = RSqrt_SSE2( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, nx ), _mm_mul_ps( ny, ny ) ), _mm_mul_ps( nz, nz ) ) );
+		nx = _mm_mul_ps( nx, f );
+		ny = _mm_mul_ps( ny, f );
+		nz = _mm_mul_ps( nz, f );
+		_mm_store_ps( v[0], nx );
+		_mm_store_ps( v[1], ny );
+		_mm_store_ps( v[2], nz );
+
+		for ( k = 3; k < 9; k += 3 ) {
+			__m128 tx = _mm_load_ps( v[k+0] );
+			__m128 ty = _mm_load_ps( v[k+1] );
+			__m128 tz = _mm_load_ps( v[k+2] );
+			__m128 d = _mm_add_ps( _mm_add_ps( _mm_mul_ps( tx, nx ), _mm_mul_ps( ty, ny ) ), _mm_mul_ps( tz, nz ) );
+			tx = _mm_sub_ps( tx, _mm_mul_ps( d, nx ) );
+			ty = _mm_sub_ps( ty, _mm_mul_ps( d, ny ) );
+			tz = _mm_sub_ps( tz, _mm_mul_ps( d, nz ) );
+			f = RSqrt_SSE2( _mm_add_ps( _mm_add_ps( _mm_mul_ps( tx, tx ), _mm_mul_ps( ty, ty ) ), _mm_mul_ps( tz, tz ) ) );
+			_mm_store_ps( v[k+0], _mm_mul_ps( tx, f ) );
+			_mm_store_ps( v[k+1], _mm_mul_ps( ty, f ) );
+			_mm_store_ps( v[k+2], _mm_mul_ps( tz, f ) );
+		}
+
+		for ( k = 0; k < 4; k++ ) {
+			float *dst = dv[k].normal.ToFloatPtr();
+			for ( j = 0; j < 9; j++ ) {
+				dst[j] = v[j][k];
+			}
+		}
+	}
+
+	if ( i < numVerts ) {
+		idSIMD_Generic::NormalizeTangents( verts + i, numVerts - i );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::CreateTextureSpaceLightVectors
+
+	Calculates light vectors in texture space for the given triangle vertices.
+	For each vertex the direction towards the light origin is projected onto texture space.
+	The light vectors are only calculated for the vertices referenced by the indexes.
+============
+*/
+void VPCALL idSIMD_SSE2::CreateTextureSpaceLightVectors( idVec3 *lightVectors, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	for ( int i = numIndexes - 1; i >= 0; i-- ) {
+		used[indexes[i]] = true;
+	}
+
+	const __m128 light = LoadVec3_SSE2( lightOrigin.ToFloatPtr() );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		if ( !used[i] ) {
+			continue;
+		}
+
+		const idDrawVert *v = &verts[i];
+
+		// the fourth float loaded with the position is st[0] and is ignored
+		__m128 lightDir = _mm_sub_ps( light, _mm_loadu_ps( v->xyz.ToFloatPtr() ) );
+		__m128 t0 = _mm_mul_ps( lightDir, LoadVec3_SSE2( v->tangents[0].ToFloatPtr() ) );
+		__m128 t1 = _mm_mul_ps( lightDir, LoadVec3_SSE2( v->tangents[1].ToFloatPtr() ) );
+		__m128 n = _mm_mul_ps( lightDir, LoadVec3_SSE2( v->normal.ToFloatPtr() ) );
+		__m128 w = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( t0, t1, n, w );
+
+		StoreVec3_SSE2( lightVectors[i].ToFloatPtr(), _mm_add_ps( _mm_add_ps( t0, t1 ), n ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::CreateSpecularTextureCoords
+
+	Calculates specular texture coordinates for the given triangle vertices.
+	For each vertex the normalized direction towards the light origin is added to the
+	normalized direction towards the view origin and the result is projected onto texture space.
+	The texture coordinates are only calculated for the vertices referenced by the indexes.
+============
+*/
+void VPCALL idSIMD_SSE2::CreateSpecularTextureCoords( idVec4 *texCoords, const idVec3 &lightOrigin, const idVec3 &viewOrigin, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	for ( int i = numIndexes - 1; i >= 0; i-- ) {
+		used[indexes[i]] = true;
+	}
+
+	const __m128 light = LoadVec3_SSE2( lightOrigin.ToFloatPtr() );
+	const __m128 view = LoadVec3_SSE2( viewOrigin.ToFloatPtr() );
+	const __m128 xyzMask = _mm_castsi128_ps( _mm_setr_epi32( -1, -1, -1, 0 ) );
+	const __m128 oneW = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		if ( !used[i] ) {
+			continue;
+		}
+
+		const idDrawVert *v = &verts[i];
+
+		__m128 xyz = _mm_and_ps( _mm_loadu_ps( v->xyz.ToFloatPtr() ), xyzMask );
+		__m128 lightDir = _mm_sub_ps( light, xyz );
+		__m128 viewDir = _mm_sub_ps( view, xyz );
+
+		// both squared lengths are summed at once
+		__m128 l2 = _mm_mul_ps( lightDir, lightDir );
+		__m128 v2 = _mm_mul_ps( viewDir, viewDir );
+		__m128 s = _mm_add_ps( _mm_unpacklo_ps( l2, v2 ), _mm_unpackhi_ps( l2, v2 ) );
+		s = _mm_add_ps( s, _mm_movehl_ps( s, s ) );
+		s = RSqrt_SSE2( s );
+
+		lightDir = _mm_mul_ps( lightDir, _mm_shuffle_ps( s, s, _MM_SHUFFLE( 0, 0, 0, 0 ) ) );
+		viewDir = _mm_mul_ps( viewDir, _mm_shuffle_ps( s, s, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+		lightDir = _mm_add_ps( lightDir, viewDir );
+
+		__m128 t0 = _mm_mul_ps( lightDir, LoadVec3_SSE2( v->tangents[0].ToFloatPtr() ) );
+		__m128 t1 = _mm_mul_ps( lightDir, LoadVec3_SSE2( v->tangents[1].ToFloatPtr() ) );
+		__m128 n = _mm_mul_ps( lightDir, LoadVec3_SSE2( v->normal.ToFloatPtr() ) );
+		__m128 w = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS( t0, t1, n, w );
+
+		_mm_storeu_ps( texCoords[i].ToFloatPtr(), _mm_add_ps( _mm_add_ps( _mm_add_ps( t0, t1 ), n ), oneW ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::CreateShadowCache
+
+  The vertex remap table is tested four entries at a time such that already
+  referenced stretches of vertices are skipped quickly.
+============
+*/
+int VPCALL idSIMD_SSE2::CreateShadowCache( idVec4 *vertexCache, int *vertRemap, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts ) {
+	int i, k, mask, outVerts = 0;
+	const __m128 light = LoadVec3_SSE2( lightOrigin.ToFloatPtr() );
+	const __m128 xyzMask = _mm_castsi128_ps( _mm_setr_epi32( -1, -1, -1, 0 ) );
+	const __m128 oneW = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+
+	for ( i = 0; i < numVerts; i += 4 ) {
+		if ( i + 4 <= numVerts ) {
+			__m128i remap = _mm_loadu_si128( (const __m128i *)( vertRemap + i ) );
+			mask = _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpeq_epi32( remap, _mm_setzero_si128() ) ) );
+		} else {
+			mask = 0;
+			for ( k = 0; i + k < numVerts; k++ ) {
+				mask |= ( vertRemap[i+k] == 0 ) << k;
+			}
+		}
+
+		for ( k = 0; mask != 0; k++, mask >>= 1 ) {
+			if ( !( mask & 1 ) ) {
+				continue;
+			}
+			// the fourth float loaded with the position is st[0] and is replaced
+			__m128 v = _mm_and_ps( _mm_loadu_ps( verts[i+k].xyz.ToFloatPtr() ), xyzMask );
+			_mm_storeu_ps( vertexCache[outVerts+0].ToFloatPtr(), _mm_or_ps( v, oneW ) );
+			// R_SetupProjection() builds the projection matrix with a slight crunch
+			// for depth, which keeps this w=0 division from rasterizing right at the
+			// wrap around point and causing depth fighting with the rear caps
+			_mm_storeu_ps( vertexCache[outVerts+1].ToFloatPtr(), _mm_sub_ps( v, light ) );
+			vertRemap[i+k] = outVerts;
+			outVerts += 2;
+		}
+	}
+	return outVerts;
+}
+
+/*
+============
+idSIMD_SSE2::CreateVertexProgramShadowCache
+============
+*/
+int VPCALL idSIMD_SSE2::CreateVertexProgramShadowCache( idVec4 *vertexCache, const idDrawVert *verts, const int numVerts ) {
+	const __m128 xyzMask = _mm_castsi128_ps( _mm_setr_epi32( -1, -1, -1, 0 ) );
+	const __m128 oneW = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		__m128 v = _mm_and_ps( _mm_loadu_ps( verts[i].xyz.ToFloatPtr() ), xyzMask );
+		_mm_storeu_ps( vertexCache[i*2+0].ToFloatPtr(), _mm_or_ps( v, oneW ) );
+		_mm_storeu_ps( vertexCache[i*2+1].ToFloatPtr(), v );
+	}
+	return numVerts * 2;
+}
+
+/*
+============
+UpSampleStore_SSE2
+
+  Stores four source floats duplicated for 44kHz output.
+  For stereo the source floats are two interleaved left/right pairs.
+============
+*/
+static ID_INLINE void UpSampleStore_SSE2( float *dest, const __m128 f, const int factor, const int numChannels ) {
+	if ( factor == 1 ) {
+		_mm_storeu_ps( dest, f );
+	} else if ( factor == 2 ) {
+		if ( numChannels == 1 ) {
+			_mm_storeu_ps( dest + 0, _mm_unpacklo_ps( f, f ) );
+			_mm_storeu_ps( dest + 4, _mm_unpackhi_ps( f, f ) );
+		} else {
+			_mm_storeu_ps( dest + 0, _mm_movelh_ps( f, f ) );
+			_mm_storeu_ps( dest + 4, _mm_movehl_ps( f, f ) );
+		}
+	} else {
+		if ( numChannels == 1 ) {
+			_mm_storeu_ps( dest +  0, _mm_shuffle_ps( f, f, _MM_SHUFFLE( 0, 0, 0, 0 ) ) );
+			_mm_storeu_ps( dest +  4, _mm_shuffle_ps( f, f, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+			_mm_storeu_ps( dest +  8, _mm_shuffle_ps( f, f, _MM_SHUFFLE( 2, 2, 2, 2 ) ) );
+			_mm_storeu_ps( dest + 12, _mm_shuffle_ps( f, f, _MM_SHUFFLE( 3, 3, 3, 3 ) ) );
+		} else {
+			__m128 lo = _mm_movelh_ps( f, f );
+			__m128 hi = _mm_movehl_ps( f, f );
+			_mm_storeu_ps( dest +  0, lo );
+			_mm_storeu_ps( dest +  4, lo );
+			_mm_storeu_ps( dest +  8, hi );
+			_mm_storeu_ps( dest + 12, hi );
+		}
+	}
+}
+
+/*
+============
+UpSampleFactor_SSE2
+============
+*/
+static int UpSampleFactor_SSE2( const int kHz ) {
+	switch( kHz ) {
+		case 11025: return 4;
+		case 22050: return 2;
+		case 44100: return 1;
+	}
+	return 0;
+}
+
+/*
+============
+idSIMD_SSE2::UpSamplePCMTo44kHz
+
+  Duplicate samples for 44kHz output.
+============
+*/
+void VPCALL idSIMD_SSE2::UpSamplePCMTo44kHz( float *dest, const short *src, const int numSamples, const int kHz, const int numChannels ) {
+	int i;
+	const int factor = UpSampleFactor_SSE2( kHz );
+
+	if ( factor == 0 ) {
+		idSIMD_Generic::UpSamplePCMTo44kHz( dest, src, numSamples, kHz, numChannels );
+		return;
+	}
+
+	for ( i = 0; i + 8 <= numSamples; i += 8 ) {
+		__m128i s = _mm_loadu_si128( (const __m128i *)( src + i ) );
+		// sign extend the shorts to integers
+		__m128 f0 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( s, s ), 16 ) );
+		__m128 f1 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( s, s ), 16 ) );
+		UpSampleStore_SSE2( dest + ( i + 0 ) * factor, f0, factor, numChannels );
+		UpSampleStore_SSE2( dest + ( i + 4 ) * factor, f1, factor, numChannels );
+	}
+
+	if ( i < numSamples ) {
+		idSIMD_Generic::UpSamplePCMTo44kHz( dest + i * factor, src + i, numSamples - i, kHz, numChannels );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::UpSampleOGGTo44kHz
+
+  Duplicate samples for 44kHz output.
+============
+*/
+void VPCALL idSIMD_SSE2::UpSampleOGGTo44kHz( float *dest, const float * const *ogg, const int numSamples, const int kHz, const int numChannels ) {
+	int i;
+	const int factor = UpSampleFactor_SSE2( kHz );
+	const __m128 scale = _mm_set1_ps( 32768.0f );
+
+	if ( factor == 0 ) {
+		idSIMD_Generic::UpSampleOGGTo44kHz( dest, ogg, numSamples, kHz, numChannels );
+		return;
+	}
+
+	if ( numChannels == 1 ) {
+		for ( i = 0; i + 4 <= numSamples; i += 4 ) {
+			UpSampleStore_SSE2( dest + i * factor, _mm_mul_ps( _mm_loadu_ps( ogg[0] + i ), scale ), factor, 1 );
+		}
+		if ( i < numSamples ) {
+			const float *tail[2] = { ogg[0] + i, NULL };
+			idSIMD_Generic::UpSampleOGGTo44kHz( dest + i * factor, tail, numSamples - i, kHz, 1 );
+		}
+	} else {
+		const int numPairs = numSamples >> 1;
+		for ( i = 0; i + 4 <= numPairs; i += 4 ) {
+			__m128 l = _mm_mul_ps( _mm_loadu_ps( ogg[0] + i ), scale );
+			__m128 r = _mm_mul_ps( _mm_loadu_ps( ogg[1] + i ), scale );
+			UpSampleStore_SSE2( dest + ( i + 0 ) * 2 * factor, _mm_unpacklo_ps( l, r ), factor, 2 );
+			UpSampleStore_SSE2( dest + ( i + 2 ) * 2 * factor, _mm_unpackhi_ps( l, r ), factor, 2 );
+		}
+		if ( i < numPairs ) {
+			const float *tail[2] = { ogg[0] + i, ogg[1] + i };
+			idSIMD_Generic::UpSampleOGGTo44kHz( dest + i * 2 * factor, tail, numSamples - i * 2, kHz, numChannels );
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MixSoundTwoSpeakerMono
+
+  The volume ramp is evaluated directly from the sample index instead
+  of being accumulated to avoid drift.
+============
+*/
+void VPCALL idSIMD_SSE2::MixSoundTwoSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	float sL = lastV[0];
+	float sR = lastV[1];
+	float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	const __m128 volBase0 = _mm_setr_ps( sL, sR, sL + incL, sR + incR );
+	const __m128 volBase1 = _mm_setr_ps( sL + 2.0f * incL, sR + 2.0f * incR, sL + 3.0f * incL, sR + 3.0f * incR );
+	const __m128 volInc = _mm_setr_ps( incL, incR, incL, incR );
+
+	for( int j = 0; j < MIXBUFFER_SAMPLES; j += 4 ) {
+		__m128 index = _mm_set1_ps( (float) j );
+		__m128 s = _mm_loadu_ps( samples + j );
+		float *m = mixBuffer + j * 2;
+		_mm_storeu_ps( m + 0, _mm_add_ps( _mm_loadu_ps( m + 0 ), _mm_mul_ps( _mm_unpacklo_ps( s, s ), _mm_add_ps( _mm_mul_ps( index, volInc ), volBase0 ) ) ) );
+		_mm_storeu_ps( m + 4, _mm_add_ps( _mm_loadu_ps( m + 4 ), _mm_mul_ps( _mm_unpackhi_ps( s, s ), _mm_add_ps( _mm_mul_ps( index, volInc ), volBase1 ) ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MixSoundTwoSpeakerStereo
+============
+*/
+void VPCALL idSIMD_SSE2::MixSoundTwoSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	float sL = lastV[0];
+	float sR = lastV[1];
+	float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	const __m128 volBase0 = _mm_setr_ps( sL, sR, sL + incL, sR + incR );
+	const __m128 volBase1 = _mm_setr_ps( sL + 2.0f * incL, sR + 2.0f * incR, sL + 3.0f * incL, sR + 3.0f * incR );
+	const __m128 volInc = _mm_setr_ps( incL, incR, incL, incR );
+
+	for( int j = 0; j < MIXBUFFER_SAMPLES; j += 4 ) {
+		__m128 index = _mm_set1_ps( (float) j );
+		float *m = mixBuffer + j * 2;
+		const float *s = samples + j * 2;
+		_mm_storeu_ps( m + 0, _mm_add_ps( _mm_loadu_ps( m + 0 ), _mm_mul_ps( _mm_loadu_ps( s + 0 ), _mm_add_ps( _mm_mul_ps( index, volInc ), volBase0 ) ) ) );
+		_mm_storeu_ps( m + 4, _mm_add_ps( _mm_loadu_ps( m + 4 ), _mm_mul_ps( _mm_loadu_ps( s + 4 ), _mm_add_ps( _mm_mul_ps( index, volInc ), volBase1 ) ) ) );
+	}
+}
+
+/*
+============
+SetupSixSpeakerVolumes_SSE2
+
+  Sets up the volumes and per sample volume increments for two consecutive samples of six speakers.
+============
+*/
+static ID_INLINE void SetupSixSpeakerVolumes_SSE2( __m128 volBase[3], __m128 volInc[3], const float lastV[6], const float currentV[6] ) {
+	ALIGN16( float v[12] );
+	ALIGN16( float inc[12] );
+
+	for ( int i = 0; i < 6; i++ ) {
+		float incV = ( currentV[i] - lastV[i] ) / MIXBUFFER_SAMPLES;
+		for ( int j = 0; j < 2; j++ ) {
+			v[j*6+i] = lastV[i] + j * incV;
+			inc[j*6+i] = incV;
+		}
+	}
+	for ( int i = 0; i < 3; i++ ) {
+		volBase[i] = _mm_loadu_ps( v + i * 4 );
+		volInc[i] = _mm_loadu_ps( inc + i * 4 );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MixSoundSixSpeakerMono
+============
+*/
+void VPCALL idSIMD_SSE2::MixSoundSixSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	__m128 volBase[3], volInc[3];
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	SetupSixSpeakerVolumes_SSE2( volBase, volInc, lastV, currentV );
+
+	for( int i = 0; i < MIXBUFFER_SAMPLES; i += 2 ) {
+		const __m128 index = _mm_set1_ps( (float) i );
+		__m128 s = _mm_loadl_pi( _mm_setzero_ps(), (const __m64 *)( samples + i ) );
+		float *m = mixBuffer + i * 6;
+		_mm_storeu_ps( m + 0, _mm_add_ps( _mm_loadu_ps( m + 0 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 0, 0, 0, 0 ) ), _mm_add_ps( _mm_mul_ps( index, volInc[0] ), volBase[0] ) ) ) );
+		_mm_storeu_ps( m + 4, _mm_add_ps( _mm_loadu_ps( m + 4 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 1, 1, 0, 0 ) ), _mm_add_ps( _mm_mul_ps( index, volInc[1] ), volBase[1] ) ) ) );
+		_mm_storeu_ps( m + 8, _mm_add_ps( _mm_loadu_ps( m + 8 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 1, 1, 1, 1 ) ), _mm_add_ps( _mm_mul_ps( index, volInc[2] ), volBase[2] ) ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MixSoundSixSpeakerStereo
+
+  The left channel feeds speakers 0, 2, 3 and 4, the right channel feeds speakers 1 and 5.
+============
+*/
+void VPCALL idSIMD_SSE2::MixSoundSixSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	__m128 volBase[3], volInc[3];
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	SetupSixSpeakerVolumes_SSE2( volBase, volInc, lastV, currentV );
+
+	for( int i = 0; i < MIXBUFFER_SAMPLES; i += 2 ) {
+		const __m128 index = _mm_set1_ps( (float) i );
+		__m128 s = _mm_loadu_ps( samples + i * 2 );
+		float *m = mixBuffer + i * 6;
+		_mm_storeu_ps( m + 0, _mm_add_ps( _mm_loadu_ps( m + 0 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 0, 0, 1, 0 ) ), _mm_add_ps( _mm_mul_ps( index, volInc[0] ), volBase[0] ) ) ) );
+		_mm_storeu_ps( m + 4, _mm_add_ps( _mm_loadu_ps( m + 4 ), _mm_mul_ps( s, _mm_add_ps( _mm_mul_ps( index, volInc[1] ), volBase[1] ) ) ) );
+		_mm_storeu_ps( m + 8, _mm_add_ps( _mm_loadu_ps( m + 8 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 3, 2, 2, 2 ) ), _mm_add_ps( _mm_mul_ps( index, volInc[2] ), volBase[2] ) ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MixedSoundToSamples
+============
+*/
+void VPCALL idSIMD_SSE2::MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples ) {
+	int i;
+	const __m128 minSample = _mm_set1_ps( -32768.0f );
+	const __m128 maxSample = _mm_set1_ps( 32767.0f );
+
+	for ( i = 0; i + 8 <= numSamples; i += 8 ) {
+		__m128 a = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( mixBuffer + i + 0 ), minSample ), maxSample );
+		__m128 b = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( mixBuffer + i + 4 ), minSample ), maxSample );
+		_mm_storeu_si128( (__m128i *)( samples + i ), _mm_packs_epi32( _mm_cvttps_epi32( a ), _mm_cvttps_epi32( b ) ) );
+	}
+
+	for ( ; i < numSamples; i++ ) {
+		if ( mixBuffer[i] <= -32768.0f ) {
+			samples[i] = -32768;
+		} else if ( mixBuffer[i] >= 32767.0f ) {
+			samples[i] = 32767;
+		} else {
+			samples[i] = (short) mixBuffer[i];
+		}
+	}
+}
+
+#endif /* ID_SIMD_SSE2_INTRINSICS */
@@ -101,6 +101,7 @@ If you have questions concerning this license or the applicable additional terms
 #include <time.h>
 #include <ctype.h>
 #include <typeinfo>
+#include <new>
 #include <errno.h>
 #include <math.h>
 
@@ -121,6 +122,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "../framework/Common.h"
 #include "../framework/File.h"
 #include "../framework/FileSystem.h"
+#include "../framework/ParallelJobs.h"
 #include "../framework/UsercmdGen.h"
 
 // decls
@@ -326,9 +326,6 @@ public:
 	// returns the number of bytes of image data bound in the previous frame
 	int					SumOfUsedImages();
 
-	// called each frame to allow some cvars to automatically force changes
-	void				CheckCvars();
-
 	// purges all the images before a vid_restart
 	void				PurgeAllImages();
 
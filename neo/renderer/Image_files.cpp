@@ -245,8 +245,8 @@ static void LoadBMP( const char *name, byte **pic, int *width, int *height, ID_T
 	int		columns, rows, numPixels;
 	byte	*pixbuf;
 	int		row, column;
-	byte	*buf_p;
-	byte	*buffer;
+	const byte	*buf_p;
+	const byte	*buffer;
 	int		length;
 	BMPHeader_t bmpHeader;
 	byte		*bmpRGBA;
@@ -261,7 +261,7 @@ static void LoadBMP( const char *name, byte **pic, int *width, int *height, ID_T
 	//
 	// load the file
 	//
-	length = fileSystem->ReadFile( name, (void **)&buffer, timestamp );
+	length = fileSystem->ReadFileMapped( name, (const void **)&buffer, timestamp );
 	if ( !buffer ) {
 		return;
 	}
@@ -390,7 +390,7 @@ static void LoadBMP( const char *name, byte **pic, int *width, int *height, ID_T
 		}
 	}
 
-	fileSystem->FreeFile( buffer );
+	fileSystem->FreeFileMapped( buffer );
 
 }
 
@@ -557,8 +557,8 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 	int		columns, rows, numPixels, fileSize, numBytes;
 	byte	*pixbuf;
 	int		row, column;
-	byte	*buf_p;
-	byte	*buffer;
+	const byte	*buf_p;
+	const byte	*buffer;
 	TargaHeader	targa_header;
 	byte		*targa_rgba;
 
@@ -572,7 +572,7 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 	//
 	// load the file
 	//
-	fileSize = fileSystem->ReadFile( name, (void **)&buffer, timestamp );
+	fileSize = fileSystem->ReadFileMapped( name, (const void **)&buffer, timestamp );
 	if ( !buffer ) {
 		return;
 	}
@@ -782,7 +782,7 @@ static void LoadTGA( const char *name, byte **pic, int *width, int *height, ID_T
 		R_VerticalFlip( *pic, *width, *height );
 	}
 
-	fileSystem->FreeFile( buffer );
+	fileSystem->FreeFileMapped( buffer );
 }
 
 /*
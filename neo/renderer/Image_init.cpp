@@ -1874,21 +1874,6 @@ void idImageManager::CompleteBackgroundImageLoads() {
 	backgroundImageLoads = remainingList;
 }
 
-/*
-===============
-CheckCvars
-===============
-*/
-void idImageManager::CheckCvars() {
-	// textureFilter stuff
-	if ( image_filter.IsModified() || image_anisotropy.IsModified() || image_lodbias.IsModified() ) {
-		ChangeTextureFilter();
-		image_filter.ClearModified();
-		image_anisotropy.ClearModified();
-		image_lodbias.ClearModified();
-	}
-}
-
 /*
 ===============
 SumOfUsedImages
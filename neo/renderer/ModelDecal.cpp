@@ -339,7 +339,8 @@ void idRenderModelDecal::CreateDecal( const idRenderModel *model, const decalPro
 			}
 
 			// create a winding with texture coordinates for the triangle
-			idFixedWinding fw;
+			// a triangle clipped by all the bounding planes can't have more than 3 + NUM_DECAL_BOUNDING_PLANES points
+			idStackWinding<3 + NUM_DECAL_BOUNDING_PLANES + 1> fw;
 			fw.SetNumPoints( 3 );
 			if ( localInfo.parallel ) {
 				for ( int j = 0; j < 3; j++ ) {
@@ -363,16 +364,16 @@ void idRenderModelDecal::CreateDecal( const idRenderModel *model, const decalPro
 
 			int orBits = cullBits[v1] | cullBits[v2] | cullBits[v3];
 
-			// clip the exact surface triangle to the projection volume
+			// clip the exact surface triangle to the projection volume in one pass
+			idPlane clipPlanes[NUM_DECAL_BOUNDING_PLANES];
+			int numClipPlanes = 0;
 			for ( int j = 0; j < NUM_DECAL_BOUNDING_PLANES; j++ ) {
 				if ( orBits & ( 1 << j ) ) {
-					if ( !fw.ClipInPlace( -localInfo.boundingPlanes[j] ) ) {
-						break;
-					}
+					clipPlanes[numClipPlanes++] = -localInfo.boundingPlanes[j];
 				}
 			}
 
-			if ( fw.GetNumPoints() == 0 ) {
+			if ( !fw.ClipInPlace( clipPlanes, numClipPlanes ) ) {
 				continue;
 			}
 
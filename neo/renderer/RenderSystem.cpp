@@ -268,16 +268,48 @@ void R_LockSurfaceScene( viewDef_t *parms ) {
 =============
 R_CheckCvars
 
-See if some cvars that we watch have changed
+See if some cvars that we watch have changed.
+Polls the cvar change journal instead of the modified flag of every cvar.
 =============
 */
 static void R_CheckCvars( void ) {
-	globalImages->CheckCvars();
+	static int			changeSequence = -1;	// starts out of date so everything is applied once
+	static cvarHandle_t	gamma = -1, brightness = -1, filter = -1, anisotropy = -1, lodBias = -1;
+	cvarHandle_t		changed[16];
+	int					i, num;
+	bool				gammaChanged, filterChanged;
+
+	if ( gamma == -1 ) {
+		gamma = cvarSystem->GetHandle( r_gamma.GetName() );
+		brightness = cvarSystem->GetHandle( r_brightness.GetName() );
+		filter = cvarSystem->GetHandle( idImageManager::image_filter.GetName() );
+		anisotropy = cvarSystem->GetHandle( idImageManager::image_anisotropy.GetName() );
+		lodBias = cvarSystem->GetHandle( idImageManager::image_lodbias.GetName() );
+	}
+
+	gammaChanged = filterChanged = false;
+	do {
+		num = cvarSystem->GetChangedCVars( changeSequence, changed, 16 );
+		if ( num < 0 ) {
+			gammaChanged = filterChanged = true;
+			break;
+		}
+		for ( i = 0; i < num; i++ ) {
+			if ( changed[i] == gamma || changed[i] == brightness ) {
+				gammaChanged = true;
+			} else if ( changed[i] == filter || changed[i] == anisotropy || changed[i] == lodBias ) {
+				filterChanged = true;
+			}
+		}
+	} while ( num == 16 );
+
+	// textureFilter stuff
+	if ( filterChanged ) {
+		globalImages->ChangeTextureFilter();
+	}
 
 	// gamma stuff
-	if ( r_gamma.IsModified() || r_brightness.IsModified() ) {
-		r_gamma.ClearModified();
-		r_brightness.ClearModified();
+	if ( gammaChanged ) {
 		R_SetColorMappings();
 	}
 
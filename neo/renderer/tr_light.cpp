@@ -1338,6 +1338,8 @@ static void R_AddAmbientDrawsurfs( viewEntity_t *vEntity ) {
 	srfTriangles_t		*tri;
 	idRenderModel		*model;
 	const idMaterial	*shader;
+	idBounds			*surfBounds;
+	dword				*cullBits;
 
 	def = vEntity->entityDef;
 
@@ -1347,8 +1349,22 @@ static void R_AddAmbientDrawsurfs( viewEntity_t *vEntity ) {
 		model = def->parms.hModel;
 	}
 
-	// add all the surfaces
 	total = model->NumSurfaces();
+
+	// cull the bounds of all the surfaces at once
+	surfBounds = (idBounds *) _alloca16( total * sizeof( idBounds ) );
+	cullBits = (dword *) _alloca16( ( ( total + 31 ) >> 5 ) * sizeof( dword ) );
+	for ( i = 0 ; i < total ; i++ ) {
+		tri = model->Surface( i )->geometry;
+		if ( tri ) {
+			surfBounds[i] = tri->bounds;
+		} else {
+			surfBounds[i].Zero();
+		}
+	}
+	R_CullLocalBoxes( cullBits, surfBounds, total, vEntity->modelMatrix, 5, tr.viewDef->frustum );
+
+	// add all the surfaces
 	for ( i = 0 ; i < total ; i++ ) {
 		const modelSurface_t	*surf = model->Surface( i );
 
@@ -1398,7 +1414,7 @@ static void R_AddAmbientDrawsurfs( viewEntity_t *vEntity ) {
 			}
 		}
 
-		if ( !R_CullLocalBox( tri->bounds, vEntity->modelMatrix, 5, tr.viewDef->frustum ) ) {
+		if ( !( cullBits[i >> 5] & ( (dword)1 << ( i & 31 ) ) ) ) {
 
 			def->visibleCount = tr.viewCount;
 
@@ -1136,6 +1136,8 @@ void R_RenderView( viewDef_t *parms );
 bool R_CullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
 bool R_RadiusCullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
 bool R_CornerCullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
+// culls boxes with the same model matrix at once, sets a bit in cullBits for every culled box
+int R_CullLocalBoxes( dword *cullBits, const idBounds *bounds, const int numBounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
 
 void R_AxisToModelMatrix( const idMat3 &axis, const idVec3 &origin, float modelMatrix[16] );
 
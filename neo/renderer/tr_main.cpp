@@ -679,6 +679,46 @@ bool R_CullLocalBox( const idBounds &bounds, const float modelMatrix[16], int nu
 	return R_CornerCullLocalBox( bounds, modelMatrix, numPlanes, planes );
 }
 
+/*
+=================
+R_CullLocalBoxes
+
+Culls an array of boxes that share a model matrix in a single call by
+transforming the planes into local space, bit i of cullBits is set when
+bounds[i] is outside the given global frustum, (positive sides are out)
+Returns the number of culled boxes
+=================
+*/
+int R_CullLocalBoxes( dword *cullBits, const idBounds *bounds, const int numBounds, const float modelMatrix[16], int numPlanes, const idPlane *planes ) {
+	int			i, numCulled;
+	idPlane		*localPlanes;
+
+	// without corner culling fall back to the radius cull of each box
+	if ( r_useCulling.GetInteger() < 2 ) {
+		memset( cullBits, 0, ( ( numBounds + 31 ) >> 5 ) * sizeof( dword ) );
+		numCulled = 0;
+		for ( i = 0 ; i < numBounds ; i++ ) {
+			if ( R_RadiusCullLocalBox( bounds[i], modelMatrix, numPlanes, planes ) ) {
+				cullBits[i >> 5] |= (dword)1 << ( i & 31 );
+				numCulled++;
+			}
+		}
+		return numCulled;
+	}
+
+	localPlanes = (idPlane *) _alloca16( numPlanes * sizeof( idPlane ) );
+	for ( i = 0 ; i < numPlanes ; i++ ) {
+		R_GlobalPlaneToLocal( modelMatrix, planes[i], localPlanes[i] );
+	}
+
+	numCulled = SIMDProcessor->CullBounds( cullBits, localPlanes, numPlanes, bounds, numBounds );
+
+	tr.pc.c_box_cull_out += numCulled;
+	tr.pc.c_box_cull_in += numBounds - numCulled;
+
+	return numCulled;
+}
+
 /*
 ==========================
 R_TransformModelToClip
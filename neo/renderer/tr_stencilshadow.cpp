@@ -447,6 +447,37 @@ static int R_ChopWinding( clipTri_t clipTris[2], int inNum, const idPlane &plane
 	return inNum ^ 1;
 }
 
+/*
+===================
+R_TriangleCutPlaneBits
+
+Returns the subset of planeBits for the planes that actually cut the triangle
+or -1 if the triangle is completely clipped away by one of the planes
+===================
+*/
+static int R_TriangleCutPlaneBits( const idVec3 &a, const idVec3 &b, const idVec3 &c, int planeBits, const idPlane frustum[6] ) {
+	int		i, cutBits;
+	float	da, db, dc;
+
+	cutBits = 0;
+	for ( i = 0 ; i < 6 ; i++ ) {
+		if ( !( planeBits & ( 1 << i ) ) ) {
+			continue;
+		}
+		da = frustum[i].Distance( a );
+		db = frustum[i].Distance( b );
+		dc = frustum[i].Distance( c );
+		// if none in front, it is completely clipped away
+		if ( da <= LIGHT_CLIP_EPSILON && db <= LIGHT_CLIP_EPSILON && dc <= LIGHT_CLIP_EPSILON ) {
+			return -1;
+		}
+		if ( da < -LIGHT_CLIP_EPSILON || db < -LIGHT_CLIP_EPSILON || dc < -LIGHT_CLIP_EPSILON ) {
+			cutBits |= 1 << i;
+		}
+	}
+	return cutBits;
+}
+
 /*
 ===================
 R_ClipTriangleToLight
@@ -469,6 +500,13 @@ static bool	R_ClipTriangleToLight( const idVec3 &a, const idVec3 &b, const idVec
 	pingPong[0].verts[1] = b;
 	pingPong[0].verts[2] = c;
 
+	// classify the corners against all the planes up front, the triangle is convex so a
+	// plane that doesn't cut the corners can't cut anything that is left after clipping
+	planeBits = R_TriangleCutPlaneBits( a, b, c, planeBits, frustum );
+	if ( planeBits < 0 ) {
+		return false;
+	}
+
 	p = 0;
 	for ( i = 0 ; i < 6 ; i++ ) {
 		if ( planeBits & ( 1 << i ) ) {
@@ -0,0 +1,406 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+/*
+===============================================================================
+
+	idlibbench
+
+	Runs the idlib benchmarks outside of the engine, linked against nothing
+	but the idlib objects. idSys and idCommon are minimal stand-ins that
+	print to stdout, there is no file system, cvar system or job manager.
+
+	idlibbench <benchmark> [arguments]
+
+===============================================================================
+*/
+
+#include "../../idlib/precompiled.h"
+#include <time.h>
+#include <xmmintrin.h>
+
+#define	MAX_PRINT_MSG_SIZE	4096
+
+#define MXCSR_DAZ	( 1 << 6 )
+#define MXCSR_FTZ	( 1 << 15 )
+
+idSys *				sys = NULL;
+idCommon *			common = NULL;
+idCVarSystem *		cvarSystem = NULL;
+idCVar *			idCVar::staticVars = NULL;
+
+/*
+==============================================================
+
+	idSysBench
+
+==============================================================
+*/
+
+class idSysBench : public idSys {
+public:
+	virtual void			DebugPrintf( const char *fmt, ... )id_attribute((format(printf,2,3)));
+	virtual void			DebugVPrintf( const char *fmt, va_list arg );
+
+	virtual double			GetClockTicks( void );
+	virtual double			ClockTicksPerSecond( void );
+	virtual cpuid_t			GetProcessorId( void );
+	virtual const char *	GetProcessorString( void ) { return "generic"; }
+	virtual const char *	FPU_GetState( void ) { return ""; }
+	virtual bool			FPU_StackIsEmpty( void ) { return true; }
+	virtual void			FPU_SetFTZ( bool enable );
+	virtual void			FPU_SetDAZ( bool enable );
+
+	virtual void			FPU_EnableExceptions( int exceptions ) {}
+
+	virtual bool			LockMemory( void *ptr, int bytes ) { return false; }
+	virtual bool			UnlockMemory( void *ptr, int bytes ) { return false; }
+
+	virtual void			GetCallStack( address_t *callStack, const int callStackSize ) { memset( callStack, 0, callStackSize * sizeof( callStack[0] ) ); }
+	virtual const char *	GetCallStackStr( const address_t *callStack, const int callStackSize ) { return ""; }
+	virtual const char *	GetCallStackCurStr( int depth ) { return ""; }
+	virtual void			ShutdownSymbols( void ) {}
+
+	virtual int				DLL_Load( const char *dllName ) { return 0; }
+	virtual void *			DLL_GetProcAddress( int dllHandle, const char *procName ) { return NULL; }
+	virtual void			DLL_Unload( int dllHandle ) {}
+	virtual void			DLL_GetFileName( const char *baseName, char *dllName, int maxLength ) { idStr::snPrintf( dllName, maxLength, "%s.so", baseName ); }
+
+	virtual sysEvent_t		GenerateMouseButtonEvent( int button, bool down ) { sysEvent_t ev; memset( &ev, 0, sizeof( ev ) ); return ev; }
+	virtual sysEvent_t		GenerateMouseMoveEvent( int deltax, int deltay ) { sysEvent_t ev; memset( &ev, 0, sizeof( ev ) ); return ev; }
+
+	virtual void			OpenURL( const char *url, bool quit ) {}
+	virtual void			StartProcess( const char *exePath, bool quit ) {}
+};
+
+void idSysBench::DebugPrintf( const char *fmt, ... ) {
+	va_list argptr;
+
+	va_start( argptr, fmt );
+	vfprintf( stderr, fmt, argptr );
+	va_end( argptr );
+}
+
+void idSysBench::DebugVPrintf( const char *fmt, va_list arg ) {
+	vfprintf( stderr, fmt, arg );
+}
+
+/*
+==============
+idSysBench::GetClockTicks
+
+  same serialized rdtsc as Sys_GetClockTicks
+==============
+*/
+double idSysBench::GetClockTicks( void ) {
+#if defined( __i386__ )
+	unsigned long lo, hi;
+
+	__asm__ __volatile__ (
+						  "push %%ebx\n"			\
+						  "xor %%eax,%%eax\n"		\
+						  "cpuid\n"					\
+						  "rdtsc\n"					\
+						  "mov %%eax,%0\n"			\
+						  "mov %%edx,%1\n"			\
+						  "pop %%ebx\n"
+						  : "=r" (lo), "=r" (hi) );
+	return (double) lo + (double) 0xFFFFFFFF * hi;
+#elif defined( __x86_64__ )
+	unsigned int lo, hi;
+
+	__asm__ __volatile__ (
+						  "xor %%eax,%%eax\n"		\
+						  "cpuid\n"					\
+						  "rdtsc\n"
+						  : "=a" (lo), "=d" (hi) : : "rbx", "rcx" );
+	return (double) lo + 4294967296.0 * hi;
+#else
+#error unsupported CPU
+#endif
+}
+
+/*
+==============
+idSysBench::ClockTicksPerSecond
+
+  measured once against the monotonic clock
+==============
+*/
+double idSysBench::ClockTicksPerSecond( void ) {
+	static double ticksPerSecond = 0.0;
+
+	if ( ticksPerSecond == 0.0 ) {
+		struct timespec t0, t1, wait;
+		wait.tv_sec = 0;
+		wait.tv_nsec = 100 * 1000 * 1000;
+
+		clock_gettime( CLOCK_MONOTONIC, &t0 );
+		double ticks0 = GetClockTicks();
+		nanosleep( &wait, NULL );
+		clock_gettime( CLOCK_MONOTONIC, &t1 );
+		double ticks1 = GetClockTicks();
+
+		double seconds = ( t1.tv_sec - t0.tv_sec ) + ( t1.tv_nsec - t0.tv_nsec ) * 1e-9;
+		ticksPerSecond = ( ticks1 - ticks0 ) / seconds;
+	}
+	return ticksPerSecond;
+}
+
+/*
+==============
+idSysBench::GetProcessorId
+==============
+*/
+cpuid_t idSysBench::GetProcessorId( void ) {
+	int flags = CPUID_GENERIC;
+
+	__builtin_cpu_init();
+	if ( __builtin_cpu_supports( "mmx" ) ) {
+		flags |= CPUID_MMX;
+	}
+	if ( __builtin_cpu_supports( "sse" ) ) {
+		flags |= CPUID_SSE | CPUID_FTZ;
+	}
+	if ( __builtin_cpu_supports( "sse2" ) ) {
+		flags |= CPUID_SSE2;
+	}
+	if ( __builtin_cpu_supports( "sse3" ) ) {
+		flags |= CPUID_SSE3 | CPUID_DAZ;
+	}
+	if ( __builtin_cpu_supports( "avx2" ) ) {
+		flags |= CPUID_AVX2;
+	}
+	if ( __builtin_cpu_supports( "fma" ) ) {
+		flags |= CPUID_FMA3;
+	}
+	if ( __builtin_cpu_supports( "pclmul" ) ) {
+		flags |= CPUID_PCLMUL;
+	}
+	return (cpuid_t)flags;
+}
+
+void idSysBench::FPU_SetFTZ( bool enable ) {
+	_mm_setcsr( enable ? ( _mm_getcsr() | MXCSR_FTZ ) : ( _mm_getcsr() & ~MXCSR_FTZ ) );
+}
+
+void idSysBench::FPU_SetDAZ( bool enable ) {
+	_mm_setcsr( enable ? ( _mm_getcsr() | MXCSR_DAZ ) : ( _mm_getcsr() & ~MXCSR_DAZ ) );
+}
+
+/*
+==============================================================
+
+	idCommonBench
+
+==============================================================
+*/
+
+class idCommonBench : public idCommon {
+public:
+	virtual void				Init( int argc, const char **argv, const char *cmdline ) {}
+	virtual void				Shutdown( void ) {}
+	virtual void				Quit( void ) { exit( 0 ); }
+	virtual bool				IsInitialized( void ) const { return true; }
+	virtual void				Frame( void ) {}
+	virtual void				GUIFrame( bool execCmd, bool network ) {}
+	virtual void				Async( void ) {}
+	virtual void				StartupVariable( const char *match, bool once ) {}
+	virtual void				InitTool( const toolFlag_t tool, const idDict *dict ) {}
+	virtual void				ActivateTool( bool active ) {}
+	virtual void				WriteConfigToFile( const char *filename ) {}
+	virtual void				WriteFlaggedCVarsToFile( const char *filename, int flags, const char *setCmd ) {}
+	virtual void				BeginRedirect( char *buffer, int buffersize, void (*flush)( const char * ) ) {}
+	virtual void				EndRedirect( void ) {}
+	virtual void				SetRefreshOnPrint( bool set ) {}
+	virtual void				Printf( const char *fmt, ... ) id_attribute((format(printf,2,3)));
+	virtual void				VPrintf( const char *fmt, va_list arg );
+	virtual void				DPrintf( const char *fmt, ... ) id_attribute((format(printf,2,3)));
+	virtual void				Warning( const char *fmt, ... ) id_attribute((format(printf,2,3)));
+	virtual void				DWarning( const char *fmt, ...) id_attribute((format(printf,2,3)));
+	virtual void				PrintWarnings( void ) {}
+	virtual void				ClearWarnings( const char *reason ) {}
+	virtual void				Error( const char *fmt, ... ) id_attribute((format(printf,2,3)));
+	virtual void				FatalError( const char *fmt, ... ) id_attribute((format(printf,2,3)));
+	virtual const idLangDict *	GetLanguageDict( void ) { return NULL; }
+	virtual const char *		KeysFromBinding( const char *bind ) { return ""; }
+	virtual const char *		BindingFromKey( const char *key ) { return ""; }
+	virtual int					ButtonState( int key ) { return 0; }
+	virtual int					KeyState( int key ) { return 0; }
+};
+
+/*
+==============
+idCommonBench::VPrintf
+
+  color escapes are stripped, the output is meant for a terminal or a log
+==============
+*/
+void idCommonBench::VPrintf( const char *fmt, va_list arg ) {
+	char msg[MAX_PRINT_MSG_SIZE];
+
+	idStr::vsnPrintf( msg, sizeof( msg ), fmt, arg );
+	idStr::RemoveColors( msg );
+	fputs( msg, stdout );
+}
+
+void idCommonBench::Printf( const char *fmt, ... ) {
+	va_list argptr;
+
+	va_start( argptr, fmt );
+	VPrintf( fmt, argptr );
+	va_end( argptr );
+}
+
+void idCommonBench::DPrintf( const char *fmt, ... ) {
+	va_list argptr;
+
+	va_start( argptr, fmt );
+	VPrintf( fmt, argptr );
+	va_end( argptr );
+}
+
+void idCommonBench::Warning( const char *fmt, ... ) {
+	char msg[MAX_PRINT_MSG_SIZE];
+	va_list argptr;
+
+	va_start( argptr, fmt );
+	idStr::vsnPrintf( msg, sizeof( msg ), fmt, argptr );
+	va_end( argptr );
+	idStr::RemoveColors( msg );
+	fprintf( stdout, "WARNING: %s\n", msg );
+}
+
+void idCommonBench::DWarning( const char *fmt, ... ) {
+	char msg[MAX_PRINT_MSG_SIZE];
+	va_list argptr;
+
+	va_start( argptr, fmt );
+	idStr::vsnPrintf( msg, sizeof( msg ), fmt, argptr );
+	va_end( argptr );
+	idStr::RemoveColors( msg );
+	fprintf( stdout, "WARNING: %s\n", msg );
+}
+
+void idCommonBench::Error( const char *fmt, ... ) {
+	char msg[MAX_PRINT_MSG_SIZE];
+	va_list argptr;
+
+	va_start( argptr, fmt );
+	idStr::vsnPrintf( msg, sizeof( msg ), fmt, argptr );
+	va_end( argptr );
+	fprintf( stderr, "ERROR: %s\n", msg );
+	exit( 1 );
+}
+
+void idCommonBench::FatalError( const char *fmt, ... ) {
+	char msg[MAX_PRINT_MSG_SIZE];
+	va_list argptr;
+
+	va_start( argptr, fmt );
+	idStr::vsnPrintf( msg, sizeof( msg ), fmt, argptr );
+	va_end( argptr );
+	fprintf( stderr, "FATAL ERROR: %s\n", msg );
+	exit( 1 );
+}
+
+/*
+==============================================================
+
+	main
+
+==============================================================
+*/
+
+typedef struct {
+	const char *		name;
+	void				(*function)( const idCmdArgs &args );
+	const char *		description;
+} benchCommand_t;
+
+static const benchCommand_t benchCommands[] = {
+	{ "simd",		idSIMD::Bench_f,		"regression test and benchmark SIMD code" },
+	{ "hashtable",	FlatHashTable_Bench_f,	"compares the speed of the hash table containers" },
+	{ "btree",		PackedBTree_Bench_f,	"compares the speed of idPackedBTree and idBTree" },
+	{ "winding",	Winding_Bench_f,		"compares the speed of single and multi-plane winding clipping" },
+	{ "matx",		MatX_Bench_f,			"compares the speed of the blocked idMatX factorizations" },
+	{ "hash",		Hash_Bench_f,			"compares the throughput of the checksum and hash functions" },
+	{ "bitmsg",		BitMsg_Bench_f,			"encodes and decodes snapshot payloads with idBitMsg" },
+	{ NULL,			NULL,					NULL }
+};
+
+static void Usage( void ) {
+	printf( "usage: idlibbench <benchmark> [arguments]\n" );
+	for ( int i = 0; benchCommands[i].name; i++ ) {
+		printf( "  %-10s %s\n", benchCommands[i].name, benchCommands[i].description );
+	}
+}
+
+int main( int argc, char **argv ) {
+	idSysBench		sysBench;
+	idCommonBench	commonBench;
+	idCmdArgs		args;
+	int				i;
+
+	if ( argc < 2 ) {
+		Usage();
+		return 1;
+	}
+
+	for ( i = 0; benchCommands[i].name; i++ ) {
+		if ( idStr::Icmp( argv[1], benchCommands[i].name ) == 0 ) {
+			break;
+		}
+	}
+	if ( !benchCommands[i].name ) {
+		Usage();
+		return 1;
+	}
+
+	sys = &sysBench;
+	common = &commonBench;
+
+	idLib::sys = sys;
+	idLib::common = common;
+	idLib::cvarSystem = NULL;
+	idLib::fileSystem = NULL;
+	idLib::parallelJobManager = NULL;
+	idLib::Init();
+
+	idSIMD::InitProcessor( "idlibbench", false );
+
+	for ( int j = 1; j < argc; j++ ) {
+		args.AppendArg( argv[j] );
+	}
+	benchCommands[i].function( args );
+
+	idSIMD::Shutdown();
+	idLib::ShutDown();
+
+	return 0;
+}
@@ -201,13 +201,101 @@ void Sys_Shutdown( void ) {
 	Posix_Shutdown();
 }
 
+#if defined(__i386__) || defined(__x86_64__)
+
+/*
+===============
+Sys_CPUID
+===============
+*/
+static void Sys_CPUID( unsigned func, unsigned subFunc, unsigned regs[4] ) {
+#if defined(__i386__)
+	// ebx is the PIC register
+	__asm__ __volatile__( "movl %%ebx, %1\n\tcpuid\n\txchgl %%ebx, %1"
+		: "=a" ( regs[0] ), "=&r" ( regs[1] ), "=c" ( regs[2] ), "=d" ( regs[3] )
+		: "a" ( func ), "c" ( subFunc ) );
+#else
+	__asm__ __volatile__( "cpuid"
+		: "=a" ( regs[0] ), "=b" ( regs[1] ), "=c" ( regs[2] ), "=d" ( regs[3] )
+		: "a" ( func ), "c" ( subFunc ) );
+#endif
+}
+
+/*
+===============
+Sys_GetVectorExtensions
+
+  Only reports the extensions that have a dedicated SIMD implementation on this platform.
+  AVX2 is only reported when the OS saves the YMM registers on context switches.
+===============
+*/
+static int Sys_GetVectorExtensions( void ) {
+	unsigned regs[4];
+	unsigned xcr0, edx;
+	int flags = 0;
+
+	Sys_CPUID( 0, 0, regs );
+	const unsigned maxFunc = regs[0];
+	if ( maxFunc < 1 ) {
+		return 0;
+	}
+
+	Sys_CPUID( 1, 0, regs );
+	if ( regs[3] & ( 1 << 23 ) ) {
+		flags |= CPUID_MMX;
+	}
+	if ( regs[3] & ( 1 << 25 ) ) {
+		flags |= CPUID_SSE;
+	}
+	if ( regs[3] & ( 1 << 26 ) ) {
+		flags |= CPUID_SSE2;
+	}
+	if ( regs[2] & ( 1 << 0 ) ) {
+		flags |= CPUID_SSE3;
+	}
+	if ( regs[2] & ( 1 << 1 ) ) {
+		flags |= CPUID_PCLMUL;
+	}
+
+	// OSXSAVE and AVX
+	if ( maxFunc < 7 || ( regs[2] & ( 3 << 27 ) ) != ( 3 << 27 ) ) {
+		return flags;
+	}
+	const bool fma = ( regs[2] & ( 1 << 12 ) ) != 0;
+
+	// the OS has to save the XMM and YMM registers
+	__asm__ __volatile__( ".byte 0x0f, 0x01, 0xd0" : "=a" ( xcr0 ), "=d" ( edx ) : "c" ( 0 ) );
+	if ( ( xcr0 & 6 ) != 6 ) {
+		return flags;
+	}
+
+	Sys_CPUID( 7, 0, regs );
+	if ( regs[1] & ( 1 << 5 ) ) {
+		flags |= CPUID_AVX2;
+	}
+	if ( fma ) {
+		flags |= CPUID_FMA3;
+	}
+	return flags;
+}
+
+#endif
+
 /*
 ===============
 Sys_GetProcessorId
 ===============
 */
 cpuid_t Sys_GetProcessorId( void ) {
+#if defined(__i386__) || defined(__x86_64__)
+	static int vectorFlags = -1;
+	if ( vectorFlags == -1 ) {
+		vectorFlags = Sys_GetVectorExtensions();
+	}
+	return (cpuid_t)( CPUID_GENERIC | vectorFlags );
+#else
 	return CPUID_GENERIC;
+#endif
 }
 
 /*
@@ -256,6 +344,15 @@ double Sys_GetClockTicks( void ) {
 						  "pop %%ebx\n"
 						  : "=r" (lo), "=r" (hi) );
 	return (double) lo + (double) 0xFFFFFFFF * hi;
+#elif defined( __x86_64__ )
+	unsigned int lo, hi;
+
+	__asm__ __volatile__ (
+						  "xor %%eax,%%eax\n"		\
+						  "cpuid\n"					\
+						  "rdtsc\n"
+						  : "=a" (lo), "=d" (hi) : : "rbx", "rcx" );
+	return (double) lo + 4294967296.0 * hi;
 #else
 #error unsupported CPU
 #endif
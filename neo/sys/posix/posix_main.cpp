@@ -436,6 +436,42 @@ long Sys_FileTimeStamp(FILE * fp) {
 	return st.st_mtime;
 }
 
+/*
+==============
+Sys_MapFile
+==============
+*/
+const void *Sys_MapFile( FILE *fp, int offset, int length, void **mapBase, int *mapLength ) {
+	*mapBase = NULL;
+	*mapLength = 0;
+
+	if ( length <= 0 || offset < 0 ) {
+		return NULL;
+	}
+
+	// the mapping has to start on a page boundary
+	int pageOffset = offset % sysconf( _SC_PAGESIZE );
+	void *base = mmap( NULL, length + pageOffset, PROT_READ, MAP_PRIVATE, fileno( fp ), offset - pageOffset );
+	if ( base == MAP_FAILED ) {
+		return NULL;
+	}
+
+	*mapBase = base;
+	*mapLength = length + pageOffset;
+	return (byte *)base + pageOffset;
+}
+
+/*
+==============
+Sys_UnmapFile
+==============
+*/
+void Sys_UnmapFile( void *mapBase, int mapLength ) {
+	if ( mapBase ) {
+		munmap( mapBase, mapLength );
+	}
+}
+
 void Sys_Sleep(int msec) {
 	if ( msec < 20 ) {
 		static int last = 0;
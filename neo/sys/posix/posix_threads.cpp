@@ -156,6 +156,37 @@ int g_thread_count = 0;
 
 typedef void *(*pthread_function_t) (void *);
 
+typedef struct {
+	xthread_t		function;
+	void *			parms;
+} threadStart_t;
+
+/*
+==================
+Sys_ThreadExit
+
+returns the memory cached by the thread to the shared heap, also runs when the thread is canceled
+==================
+*/
+static void Sys_ThreadExit( void *unused ) {
+	Mem_FlushThreadCache();
+}
+
+/*
+==================
+Sys_ThreadStart
+==================
+*/
+static void *Sys_ThreadStart( void *parms ) {
+	threadStart_t start = *(threadStart_t *)parms;
+	free( parms );
+
+	pthread_cleanup_push( Sys_ThreadExit, NULL );
+	start.function( start.parms );
+	pthread_cleanup_pop( 1 );
+	return NULL;
+}
+
 /*
 ==================
 Sys_CreateThread
@@ -168,7 +199,10 @@ void Sys_CreateThread( xthread_t function, void *parms, xthreadPriority priority
 	if ( pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_JOINABLE ) != 0 ) {
 		common->Error( "ERROR: pthread_attr_setdetachstate %s failed\n", name );
 	}
-	if ( pthread_create( ( pthread_t* )&info.threadHandle, &attr, ( pthread_function_t )function, parms ) != 0 ) {
+	threadStart_t *start = (threadStart_t *)malloc( sizeof( threadStart_t ) );
+	start->function = function;
+	start->parms = parms;
+	if ( pthread_create( ( pthread_t* )&info.threadHandle, &attr, Sys_ThreadStart, start ) != 0 ) {
 		common->Error( "ERROR: pthread_create %s failed\n", name );
 	}
 	pthread_attr_destroy( &attr );
@@ -192,6 +226,16 @@ void Sys_DestroyThread( xthreadInfo& info ) {
 	if ( pthread_cancel( ( pthread_t )info.threadHandle ) != 0 ) {
 		common->Error( "ERROR: pthread_cancel %s failed\n", info.name );
 	}
+	Sys_JoinThread( info );
+}
+
+/*
+==================
+Sys_JoinThread
+==================
+*/
+void Sys_JoinThread( xthreadInfo& info ) {
+	assert( info.threadHandle );
 	if ( pthread_join( ( pthread_t )info.threadHandle, NULL ) != 0 ) {
 		common->Error( "ERROR: pthread_join %s failed\n", info.name );
 	}
@@ -213,6 +257,75 @@ void Sys_DestroyThread( xthreadInfo& info ) {
 	Sys_LeaveCriticalSection( );
 }
 
+/*
+======================================================
+counting semaphore
+======================================================
+*/
+
+typedef struct {
+	pthread_mutex_t			mutex;
+	pthread_cond_t			cond;
+	int						value;
+} semaphore_t;
+
+/*
+==================
+Sys_CreateSemaphore
+==================
+*/
+void *Sys_CreateSemaphore( void ) {
+	semaphore_t *sem = new semaphore_t;
+	pthread_mutex_init( &sem->mutex, NULL );
+	pthread_cond_init( &sem->cond, NULL );
+	sem->value = 0;
+	return sem;
+}
+
+/*
+==================
+Sys_DestroySemaphore
+==================
+*/
+void Sys_DestroySemaphore( void *semaphore ) {
+	semaphore_t *sem = (semaphore_t *)semaphore;
+	pthread_cond_destroy( &sem->cond );
+	pthread_mutex_destroy( &sem->mutex );
+	delete sem;
+}
+
+/*
+==================
+Sys_PostSemaphore
+==================
+*/
+void Sys_PostSemaphore( void *semaphore, int count ) {
+	semaphore_t *sem = (semaphore_t *)semaphore;
+	pthread_mutex_lock( &sem->mutex );
+	sem->value += count;
+	if ( count > 1 ) {
+		pthread_cond_broadcast( &sem->cond );
+	} else {
+		pthread_cond_signal( &sem->cond );
+	}
+	pthread_mutex_unlock( &sem->mutex );
+}
+
+/*
+==================
+Sys_WaitSemaphore
+==================
+*/
+void Sys_WaitSemaphore( void *semaphore ) {
+	semaphore_t *sem = (semaphore_t *)semaphore;
+	pthread_mutex_lock( &sem->mutex );
+	while ( sem->value == 0 ) {
+		pthread_cond_wait( &sem->cond, &sem->mutex );
+	}
+	sem->value--;
+	pthread_mutex_unlock( &sem->mutex );
+}
+
 /*
 ==================
 Sys_GetThreadName
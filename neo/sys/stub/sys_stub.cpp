@@ -63,6 +63,9 @@ void	Sys_CreateThread(  xthread_t function, void *parms, xthreadPriority priorit
 void Sys_DestroyThread( xthreadInfo& info ) {
 }
 
+void Sys_JoinThread( xthreadInfo& info ) {
+}
+
 void	Sys_FlushCacheMemory( void *base, int bytes ) {
 }
 
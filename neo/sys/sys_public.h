@@ -84,7 +84,7 @@ If you have questions concerning this license or the applicable additional terms
 #endif
 
 #define _alloca							alloca
-#define _alloca16( x )					((void *)((((int)alloca( (x)+15 )) + 15) & ~15))
+#define _alloca16( x )					((void *)((((size_t)alloca( (x)+15 )) + 15) & ~15))
 
 #define PATHSEPERATOR_STR				"/"
 #define PATHSEPERATOR_CHAR				'/'
@@ -115,7 +115,7 @@ If you have questions concerning this license or the applicable additional terms
 #endif
 
 #define _alloca							alloca
-#define _alloca16( x )					((void *)((((int)alloca( (x)+15 )) + 15) & ~15))
+#define _alloca16( x )					((void *)((((size_t)alloca( (x)+15 )) + 15) & ~15))
 
 #define ALIGN16( x )					x
 #define PACKED							__attribute__((packed))
@@ -136,7 +136,12 @@ If you have questions concerning this license or the applicable additional terms
 #ifdef __GNUC__
 #define id_attribute(x) __attribute__(x)
 #else
-#define id_attribute(x)  
+#define id_attribute(x)
+#endif
+
+// compilers with rvalue references get move constructors and move assignments
+#if __cplusplus >= 201103L || ( defined( _MSC_VER ) && _MSC_VER >= 1600 )
+#define ID_RVALUE_REFERENCES
 #endif
 
 typedef enum {
@@ -154,7 +159,10 @@ typedef enum {
 	CPUID_HTT							= 0x01000,	// Hyper-Threading Technology
 	CPUID_CMOV							= 0x02000,	// Conditional Move (CMOV) and fast floating point comparison (FCOMI) instructions
 	CPUID_FTZ							= 0x04000,	// Flush-To-Zero mode (denormal results are flushed to zero)
-	CPUID_DAZ							= 0x08000	// Denormals-Are-Zero mode (denormal source operands are set to zero)
+	CPUID_DAZ							= 0x08000,	// Denormals-Are-Zero mode (denormal source operands are set to zero)
+	CPUID_AVX2							= 0x10000,	// Advanced Vector Extensions 2 (with OS support for the 256 bit registers)
+	CPUID_FMA3							= 0x20000,	// three operand Fused Multiply-Add
+	CPUID_PCLMUL						= 0x40000	// carry-less multiplication (PCLMULQDQ)
 } cpuid_t;
 
 typedef enum {
@@ -233,7 +241,8 @@ typedef struct sysMemoryStats_s {
 
 typedef unsigned long address_t;
 
-template<class type> class idList;		// for Sys_ListFiles
+class idListHeapAllocator;
+template<class type, class allocator> class idList;		// for Sys_ListFiles
 
 
 void			Sys_Init( void );
@@ -369,6 +378,10 @@ void			Sys_ShowConsole( int visLevel, bool quitOnClose );
 
 void			Sys_Mkdir( const char *path );
 ID_TIME_T			Sys_FileTimeStamp( FILE *fp );
+// maps length bytes at offset of an open file read-only into memory, the view stays valid after the file is closed
+// returns NULL if the file can't be mapped, otherwise mapBase and mapLength are set for Sys_UnmapFile
+const void *	Sys_MapFile( FILE *fp, int offset, int length, void **mapBase, int *mapLength );
+void			Sys_UnmapFile( void *mapBase, int mapLength );
 // NOTE: do we need to guarantee the same output on all platforms?
 const char *	Sys_TimeStampToStr( ID_TIME_T timeStamp );
 const char *	Sys_DefaultCDPath( void );
@@ -378,7 +391,7 @@ const char *	Sys_EXEPath( void );
 
 // use fs_debug to verbose Sys_ListFiles
 // returns -1 if directory was not found (the list is cleared)
-int				Sys_ListFiles( const char *directory, const char *extension, idList<class idStr> &list );
+int				Sys_ListFiles( const char *directory, const char *extension, idList<class idStr, idListHeapAllocator> &list );
 
 // know early if we are performing a fatal error shutdown so the error message doesn't get lost
 void			Sys_SetFatalError( const char *error );
@@ -497,6 +510,13 @@ extern int			g_thread_count;
 
 void				Sys_CreateThread( xthread_t function, void *parms, xthreadPriority priority, xthreadInfo &info, const char *name, xthreadInfo *threads[MAX_THREADS], int *thread_count );
 void				Sys_DestroyThread( xthreadInfo& info ); // sets threadHandle back to 0
+void				Sys_JoinThread( xthreadInfo& info );	// waits for a thread that leaves on its own, sets threadHandle back to 0
+
+// counting semaphore for worker threads to sleep on
+void *				Sys_CreateSemaphore( void );
+void				Sys_DestroySemaphore( void *semaphore );
+void				Sys_PostSemaphore( void *semaphore, int count );
+void				Sys_WaitSemaphore( void *semaphore );
 
 // find the name of the calling thread
 // if index != NULL, set the index in g_threads array (use -1 for "main" thread)
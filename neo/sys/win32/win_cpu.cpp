@@ -190,6 +190,53 @@ static void CPUID( int func, unsigned regs[4] ) {
 	regs[_REG_EDX] = regEDX;
 }
 
+/*
+================
+CPUIDEX
+
+  Same as CPUID but also sets the sub-leaf in ECX.
+================
+*/
+static void CPUIDEX( int func, int subFunc, unsigned regs[4] ) {
+	unsigned regEAX, regEBX, regECX, regEDX;
+
+	__asm pusha
+	__asm mov eax, func
+	__asm mov ecx, subFunc
+	__asm __emit 00fh
+	__asm __emit 0a2h
+	__asm mov regEAX, eax
+	__asm mov regEBX, ebx
+	__asm mov regECX, ecx
+	__asm mov regEDX, edx
+	__asm popa
+
+	regs[_REG_EAX] = regEAX;
+	regs[_REG_EBX] = regEBX;
+	regs[_REG_ECX] = regECX;
+	regs[_REG_EDX] = regEDX;
+}
+
+/*
+================
+XGETBV
+
+  Returns the low 32 bits of the extended control register XCR0.
+================
+*/
+static unsigned XGETBV( void ) {
+	unsigned regEAX;
+
+	__asm pusha
+	__asm xor ecx, ecx
+	__asm __emit 00fh
+	__asm __emit 001h
+	__asm __emit 0d0h
+	__asm mov regEAX, eax
+	__asm popa
+
+	return regEAX;
+}
 
 /*
 ================
@@ -335,6 +382,96 @@ static bool HasSSE3( void ) {
 	return false;
 }
 
+/*
+================
+HasAVX
+
+  Also verifies the OS saves the 256 bit registers on a context switch.
+================
+*/
+static bool HasAVX( void ) {
+	unsigned regs[4];
+
+	// get CPU feature bits
+	CPUID( 1, regs );
+
+	// bit 27 of ECX denotes OSXSAVE and bit 28 of ECX denotes AVX existence
+	if ( ( regs[_REG_ECX] & ( 3 << 27 ) ) != ( 3 << 27 ) ) {
+		return false;
+	}
+
+	// bits 1 and 2 of XCR0 denote the OS saves the XMM and YMM registers
+	return ( XGETBV() & 6 ) == 6;
+}
+
+/*
+================
+HasAVX2
+================
+*/
+static bool HasAVX2( void ) {
+	unsigned regs[4];
+
+	if ( !HasAVX() ) {
+		return false;
+	}
+
+	// the extended feature bits are only available if the maximum leaf is at least 7
+	CPUID( 0, regs );
+	if ( regs[_REG_EAX] < 7 ) {
+		return false;
+	}
+
+	// get extended CPU feature bits
+	CPUIDEX( 7, 0, regs );
+
+	// bit 5 of EBX denotes AVX2 existence
+	if ( regs[_REG_EBX] & ( 1 << 5 ) ) {
+		return true;
+	}
+	return false;
+}
+
+/*
+================
+HasFMA3
+================
+*/
+static bool HasFMA3( void ) {
+	unsigned regs[4];
+
+	if ( !HasAVX() ) {
+		return false;
+	}
+
+	// get CPU feature bits
+	CPUID( 1, regs );
+
+	// bit 12 of ECX denotes FMA3 existence
+	if ( regs[_REG_ECX] & ( 1 << 12 ) ) {
+		return true;
+	}
+	return false;
+}
+
+/*
+================
+HasPCLMUL
+================
+*/
+static bool HasPCLMUL( void ) {
+	unsigned regs[4];
+
+	// get CPU feature bits
+	CPUID( 1, regs );
+
+	// bit 1 of ECX denotes PCLMULQDQ existence
+	if ( regs[_REG_ECX] & ( 1 << 1 ) ) {
+		return true;
+	}
+	return false;
+}
+
 /*
 ================
 LogicalProcPerPhysicalProc
@@ -571,6 +708,21 @@ cpuid_t Sys_GetCPUId( void ) {
 		flags |= CPUID_SSE3;
 	}
 
+	// check for Advanced Vector Extensions 2
+	if ( HasAVX2() ) {
+		flags |= CPUID_AVX2;
+	}
+
+	// check for Fused Multiply-Add
+	if ( HasFMA3() ) {
+		flags |= CPUID_FMA3;
+	}
+
+	// check for carry-less multiplication
+	if ( HasPCLMUL() ) {
+		flags |= CPUID_PCLMUL;
+	}
+
 	// check for Hyper-Threading Technology
 	if ( HasHTT() ) {
 		flags |= CPUID_HTT;
@@ -85,16 +85,40 @@ void Sys_GetExeLaunchMemoryStatus( sysMemoryStats_t &stats ) {
 	stats = exeLaunchMemoryStats;
 }
 
+typedef struct {
+	xthread_t		function;
+	void *			parms;
+} threadStart_t;
+
+/*
+==================
+Sys_ThreadStart
+
+returns the memory cached by the thread to the shared heap when the thread function returns
+==================
+*/
+static DWORD WINAPI Sys_ThreadStart( LPVOID parms ) {
+	threadStart_t start = *(threadStart_t *)parms;
+	free( parms );
+
+	DWORD result = start.function( start.parms );
+	Mem_FlushThreadCache();
+	return result;
+}
+
 /*
 ==================
 Sys_Createthread
 ==================
 */
 void Sys_CreateThread(  xthread_t function, void *parms, xthreadPriority priority, xthreadInfo &info, const char *name, xthreadInfo *threads[MAX_THREADS], int *thread_count ) {
+	threadStart_t *start = (threadStart_t *)malloc( sizeof( threadStart_t ) );
+	start->function = function;
+	start->parms = parms;
 	HANDLE temp = CreateThread(	NULL,	// LPSECURITY_ATTRIBUTES lpsa,
 									0,		// DWORD cbStack,
-									(LPTHREAD_START_ROUTINE)function,	// LPTHREAD_START_ROUTINE lpStartAddr,
-									parms,	// LPVOID lpvThreadParm,
+									Sys_ThreadStart,	// LPTHREAD_START_ROUTINE lpStartAddr,
+									start,	// LPVOID lpvThreadParm,
 									0,		//   DWORD fdwCreate,
 									&info.threadId);
 	info.threadHandle = (int) temp;
@@ -122,6 +146,51 @@ void Sys_DestroyThread( xthreadInfo& info ) {
 	info.threadHandle = 0;
 }
 
+/*
+==================
+Sys_JoinThread
+==================
+*/
+void Sys_JoinThread( xthreadInfo& info ) {
+	Sys_DestroyThread( info );
+}
+
+/*
+==================
+Sys_CreateSemaphore
+==================
+*/
+void *Sys_CreateSemaphore( void ) {
+	return CreateSemaphore( NULL, 0, 0x7fffffff, NULL );
+}
+
+/*
+==================
+Sys_DestroySemaphore
+==================
+*/
+void Sys_DestroySemaphore( void *semaphore ) {
+	CloseHandle( (HANDLE)semaphore );
+}
+
+/*
+==================
+Sys_PostSemaphore
+==================
+*/
+void Sys_PostSemaphore( void *semaphore, int count ) {
+	ReleaseSemaphore( (HANDLE)semaphore, count, NULL );
+}
+
+/*
+==================
+Sys_WaitSemaphore
+==================
+*/
+void Sys_WaitSemaphore( void *semaphore ) {
+	WaitForSingleObject( (HANDLE)semaphore, INFINITE );
+}
+
 /*
 ==================
 Sys_Sentry
@@ -482,6 +551,53 @@ ID_TIME_T Sys_FileTimeStamp( FILE *fp ) {
 	return (long) st.st_mtime;
 }
 
+/*
+=================
+Sys_MapFile
+=================
+*/
+const void *Sys_MapFile( FILE *fp, int offset, int length, void **mapBase, int *mapLength ) {
+	*mapBase = NULL;
+	*mapLength = 0;
+
+	if ( length <= 0 || offset < 0 ) {
+		return NULL;
+	}
+
+	HANDLE mapping = CreateFileMapping( (HANDLE)_get_osfhandle( _fileno( fp ) ), NULL, PAGE_READONLY, 0, 0, NULL );
+	if ( mapping == NULL ) {
+		return NULL;
+	}
+
+	// the view has to start on an allocation granularity boundary
+	SYSTEM_INFO info;
+	GetSystemInfo( &info );
+	int viewOffset = offset % info.dwAllocationGranularity;
+	void *base = MapViewOfFile( mapping, FILE_MAP_READ, 0, offset - viewOffset, length + viewOffset );
+
+	// the view keeps a reference to the mapping
+	CloseHandle( mapping );
+
+	if ( base == NULL ) {
+		return NULL;
+	}
+
+	*mapBase = base;
+	*mapLength = length + viewOffset;
+	return (byte *)base + viewOffset;
+}
+
+/*
+=================
+Sys_UnmapFile
+=================
+*/
+void Sys_UnmapFile( void *mapBase, int mapLength ) {
+	if ( mapBase ) {
+		UnmapViewOfFile( mapBase );
+	}
+}
+
 /*
 ==============
 Sys_Cwd
@@ -1075,6 +1191,15 @@ void Sys_Init( void ) {
 		if ( win32.cpuid & CPUID_SSE3 ) {
 			string += "SSE3 & ";
 		}
+		if ( win32.cpuid & CPUID_AVX2 ) {
+			string += "AVX2 & ";
+		}
+		if ( win32.cpuid & CPUID_FMA3 ) {
+			string += "FMA3 & ";
+		}
+		if ( win32.cpuid & CPUID_PCLMUL ) {
+			string += "PCLMUL & ";
+		}
 		if ( win32.cpuid & CPUID_HTT ) {
 			string += "HTT & ";
 		}
@@ -1104,6 +1229,12 @@ void Sys_Init( void ) {
 				id |= CPUID_SSE2;
 			} else if ( token.Icmp( "sse3" ) == 0 ) {
 				id |= CPUID_SSE3;
+			} else if ( token.Icmp( "avx2" ) == 0 ) {
+				id |= CPUID_AVX2;
+			} else if ( token.Icmp( "fma3" ) == 0 ) {
+				id |= CPUID_FMA3;
+			} else if ( token.Icmp( "pclmul" ) == 0 ) {
+				id |= CPUID_PCLMUL;
 			} else if ( token.Icmp( "htt" ) == 0 ) {
 				id |= CPUID_HTT;
 			}